@@ -92,7 +92,7 @@ public:
 #include "animator.h"
 #include "ianimationtarget.h"
 #include "itimingfunction.h"
-#include "../cvstguitimer.h"
+#include "../cframeclock.h"
 #include "../cview.h"
 #include "../dispatchlist.h"
 #include "../platform/iplatformframe.h"
@@ -107,7 +107,7 @@ namespace Animation {
 namespace Detail {
 
 //-----------------------------------------------------------------------------
-class Timer : public NonAtomicReferenceCounted
+class Timer : public NonAtomicReferenceCounted, public IFrameClockHandler
 {
 public:
 	static void addAnimator (Animator* animator)
@@ -154,9 +154,7 @@ protected:
 #if DEBUG_LOG
 		DebugPrint ("Animation timer started\n");
 #endif
-		timer = new CVSTGUITimer ([this] (CVSTGUITimer*) {
-			onTimer ();
-		}, 1000/60); // 60 Hz
+		CFrameClock::instance ().add (CFrameClock::Phase::animate, this);
 	}
 	
 	~Timer () noexcept override
@@ -164,11 +162,11 @@ protected:
 #if DEBUG_LOG
 		DebugPrint ("Animation timer stopped\n");
 #endif
-		timer->forget ();
+		CFrameClock::instance ().remove (CFrameClock::Phase::animate, this);
 		gInstance = nullptr;
 	}
 	
-	void onTimer ()
+	void onFrameClockTick (CFrameClock::Phase phase) override
 	{
 		inTimer = true;
 		auto guard = shared (this);
@@ -183,8 +181,6 @@ protected:
 		toRemove.clear ();
 	}
 
-	CVSTGUITimer* timer;
-	
 	using Animators = std::list<Animator*>;
 	Animators animators;
 	Animators toRemove;
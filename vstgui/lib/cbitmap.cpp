@@ -53,6 +53,14 @@ CBitmap::CBitmap (const CResourceDescription& desc)
 	}
 }
 
+//-----------------------------------------------------------------------------
+CBitmap::CBitmap (const CResourceDescription& desc, const PlatformBitmapPtr& platformBitmap)
+: resourceDesc (desc)
+{
+	if (platformBitmap)
+		bitmaps.emplace_back (platformBitmap);
+}
+
 //-----------------------------------------------------------------------------
 CBitmap::CBitmap (CCoord width, CCoord height)
 {
@@ -222,6 +230,13 @@ CNinePartTiledBitmap::CNinePartTiledBitmap (const PlatformBitmapPtr& platformBit
 {
 }
 
+//-----------------------------------------------------------------------------
+CNinePartTiledBitmap::CNinePartTiledBitmap (const CResourceDescription& desc, const PlatformBitmapPtr& platformBitmap, const CNinePartTiledDescription& offsets)
+: CBitmap (desc, platformBitmap)
+, offsets (offsets)
+{
+}
+
 //-----------------------------------------------------------------------------
 void CNinePartTiledBitmap::draw (CDrawContext* inContext, const CRect& inDestRect, const CPoint& offset, float inAlpha)
 {
@@ -241,13 +256,16 @@ CBitmapPixelAccess::CBitmapPixelAccess ()
 , maxY (0)
 , x (0)
 , y (0)
+, alphaPremultiplied (true)
 {
 }
 
 //------------------------------------------------------------------------
-void CBitmapPixelAccess::init (CBitmap* _bitmap, IPlatformBitmapPixelAccess* _pixelAccess)
+void CBitmapPixelAccess::init (CBitmap* _bitmap, IPlatformBitmapPixelAccess* _pixelAccess,
+                               bool _alphaPremultiplied)
 {
 	bitmap = _bitmap;
+	alphaPremultiplied = _alphaPremultiplied;
 	pixelAccess = _pixelAccess;
 	address = currentPos = pixelAccess->getAddress ();
 	bytesPerRow = pixelAccess->getBytesPerRow ();
@@ -298,7 +316,7 @@ CBitmapPixelAccess* CBitmapPixelAccess::create (CBitmap* bitmap, bool alphaPremu
 		case IPlatformBitmapPixelAccess::kBGRA: result = new CBitmapPixelAccessOrder<2,1,0,3> (); break;
 	}
 	if (result)
-		result->init (bitmap, pixelAccess);
+		result->init (bitmap, pixelAccess, alphaPremultiplied);
 	return result;
 }
 
@@ -25,6 +25,8 @@ public:
 
 	/** Create an image from a resource identifier */
 	explicit CBitmap (const CResourceDescription& desc);
+	/** Create an image from a resource identifier with an already loaded platform bitmap */
+	CBitmap (const CResourceDescription& desc, const PlatformBitmapPtr& platformBitmap);
 	/** Create an image with a given size */
 	CBitmap (CCoord width, CCoord height);
 	/** Create an image with a given size and scale factor */
@@ -126,6 +128,7 @@ class CNinePartTiledBitmap : public CBitmap
 public:
 	CNinePartTiledBitmap (const CResourceDescription& desc, const CNinePartTiledDescription& offsets);
 	CNinePartTiledBitmap (const PlatformBitmapPtr& platformBitmap, const CNinePartTiledDescription& offsets);
+	CNinePartTiledBitmap (const CResourceDescription& desc, const PlatformBitmapPtr& platformBitmap, const CNinePartTiledDescription& offsets);
 	~CNinePartTiledBitmap () noexcept override = default;
 	
 	//-----------------------------------------------------------------------------
@@ -173,6 +176,16 @@ public:
 	inline uint32_t getBitmapHeight () const { return maxY+1; }
 
 	inline IPlatformBitmapPixelAccess* getPlatformBitmapPixelAccess () const { return pixelAccess; }
+
+	/** get the address of the first pixel of a row. The pixels of a row are in the native pixel format */
+	inline uint8_t* getRowAddress (uint32_t row) const { return address + row * bytesPerRow; }
+	/** get the number of bytes between the start of two rows */
+	inline uint32_t getBytesPerRow () const { return bytesPerRow; }
+	/** get the native pixel format */
+	inline IPlatformBitmapPixelAccess::PixelFormat getPixelFormat () const { return pixelAccess->getPixelFormat (); }
+	/** true if the color components are premultiplied with the alpha value */
+	inline bool isAlphaPremultiplied () const { return alphaPremultiplied; }
+
 	/** create an accessor.
 		can return 0 if platform implementation does not support this.
 		result needs to be forgotten before the CBitmap reflects the change to the pixels */
@@ -181,7 +194,7 @@ public:
 protected:
 	CBitmapPixelAccess ();
 	~CBitmapPixelAccess () noexcept override = default;
-	void init (CBitmap* bitmap, IPlatformBitmapPixelAccess* pixelAccess);
+	void init (CBitmap* bitmap, IPlatformBitmapPixelAccess* pixelAccess, bool alphaPremultiplied);
 
 	CBitmap* bitmap;
 	SharedPointer<IPlatformBitmapPixelAccess> pixelAccess;
@@ -192,6 +205,7 @@ protected:
 	uint32_t maxY;
 	uint32_t x;
 	uint32_t y;
+	bool alphaPremultiplied;
 };
 
 //------------------------------------------------------------------------
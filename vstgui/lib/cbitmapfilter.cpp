@@ -10,7 +10,22 @@
 #include "cgraphicstransform.h"
 #include <cassert>
 #include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <cstring>
 #include <memory>
+#include <mutex>
+#include <thread>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define VSTGUI_BITMAPFILTER_SSE2 1
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define VSTGUI_BITMAPFILTER_NEON 1
+#include <arm_neon.h>
+#endif
 
 namespace VSTGUI {
 
@@ -382,35 +397,385 @@ CBitmap* FilterBase::getInputBitmap () const
 	return nullptr;
 }
 
-///@cond ignore
-namespace Standard {
+//----------------------------------------------------------------------------------------------------
+void FilterBase::processRowBands (uint32_t width, uint32_t height,
+                                  const Tiling::RowBandFunction& func) const
+{
+	if (tileSafe)
+		Tiling::processRowBands (width, height, func);
+	else
+		func (0, height);
+}
 
 //----------------------------------------------------------------------------------------------------
 //----------------------------------------------------------------------------------------------------
 //----------------------------------------------------------------------------------------------------
-class BoxBlur : public FilterBase
+namespace Tiling {
+namespace {
+
+//----------------------------------------------------------------------------------------------------
+uint32_t defaultMaxThreads ()
+{
+	return std::max (1u, std::min (4u, std::thread::hardware_concurrency ()));
+}
+
+std::atomic<uint32_t> gMaxThreads {defaultMaxThreads ()};
+std::atomic<uint32_t> gMinPixels {256 * 256};
+
+//----------------------------------------------------------------------------------------------------
+/** Worker threads processing the tiles of one job at a time.
+ *
+ *	Workers are started on demand and stop again after being idle for a while, so that a
+ *	plug-in does not keep threads alive when no filters are used.
+ *
+ *	The pool is never destroyed, as joining the workers from a static destructor can deadlock while
+ *	a plug-in is unloaded. The workers are stopped explicitly with stop instead.
+ */
+class WorkerPool
 {
 public:
-	static IFilter* CreateFunction (IdStringPtr _name)
+	using TileFunction = std::function<void (uint32_t tile)>;
+
+	static WorkerPool& instance ()
 	{
-		return new BoxBlur ();
+		static WorkerPool* gInstance = new WorkerPool ();
+		return *gInstance;
+	}
+
+	/** stop and join all workers, waits for a running job first */
+	void stop ()
+	{
+		std::lock_guard<std::mutex> runGuard (runMutex);
+		std::vector<Worker> stoppedWorkers;
+		{
+			std::lock_guard<std::mutex> guard (mutex);
+			quit = true;
+			stoppedWorkers.swap (workers);
+		}
+		jobCondition.notify_all ();
+		for (auto& worker : stoppedWorkers)
+		{
+			if (worker.thread.joinable ())
+				worker.thread.join ();
+		}
+		std::lock_guard<std::mutex> guard (mutex);
+		quit = false;
+	}
+
+	/** process numTiles tiles with numWorkers worker threads and the calling thread.
+	 *	Returns false without processing anything if the pool is busy with another job.
+	 */
+	bool run (uint32_t numTiles, uint32_t numWorkers, const TileFunction& func)
+	{
+		std::unique_lock<std::mutex> runGuard (runMutex, std::try_to_lock);
+		if (!runGuard.owns_lock ())
+			return false;
+		{
+			std::lock_guard<std::mutex> guard (mutex);
+			startWorkers (numWorkers);
+			job.func = &func;
+			job.numTiles = numTiles;
+			job.numWorkers = numWorkers;
+			nextTile = 0;
+			pendingWorkers = numWorkers;
+			++generation;
+		}
+		jobCondition.notify_all ();
+		processTiles ();
+		std::unique_lock<std::mutex> guard (mutex);
+		doneCondition.wait (guard, [this] () { return pendingWorkers == 0; });
+		job = Job ();
+		return true;
 	}
 
 private:
-	BoxBlur ()
-	: FilterBase ("A Box Blur Filter")
+	struct Job
 	{
+		const TileFunction* func {nullptr};
+		uint32_t numTiles {0};
+		uint32_t numWorkers {0};
+	};
+
+	struct Worker
+	{
+		std::thread thread;
+		bool running {false};
+	};
+
+	static constexpr std::chrono::seconds kIdleTimeout {10};
+
+	void startWorkers (uint32_t numWorkers)
+	{
+		if (workers.size () < numWorkers)
+			workers.resize (numWorkers);
+		for (auto index = 0u; index < numWorkers; ++index)
+		{
+			auto& worker = workers[index];
+			if (worker.running)
+				continue;
+			if (worker.thread.joinable ())
+				worker.thread.join ();
+			worker.running = true;
+			auto currentGeneration = generation;
+			worker.thread = std::thread ([this, index, currentGeneration] () {
+				workerLoop (index, currentGeneration);
+			});
+		}
+	}
+
+	void processTiles ()
+	{
+		uint32_t tile;
+		while ((tile = nextTile.fetch_add (1)) < job.numTiles)
+			(*job.func) (tile);
+	}
+
+	void workerLoop (uint32_t index, uint64_t seenGeneration)
+	{
+		std::unique_lock<std::mutex> guard (mutex);
+		while (true)
+		{
+			if (!jobCondition.wait_for (guard, kIdleTimeout, [&] () {
+				    return quit || generation != seenGeneration;
+			    }))
+			{
+				workers[index].running = false;
+				return;
+			}
+			if (quit)
+				return;
+			seenGeneration = generation;
+			if (index >= job.numWorkers)
+				continue;
+			guard.unlock ();
+			processTiles ();
+			guard.lock ();
+			if (--pendingWorkers == 0)
+				doneCondition.notify_one ();
+		}
+	}
+
+	std::mutex runMutex;
+	std::mutex mutex;
+	std::condition_variable jobCondition;
+	std::condition_variable doneCondition;
+	std::vector<Worker> workers;
+	Job job;
+	std::atomic<uint32_t> nextTile {0};
+	uint32_t pendingWorkers {0};
+	uint64_t generation {0};
+	bool quit {false};
+};
+
+constexpr std::chrono::seconds WorkerPool::kIdleTimeout;
+
+/** bands per thread, more bands balance the load better when threads are interrupted */
+constexpr uint32_t kBandsPerThread = 4;
+
+} // anonymous
+
+//----------------------------------------------------------------------------------------------------
+void setMaxThreads (uint32_t numThreads)
+{
+	gMaxThreads = std::max (1u, numThreads);
+}
+
+//----------------------------------------------------------------------------------------------------
+uint32_t getMaxThreads ()
+{
+	return gMaxThreads;
+}
+
+//----------------------------------------------------------------------------------------------------
+void setMinPixels (uint32_t numPixels)
+{
+	gMinPixels = numPixels;
+}
+
+//----------------------------------------------------------------------------------------------------
+uint32_t getMinPixels ()
+{
+	return gMinPixels;
+}
+
+//----------------------------------------------------------------------------------------------------
+void processRowBands (uint32_t width, uint32_t height, const RowBandFunction& func)
+{
+	auto numThreads = std::min (getMaxThreads (), height);
+	if (numThreads <= 1 || static_cast<uint64_t> (width) * height < getMinPixels ())
+	{
+		func (0, height);
+		return;
+	}
+	auto numBands = std::min (height, numThreads * kBandsPerThread);
+	auto rowsPerBand = (height + numBands - 1) / numBands;
+	numBands = (height + rowsPerBand - 1) / rowsPerBand;
+	auto processBand = [&] (uint32_t band) {
+		auto firstRow = band * rowsPerBand;
+		func (firstRow, std::min (height, firstRow + rowsPerBand));
+	};
+	if (!WorkerPool::instance ().run (numBands, numThreads - 1, processBand))
+		func (0, height);
+}
+
+//----------------------------------------------------------------------------------------------------
+void stopWorkers ()
+{
+	WorkerPool::instance ().stop ();
+}
+
+} // namespace Tiling
+
+///@cond ignore
+namespace Standard {
+
+//----------------------------------------------------------------------------------------------------
+/** the four components of a pixel as float values, operations work on all four at once */
+struct PixelVector
+{
+#if VSTGUI_BITMAPFILTER_SSE2
+	__m128 v;
+
+	static PixelVector zero () { return {_mm_setzero_ps ()}; }
+	static PixelVector load (const uint8_t* pixel)
+	{
+		int32_t value;
+		memcpy (&value, pixel, sizeof (value));
+		auto zero = _mm_setzero_si128 ();
+		auto i = _mm_unpacklo_epi16 (_mm_unpacklo_epi8 (_mm_cvtsi32_si128 (value), zero), zero);
+		return {_mm_cvtepi32_ps (i)};
+	}
+	static PixelVector loadFloat (const float* values) { return {_mm_loadu_ps (values)}; }
+	void storeFloat (float* values) const { _mm_storeu_ps (values, v); }
+	void store (uint8_t* pixel, float scale) const
+	{
+		// round like the scalar and the NEON version by adding 0.5 and truncating
+		auto i = _mm_cvttps_epi32 (_mm_add_ps (_mm_mul_ps (v, _mm_set1_ps (scale)), _mm_set1_ps (0.5f)));
+		i = _mm_packs_epi32 (i, i);
+		i = _mm_packus_epi16 (i, i);
+		auto value = _mm_cvtsi128_si32 (i);
+		memcpy (pixel, &value, sizeof (value));
+	}
+	void add (const PixelVector& p) { v = _mm_add_ps (v, p.v); }
+	void sub (const PixelVector& p) { v = _mm_sub_ps (v, p.v); }
+	void addMul (const PixelVector& p, float factor) { v = _mm_add_ps (v, _mm_mul_ps (p.v, _mm_set1_ps (factor))); }
+#elif VSTGUI_BITMAPFILTER_NEON
+	float32x4_t v;
+
+	static PixelVector zero () { return {vdupq_n_f32 (0.f)}; }
+	static PixelVector load (const uint8_t* pixel)
+	{
+		uint32_t value;
+		memcpy (&value, pixel, sizeof (value));
+		auto w = vmovl_u8 (vreinterpret_u8_u32 (vdup_n_u32 (value)));
+		return {vcvtq_f32_u32 (vmovl_u16 (vget_low_u16 (w)))};
+	}
+	static PixelVector loadFloat (const float* values) { return {vld1q_f32 (values)}; }
+	void storeFloat (float* values) const { vst1q_f32 (values, v); }
+	void store (uint8_t* pixel, float scale) const
+	{
+		auto f = vmlaq_n_f32 (vdupq_n_f32 (0.5f), v, scale);
+		auto h = vqmovn_u32 (vcvtq_u32_f32 (f));
+		auto b = vqmovn_u16 (vcombine_u16 (h, h));
+		auto value = vget_lane_u32 (vreinterpret_u32_u8 (b), 0);
+		memcpy (pixel, &value, sizeof (value));
+	}
+	void add (const PixelVector& p) { v = vaddq_f32 (v, p.v); }
+	void sub (const PixelVector& p) { v = vsubq_f32 (v, p.v); }
+	void addMul (const PixelVector& p, float factor) { v = vmlaq_n_f32 (v, p.v, factor); }
+#else
+	float v[4];
+
+	static PixelVector zero () { return {{0.f, 0.f, 0.f, 0.f}}; }
+	static PixelVector load (const uint8_t* pixel)
+	{
+		return {{static_cast<float> (pixel[0]), static_cast<float> (pixel[1]),
+		         static_cast<float> (pixel[2]), static_cast<float> (pixel[3])}};
+	}
+	static PixelVector loadFloat (const float* values)
+	{
+		return {{values[0], values[1], values[2], values[3]}};
+	}
+	void storeFloat (float* values) const { memcpy (values, v, sizeof (v)); }
+	void store (uint8_t* pixel, float scale) const
+	{
+		for (auto i = 0; i < 4; ++i)
+			pixel[i] = static_cast<uint8_t> (std::min (255.f, std::max (0.f, v[i] * scale + 0.5f)));
+	}
+	void add (const PixelVector& p)
+	{
+		for (auto i = 0; i < 4; ++i)
+			v[i] += p.v[i];
+	}
+	void sub (const PixelVector& p)
+	{
+		for (auto i = 0; i < 4; ++i)
+			v[i] -= p.v[i];
+	}
+	void addMul (const PixelVector& p, float factor)
+	{
+		for (auto i = 0; i < 4; ++i)
+			v[i] += p.v[i] * factor;
+	}
+#endif
+};
+
+//----------------------------------------------------------------------------------------------------
+/** pixel rows of a bitmap, x and y positions are clamped to the edges */
+struct PixelRows
+{
+	uint8_t* address;
+	uint32_t bytesPerRow;
+	int32_t width;
+	int32_t height;
+
+	uint8_t* row (int32_t y) const
+	{
+		return address + std::min (height - 1, std::max (0, y)) * bytesPerRow;
+	}
+	static uint8_t* pixel (uint8_t* row, int32_t x, int32_t width)
+	{
+		return row + std::min (width - 1, std::max (0, x)) * 4;
+	}
+};
+
+//----------------------------------------------------------------------------------------------------
+/** Base class for blur filters which are separable into a horizontal and a vertical pass.
+ *
+ *	The passes treat all four components of a pixel the same, which is correct for the alpha
+ *	premultiplied pixels of the bitmap pixel accessor.
+ */
+class SeparableBlur : public FilterBase
+{
+protected:
+	SeparableBlur (UTF8StringPtr description)
+	: FilterBase (description)
+	{
+		setTileSafe (true);
 		registerProperty (Property::kInputBitmap, BitmapFilter::Property (BitmapFilter::Property::kObject));
 		registerProperty (Property::kRadius, BitmapFilter::Property ((int32_t)2));
 	}
 
+	/** prepare the kernel for the radius in pixels, return false if there is nothing to do */
+	virtual bool prepare (uint32_t radius) = 0;
+	/** blur the rows [firstRow, lastRow) of src horizontally into dst */
+	virtual void horizontalPass (const PixelRows& src, const PixelRows& dst, int32_t firstRow,
+	                             int32_t lastRow) const = 0;
+	/** blur the rows [firstRow, lastRow) of dst vertically from src */
+	virtual void verticalPass (const PixelRows& src, const PixelRows& dst, int32_t firstRow,
+	                           int32_t lastRow) const = 0;
+
 	bool run (bool replace) override
 	{
 		CBitmap* inputBitmap = getInputBitmap ();
-		uint32_t radius = static_cast<uint32_t>(static_cast<double>(getProperty (Property::kRadius).getInteger ()) * inputBitmap->getPlatformBitmap ()->getScaleFactor ());
-		if (inputBitmap == nullptr || radius == UINT_MAX)
+		if (inputBitmap == nullptr || inputBitmap->getPlatformBitmap () == nullptr)
 			return false;
-		if (radius < 2)
+		auto radiusValue = getProperty (Property::kRadius).getInteger ();
+		if (radiusValue < 0)
+			return false;
+		auto radius = static_cast<uint32_t> (
+		    static_cast<double> (radiusValue) * inputBitmap->getPlatformBitmap ()->getScaleFactor ());
+		if (!prepare (radius))
 		{
 			if (replace)
 				return true;
@@ -421,7 +786,7 @@ private:
 			SharedPointer<CBitmapPixelAccess> inputAccessor = owned (CBitmapPixelAccess::create (inputBitmap));
 			if (inputAccessor == nullptr)
 				return false;
-			run (*inputAccessor, *inputAccessor, radius);
+			run (*inputAccessor, *inputAccessor);
 			return registerProperty (Property::kOutputBitmap, BitmapFilter::Property (inputBitmap));
 		}
 		SharedPointer<CBitmap> outputBitmap = owned (new CBitmap (inputBitmap->getWidth (), inputBitmap->getHeight ()));
@@ -432,150 +797,189 @@ private:
 			if (inputAccessor == nullptr || outputAccessor == nullptr)
 				return false;
 
-			run (*inputAccessor, *outputAccessor, radius);
+			run (*inputAccessor, *outputAccessor);
 			return registerProperty (Property::kOutputBitmap, BitmapFilter::Property (outputBitmap));
 		}
 		return false;
 	}
 
-	void run (CBitmapPixelAccess& inputAccessor, CBitmapPixelAccess& outputAccessor, uint32_t radius)
+	void run (CBitmapPixelAccess& inputAccessor, CBitmapPixelAccess& outputAccessor)
 	{
+		auto width = static_cast<int32_t> (std::min (inputAccessor.getBitmapWidth (), outputAccessor.getBitmapWidth ()));
+		auto height = static_cast<int32_t> (std::min (inputAccessor.getBitmapHeight (), outputAccessor.getBitmapHeight ()));
 		auto inputPbpa = inputAccessor.getPlatformBitmapPixelAccess ();
 		auto outputPbpa = outputAccessor.getPlatformBitmapPixelAccess ();
-		auto inputAddressPtr = inputPbpa->getAddress ();
-		auto outputAddressPtr = outputPbpa->getAddress ();
-		auto width = inputPbpa->getBytesPerRow () / 4;
-		auto height = inputAccessor.getBitmapHeight ();
-		switch (inputPbpa->getPixelFormat ())
-		{
-			case IPlatformBitmapPixelAccess::kARGB:
-			case IPlatformBitmapPixelAccess::kABGR:
-			{
-				algo<0, 1, 2, 3> (inputAddressPtr, outputAddressPtr, width, height,
-				                  static_cast<int32_t> (radius / 2));
-				break;
-			}
-			case IPlatformBitmapPixelAccess::kRGBA:
-			case IPlatformBitmapPixelAccess::kBGRA:
-			{
-				algo<1, 2, 3, 0> (inputAddressPtr, outputAddressPtr, width, height,
-				                  static_cast<int32_t> (radius / 2));
-				break;
-			}
-		}
+		auto tmpBytesPerRow = static_cast<uint32_t> (width) * 4;
+		auto tmp = std::unique_ptr<uint8_t[]> (new uint8_t[tmpBytesPerRow * height]);
+		PixelRows input {inputPbpa->getAddress (), inputPbpa->getBytesPerRow (), width, height};
+		PixelRows output {outputPbpa->getAddress (), outputPbpa->getBytesPerRow (), width, height};
+		PixelRows intermediate {tmp.get (), tmpBytesPerRow, width, height};
+		auto numRows = static_cast<uint32_t> (height);
+		processRowBands (static_cast<uint32_t> (width), numRows,
+		                 [&] (uint32_t firstRow, uint32_t lastRow) {
+			                 horizontalPass (input, intermediate, static_cast<int32_t> (firstRow),
+			                                 static_cast<int32_t> (lastRow));
+		                 });
+		processRowBands (static_cast<uint32_t> (width), numRows,
+		                 [&] (uint32_t firstRow, uint32_t lastRow) {
+			                 verticalPass (intermediate, output, static_cast<int32_t> (firstRow),
+			                               static_cast<int32_t> (lastRow));
+		                 });
 	}
+};
 
-	template <int32_t redPos, int32_t greenPos, int32_t bluePos, int32_t alphaPos>
-	void algo (uint8_t* inputPixel, uint8_t* outputPixel, int32_t width, int32_t height,
-	           int32_t radius)
+//----------------------------------------------------------------------------------------------------
+//----------------------------------------------------------------------------------------------------
+//----------------------------------------------------------------------------------------------------
+class BoxBlur : public SeparableBlur
+{
+public:
+	static IFilter* CreateFunction (IdStringPtr _name)
 	{
-		vstgui_assert (radius > 0);
-		constexpr int32_t numComponents = 4;
-		int32_t wm = width - 1;
-		int32_t hm = height - 1;
-		int32_t areaSize = width * height;
-		int32_t div = radius + radius + 1;
-		auto red = std::unique_ptr<uint8_t[]> (new uint8_t[areaSize]);
-		auto green = std::unique_ptr<uint8_t[]> (new uint8_t[areaSize]);
-		auto blue = std::unique_ptr<uint8_t[]> (new uint8_t[areaSize]);
-		auto vMin = std::unique_ptr<int32_t[]> (new int32_t[std::max (width, height)]);
-		auto vMax = std::unique_ptr<int32_t[]> (new int32_t[std::max (width, height)]);
+		return new BoxBlur ();
+	}
+
+private:
+	BoxBlur () : SeparableBlur ("A Box Blur Filter") {}
 
-		auto dv = std::unique_ptr<uint8_t[]> (new uint8_t[256 * div]);
+	int32_t halfSize {0};
+	float scale {1.f};
 
-		for (auto i = 0; i < 256 * div; ++i)
-			dv[i] = (i / div);
+	bool prepare (uint32_t radius) override
+	{
+		if (radius < 2)
+			return false;
+		halfSize = static_cast<int32_t> (radius / 2);
+		scale = 1.f / static_cast<float> (halfSize + halfSize + 1);
+		return true;
+	}
 
-		int32_t rsum, gsum, bsum;
-		for (auto y = 0, yw = 0, yi = 0; y < height; ++y, yw += width)
+	void horizontalPass (const PixelRows& src, const PixelRows& dst, int32_t firstRow,
+	                     int32_t lastRow) const override
+	{
+		auto width = src.width;
+		for (auto y = firstRow; y < lastRow; ++y)
 		{
-			rsum = gsum = bsum = 0;
-			for (auto i = -radius; i <= radius; i++)
+			auto srcRow = src.row (y);
+			auto dstRow = dst.row (y);
+			auto sum = PixelVector::zero ();
+			for (auto i = -halfSize; i <= halfSize; ++i)
+				sum.add (PixelVector::load (PixelRows::pixel (srcRow, i, width)));
+			for (auto x = 0; x < width; ++x)
 			{
-				auto p = (yi + std::min (wm, std::max (i, 0))) * numComponents;
-				rsum += inputPixel[p + redPos];
-				gsum += inputPixel[p + greenPos];
-				bsum += inputPixel[p + bluePos];
-			}
-			if (y == 0)
-			{
-				for (auto x = 0; x < width; ++x, ++yi)
-				{
-					red[yi] = dv[rsum];
-					green[yi] = dv[gsum];
-					blue[yi] = dv[bsum];
-					vMin[x] = std::min (x + radius + 1, wm);
-					vMax[x] = std::max (x - radius, 0);
-					auto p1 = (yw + vMin[x]) * numComponents;
-					auto p2 = (yw + vMax[x]) * numComponents;
-					rsum += inputPixel[p1 + redPos] - inputPixel[p2 + redPos];
-					gsum += inputPixel[p1 + greenPos] - inputPixel[p2 + greenPos];
-					bsum += inputPixel[p1 + bluePos] - inputPixel[p2 + bluePos];
-				}
-			}
-			else
-			{
-				for (auto x = 0; x < width; ++x, ++yi)
-				{
-					red[yi] = dv[rsum];
-					green[yi] = dv[gsum];
-					blue[yi] = dv[bsum];
-					auto p1 = (yw + vMin[x]) * numComponents;
-					auto p2 = (yw + vMax[x]) * numComponents;
-					rsum += inputPixel[p1 + redPos] - inputPixel[p2 + redPos];
-					gsum += inputPixel[p1 + greenPos] - inputPixel[p2 + greenPos];
-					bsum += inputPixel[p1 + bluePos] - inputPixel[p2 + bluePos];
-				}
+				sum.store (dstRow + x * 4, scale);
+				sum.add (PixelVector::load (PixelRows::pixel (srcRow, x + halfSize + 1, width)));
+				sum.sub (PixelVector::load (PixelRows::pixel (srcRow, x - halfSize, width)));
 			}
 		}
+	}
 
-		rsum = gsum = bsum = 0;
-		for (auto i = -radius, yp = -radius * width; i <= radius; ++i, yp += width)
+	void verticalPass (const PixelRows& src, const PixelRows& dst, int32_t firstRow,
+	                   int32_t lastRow) const override
+	{
+		auto width = src.width;
+		auto sums = std::unique_ptr<float[]> (new float[width * 4]);
+		for (auto x = 0; x < width; ++x)
 		{
-			auto yi = std::max (0, yp);
-			rsum += red[yi];
-			gsum += green[yi];
-			bsum += blue[yi];
+			auto sum = PixelVector::zero ();
+			for (auto i = firstRow - halfSize; i <= firstRow + halfSize; ++i)
+				sum.add (PixelVector::load (src.row (i) + x * 4));
+			sum.storeFloat (sums.get () + x * 4);
 		}
-		for (auto y = 0, yi = 0; y < height; ++y, yi += width)
+		for (auto y = firstRow; y < lastRow; ++y)
 		{
-			auto pos = yi * numComponents;
-			outputPixel[pos + redPos] = dv[rsum];
-			outputPixel[pos + greenPos] = dv[gsum];
-			outputPixel[pos + bluePos] = dv[bsum];
-			outputPixel[pos + alphaPos] = inputPixel[pos + alphaPos];
-			vMin[y] = std::min (y + radius + 1, hm) * width;
-			vMax[y] = std::max (y - radius, 0) * width;
-			auto p1 = vMin[y];
-			auto p2 = vMax[y];
-			rsum += red[p1] - red[p2];
-			gsum += green[p1] - green[p2];
-			bsum += blue[p1] - blue[p2];
+			auto dstRow = dst.row (y);
+			auto addRow = src.row (y + halfSize + 1);
+			auto subRow = src.row (y - halfSize);
+			for (auto x = 0; x < width; ++x)
+			{
+				auto sum = PixelVector::loadFloat (sums.get () + x * 4);
+				sum.store (dstRow + x * 4, scale);
+				sum.add (PixelVector::load (addRow + x * 4));
+				sum.sub (PixelVector::load (subRow + x * 4));
+				sum.storeFloat (sums.get () + x * 4);
+			}
 		}
+	}
+};
 
-		for (auto x = 1; x < width; ++x)
+//----------------------------------------------------------------------------------------------------
+//----------------------------------------------------------------------------------------------------
+//----------------------------------------------------------------------------------------------------
+class GaussianBlur : public SeparableBlur
+{
+public:
+	static IFilter* CreateFunction (IdStringPtr _name)
+	{
+		return new GaussianBlur ();
+	}
+
+private:
+	GaussianBlur () : SeparableBlur ("A Gaussian Blur Filter") {}
+
+	int32_t halfSize {0};
+	std::vector<float> weights;
+
+	bool prepare (uint32_t radius) override
+	{
+		if (radius < 1)
+			return false;
+		halfSize = static_cast<int32_t> (radius);
+		auto sigma = std::max (0.5, radius / 3.);
+		weights.resize (static_cast<size_t> (halfSize + halfSize + 1));
+		float sum = 0.f;
+		for (auto i = -halfSize; i <= halfSize; ++i)
 		{
-			rsum = gsum = bsum = 0;
-			for (auto i = -radius, yp = -radius * width; i <= radius; ++i, yp += width)
+			auto w = static_cast<float> (std::exp (-(i * i) / (2. * sigma * sigma)));
+			weights[static_cast<size_t> (i + halfSize)] = w;
+			sum += w;
+		}
+		for (auto& w : weights)
+			w /= sum;
+		return true;
+	}
+
+	void horizontalPass (const PixelRows& src, const PixelRows& dst, int32_t firstRow,
+	                     int32_t lastRow) const override
+	{
+		auto width = src.width;
+		for (auto y = firstRow; y < lastRow; ++y)
+		{
+			auto srcRow = src.row (y);
+			auto dstRow = dst.row (y);
+			for (auto x = 0; x < width; ++x)
 			{
-				auto yi = std::max (0, yp) + x;
-				rsum += red[yi];
-				gsum += green[yi];
-				bsum += blue[yi];
+				auto sum = PixelVector::zero ();
+				for (auto i = -halfSize; i <= halfSize; ++i)
+					sum.addMul (PixelVector::load (PixelRows::pixel (srcRow, x + i, width)),
+					            weights[static_cast<size_t> (i + halfSize)]);
+				sum.store (dstRow + x * 4, 1.f);
 			}
-			for (auto y = 0, yi = x; y < height; ++y, yi += width)
+		}
+	}
+
+	void verticalPass (const PixelRows& src, const PixelRows& dst, int32_t firstRow,
+	                   int32_t lastRow) const override
+	{
+		auto width = src.width;
+		auto sums = std::unique_ptr<float[]> (new float[width * 4]);
+		for (auto y = firstRow; y < lastRow; ++y)
+		{
+			std::fill (sums.get (), sums.get () + width * 4, 0.f);
+			for (auto i = -halfSize; i <= halfSize; ++i)
 			{
-				auto pos = yi * numComponents;
-				outputPixel[pos + redPos] = dv[rsum];
-				outputPixel[pos + greenPos] = dv[gsum];
-				outputPixel[pos + bluePos] = dv[bsum];
-				outputPixel[pos + alphaPos] = inputPixel[pos + alphaPos];
-				auto p1 = x + vMin[y];
-				auto p2 = x + vMax[y];
-				rsum += red[p1] - red[p2];
-				gsum += green[p1] - green[p2];
-				bsum += blue[p1] - blue[p2];
+				auto srcRow = src.row (y + i);
+				auto weight = weights[static_cast<size_t> (i + halfSize)];
+				for (auto x = 0; x < width; ++x)
+				{
+					auto sum = PixelVector::loadFloat (sums.get () + x * 4);
+					sum.addMul (PixelVector::load (srcRow + x * 4), weight);
+					sum.storeFloat (sums.get () + x * 4);
+				}
 			}
+			auto dstRow = dst.row (y);
+			for (auto x = 0; x < width; ++x)
+				PixelVector::loadFloat (sums.get () + x * 4).store (dstRow + x * 4, 1.f);
 		}
 	}
 };
@@ -587,6 +991,7 @@ protected:
 	ScaleBase (UTF8StringPtr description = "")
 	: FilterBase (description)
 	{
+		setTileSafe (true);
 		registerProperty (Property::kInputBitmap, BitmapFilter::Property (BitmapFilter::Property::kObject));
 		registerProperty (Property::kOutputRect, CRect (0, 0, 10, 10));
 	}
@@ -610,11 +1015,16 @@ protected:
 		SharedPointer<CBitmapPixelAccess> outputAccessor = owned (CBitmapPixelAccess::create (outputBitmap));
 		if (inputAccessor == nullptr || outputAccessor == nullptr)
 			return false;
-		process (*inputAccessor, *outputAccessor);
+		processRowBands (outputAccessor->getBitmapWidth (), outputAccessor->getBitmapHeight (),
+		                 [&] (uint32_t firstRow, uint32_t lastRow) {
+			                 process (*inputAccessor, *outputAccessor, firstRow, lastRow);
+		                 });
 		return registerProperty (Property::kOutputBitmap, BitmapFilter::Property (outputBitmap));
 	}
 	
-	virtual void process (CBitmapPixelAccess& originalBitmap, CBitmapPixelAccess& copyBitmap) = 0;
+	/** scale the rows [firstRow, lastRow) of the copy bitmap */
+	virtual void process (const CBitmapPixelAccess& originalBitmap, const CBitmapPixelAccess& copyBitmap,
+	                      uint32_t firstRow, uint32_t lastRow) const = 0;
 	
 };
 
@@ -630,11 +1040,9 @@ public:
 private:
 	ScaleLinear () : ScaleBase ("A Linear Scale Filter") {}
 
-	void process (CBitmapPixelAccess& originalBitmap, CBitmapPixelAccess& copyBitmap) override
+	void process (const CBitmapPixelAccess& originalBitmap, const CBitmapPixelAccess& copyBitmap,
+	              uint32_t firstRow, uint32_t lastRow) const override
 	{
-		originalBitmap.setPosition (0, 0);
-		copyBitmap.setPosition (0, 0);
-		
 		uint32_t origWidth = (uint32_t)originalBitmap.getBitmapWidth ();
 		uint32_t origHeight = (uint32_t)originalBitmap.getBitmapHeight ();
 		uint32_t newWidth = (uint32_t)copyBitmap.getBitmapWidth ();
@@ -643,21 +1051,14 @@ private:
 		float xRatio = (float)origWidth / (float)newWidth;
 		float yRatio = (float)origHeight / (float)newHeight;
 
-		uint8_t* origAddress = originalBitmap.getPlatformBitmapPixelAccess ()->getAddress ();
-		uint8_t* copyAddress = copyBitmap.getPlatformBitmapPixelAccess ()->getAddress ();
-		uint32_t origBytesPerRow = originalBitmap.getPlatformBitmapPixelAccess ()->getBytesPerRow ();
-		uint32_t copyBytesPerRow = copyBitmap.getPlatformBitmapPixelAccess ()->getBytesPerRow ();
-
 		int32_t ix;
-		int32_t iy = -1;
 		int32_t* origPixel = nullptr;
-		float origY = 0;
 		float origX = 0;
-		for (uint32_t y = 0; y < newHeight; y++, origY += yRatio)
+		for (uint32_t y = firstRow; y < lastRow; y++)
 		{
-			int32_t* copyPixel = (int32_t*)(copyAddress + y * copyBytesPerRow);
-			if (iy != (int32_t)origY)
-				iy = (int32_t)origY;
+			int32_t* copyPixel = (int32_t*)copyBitmap.getRowAddress (y);
+			auto iy = std::min (origHeight - 1, static_cast<uint32_t> (y * yRatio));
+			auto origRow = originalBitmap.getRowAddress (iy);
 			ix = -1;
 			origX = 0;
 			for (uint32_t x = 0; x < newWidth; x++, origX += xRatio, copyPixel++)
@@ -665,8 +1066,7 @@ private:
 				if (ix != (int32_t)origX || origPixel == nullptr)
 				{
 					ix = (int32_t)origX;
-					vstgui_assert (iy >= 0);
-					origPixel = (int32_t*)(origAddress + static_cast<uint32_t> (iy) * origBytesPerRow + ix * 4);
+					origPixel = (int32_t*)(origRow + ix * 4);
 				}
 				*copyPixel = *origPixel;
 			}
@@ -686,11 +1086,9 @@ public:
 private:
 	ScaleBiliniear () : ScaleBase ("A Biliniear Scale Filter") {}
 
-	void process (CBitmapPixelAccess& originalBitmap, CBitmapPixelAccess& copyBitmap) override
+	void process (const CBitmapPixelAccess& originalBitmap, const CBitmapPixelAccess& copyBitmap,
+	              uint32_t firstRow, uint32_t lastRow) const override
 	{
-		originalBitmap.setPosition (0, 0);
-		copyBitmap.setPosition (0, 0);
-
 		uint32_t origWidth = (uint32_t)originalBitmap.getBitmapWidth ();
 		uint32_t origHeight = (uint32_t)originalBitmap.getBitmapHeight ();
 		uint32_t newWidth = (uint32_t)copyBitmap.getBitmapWidth ();
@@ -698,59 +1096,134 @@ private:
 
 		float xRatio = ((float)(origWidth-1)) / (float)newWidth;
 		float yRatio = ((float)(origHeight-1)) / (float)newHeight;
-		float xDiff, yDiff, r, g, b, a;
+		float xDiff, yDiff;
 		uint32_t x, y;
-		CColor color[4];
-		CColor result;
 
-		for (uint32_t i = 0; i < newHeight; i++)
+		// all four components are interpolated the same way, so the native pixel format does not matter
+		for (uint32_t i = firstRow; i < lastRow; i++)
 		{
 			y = static_cast<uint32_t> (yRatio * i);
 			yDiff = (yRatio * i) - y;
+			const uint8_t* row0 = originalBitmap.getRowAddress (y);
+			const uint8_t* row1 = originalBitmap.getRowAddress (std::min (y + 1, origHeight - 1));
+			uint8_t* copyPixel = copyBitmap.getRowAddress (i);
 
-			for (uint32_t j = 0; j < newWidth; j++, ++copyBitmap)
+			for (uint32_t j = 0; j < newWidth; j++, copyPixel += 4)
 			{
 				x = static_cast<uint32_t> (xRatio * j);
 				xDiff = (xRatio * j) - x;
-				originalBitmap.setPosition (x, y);
-				originalBitmap.getColor (color[0]);
-				originalBitmap.setPosition (x+1, y);
-				originalBitmap.getColor (color[1]);
-				originalBitmap.setPosition (x, y+1);
-				originalBitmap.getColor (color[2]);
-				originalBitmap.setPosition (x+1, y+1);
-				originalBitmap.getColor (color[3]);
-				r = color[0].red * (1.f - xDiff) * (1.f - yDiff) + color[1].red * xDiff * (1.f - yDiff)
-				+ color[2].red * yDiff * (1.f - xDiff) + color[3].red * xDiff * yDiff;
-				g = color[0].green * (1.f - xDiff) * (1.f - yDiff) + color[1].green * xDiff * (1.f - yDiff)
-				+ color[2].green * yDiff * (1.f - xDiff) + color[3].green * xDiff * yDiff;
-				b = color[0].blue * (1.f - xDiff) * (1.f - yDiff) + color[1].blue * xDiff * (1.f - yDiff)
-				+ color[2].blue * yDiff * (1.f - xDiff) + color[3].blue * xDiff * yDiff;
-				a = color[0].alpha * (1.f - xDiff) * (1.f - yDiff) + color[1].alpha * xDiff * (1.f - yDiff)
-				+ color[2].alpha * yDiff * (1.f - xDiff) + color[3].alpha * xDiff * yDiff;
-				result = CColor ((uint8_t)r, (uint8_t)g, (uint8_t)b, (uint8_t)a);
-				copyBitmap.setColor (result);
+				auto x1 = std::min (x + 1, origWidth - 1);
+				const uint8_t* color[4] = {row0 + x * 4, row0 + x1 * 4, row1 + x * 4, row1 + x1 * 4};
+				for (auto c = 0; c < 4; ++c)
+				{
+					auto value = color[0][c] * (1.f - xDiff) * (1.f - yDiff) + color[1][c] * xDiff * (1.f - yDiff)
+					+ color[2][c] * yDiff * (1.f - xDiff) + color[3][c] * xDiff * yDiff;
+					copyPixel[c] = (uint8_t)value;
+				}
 			}
 		}
 	}
 };
 
 //----------------------------------------------------------------------------------------------------
+/** byte positions of the color components in a native pixel */
+struct PixelLayout
+{
+	int32_t red;
+	int32_t green;
+	int32_t blue;
+	int32_t alpha;
+
+	static PixelLayout fromFormat (IPlatformBitmapPixelAccess::PixelFormat format)
+	{
+		switch (format)
+		{
+			case IPlatformBitmapPixelAccess::kARGB: return {1, 2, 3, 0};
+			case IPlatformBitmapPixelAccess::kRGBA: return {0, 1, 2, 3};
+			case IPlatformBitmapPixelAccess::kABGR: return {3, 2, 1, 0};
+			case IPlatformBitmapPixelAccess::kBGRA: return {2, 1, 0, 3};
+		}
+		return {0, 1, 2, 3};
+	}
+
+	static uint8_t div255 (uint32_t value)
+	{
+		value += 128;
+		return static_cast<uint8_t> ((value + (value >> 8)) >> 8);
+	}
+
+	/** returns the color as a native pixel value */
+	uint32_t toNative (const CColor& color, bool premultiply) const
+	{
+		uint8_t pixel[4];
+		pixel[red] = premultiply ? div255 (color.red * color.alpha) : color.red;
+		pixel[green] = premultiply ? div255 (color.green * color.alpha) : color.green;
+		pixel[blue] = premultiply ? div255 (color.blue * color.alpha) : color.blue;
+		pixel[alpha] = color.alpha;
+		uint32_t value;
+		memcpy (&value, pixel, sizeof (value));
+		return value;
+	}
+
+	/** returns a native pixel value where only the alpha component is set */
+	uint32_t alphaMask () const { return toNative (CColor (0, 0, 0, 255), false); }
+};
+
+#if VSTGUI_BITMAPFILTER_SSE2
 //----------------------------------------------------------------------------------------------------
+/** divide eight 16 bit values in the range [0..255*255] by 255 */
+inline __m128i div255Epu16 (__m128i x)
+{
+	x = _mm_add_epi16 (x, _mm_set1_epi16 (128));
+	return _mm_srli_epi16 (_mm_add_epi16 (x, _mm_srli_epi16 (x, 8)), 8);
+}
+
 //----------------------------------------------------------------------------------------------------
-using SimpleFilterProcessFunction = void (*) (CColor& color, FilterBase* self);
+/** copy the alpha component of two pixels with 16 bit components to all components */
+template<int32_t alphaPos>
+inline __m128i broadcastAlphaEpu16 (__m128i x)
+{
+	x = _mm_shufflelo_epi16 (x, _MM_SHUFFLE (alphaPos, alphaPos, alphaPos, alphaPos));
+	return _mm_shufflehi_epi16 (x, _MM_SHUFFLE (alphaPos, alphaPos, alphaPos, alphaPos));
+}
+
+//----------------------------------------------------------------------------------------------------
+/** returns the eight 16 bit values of two pixels with the components from the layout */
+inline __m128i setEpu16 (const PixelLayout& layout, uint16_t r, uint16_t g, uint16_t b, uint16_t a)
+{
+	uint16_t values[8];
+	for (auto i = 0; i < 8; i += 4)
+	{
+		values[i + layout.red] = r;
+		values[i + layout.green] = g;
+		values[i + layout.blue] = b;
+		values[i + layout.alpha] = a;
+	}
+	return _mm_loadu_si128 (reinterpret_cast<const __m128i*> (values));
+}
+#endif
 
-template<typename SimpleFilterProcessFunction>
+//----------------------------------------------------------------------------------------------------
+//----------------------------------------------------------------------------------------------------
+//----------------------------------------------------------------------------------------------------
+/** Base class for filters which change every pixel independent of the other pixels.
+ *
+ *	The subclasses process whole rows of native pixels.
+ */
 class SimpleFilter : public FilterBase
 {
 protected:
-	SimpleFilter (UTF8StringPtr description, SimpleFilterProcessFunction function)
+	SimpleFilter (UTF8StringPtr description)
 	: FilterBase (description)
-	, processFunction (function)
 	{
+		setTileSafe (true);
 		registerProperty (Property::kInputBitmap, BitmapFilter::Property (BitmapFilter::Property::kObject));
 	}
 
+	/** process numPixels native pixels from src to dst, src and dst may be the same */
+	virtual void processRow (const uint8_t* src, uint8_t* dst, uint32_t numPixels,
+	                         const PixelLayout& layout, bool premultiplied) const = 0;
+
 	bool run (bool replace) override
 	{
 		SharedPointer<CBitmap> inputBitmap = getInputBitmap ();
@@ -781,39 +1254,23 @@ protected:
 
 	void run (CBitmapPixelAccess& inputAccessor, CBitmapPixelAccess& outputAccessor)
 	{
-		inputAccessor.setPosition (0, 0);
-		outputAccessor.setPosition (0, 0);
-		CColor color;
-		if (&inputAccessor == &outputAccessor)
-		{
-			do
-			{
-				inputAccessor.getColor (color);
-				processFunction (color, this);
-				outputAccessor.setColor (color);
-			}
-			while (++inputAccessor);
-		}
-		else
-		{
-			do
-			{
-				inputAccessor.getColor (color);
-				processFunction (color, this);
-				outputAccessor.setColor (color);
-				++outputAccessor;
-			}
-			while (++inputAccessor);
-		}
+		vstgui_assert (inputAccessor.getPixelFormat () == outputAccessor.getPixelFormat ());
+		auto layout = PixelLayout::fromFormat (inputAccessor.getPixelFormat ());
+		auto premultiplied = inputAccessor.isAlphaPremultiplied ();
+		auto width = std::min (inputAccessor.getBitmapWidth (), outputAccessor.getBitmapWidth ());
+		auto height = std::min (inputAccessor.getBitmapHeight (), outputAccessor.getBitmapHeight ());
+		processRowBands (width, height, [&] (uint32_t firstRow, uint32_t lastRow) {
+			for (auto y = firstRow; y < lastRow; ++y)
+				processRow (inputAccessor.getRowAddress (y), outputAccessor.getRowAddress (y), width,
+				            layout, premultiplied);
+		});
 	}
-
-	SimpleFilterProcessFunction processFunction;
 };
 
 //----------------------------------------------------------------------------------------------------
 //----------------------------------------------------------------------------------------------------
 //----------------------------------------------------------------------------------------------------
-class SetColor : public SimpleFilter<SimpleFilterProcessFunction>
+class SetColor : public SimpleFilter
 {
 public:
 	static IFilter* CreateFunction (IdStringPtr _name)
@@ -823,20 +1280,12 @@ public:
 
 private:
 	SetColor ()
-	: SimpleFilter<SimpleFilterProcessFunction> ("A Set Color Filter", processSetColor)
+	: SimpleFilter ("A Set Color Filter")
 	{
 		registerProperty (Property::kIgnoreAlphaColorValue, BitmapFilter::Property ((int32_t)1));
 		registerProperty (Property::kInputColor, BitmapFilter::Property (kWhiteCColor));
 	}
 
-	static void processSetColor (CColor& color, FilterBase* obj)
-	{
-		SetColor* filter = static_cast<SetColor*> (obj);
-		if (filter->ignoreAlpha)
-			filter->inputColor.alpha = color.alpha;
-		color = filter->inputColor;
-	}
-
 	bool ignoreAlpha;
 	CColor inputColor;
 
@@ -844,14 +1293,71 @@ private:
 	{
 		inputColor = getProperty (Property::kInputColor).getColor ();
 		ignoreAlpha = getProperty (Property::kIgnoreAlphaColorValue).getInteger () > 0;
-		return SimpleFilter<SimpleFilterProcessFunction>::run (replace);
+		return SimpleFilter::run (replace);
+	}
+
+	void processRow (const uint8_t* src, uint8_t* dst, uint32_t numPixels,
+	                 const PixelLayout& layout, bool premultiplied) const override
+	{
+		if (!ignoreAlpha)
+		{
+			auto value = layout.toNative (inputColor, premultiplied);
+			for (auto i = 0u; i < numPixels; ++i, dst += 4)
+				memcpy (dst, &value, sizeof (value));
+		}
+		else if (!premultiplied)
+		{
+			auto colorValue = layout.toNative (inputColor, false);
+			auto alphaMask = layout.alphaMask ();
+			colorValue &= ~alphaMask;
+			for (auto i = 0u; i < numPixels; ++i, src += 4, dst += 4)
+			{
+				uint32_t value;
+				memcpy (&value, src, sizeof (value));
+				value = (value & alphaMask) | colorValue;
+				memcpy (dst, &value, sizeof (value));
+			}
+		}
+		else if (layout.alpha == 0)
+			processPremultiplied<0> (src, dst, numPixels, layout);
+		else
+			processPremultiplied<3> (src, dst, numPixels, layout);
+	}
+
+	/** set the color components to the input color multiplied with the alpha of the pixel */
+	template<int32_t alphaPos>
+	void processPremultiplied (const uint8_t* src, uint8_t* dst, uint32_t numPixels,
+	                           const PixelLayout& layout) const
+	{
+		auto i = 0u;
+#if VSTGUI_BITMAPFILTER_SSE2
+		auto factors = setEpu16 (layout, inputColor.red, inputColor.green, inputColor.blue, 255);
+		auto zero = _mm_setzero_si128 ();
+		for (; i + 4 <= numPixels; i += 4, src += 16, dst += 16)
+		{
+			auto pixels = _mm_loadu_si128 (reinterpret_cast<const __m128i*> (src));
+			auto lo = _mm_unpacklo_epi8 (pixels, zero);
+			auto hi = _mm_unpackhi_epi8 (pixels, zero);
+			lo = div255Epu16 (_mm_mullo_epi16 (broadcastAlphaEpu16<alphaPos> (lo), factors));
+			hi = div255Epu16 (_mm_mullo_epi16 (broadcastAlphaEpu16<alphaPos> (hi), factors));
+			_mm_storeu_si128 (reinterpret_cast<__m128i*> (dst), _mm_packus_epi16 (lo, hi));
+		}
+#endif
+		for (; i < numPixels; ++i, src += 4, dst += 4)
+		{
+			auto alpha = src[alphaPos];
+			dst[layout.red] = PixelLayout::div255 (inputColor.red * alpha);
+			dst[layout.green] = PixelLayout::div255 (inputColor.green * alpha);
+			dst[layout.blue] = PixelLayout::div255 (inputColor.blue * alpha);
+			dst[alphaPos] = alpha;
+		}
 	}
 };
 
 //----------------------------------------------------------------------------------------------------
 //----------------------------------------------------------------------------------------------------
 //----------------------------------------------------------------------------------------------------
-class Grayscale : public SimpleFilter<SimpleFilterProcessFunction>
+class Grayscale : public SimpleFilter
 {
 public:
 	static IFilter* CreateFunction (IdStringPtr name)
@@ -861,21 +1367,61 @@ public:
 
 private:
 	Grayscale ()
-	: SimpleFilter<SimpleFilterProcessFunction> ("A Grayscale Filter", processGrayscale)
+	: SimpleFilter ("A Grayscale Filter")
 	{
 	}
 
-	static void processGrayscale (CColor& color, FilterBase* obj)
+	// the weights of CColor::getLuma in 1/256
+	static constexpr uint16_t kRedWeight = 77;
+	static constexpr uint16_t kGreenWeight = 151;
+	static constexpr uint16_t kBlueWeight = 28;
+
+	/** the luma is linear in the color components, so it is the same for premultiplied pixels */
+	void processRow (const uint8_t* src, uint8_t* dst, uint32_t numPixels,
+	                 const PixelLayout& layout, bool premultiplied) const override
 	{
-		color.red = color.green = color.blue = color.getLuma ();
+		auto i = 0u;
+#if VSTGUI_BITMAPFILTER_SSE2
+		auto weights = setEpu16 (layout, kRedWeight, kGreenWeight, kBlueWeight, 0);
+		auto alphaMask = _mm_set1_epi32 (static_cast<int32_t> (layout.alphaMask ()));
+		auto zero = _mm_setzero_si128 ();
+		for (; i + 4 <= numPixels; i += 4, src += 16, dst += 16)
+		{
+			auto pixels = _mm_loadu_si128 (reinterpret_cast<const __m128i*> (src));
+			// two partial sums per pixel
+			auto lo = _mm_madd_epi16 (_mm_unpacklo_epi8 (pixels, zero), weights);
+			auto hi = _mm_madd_epi16 (_mm_unpackhi_epi8 (pixels, zero), weights);
+			auto even = _mm_castps_si128 (_mm_shuffle_ps (
+			    _mm_castsi128_ps (lo), _mm_castsi128_ps (hi), _MM_SHUFFLE (2, 0, 2, 0)));
+			auto odd = _mm_castps_si128 (_mm_shuffle_ps (
+			    _mm_castsi128_ps (lo), _mm_castsi128_ps (hi), _MM_SHUFFLE (3, 1, 3, 1)));
+			auto luma = _mm_srli_epi32 (_mm_add_epi32 (even, odd), 8);
+			luma = _mm_or_si128 (luma, _mm_slli_epi32 (luma, 8));
+			luma = _mm_or_si128 (luma, _mm_slli_epi32 (luma, 16));
+			auto result = _mm_or_si128 (_mm_andnot_si128 (alphaMask, luma),
+			                            _mm_and_si128 (alphaMask, pixels));
+			_mm_storeu_si128 (reinterpret_cast<__m128i*> (dst), result);
+		}
+#endif
+		for (; i < numPixels; ++i, src += 4, dst += 4)
+		{
+			auto luma = static_cast<uint8_t> ((src[layout.red] * kRedWeight + src[layout.green] * kGreenWeight +
+			                                   src[layout.blue] * kBlueWeight) >> 8);
+			dst[layout.alpha] = src[layout.alpha];
+			dst[layout.red] = dst[layout.green] = dst[layout.blue] = luma;
+		}
 	}
-
 };
 
+//----------------------------------------------------------------------------------------------------
+constexpr uint16_t Grayscale::kRedWeight;
+constexpr uint16_t Grayscale::kGreenWeight;
+constexpr uint16_t Grayscale::kBlueWeight;
+
 //----------------------------------------------------------------------------------------------------
 //----------------------------------------------------------------------------------------------------
 //----------------------------------------------------------------------------------------------------
-class ReplaceColor : public SimpleFilter<SimpleFilterProcessFunction>
+class ReplaceColor : public SimpleFilter
 {
 public:
 	static IFilter* CreateFunction (IdStringPtr name)
@@ -885,19 +1431,12 @@ public:
 
 private:
 	ReplaceColor ()
-	: SimpleFilter<SimpleFilterProcessFunction> ("A Replace Color Filter", processReplace)
+	: SimpleFilter ("A Replace Color Filter")
 	{
 		registerProperty (Property::kInputColor, BitmapFilter::Property (kWhiteCColor));
 		registerProperty (Property::kOutputColor, BitmapFilter::Property (kTransparentCColor));
 	}
 
-	static void processReplace (CColor& color, FilterBase* obj)
-	{
-		ReplaceColor* filter = static_cast<ReplaceColor*> (obj);
-		if (color == filter->inputColor)
-			color = filter->outputColor;
-	}
-
 	CColor inputColor;
 	CColor outputColor;
 
@@ -905,9 +1444,36 @@ private:
 	{
 		inputColor = getProperty (Property::kInputColor).getColor ();
 		outputColor = getProperty (Property::kOutputColor).getColor ();
-		return SimpleFilter<SimpleFilterProcessFunction>::run (replace);
+		return SimpleFilter::run (replace);
 	}
 
+	/** compares and replaces whole native pixel values */
+	void processRow (const uint8_t* src, uint8_t* dst, uint32_t numPixels,
+	                 const PixelLayout& layout, bool premultiplied) const override
+	{
+		auto inputValue = layout.toNative (inputColor, premultiplied);
+		auto outputValue = layout.toNative (outputColor, premultiplied);
+		auto i = 0u;
+#if VSTGUI_BITMAPFILTER_SSE2
+		auto input = _mm_set1_epi32 (static_cast<int32_t> (inputValue));
+		auto output = _mm_set1_epi32 (static_cast<int32_t> (outputValue));
+		for (; i + 4 <= numPixels; i += 4, src += 16, dst += 16)
+		{
+			auto pixels = _mm_loadu_si128 (reinterpret_cast<const __m128i*> (src));
+			auto equal = _mm_cmpeq_epi32 (pixels, input);
+			auto result = _mm_or_si128 (_mm_and_si128 (equal, output), _mm_andnot_si128 (equal, pixels));
+			_mm_storeu_si128 (reinterpret_cast<__m128i*> (dst), result);
+		}
+#endif
+		for (; i < numPixels; ++i, src += 4, dst += 4)
+		{
+			uint32_t value;
+			memcpy (&value, src, sizeof (value));
+			if (value == inputValue)
+				value = outputValue;
+			memcpy (dst, &value, sizeof (value));
+		}
+	}
 };
 
 //----------------------------------------------------------------------------------------------------
@@ -916,6 +1482,7 @@ private:
 void registerStandardFilters (Factory& factory)
 {
 	factory.registerFilter (kBoxBlur, BoxBlur::CreateFunction);
+	factory.registerFilter (kGaussianBlur, GaussianBlur::CreateFunction);
 	factory.registerFilter (kSetColor, SetColor::CreateFunction);
 	factory.registerFilter (kGrayscale, Grayscale::CreateFunction);
 	factory.registerFilter (kReplaceColor, ReplaceColor::CreateFunction);
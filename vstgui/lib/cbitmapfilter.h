@@ -9,6 +9,7 @@
 #include <vector>
 #include <string>
 #include <map>
+#include <functional>
 
 namespace VSTGUI {
 
@@ -108,6 +109,41 @@ protected:
 	FilterMap filters;
 };
 
+//----------------------------------------------------------------------------------------------------
+/// @brief Tiled Execution of Bitmap Filters
+/// @details Tile safe filters split large bitmaps into bands of rows which are processed on a pool of
+/// worker threads. The calling thread takes part in the work and returns when all bands are done.
+/// The standard blur, color and scale filters are tile safe.
+///
+/// The worker threads are stopped when the last frame is closed on Linux and Windows. A plug-in
+/// which runs filters without a frame or on macOS must call stopWorkers before it is unloaded.
+//----------------------------------------------------------------------------------------------------
+namespace Tiling {
+
+/** set the maximum number of threads used for one filter run including the calling thread.
+ *	1 disables the worker threads. The default is the number of cores, but not more than 4.
+ */
+void setMaxThreads (uint32_t numThreads);
+uint32_t getMaxThreads ();
+
+/** bitmaps with less pixels are processed on the calling thread only */
+void setMinPixels (uint32_t numPixels);
+uint32_t getMinPixels ();
+
+using RowBandFunction = std::function<void (uint32_t firstRow, uint32_t lastRow)>;
+
+/** call func for bands of rows [firstRow, lastRow) which together cover all rows of the bitmap.
+ *	The bands may be processed concurrently, so func must only write to its own rows.
+ */
+void processRowBands (uint32_t width, uint32_t height, const RowBandFunction& func);
+
+/** stop and join the worker threads, they are started again by the next tiled filter run.
+ *	Must not be called while the library is unloaded (from DllMain or static destructors).
+ */
+void stopWorkers ();
+
+} // namespace Tiling
+
 /** @brief Standard Bitmap Filter Names */
 namespace Standard {
 
@@ -122,6 +158,17 @@ namespace Standard {
 	*/
 	static const IdStringPtr kBoxBlur = "Box Blur";
 
+	/** Gaussian Blur Filter Name.
+
+		Applies a gaussian blur on the input bitmap. The standard deviation is a third of the radius.
+
+		Properties:
+			- Property::kInputBitmap
+			- Property::kRadius
+			- Property::kOutputBitmap
+	*/
+	static const IdStringPtr kGaussianBlur = "Gaussian Blur";
+
 	/** Grayscale Filter Name.
 	 
 		Produces a grayscale version of the input bitmap.
@@ -208,12 +255,24 @@ namespace Standard {
 //----------------------------------------------------------------------------------------------------
 class FilterBase : public IFilter
 {
+public:
+	/** returns true if the filter processes large bitmaps in bands of rows on worker threads */
+	bool isTileSafe () const { return tileSafe; }
+
 protected:
 	FilterBase (UTF8StringPtr description);
 
 	bool registerProperty (IdStringPtr name, const Property& defaultProperty);
 	CBitmap* getInputBitmap () const;
 
+	/** declare that the rows of the output can be processed concurrently, off by default */
+	void setTileSafe (bool state) { tileSafe = state; }
+	/** call func for bands of rows which together cover all rows, the bands are only processed
+	 *	concurrently if the filter is tile safe
+	 *	@see Tiling::processRowBands
+	 */
+	void processRowBands (uint32_t width, uint32_t height, const Tiling::RowBandFunction& func) const;
+
 	UTF8StringPtr getDescription () const override;
 	bool setProperty (IdStringPtr name, const Property& property) override;
 	bool setProperty (IdStringPtr name, Property&& property) override;
@@ -228,6 +287,7 @@ private:
 	using PropertyMap = std::map<std::string, Property>;
 	std::string description;
 	PropertyMap properties;
+	bool tileSafe {false};
 };
 
 } // namespace BitmapFilter
@@ -43,12 +43,23 @@ public:
 
 	bool getCell (const CPoint& where, CDataBrowser::Cell& cell);
 
+	CCoord getColumnOffset (int32_t column);
+	CCoord getColumnWidth (int32_t column);
+	void invalidateColumns () { columnsValid = false; }
+
 	bool drawFocusOnTop () override;
 	bool getFocusPath (CGraphicsPath& outPath) override;
 protected:
+	void updateColumns ();
 
 	IDataBrowserDelegate* db;
 	CDataBrowser* browser;
+
+	// columnOffsets[i] is the left edge of column i including the preceding column lines, the last
+	// entry is the width of all columns
+	std::vector<CCoord> columnOffsets;
+	std::vector<CCoord> columnWidths;
+	bool columnsValid {false};
 };
 
 //-----------------------------------------------------------------------------------------------
@@ -222,6 +233,9 @@ void CDataBrowser::valueChanged (CControl *pControl)
 //-----------------------------------------------------------------------------------------------
 void CDataBrowser::recalculateSubViews ()
 {
+	// the style may have changed
+	if (dbView)
+		dbView->invalidateColumns ();
 	CScrollView::recalculateSubViews ();
 }
 
@@ -241,11 +255,8 @@ void CDataBrowser::recalculateLayout (bool rememberSelection)
 	CCoord allRowsHeight = rowHeight * numRows;
 	if (style & kDrawRowLines)
 		allRowsHeight += numRows * lineWidth;
-	CCoord allColumnsWidth = 0;
-	for (int32_t i = 0; i < numColumns; i++)
-		allColumnsWidth += db->dbGetCurrentColumnWidth (i, this);
-	if (style & kDrawColumnLines)
-		allColumnsWidth += numColumns * lineWidth;
+	dbView->invalidateColumns ();
+	CCoord allColumnsWidth = dbView->getColumnOffset (numColumns);
 	CRect newContainerSize (0, 0, allColumnsWidth, allRowsHeight);
 	if (style & kDrawHeader)
 	{
@@ -376,12 +387,16 @@ void CDataBrowser::setSelectedRow (int32_t index, bool makeVisible)
 	int32_t numRows = db->dbGetNumRows (this);
 	if (index >= numRows)
 		index = numRows-1;
+	if (index < 0)
+	{
+		unselectAll ();
+		return;
+	}
 
 	bool hasChanged = true;
-	Selection::iterator alreadySelected = std::find (selection.begin (), selection.end (), index);
-	if (alreadySelected != selection.end ())
+	if (isRowSelected (index))
 	{
-		selection.erase (alreadySelected);
+		selection.erase (std::find (selection.begin (), selection.end (), index));
 		hasChanged = selection.size () > 0;
 	}
 	else
@@ -392,10 +407,12 @@ void CDataBrowser::setSelectedRow (int32_t index, bool makeVisible)
 	for (auto row : selection)
 	{
 		dbView->invalidateRow (row);
+		setRowSelectionState (row, false);
 	}
 	selection.clear ();
 	
 	selection.emplace_back (index);
+	setRowSelectionState (index, true);
 	if (hasChanged)
 		db->dbSelectionChanged (this);
 	
@@ -411,17 +428,39 @@ int32_t CDataBrowser::getSelectedRow () const
 	return kNoSelection;
 }
 
+//-----------------------------------------------------------------------------------------------
+bool CDataBrowser::isRowSelected (int32_t row) const
+{
+	return row >= 0 && static_cast<size_t> (row) < selectedRows.size () &&
+	       selectedRows[static_cast<size_t> (row)];
+}
+
+//-----------------------------------------------------------------------------------------------
+void CDataBrowser::setRowSelectionState (int32_t row, bool state)
+{
+	if (row < 0)
+		return;
+	auto index = static_cast<size_t> (row);
+	if (index >= selectedRows.size ())
+	{
+		if (!state)
+			return;
+		selectedRows.resize (index + 1, false);
+	}
+	selectedRows[index] = state;
+}
+
 //-----------------------------------------------------------------------------------------------
 void CDataBrowser::selectRow (int32_t row)
 {
-	if (row > db->dbGetNumRows (this))
+	if (row < 0 || row > db->dbGetNumRows (this))
 		return;
-	Selection::iterator alreadySelected = std::find (selection.begin (), selection.end (), row);
-	if (alreadySelected == selection.end ())
+	if (!isRowSelected (row))
 	{
 		if (getStyle () & kMultiSelectionStyle)
 		{
 			selection.emplace_back (row);
+			setRowSelectionState (row, true);
 			dbView->invalidateRow (row);
 			db->dbSelectionChanged (this);
 		}
@@ -435,14 +474,14 @@ void CDataBrowser::selectRow (int32_t row)
 //-----------------------------------------------------------------------------------------------
 void CDataBrowser::unselectRow (int32_t row)
 {
-	if (row > db->dbGetNumRows (this))
+	if (row < 0 || row > db->dbGetNumRows (this))
 		return;
-	Selection::iterator alreadySelected = std::find (selection.begin (), selection.end (), row);
-	if (alreadySelected != selection.end ())
+	if (isRowSelected (row))
 	{
 		if (getStyle () & kMultiSelectionStyle)
 		{
-			selection.erase (alreadySelected);
+			selection.erase (std::find (selection.begin (), selection.end (), row));
+			setRowSelectionState (row, false);
 			dbView->invalidateRow (row);
 			db->dbSelectionChanged (this);
 		}
@@ -461,6 +500,7 @@ void CDataBrowser::unselectAll ()
 		for (auto row : selection)
 		{
 			dbView->invalidateRow (row);
+			setRowSelectionState (row, false);
 		}
 		selection.clear ();
 		db->dbSelectionChanged (this);
@@ -470,22 +510,16 @@ void CDataBrowser::unselectAll ()
 //-----------------------------------------------------------------------------------------------
 void CDataBrowser::validateSelection ()
 {
-	bool selectionChanged = false;
-	int32_t numRows = db->dbGetNumRows (this);
-	for (Selection::iterator it = selection.begin (); it != selection.end ();)
+	int32_t numRows = std::max<int32_t> (db->dbGetNumRows (this), 0);
+	if (selectedRows.size () > static_cast<size_t> (numRows))
+		selectedRows.resize (static_cast<size_t> (numRows));
+	auto it = std::remove_if (selection.begin (), selection.end (),
+	                          [&] (int32_t row) { return row >= numRows; });
+	if (it != selection.end ())
 	{
-		if (*it >= numRows)
-		{
-			it = selection.erase (it);
-			selectionChanged = true;
-		}
-		else
-		{
-			++it;
-		}
-	}
-	if (selectionChanged)
+		selection.erase (it, selection.end ());
 		db->dbSelectionChanged (this);
+	}
 }
 
 //-----------------------------------------------------------------------------------------------
@@ -505,16 +539,10 @@ CRect CDataBrowser::getCellBounds (const Cell& cell)
 	if (style & kDrawRowLines)
 		rowHeight += lineWidth;
 	CRect result (0, rowHeight * cell.row, 0, rowHeight * (cell.row+1));
-	for (int32_t i = 0; i <= cell.column; i++)
+	if (cell.column >= 0)
 	{
-		CCoord colWidth = db->dbGetCurrentColumnWidth (i, this);
-		if (i != cell.column)
-		{
-			result.offset (colWidth, 0);
-			if (style & kDrawColumnLines)
-				result.offset (lineWidth, 0);
-		}
-		result.setWidth (colWidth);
+		result.offset (dbView->getColumnOffset (cell.column), 0);
+		result.setWidth (dbView->getColumnWidth (cell.column));
 	}
 	CRect viewSize = dbView->getViewSize ();
 	result.offset (viewSize.left, viewSize.top);
@@ -761,6 +789,47 @@ CRect CDataBrowserView::getRowBounds (int32_t row)
 	return r;
 }
 
+//-----------------------------------------------------------------------------------------------
+void CDataBrowserView::updateColumns ()
+{
+	int32_t numColumns = std::max<int32_t> (db->dbGetNumColumns (browser), 0);
+	if (columnsValid && columnWidths.size () == static_cast<size_t> (numColumns))
+		return;
+	CCoord columnLineWidth = 0;
+	if (browser->getStyle () & CDataBrowser::kDrawColumnLines)
+	{
+		CColor lineColor;
+		db->dbGetLineWidthAndColor (columnLineWidth, lineColor, browser);
+	}
+	columnWidths.clear ();
+	columnOffsets.assign (1, 0.);
+	for (int32_t col = 0; col < numColumns; col++)
+	{
+		CCoord columnWidth = db->dbGetCurrentColumnWidth (col, browser);
+		columnWidths.emplace_back (columnWidth);
+		columnOffsets.emplace_back (columnOffsets.back () + columnWidth + columnLineWidth);
+	}
+	columnsValid = true;
+}
+
+//-----------------------------------------------------------------------------------------------
+CCoord CDataBrowserView::getColumnOffset (int32_t column)
+{
+	updateColumns ();
+	if (column < 0)
+		return 0.;
+	return columnOffsets[std::min<size_t> (static_cast<size_t> (column), columnWidths.size ())];
+}
+
+//-----------------------------------------------------------------------------------------------
+CCoord CDataBrowserView::getColumnWidth (int32_t column)
+{
+	updateColumns ();
+	if (column < 0 || static_cast<size_t> (column) >= columnWidths.size ())
+		return 0.;
+	return columnWidths[static_cast<size_t> (column)];
+}
+
 //-----------------------------------------------------------------------------------------------
 void CDataBrowserView::invalidateRow (int32_t row)
 {
@@ -792,60 +861,60 @@ void CDataBrowserView::drawRect (CDrawContext* context, const CRect& updateRect)
 	if (drawRowLines)
 		rowHeight += lineWidth;
 	int32_t numRows = db->dbGetNumRows (browser);
-	int32_t numColumns = db->dbGetNumColumns (browser);
-
-	const CDataBrowser::Selection& selection = browser->getSelection ();
+	updateColumns ();
+	auto numColumns = static_cast<int32_t> (columnWidths.size ());
+
+	// only the rows intersecting the update rect are drawn, one more row on each side is included as
+	// its line may reach into the update rect
+	int32_t firstRow = 0;
+	int32_t lastRow = 0;
+	if (rowHeight > 0. && numRows > 0)
+	{
+		CCoord top = std::floor ((updateRect.top - getViewSize ().top) / rowHeight) - 1.;
+		CCoord bottom = std::ceil ((updateRect.bottom - getViewSize ().top) / rowHeight) + 1.;
+		firstRow = static_cast<int32_t> (std::min<CCoord> (std::max<CCoord> (top, 0.), numRows));
+		lastRow = static_cast<int32_t> (std::min<CCoord> (std::max<CCoord> (bottom, 0.), numRows));
+	}
 
 	CDrawContext::LineList lines;
 
 	CRect r (getViewSize ());
-	r.setHeight (rowHeight - lineWidth);
-	for (int32_t row = 0; row < numRows; row++)
+	for (int32_t row = firstRow; row < lastRow; row++)
 	{
+		r.top = getViewSize ().top + rowHeight * row;
+		r.setHeight (rowHeight - lineWidth);
 		CRect testRect (r);
 		testRect.bound (updateRect);
 		if (testRect.isEmpty () == false)
 		{
-			bool isSelected = std::find (selection.begin (), selection.end (), row) != selection.end ();
+			bool isSelected = browser->isRowSelected (row);
 			for (int32_t col = 0; col < numColumns; col++)
 			{
-				CCoord columnWidth = db->dbGetCurrentColumnWidth (col, browser);
-				r.setWidth (columnWidth);
-				testRect = r;
+				CRect cellRect (r);
+				cellRect.left += columnOffsets[static_cast<size_t> (col)];
+				cellRect.setWidth (columnWidths[static_cast<size_t> (col)]);
+				testRect = cellRect;
 				testRect.bound (updateRect);
 				if (testRect.isEmpty () == false)
 				{
 					context->setClipRect (testRect);
-					CRect cellSize (r);
-					cellSize.bottom++;
-					cellSize.right++;
-					db->dbDrawCell (context, cellSize, row, col, isSelected ? IDataBrowserDelegate::kRowSelected : 0, browser);
+					cellRect.bottom++;
+					cellRect.right++;
+					db->dbDrawCell (context, cellRect, row, col, isSelected ? IDataBrowserDelegate::kRowSelected : 0, browser);
 				}
-				r.offset (columnWidth, 0);
-				if (browser->getStyle () & CDataBrowser::kDrawColumnLines)
-					r.offset (lineWidth, 0);
 			}
 		}
-		r.left = getViewSize ().left;
-		r.setWidth (getWidth ());
 		if (drawRowLines)
 			lines.emplace_back (r.getBottomLeft (), r.getBottomRight ());
-		r.offset (0, rowHeight);
 	}
 	if (browser->getStyle () & CDataBrowser::kDrawColumnLines)
 	{
-		
-		CPoint p1;
-		CPoint p2;
-		if (browser->getStyle () & CDataBrowser::kDrawColumnLines)
+		CPoint p1 (0, getViewSize ().top);
+		CPoint p2 (0, getViewSize ().bottom);
+		for (int32_t col = 0; col < numColumns - 1; col++)
 		{
-			p1 (getViewSize ().left - lineWidth, getViewSize ().top);
-			p2 (getViewSize ().left - lineWidth, getViewSize ().bottom);
-			for (int32_t col = 0; col < numColumns - 1; col++)
-			{
-				p1.x = p2.x = p1.x + db->dbGetCurrentColumnWidth (col, browser) + lineWidth;
-				lines.emplace_back (p1, p2);
-			}
+			p1.x = p2.x = getViewSize ().left + columnOffsets[static_cast<size_t> (col + 1)] - lineWidth;
+			lines.emplace_back (p1, p2);
 		}
 	}
 	if (lines.size ())
@@ -864,35 +933,26 @@ void CDataBrowserView::drawRect (CDrawContext* context, const CRect& updateRect)
 bool CDataBrowserView::getCell (const CPoint& where, CDataBrowser::Cell& cell)
 {
 	CCoord lineWidth = 0;
-	if (browser->getStyle () & CDataBrowser::kDrawRowLines || browser->getStyle () & CDataBrowser::kDrawColumnLines)
+	if (browser->getStyle () & CDataBrowser::kDrawRowLines)
 	{
 		CColor lineColor;
 		db->dbGetLineWidthAndColor (lineWidth, lineColor, browser);
 	}
-	CCoord rowHeight = db->dbGetRowHeight (browser);
-	int32_t numColumns = db->dbGetNumColumns (browser);
+	CCoord rowHeight = db->dbGetRowHeight (browser) + lineWidth;
 
 	CPoint _where (where);
 	_where.offset (-getViewSize ().left, -getViewSize ().top);
-	if (browser->getStyle () & CDataBrowser::kDrawRowLines)
-		rowHeight += lineWidth;
 	int32_t rowNum = (int32_t)(_where.y / rowHeight);
-	int32_t colNum = 0;
-	CCoord cw = 0;
-	for (int32_t i = 0; i < numColumns; i++)
-	{
-		cw += db->dbGetCurrentColumnWidth (i, browser);
-		if (browser->getStyle () & CDataBrowser::kDrawColumnLines)
-			cw += lineWidth;
-		if (_where.x < cw && rowNum < db->dbGetNumRows (browser) && colNum < db->dbGetNumColumns (browser))
-		{
-			colNum = i;
-			cell.row = rowNum;
-			cell.column = colNum;
-			return true;
-		}
-	}
-	return false;
+	if (rowNum >= db->dbGetNumRows (browser))
+		return false;
+	updateColumns ();
+	// the first column whose right edge is right of the point
+	auto it = std::upper_bound (columnOffsets.begin () + 1, columnOffsets.end (), _where.x);
+	if (it == columnOffsets.end ())
+		return false;
+	cell.row = rowNum;
+	cell.column = static_cast<int32_t> (it - columnOffsets.begin ()) - 1;
+	return true;
 }
 
 //-----------------------------------------------------------------------------------------------
@@ -903,7 +963,7 @@ CMouseEventResult CDataBrowserView::onMouseDown (CPoint &where, const CButtonSta
 	if (getCell (where, cell))
 	{
 		const CDataBrowser::Selection& selection = browser->getSelection ();
-		bool alreadySelected = std::find (selection.begin (), selection.end (), cell.row) != selection.end ();
+		bool alreadySelected = browser->isRowSelected (cell.row);
 		if (browser->getStyle () & CDataBrowser::kMultiSelectionStyle)
 		{
 			if (buttons.getModifierState () == kControl)
@@ -86,8 +86,10 @@ public:
 	/** set the exclusive selected row */
 	virtual void setSelectedRow (int32_t row, bool makeVisible = false);
 
-	/** get all selected rows */
+	/** get all selected rows in the order they were selected */
 	const Selection& getSelection () const { return selection; }
+	/** check if row is selected, does not depend on the number of selected rows */
+	bool isRowSelected (int32_t row) const;
 	/** add row to selection */
 	virtual void selectRow (int32_t row);
 	/** remove row from selection */
@@ -118,12 +120,15 @@ protected:
 
 	void recalculateSubViews () override;
 	void validateSelection ();
+	void setRowSelectionState (int32_t row, bool state);
 
 	IDataBrowserDelegate* db;
 	CDataBrowserView* dbView;
 	CDataBrowserHeader* dbHeader;
 	CViewContainer* dbHeaderContainer;
 	Selection selection;
+	/** one bit per row, kept in sync with selection */
+	std::vector<bool> selectedRows;
 };
 
 //-----------------------------------------------------------------------------
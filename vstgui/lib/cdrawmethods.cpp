@@ -7,6 +7,7 @@
 #include "cstring.h"
 #include "cdrawcontext.h"
 #include "platform/iplatformfont.h"
+#include <vector>
 
 namespace VSTGUI {
 namespace CDrawMethods {
@@ -14,46 +15,59 @@ namespace CDrawMethods {
 //------------------------------------------------------------------------
 UTF8String createTruncatedText (TextTruncateMode mode, const UTF8String& text, CFontRef font, CCoord maxWidth, const CPoint& textInset, uint32_t flags)
 {
-	if (mode == kTextTruncateNone)
+	if (mode == kTextTruncateNone || text.empty ())
 		return text;
 	auto painter = font->getPlatformFont () ? font->getPlatformFont ()->getPainter () : nullptr;
 	if (!painter)
 		return text;
 	CCoord width = painter->getStringWidth (nullptr, text.getPlatformString (), true);
 	width += textInset.x * 2;
-	if (width > maxWidth)
-	{
-		std::string truncatedText;
-		UTF8String result;
-		auto left = text.begin ();
-		auto right = text.end ();
-		while (width > maxWidth && left != right)
-		{
-			if (mode == kTextTruncateHead)
-			{
-				++left;
-				truncatedText = "..";
-			}
-			else if (mode == kTextTruncateTail)
-			{
-				--right;
-				truncatedText = "";
-			}
+	if (width <= maxWidth)
+		return text;
 
-			truncatedText += {left.base (), right.base ()};
+	// the code point boundaries of the text
+	std::vector<UTF8String::CodePointIterator> boundaries;
+	for (auto it = text.begin (), end = text.end (); it != end; ++it)
+		boundaries.emplace_back (it);
+	boundaries.emplace_back (text.end ());
+	auto numCharacters = boundaries.size () - 1;
 
-			if (mode == kTextTruncateTail)
-				truncatedText += "..";
+	UTF8String result;
+	std::string truncatedText;
+	auto createText = [&] (size_t numKeep) {
+		size_t numHead = 0;
+		if (mode == kTextTruncateTail)
+			numHead = numKeep;
+		else if (mode == kTextTruncateMiddle)
+			numHead = (numKeep + 1) / 2;
+		auto numTail = numKeep - numHead;
+		truncatedText.assign (boundaries.front ().base (), boundaries[numHead].base ());
+		truncatedText += "..";
+		truncatedText.append (boundaries[numCharacters - numTail].base (), boundaries.back ().base ());
+		result = truncatedText;
+	};
+	auto fits = [&] (size_t numKeep) {
+		createText (numKeep);
+		auto w = painter->getStringWidth (nullptr, result.getPlatformString (), true);
+		return w + textInset.x * 2 <= maxWidth;
+	};
 
-			result = truncatedText;
-			width = painter->getStringWidth (nullptr, result.getPlatformString (), true);
-			width += textInset.x * 2;
-		}
-		if (left == right && flags & kReturnEmptyIfTruncationIsPlaceholderOnly)
-			result = "";
-		return result;
+	// the text width grows with the number of kept characters, so binary search the maximum
+	// number of characters which fit instead of removing one character after another
+	size_t low = 0;
+	size_t high = numCharacters;
+	while (high - low > 1)
+	{
+		auto mid = low + (high - low) / 2;
+		if (fits (mid))
+			low = mid;
+		else
+			high = mid;
 	}
-	return text;
+	if (low == 0 && flags & kReturnEmptyIfTruncationIsPlaceholderOnly)
+		return "";
+	createText (low);
+	return result;
 }
 
 //------------------------------------------------------------------------
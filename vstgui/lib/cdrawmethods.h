@@ -30,7 +30,8 @@ enum IconPosition {
 enum TextTruncateMode {
 	kTextTruncateNone,
 	kTextTruncateHead,
-	kTextTruncateTail
+	kTextTruncateTail,
+	kTextTruncateMiddle
 };
 
 //-----------------------------------------------------------------------------
@@ -3,6 +3,8 @@
 // distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
 
 #include "cframe.h"
+#include "cframeprofiler.h"
+#include "cinvalidrectlist.h"
 #include "coffscreencontext.h"
 #include "ctooltipsupport.h"
 #include "itouchevent.h"
@@ -33,14 +35,9 @@ struct CFrame::CollectInvalidRects
 	void flush ();
 
 private:
-	using InvalidRects = std::vector<CRect>;
-
 	SharedPointer<CFrame> frame;
-	InvalidRects invalidRects;
+	CInvalidRectList invalidRects;
 	uint32_t lastTicks;
-#if VSTGUI_LOG_COLLECT_INVALID_RECTS
-	uint32_t numAddedRects;
-#endif
 };
 
 //------------------------------------------------------------------------
@@ -61,6 +58,7 @@ struct CFrame::Impl
 	IViewAddedRemovedObserver* viewAddedRemovedObserver {nullptr};
 	SharedPointer<CTooltipSupport> tooltips;
 	SharedPointer<Animation::Animator> animator;
+	SharedPointer<CFrameProfiler> profiler;
 #if VSTGUI_ENABLE_DEPRECATED_METHODS
 	ModalViewSession* legacyModalViewSession {nullptr};
 #endif
@@ -320,6 +318,10 @@ void CFrame::drawRect (CDrawContext* pContext, const CRect& updateRect)
 	if (updateRect.getWidth () <= 0 || updateRect.getHeight () <= 0 || pContext == nullptr)
 		return;
 
+#if VSTGUI_ENABLE_FRAME_PROFILER
+	CFrameProfiler::PaintScope paintScope (pImpl->profiler, updateRect);
+#endif
+
 	if (pContext)
 		pContext->remember ();
 
@@ -754,6 +756,18 @@ Animation::Animator* CFrame::getAnimator ()
 	return pImpl->animator;
 }
 
+//-----------------------------------------------------------------------------
+void CFrame::setProfiler (CFrameProfiler* profiler)
+{
+	pImpl->profiler = profiler;
+}
+
+//-----------------------------------------------------------------------------
+CFrameProfiler* CFrame::getProfiler () const
+{
+	return pImpl->profiler;
+}
+
 //-----------------------------------------------------------------------------
 /**
  * @return tick count in milliseconds
@@ -1376,8 +1390,12 @@ void CFrame::scrollRect (const CRect& src, const CPoint& distance)
 	CRect rect (src);
 	rect.offset (getViewSize ().left, getViewSize ().top);
 
-	if (pImpl->platformFrame)
+	// the platform frames move pixels in untransformed coordinates
+	if (pImpl->platformFrame && getTransform ().isInvariant ())
 	{
+		// pending dirty rects must be known to the platform frame before the pixels are moved
+		if (pImpl->collectInvalidRects)
+			pImpl->collectInvalidRects->flush ();
 		if (pImpl->platformFrame->scrollRect (src, distance))
 			return;
 	}
@@ -1404,6 +1422,10 @@ void CFrame::invalidRect (const CRect& rect)
 	CRect _rect (rect);
 	getTransform ().transform (_rect);
 	_rect.makeIntegral ();
+#if VSTGUI_ENABLE_FRAME_PROFILER
+	if (pImpl->profiler)
+		pImpl->profiler->addDirtyRect (_rect);
+#endif
 	if (pImpl->collectInvalidRects)
 		pImpl->collectInvalidRects->addRect (_rect);
 	else
@@ -1867,9 +1889,6 @@ CFrame::CollectInvalidRects::CollectInvalidRects (CFrame* frame)
 : frame (frame)
 , lastTicks (frame->getTicks ())
 {
-#if VSTGUI_LOG_COLLECT_INVALID_RECTS
-	numAddedRects = 0;
-#endif
 	frame->setCollectInvalidRects (this);
 }
 
@@ -1889,8 +1908,10 @@ void CFrame::CollectInvalidRects::flush ()
 			for (auto& rect : invalidRects)
 				frame->pImpl->platformFrame->invalidRect (rect);
 		#if VSTGUI_LOG_COLLECT_INVALID_RECTS
-			DebugPrint ("%d -> %d\n", numAddedRects, invalidRects.size ());
-			numAddedRects = 0;
+			DebugPrint ("%u -> %u\n",
+						static_cast<uint32_t> (invalidRects.getStatistics ().numAddedRects),
+						static_cast<uint32_t> (invalidRects.size ()));
+			invalidRects.resetStatistics ();
 		#endif
 		}
 		invalidRects.clear ();
@@ -1900,27 +1921,7 @@ void CFrame::CollectInvalidRects::flush ()
 //-----------------------------------------------------------------------------
 void CFrame::CollectInvalidRects::addRect (const CRect& rect)
 {
-#if VSTGUI_LOG_COLLECT_INVALID_RECTS
-	numAddedRects++;
-#endif
-	bool add = true;
-	for (InvalidRects::iterator it = invalidRects.begin (), end = invalidRects.end (); it != end; ++it)
-	{
-		CRect r (rect);
-		if (r.bound (*it) == rect)
-		{
-			add = false;
-			break;
-		}
-		r = *it;
-		if (r.bound (rect) == *it)
-		{
-			invalidRects.erase (it);
-			break;
-		}
-	}
-	if (add)
-		invalidRects.emplace_back (rect);
+	invalidRects.add (rect);
 	uint32_t now = frame->getTicks ();
 	if (now - lastTicks > 16)
 	{
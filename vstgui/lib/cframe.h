@@ -108,6 +108,11 @@ public:
 	/** get animator for this frame */
 	Animation::Animator* getAnimator ();
 
+	/** set the profiler recording the paints of this frame, the frame only records into it if
+	 *	VSTGUI_ENABLE_FRAME_PROFILER is set to 1 */
+	void setProfiler (CFrameProfiler* profiler);
+	CFrameProfiler* getProfiler () const;
+
 	/** get the clipboard data. data is owned by the caller */
 	SharedPointer<IDataPackage> getClipboard ();
 	/** set the clipboard data. */
@@ -0,0 +1,187 @@
+// This file is part of VSTGUI. It is subject to the license terms
+// in the LICENSE file found in the top-level directory of this
+// distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
+
+#include "cframeclock.h"
+#include "cframe.h"
+#include "cvstguitimer.h"
+#include <chrono>
+#include <cmath>
+
+namespace VSTGUI {
+
+//------------------------------------------------------------------------
+static double getCurrentTimeInMilliseconds ()
+{
+	using namespace std::chrono;
+	return duration<double, std::milli> (steady_clock::now ().time_since_epoch ()).count ();
+}
+
+//------------------------------------------------------------------------
+// CFrameClock
+//------------------------------------------------------------------------
+/*! @class CFrameClock
+*/
+//------------------------------------------------------------------------
+CFrameClock::CFrameClock () = default;
+
+//------------------------------------------------------------------------
+CFrameClock::~CFrameClock () noexcept
+{
+	if (timer)
+		timer->stop ();
+}
+
+//------------------------------------------------------------------------
+CFrameClock& CFrameClock::instance ()
+{
+	// never destroyed, handlers in static objects may still remove themselves on exit
+	static CFrameClock* gInstance = new CFrameClock ();
+	return *gInstance;
+}
+
+//------------------------------------------------------------------------
+void CFrameClock::add (Phase phase, IFrameClockHandler* handler)
+{
+	handlers[static_cast<size_t> (phase)].add (handler);
+	updateTimer ();
+}
+
+//------------------------------------------------------------------------
+void CFrameClock::remove (Phase phase, IFrameClockHandler* handler)
+{
+	handlers[static_cast<size_t> (phase)].remove (handler);
+	updateTimer ();
+}
+
+//------------------------------------------------------------------------
+void CFrameClock::setFrameInterval (uint32_t milliseconds)
+{
+	if (milliseconds == 0 || frameInterval == milliseconds)
+		return;
+	frameInterval = milliseconds;
+	if (timer)
+		timer->setFireTime (frameInterval);
+}
+
+//------------------------------------------------------------------------
+bool CFrameClock::hasHandlers () const
+{
+	for (const auto& phaseHandlers : handlers)
+	{
+		if (!phaseHandlers.empty ())
+			return true;
+	}
+	return false;
+}
+
+//------------------------------------------------------------------------
+void CFrameClock::updateTimer ()
+{
+	// handlers removed while ticking are only removed from the lists after their phase
+	if (inTick)
+		return;
+	if (hasHandlers ())
+	{
+		if (!timer)
+		{
+			timer = makeOwned<CVSTGUITimer> ([this] (CVSTGUITimer*) { tick (); }, frameInterval);
+			// the first interval is measured from now on
+			tickTime = getCurrentTimeInMilliseconds ();
+		}
+	}
+	else if (timer)
+	{
+		timer->stop ();
+		timer = nullptr;
+	}
+}
+
+//------------------------------------------------------------------------
+void CFrameClock::tick ()
+{
+	tick (getCurrentTimeInMilliseconds ());
+}
+
+//------------------------------------------------------------------------
+void CFrameClock::tick (double timeInMilliseconds)
+{
+	if (inTick)
+		return;
+
+	if (statistics.numTicks > 0 && timeInMilliseconds > tickTime)
+	{
+		auto interval = timeInMilliseconds - tickTime;
+		statistics.lastInterval = interval;
+		statistics.totalInterval += interval;
+		if (interval > statistics.maxInterval)
+			statistics.maxInterval = interval;
+		if (interval > frameInterval * 1.5)
+		{
+			++statistics.numLateTicks;
+			statistics.numDroppedFrames +=
+			    static_cast<uint64_t> (std::round (interval / frameInterval)) - 1;
+		}
+	}
+	++statistics.numTicks;
+	tickTime = timeInMilliseconds;
+
+	auto start = getCurrentTimeInMilliseconds ();
+	inTick = true;
+	for (uint32_t index = 0; index < kNumPhases; ++index)
+	{
+		auto phase = static_cast<Phase> (index);
+		handlers[index].forEach (
+		    [phase] (IFrameClockHandler* handler) { handler->onFrameClockTick (phase); });
+	}
+	inTick = false;
+	auto duration = getCurrentTimeInMilliseconds () - start;
+	statistics.lastTickDuration = duration;
+	if (duration > statistics.maxTickDuration)
+		statistics.maxTickDuration = duration;
+
+	updateTimer ();
+}
+
+//------------------------------------------------------------------------
+void CFrameClock::resetStatistics ()
+{
+	statistics = {};
+}
+
+//------------------------------------------------------------------------
+// CDirtyViewInvalidator
+//------------------------------------------------------------------------
+CDirtyViewInvalidator::CDirtyViewInvalidator (CFrame* frame, CFrameClock& clock)
+: frame (frame), clock (clock)
+{
+	if (!CView::kDirtyCallAlwaysOnMainThread)
+	{
+		clock.add (CFrameClock::Phase::invalidate, this);
+		added = true;
+	}
+}
+
+//------------------------------------------------------------------------
+CDirtyViewInvalidator::~CDirtyViewInvalidator () noexcept
+{
+	if (added)
+		clock.remove (CFrameClock::Phase::invalidate, this);
+}
+
+//------------------------------------------------------------------------
+void CDirtyViewInvalidator::onFrameClockTick (CFrameClock::Phase phase)
+{
+	if (phase != CFrameClock::Phase::invalidate)
+		return;
+	if (CView::kDirtyCallAlwaysOnMainThread)
+	{
+		// the views invalidate themselves from now on
+		clock.remove (CFrameClock::Phase::invalidate, this);
+		added = false;
+		return;
+	}
+	frame->idle ();
+}
+
+} // namespace
@@ -0,0 +1,147 @@
+// This file is part of VSTGUI. It is subject to the license terms
+// in the LICENSE file found in the top-level directory of this
+// distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
+
+#ifndef __cframeclock__
+#define __cframeclock__
+
+#include "vstguifwd.h"
+#include "dispatchlist.h"
+#include <array>
+
+namespace VSTGUI {
+
+class IFrameClockHandler;
+
+//-----------------------------------------------------------------------------
+// CFrameClock Declaration
+//! @brief a single clock driving animations, idle views and redrawing
+///
+/// Instead of one timer for each of them, the handlers of all phases are called from one timer in
+/// a fixed order per tick: first the animations are advanced, then the idle views are called, then
+/// dirty views are invalidated and finally the invalid areas are painted. So everything changed in
+/// a tick is painted in the same tick.
+///
+/// The timer only runs as long as handlers are registered.
+//-----------------------------------------------------------------------------
+class CFrameClock
+{
+public:
+	enum class Phase : uint32_t
+	{
+		animate,
+		idle,
+		invalidate,
+		paint
+	};
+
+	struct Statistics
+	{
+		/** number of ticks */
+		uint64_t numTicks {0};
+		/** number of ticks which came more than half a frame interval too late */
+		uint64_t numLateTicks {0};
+		/** number of frame intervals without a tick */
+		uint64_t numDroppedFrames {0};
+		/** interval between the last two ticks in milliseconds */
+		double lastInterval {0.};
+		/** longest interval between two ticks in milliseconds */
+		double maxInterval {0.};
+		/** sum of all intervals between ticks in milliseconds */
+		double totalInterval {0.};
+		/** time spent in the handlers during the last tick in milliseconds */
+		double lastTickDuration {0.};
+		/** longest time spent in the handlers of one tick in milliseconds */
+		double maxTickDuration {0.};
+
+		double getAverageInterval () const
+		{
+			return numTicks > 1 ? totalInterval / static_cast<double> (numTicks - 1) : 0.;
+		}
+	};
+
+	CFrameClock ();
+	~CFrameClock () noexcept;
+
+	/** the clock used by the animators, idle views and platform frames */
+	static CFrameClock& instance ();
+
+	//-----------------------------------------------------------------------------
+	/// @name CFrameClock Methods
+	//-----------------------------------------------------------------------------
+	//@{
+	/** add a handler to a phase, starts the timer if it is not running */
+	void add (Phase phase, IFrameClockHandler* handler);
+	/** remove a handler from a phase, stops the timer if it was the last handler */
+	void remove (Phase phase, IFrameClockHandler* handler);
+	/** true as long as the timer runs */
+	bool isRunning () const { return timer != nullptr; }
+
+	/** set the interval of the ticks in milliseconds */
+	void setFrameInterval (uint32_t milliseconds);
+	uint32_t getFrameInterval () const { return frameInterval; }
+
+	/** time of the current or last tick in milliseconds */
+	double getTickTime () const { return tickTime; }
+
+	/** call the handlers of all phases, normally called by the timer */
+	void tick ();
+	/** call the handlers of all phases with the time from an external time source, e.g. a display
+	 *	synchronized callback */
+	void tick (double timeInMilliseconds);
+
+	const Statistics& getStatistics () const { return statistics; }
+	void resetStatistics ();
+	//@}
+
+private:
+	enum { kNumPhases = 4 };
+	using Handlers = DispatchList<IFrameClockHandler*>;
+
+	bool hasHandlers () const;
+	void updateTimer ();
+
+	std::array<Handlers, kNumPhases> handlers;
+	SharedPointer<CVSTGUITimer> timer;
+	uint32_t frameInterval {16};
+	double tickTime {0.};
+	bool inTick {false};
+	Statistics statistics;
+};
+
+//-----------------------------------------------------------------------------
+class IFrameClockHandler
+{
+public:
+	virtual ~IFrameClockHandler () noexcept = default;
+
+	/** called once per tick for each phase the handler was added to */
+	virtual void onFrameClockTick (CFrameClock::Phase phase) = 0;
+};
+
+//-----------------------------------------------------------------------------
+// CDirtyViewInvalidator Declaration
+//! @brief invalidates the dirty views of a frame in the invalidate phase of a frame clock
+///
+/// Used by platform frames which do not have a timer of their own to idle the frame. If views
+/// invalidate themselves when they are set dirty (CView::kDirtyCallAlwaysOnMainThread) there is
+/// nothing to do and the invalidator is not added to the clock, so the clock can stop while
+/// nothing is animated or painted.
+//-----------------------------------------------------------------------------
+class CDirtyViewInvalidator : public IFrameClockHandler
+{
+public:
+	explicit CDirtyViewInvalidator (CFrame* frame, CFrameClock& clock = CFrameClock::instance ());
+	~CDirtyViewInvalidator () noexcept override;
+
+	void onFrameClockTick (CFrameClock::Phase phase) override;
+
+private:
+	CFrame* frame;
+	CFrameClock& clock;
+	bool added {false};
+};
+
+} // namespace
+
+#endif // __cframeclock__
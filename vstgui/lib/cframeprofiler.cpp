@@ -0,0 +1,381 @@
+// This file is part of VSTGUI. It is subject to the license terms
+// in the LICENSE file found in the top-level directory of this
+// distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
+
+#include "cframeprofiler.h"
+#include "cview.h"
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <ostream>
+#include <sstream>
+#include <typeinfo>
+#if defined(__GNUC__)
+#include <cxxabi.h>
+#endif
+
+namespace VSTGUI {
+
+//------------------------------------------------------------------------
+static double getProfilerTimeInMilliseconds ()
+{
+	using namespace std::chrono;
+	return duration<double, std::milli> (steady_clock::now ().time_since_epoch ()).count ();
+}
+
+//------------------------------------------------------------------------
+static std::string getTypeName (const std::type_info& info)
+{
+	std::string name;
+#if defined(__GNUC__)
+	int status = 0;
+	if (auto demangled = abi::__cxa_demangle (info.name (), nullptr, nullptr, &status))
+	{
+		name = demangled;
+		std::free (demangled);
+	}
+#endif
+	if (name.empty ())
+		name = info.name ();
+	// MSVC prefixes the names with the kind of the type
+	for (auto prefix : {"class ", "struct "})
+	{
+		if (name.compare (0, strlen (prefix), prefix) == 0)
+			name.erase (0, strlen (prefix));
+	}
+	static const std::string vstguiNamespace ("VSTGUI::");
+	if (name.compare (0, vstguiNamespace.size (), vstguiNamespace) == 0)
+		name.erase (0, vstguiNamespace.size ());
+	return name;
+}
+
+//------------------------------------------------------------------------
+static void writeJSONString (std::ostream& stream, const std::string& str)
+{
+	stream << '"';
+	for (auto c : str)
+	{
+		if (c == '"' || c == '\\')
+			stream << '\\';
+		if (static_cast<unsigned char> (c) >= 0x20)
+			stream << c;
+	}
+	stream << '"';
+}
+
+//------------------------------------------------------------------------
+// CFrameProfiler
+//------------------------------------------------------------------------
+/*! @class CFrameProfiler
+*/
+//------------------------------------------------------------------------
+constexpr uint32_t CFrameProfiler::kRootIndex;
+
+//------------------------------------------------------------------------
+CFrameProfiler::CFrameProfiler (CFrameClock& clock)
+: clock (clock)
+, startTime (getProfilerTimeInMilliseconds ())
+{
+	callTree.emplace_back ();
+	clock.add (CFrameClock::Phase::animate, this);
+}
+
+//------------------------------------------------------------------------
+CFrameProfiler::~CFrameProfiler () noexcept
+{
+	clock.remove (CFrameClock::Phase::animate, this);
+}
+
+//------------------------------------------------------------------------
+double CFrameProfiler::now () const
+{
+	return getProfilerTimeInMilliseconds () - startTime;
+}
+
+//------------------------------------------------------------------------
+void CFrameProfiler::beginPaint (const CRect& updateRect)
+{
+	// paints inside of paints are part of the outer paint
+	if (paintDepth++ > 0)
+		return;
+	paintRect = updateRect;
+	drawStack.clear ();
+	paintStart = now ();
+}
+
+//------------------------------------------------------------------------
+void CFrameProfiler::endPaint ()
+{
+	if (paintDepth == 0 || --paintDepth > 0)
+		return;
+	auto duration = now () - paintStart;
+	++statistics.numPaints;
+	statistics.totalPaintTime += duration;
+	if (duration > statistics.maxPaintTime)
+		statistics.maxPaintTime = duration;
+	statistics.paintedArea += paintRect.getWidth () * paintRect.getHeight ();
+	auto& root = callTree.front ();
+	++root.count;
+	root.time += duration;
+	addTraceEvent (TraceEvent::Type::paint, kRootIndex, paintStart, duration, paintRect,
+	               dirtyAreaSincePaint);
+	dirtyAreaSincePaint = 0.;
+}
+
+//------------------------------------------------------------------------
+void CFrameProfiler::beginDrawView (const CView* view, const CRect& drawRect)
+{
+	auto viewIndex = getViewIndex (view);
+	auto parentNode = drawStack.empty () ? 0 : drawStack.back ().node;
+	auto node = getChildNode (parentNode, viewIndex);
+	drawStack.push_back ({viewIndex, node, now (), 0., drawRect});
+}
+
+//------------------------------------------------------------------------
+void CFrameProfiler::endDrawView ()
+{
+	if (drawStack.empty ())
+		return;
+	auto entry = drawStack.back ();
+	drawStack.pop_back ();
+	auto duration = now () - entry.start;
+	if (!drawStack.empty ())
+		drawStack.back ().childTime += duration;
+
+	++statistics.numViewDraws;
+	auto& view = viewStatistics[entry.view];
+	++view.numDraws;
+	view.drawTime += duration;
+	view.selfDrawTime += duration - entry.childTime;
+	if (duration > view.maxDrawTime)
+		view.maxDrawTime = duration;
+	auto& node = callTree[entry.node];
+	++node.count;
+	node.time += duration;
+	addTraceEvent (TraceEvent::Type::drawView, entry.view, entry.start, duration, entry.rect);
+}
+
+//------------------------------------------------------------------------
+void CFrameProfiler::addInvalidation (const CView* source, const CRect& rect)
+{
+	auto viewIndex = getViewIndex (source);
+	auto& view = viewStatistics[viewIndex];
+	++view.numInvalidations;
+	view.invalidatedArea += rect.getWidth () * rect.getHeight ();
+	addTraceEvent (TraceEvent::Type::invalidate, viewIndex, now (), 0., rect);
+}
+
+//------------------------------------------------------------------------
+void CFrameProfiler::addDirtyRect (const CRect& rect)
+{
+	++statistics.numInvalidations;
+	auto area = rect.getWidth () * rect.getHeight ();
+	statistics.dirtyArea += area;
+	dirtyAreaSincePaint += area;
+}
+
+//------------------------------------------------------------------------
+void CFrameProfiler::onFrameClockTick (CFrameClock::Phase phase)
+{
+	auto tickTime = clock.getTickTime ();
+	++statistics.numTicks;
+	if (lastTickTime >= 0. && tickTime > lastTickTime)
+	{
+		auto interval = tickTime - lastTickTime;
+		auto jitter = std::abs (interval - clock.getFrameInterval ());
+		statistics.totalJitter += jitter;
+		if (jitter > statistics.maxJitter)
+			statistics.maxJitter = jitter;
+		addTraceEvent (TraceEvent::Type::tick, kRootIndex, now (), interval, CRect ());
+	}
+	lastTickTime = tickTime;
+}
+
+//------------------------------------------------------------------------
+uint32_t CFrameProfiler::getViewIndex (const CView* view)
+{
+	std::type_index type (typeid (*view));
+	auto it = viewTypes.find (type);
+	if (it != viewTypes.end ())
+		return it->second;
+	auto index = static_cast<uint32_t> (viewStatistics.size ());
+	viewStatistics.emplace_back ();
+	viewStatistics.back ().name = getTypeName (typeid (*view));
+	viewTypes.emplace (type, index);
+	return index;
+}
+
+//------------------------------------------------------------------------
+uint32_t CFrameProfiler::getChildNode (uint32_t node, uint32_t view)
+{
+	for (auto child : callTree[node].children)
+	{
+		if (callTree[child].view == view)
+			return child;
+	}
+	auto child = static_cast<uint32_t> (callTree.size ());
+	callTree.emplace_back ();
+	callTree.back ().view = view;
+	callTree.back ().parent = node;
+	callTree[node].children.push_back (child);
+	return child;
+}
+
+//------------------------------------------------------------------------
+void CFrameProfiler::addTraceEvent (TraceEvent::Type type, uint32_t view, double start,
+                                    double duration, const CRect& rect, double dirtyArea)
+{
+	if (maxNumTraceEvents == 0)
+		return;
+	if (traceEvents.size () >= maxNumTraceEvents)
+		traceEvents.pop_front ();
+	traceEvents.push_back ({type, view, start, duration, rect, dirtyArea});
+}
+
+//------------------------------------------------------------------------
+void CFrameProfiler::setMaxNumTraceEvents (size_t maxEvents)
+{
+	maxNumTraceEvents = maxEvents;
+	while (traceEvents.size () > maxNumTraceEvents)
+		traceEvents.pop_front ();
+}
+
+//------------------------------------------------------------------------
+void CFrameProfiler::resetStatistics ()
+{
+	statistics = {};
+	// the jitter is measured from the first tick after the reset on
+	lastTickTime = -1.;
+	for (auto& view : viewStatistics)
+	{
+		ViewStatistics empty;
+		empty.name = std::move (view.name);
+		view = std::move (empty);
+	}
+	// the nodes are kept, as views may be drawn right now
+	for (auto& node : callTree)
+	{
+		node.count = 0;
+		node.time = 0.;
+	}
+}
+
+//------------------------------------------------------------------------
+void CFrameProfiler::clearTraceEvents ()
+{
+	traceEvents.clear ();
+}
+
+//------------------------------------------------------------------------
+void CFrameProfiler::writeChromeTrace (std::ostream& stream) const
+{
+	// times are in microseconds in the trace event format
+	auto writeCommon = [&] (const char* name, const char* category, const char* phase,
+	                        double start) {
+		stream << "{\"name\":";
+		writeJSONString (stream, name);
+		stream << ",\"cat\":\"" << category << "\",\"ph\":\"" << phase
+		       << "\",\"pid\":1,\"tid\":1,\"ts\":" << start * 1000.;
+	};
+	auto writeRect = [&] (const CRect& rect) {
+		stream << "\"x\":" << rect.left << ",\"y\":" << rect.top << ",\"width\":" << rect.getWidth ()
+		       << ",\"height\":" << rect.getHeight ();
+	};
+
+	auto precision = stream.precision (3);
+	auto flags = stream.setf (std::ios::fixed, std::ios::floatfield);
+	stream << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+	bool first = true;
+	for (const auto& event : traceEvents)
+	{
+		if (!first)
+			stream << ",\n";
+		first = false;
+		switch (event.type)
+		{
+			case TraceEvent::Type::paint:
+			{
+				writeCommon ("paint", "frame", "X", event.start);
+				stream << ",\"dur\":" << event.duration * 1000. << ",\"args\":{";
+				writeRect (event.rect);
+				stream << "}},\n";
+				// the dirty area can be larger than the painted area when invalid rects overlap or
+				// smaller when they were joined
+				writeCommon ("area", "frame", "C", event.start);
+				stream << ",\"args\":{\"dirty\":" << event.dirtyArea
+				       << ",\"painted\":" << event.rect.getWidth () * event.rect.getHeight () << "}}";
+				break;
+			}
+			case TraceEvent::Type::drawView:
+			{
+				writeCommon (viewStatistics[event.view].name.data (), "draw", "X", event.start);
+				stream << ",\"dur\":" << event.duration * 1000. << ",\"args\":{";
+				writeRect (event.rect);
+				stream << "}}";
+				break;
+			}
+			case TraceEvent::Type::invalidate:
+			{
+				writeCommon ("invalidate", "invalidate", "i", event.start);
+				stream << ",\"s\":\"t\",\"args\":{\"source\":";
+				writeJSONString (stream, viewStatistics[event.view].name);
+				stream << ",";
+				writeRect (event.rect);
+				stream << "}}";
+				break;
+			}
+			case TraceEvent::Type::tick:
+			{
+				writeCommon ("frame clock", "clock", "C", event.start);
+				stream << ",\"args\":{\"interval\":" << event.duration << ",\"jitter\":"
+				       << std::abs (event.duration - clock.getFrameInterval ()) << "}}";
+				break;
+			}
+		}
+	}
+	stream << "]}\n";
+	stream.flags (flags);
+	stream.precision (precision);
+}
+
+//------------------------------------------------------------------------
+std::string CFrameProfiler::getChromeTrace () const
+{
+	std::ostringstream stream;
+	writeChromeTrace (stream);
+	return stream.str ();
+}
+
+//------------------------------------------------------------------------
+CFrameProfiler::PaintScope::PaintScope (CFrameProfiler* profiler, const CRect& updateRect)
+: profiler (profiler)
+{
+	if (profiler)
+		profiler->beginPaint (updateRect);
+}
+
+//------------------------------------------------------------------------
+CFrameProfiler::PaintScope::~PaintScope () noexcept
+{
+	if (profiler)
+		profiler->endPaint ();
+}
+
+//------------------------------------------------------------------------
+CFrameProfiler::DrawViewScope::DrawViewScope (CFrameProfiler* profiler, const CView* view,
+                                              const CRect& drawRect)
+: profiler (profiler)
+{
+	if (profiler)
+		profiler->beginDrawView (view, drawRect);
+}
+
+//------------------------------------------------------------------------
+CFrameProfiler::DrawViewScope::~DrawViewScope () noexcept
+{
+	if (profiler)
+		profiler->endDrawView ();
+}
+
+} // namespace
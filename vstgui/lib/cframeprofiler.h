@@ -0,0 +1,220 @@
+// This file is part of VSTGUI. It is subject to the license terms
+// in the LICENSE file found in the top-level directory of this
+// distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
+
+#ifndef __cframeprofiler__
+#define __cframeprofiler__
+
+#include "vstguifwd.h"
+#include "cframeclock.h"
+#include "crect.h"
+#include <deque>
+#include <iosfwd>
+#include <string>
+#include <typeindex>
+#include <unordered_map>
+#include <vector>
+
+namespace VSTGUI {
+
+//-----------------------------------------------------------------------------
+// CFrameProfiler Declaration
+//! @brief records where the time of the frames goes
+///
+/// The profiler records the paints of a frame, the draw time of every view drawn by a view
+/// container, the invalidations and their source views and the jitter of the frame clock. The
+/// recorded events can be exported as Chrome trace event JSON (to be loaded into chrome://tracing
+/// or Perfetto) and the drawn views are summed up in a call tree for a flame graph.
+///
+/// The frame, view container and view hooks are only compiled if VSTGUI_ENABLE_FRAME_PROFILER is
+/// set to 1, otherwise the profiler only records what is passed to it manually.
+///
+/// As long as a profiler exists the frame clock keeps ticking to measure its jitter.
+/// @see CFrame::setProfiler, CFrameProfilerView
+//-----------------------------------------------------------------------------
+class CFrameProfiler : public NonAtomicReferenceCounted, public IFrameClockHandler
+{
+public:
+	struct Statistics
+	{
+		/** number of paints */
+		uint64_t numPaints {0};
+		/** time spent painting in milliseconds */
+		double totalPaintTime {0.};
+		/** longest paint in milliseconds */
+		double maxPaintTime {0.};
+		/** number of drawn views */
+		uint64_t numViewDraws {0};
+		/** number of invalidated rects */
+		uint64_t numInvalidations {0};
+		/** sum of the area of all invalidated rects */
+		double dirtyArea {0.};
+		/** sum of the area of all painted rects */
+		double paintedArea {0.};
+		/** number of frame clock ticks */
+		uint64_t numTicks {0};
+		/** sum of the deviations of the tick intervals from the frame interval in milliseconds */
+		double totalJitter {0.};
+		/** largest deviation of a tick interval from the frame interval in milliseconds */
+		double maxJitter {0.};
+
+		double getAveragePaintTime () const
+		{
+			return numPaints ? totalPaintTime / static_cast<double> (numPaints) : 0.;
+		}
+		double getAverageJitter () const
+		{
+			return numTicks > 1 ? totalJitter / static_cast<double> (numTicks - 1) : 0.;
+		}
+	};
+
+	/** statistics of all views of one class */
+	struct ViewStatistics
+	{
+		std::string name;
+		uint64_t numDraws {0};
+		/** time spent drawing the views including their children in milliseconds */
+		double drawTime {0.};
+		/** time spent drawing the views without their children in milliseconds */
+		double selfDrawTime {0.};
+		double maxDrawTime {0.};
+		/** number of times the views invalidated themselves */
+		uint64_t numInvalidations {0};
+		double invalidatedArea {0.};
+	};
+
+	/** node of the call tree of the drawn views, the first node is the root for all paints */
+	struct CallTreeNode
+	{
+		/** index of the view statistics, kRootIndex for the root node */
+		uint32_t view {kRootIndex};
+		uint32_t parent {kRootIndex};
+		std::vector<uint32_t> children;
+		uint64_t count {0};
+		/** time spent in this node including the children in milliseconds */
+		double time {0.};
+	};
+
+	struct TraceEvent
+	{
+		enum class Type : uint32_t
+		{
+			paint,
+			drawView,
+			invalidate,
+			tick
+		};
+
+		Type type;
+		/** index of the view statistics for drawView and invalidate events */
+		uint32_t view;
+		/** start time in milliseconds since the profiler was created */
+		double start;
+		/** duration of paints and draws, interval of ticks in milliseconds */
+		double duration;
+		/** paint rect in frame coordinates, invalid and drawn rects in parent view coordinates */
+		CRect rect;
+		/** area invalidated since the previous paint for paint events */
+		double dirtyArea;
+	};
+
+	static constexpr uint32_t kRootIndex = 0xFFFFFFFF;
+
+	explicit CFrameProfiler (CFrameClock& clock = CFrameClock::instance ());
+	~CFrameProfiler () noexcept override;
+
+	CFrameClock& getFrameClock () const { return clock; }
+
+	//-----------------------------------------------------------------------------
+	/// @name Recording
+	//-----------------------------------------------------------------------------
+	//@{
+	void beginPaint (const CRect& updateRect);
+	void endPaint ();
+	void beginDrawView (const CView* view, const CRect& drawRect);
+	void endDrawView ();
+	/** a view invalidated a rect of itself */
+	void addInvalidation (const CView* source, const CRect& rect);
+	/** a rect of the frame was invalidated */
+	void addDirtyRect (const CRect& rect);
+
+	/** maximum number of trace events kept, the oldest events are removed first */
+	void setMaxNumTraceEvents (size_t maxEvents);
+	size_t getMaxNumTraceEvents () const { return maxNumTraceEvents; }
+
+	/** records paints for the lifetime of the object */
+	struct PaintScope
+	{
+		PaintScope (CFrameProfiler* profiler, const CRect& updateRect);
+		~PaintScope () noexcept;
+
+	private:
+		CFrameProfiler* profiler;
+	};
+
+	/** records the draw of a view for the lifetime of the object */
+	struct DrawViewScope
+	{
+		DrawViewScope (CFrameProfiler* profiler, const CView* view, const CRect& drawRect);
+		~DrawViewScope () noexcept;
+
+	private:
+		CFrameProfiler* profiler;
+	};
+	//@}
+
+	//-----------------------------------------------------------------------------
+	/// @name Results
+	//-----------------------------------------------------------------------------
+	//@{
+	const Statistics& getStatistics () const { return statistics; }
+	const std::vector<ViewStatistics>& getViewStatistics () const { return viewStatistics; }
+	const std::vector<CallTreeNode>& getCallTree () const { return callTree; }
+	const std::deque<TraceEvent>& getTraceEvents () const { return traceEvents; }
+
+	/** reset the statistics and the call tree, but keep the trace events */
+	void resetStatistics ();
+	void clearTraceEvents ();
+
+	/** write the trace events as Chrome trace event JSON */
+	void writeChromeTrace (std::ostream& stream) const;
+	std::string getChromeTrace () const;
+	//@}
+
+	void onFrameClockTick (CFrameClock::Phase phase) override;
+
+private:
+	struct DrawStackEntry
+	{
+		uint32_t view;
+		uint32_t node;
+		double start;
+		double childTime;
+		CRect rect;
+	};
+
+	double now () const;
+	uint32_t getViewIndex (const CView* view);
+	uint32_t getChildNode (uint32_t node, uint32_t view);
+	void addTraceEvent (TraceEvent::Type type, uint32_t view, double start, double duration,
+	                    const CRect& rect, double dirtyArea = 0.);
+
+	CFrameClock& clock;
+	double startTime;
+	double lastTickTime {-1.};
+	double paintStart {0.};
+	CRect paintRect;
+	double dirtyAreaSincePaint {0.};
+	uint32_t paintDepth {0};
+	size_t maxNumTraceEvents {100000};
+	Statistics statistics;
+	std::vector<ViewStatistics> viewStatistics;
+	std::unordered_map<std::type_index, uint32_t> viewTypes;
+	std::vector<CallTreeNode> callTree;
+	std::vector<DrawStackEntry> drawStack;
+	std::deque<TraceEvent> traceEvents;
+};
+
+} // namespace
+
+#endif // __cframeprofiler__
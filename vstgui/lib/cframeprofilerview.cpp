@@ -0,0 +1,230 @@
+// This file is part of VSTGUI. It is subject to the license terms
+// in the LICENSE file found in the top-level directory of this
+// distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
+
+#include "cframeprofilerview.h"
+#include "cdrawcontext.h"
+#include "cframe.h"
+#include <algorithm>
+#include <cstdio>
+#include <functional>
+
+namespace VSTGUI {
+
+//------------------------------------------------------------------------
+static constexpr CCoord kLineHeight = 13.;
+static constexpr CCoord kMargin = 4.;
+
+//------------------------------------------------------------------------
+static CColor getFlameColor (const std::string& name)
+{
+	// a stable warm color for each view class
+	auto hash = std::hash<std::string> () (name);
+	CColor color;
+	color.fromHSL (static_cast<double> (hash % 50), 0.8, 0.45 + (hash % 7) * 0.03);
+	return color;
+}
+
+//------------------------------------------------------------------------
+// CFrameProfilerView
+//------------------------------------------------------------------------
+/*! @class CFrameProfilerView
+*/
+//------------------------------------------------------------------------
+CFrameProfilerView::CFrameProfilerView (const CRect& size, CFrameProfiler* profiler)
+: CView (size)
+, profiler (profiler)
+{
+	setMouseEnabled (false);
+	setTransparency (true);
+}
+
+//------------------------------------------------------------------------
+CFrameProfilerView::~CFrameProfilerView () noexcept
+{
+	if (clockHandlerAdded)
+		profiler->getFrameClock ().remove (CFrameClock::Phase::idle, this);
+}
+
+//------------------------------------------------------------------------
+CFrameProfilerView* CFrameProfilerView::attach (CFrame* frame)
+{
+	auto profiler = shared (frame->getProfiler ());
+	if (!profiler)
+	{
+		profiler = makeOwned<CFrameProfiler> ();
+		frame->setProfiler (profiler);
+	}
+	CRect size (0, 0, 360, 240);
+	size.offset (frame->getViewSize ().getWidth () - size.getWidth () - kMargin, kMargin);
+	auto view = new CFrameProfilerView (size, profiler);
+	view->setAutosizeFlags (kAutosizeRight | kAutosizeTop);
+	frame->addView (view);
+	return view;
+}
+
+//------------------------------------------------------------------------
+void CFrameProfilerView::setRefreshInterval (uint32_t milliseconds)
+{
+	refreshInterval = std::max (1u, milliseconds);
+}
+
+//------------------------------------------------------------------------
+void CFrameProfilerView::refresh ()
+{
+	if (!profiler)
+		return;
+	statistics = profiler->getStatistics ();
+	viewStatistics = profiler->getViewStatistics ();
+	callTree = profiler->getCallTree ();
+	profiler->resetStatistics ();
+	invalid ();
+}
+
+//------------------------------------------------------------------------
+bool CFrameProfilerView::attached (CView* parent)
+{
+	if (CView::attached (parent))
+	{
+		if (profiler && !clockHandlerAdded)
+		{
+			lastRefreshTime = -1.;
+			profiler->getFrameClock ().add (CFrameClock::Phase::idle, this);
+			clockHandlerAdded = true;
+		}
+		return true;
+	}
+	return false;
+}
+
+//------------------------------------------------------------------------
+bool CFrameProfilerView::removed (CView* parent)
+{
+	if (clockHandlerAdded)
+	{
+		profiler->getFrameClock ().remove (CFrameClock::Phase::idle, this);
+		clockHandlerAdded = false;
+	}
+	return CView::removed (parent);
+}
+
+//------------------------------------------------------------------------
+void CFrameProfilerView::onFrameClockTick (CFrameClock::Phase phase)
+{
+	const auto& clock = profiler->getFrameClock ();
+	auto tickTime = clock.getTickTime ();
+	if (lastRefreshTime < 0.)
+	{
+		lastRefreshTime = tickTime;
+		return;
+	}
+	// the statistics are refreshed in the tick closest to the refresh interval
+	if (tickTime - lastRefreshTime < refreshInterval - clock.getFrameInterval () / 2.)
+		return;
+	lastRefreshTime = tickTime;
+	refresh ();
+}
+
+//------------------------------------------------------------------------
+void CFrameProfilerView::drawCallTreeNode (CDrawContext* context, uint32_t nodeIndex,
+                                           const CRect& rect, CCoord bottom)
+{
+	if (rect.bottom > bottom || rect.getWidth () < 1.)
+		return;
+	const auto& node = callTree[nodeIndex];
+	if (node.view != CFrameProfiler::kRootIndex)
+	{
+		const auto& name = viewStatistics[node.view].name;
+		CRect r (rect);
+		r.right -= 1.;
+		context->setFillColor (getFlameColor (name));
+		context->drawRect (r, kDrawFilled);
+		if (r.getWidth () > 30.)
+		{
+			CRect oldClip;
+			context->getClipRect (oldClip);
+			CRect clip (r);
+			clip.bound (oldClip);
+			context->setClipRect (clip);
+			r.left += 2.;
+			context->drawString (name.data (), r, kLeftText);
+			context->setClipRect (oldClip);
+		}
+	}
+	if (node.time <= 0.)
+		return;
+	// the children are laid out from left to right in the width of their parent relative to their
+	// part of the time of their parent
+	CRect childRect (rect.left, rect.bottom, rect.left, rect.bottom + kLineHeight);
+	for (auto child : node.children)
+	{
+		if (callTree[child].count == 0)
+			continue;
+		childRect.right = childRect.left + rect.getWidth () * callTree[child].time / node.time;
+		drawCallTreeNode (context, child, childRect, bottom);
+		childRect.left = childRect.right;
+	}
+}
+
+//------------------------------------------------------------------------
+void CFrameProfilerView::draw (CDrawContext* context)
+{
+	auto size = getViewSize ();
+	context->setDrawMode (kAliasing);
+	context->setFillColor (CColor (0, 0, 0, 200));
+	context->drawRect (size, kDrawFilled);
+	context->setFont (kNormalFontSmaller);
+	context->setFontColor (kWhiteCColor);
+
+	char text[256];
+	CRect line (size.left + kMargin, size.top + kMargin, size.right - kMargin,
+	            size.top + kMargin + kLineHeight);
+	auto drawLine = [&] () {
+		context->drawString (text, line, kLeftText);
+		line.offset (0, kLineHeight);
+	};
+
+	snprintf (text, sizeof (text), "last %u ms: %u paints, avg %.2f ms, max %.2f ms",
+	          refreshInterval, static_cast<uint32_t> (statistics.numPaints),
+	          statistics.getAveragePaintTime (), statistics.maxPaintTime);
+	drawLine ();
+	snprintf (text, sizeof (text), "%u views drawn, painted area %.0f, dirty area %.0f (%.0f%%)",
+	          static_cast<uint32_t> (statistics.numViewDraws), statistics.paintedArea,
+	          statistics.dirtyArea,
+	          statistics.paintedArea > 0. ? statistics.dirtyArea * 100. / statistics.paintedArea :
+	                                        0.);
+	drawLine ();
+	snprintf (text, sizeof (text), "%u invalidations, %u ticks, jitter avg %.2f ms, max %.2f ms",
+	          static_cast<uint32_t> (statistics.numInvalidations),
+	          static_cast<uint32_t> (statistics.numTicks), statistics.getAverageJitter (),
+	          statistics.maxJitter);
+	drawLine ();
+
+	// the views which took the most time themselves
+	std::vector<const CFrameProfiler::ViewStatistics*> slowestViews;
+	for (const auto& view : viewStatistics)
+	{
+		if (view.numDraws > 0)
+			slowestViews.push_back (&view);
+	}
+	std::sort (slowestViews.begin (), slowestViews.end (),
+	           [] (const CFrameProfiler::ViewStatistics* v1,
+	               const CFrameProfiler::ViewStatistics* v2) {
+		           return v1->selfDrawTime > v2->selfDrawTime;
+	           });
+	if (slowestViews.size () > 5)
+		slowestViews.resize (5);
+	for (auto view : slowestViews)
+	{
+		snprintf (text, sizeof (text), "%.2f ms  %ux  %s", view->selfDrawTime,
+		          static_cast<uint32_t> (view->numDraws), view->name.data ());
+		drawLine ();
+	}
+
+	if (callTree.empty () || callTree.front ().count == 0)
+		return;
+	CRect flameRect (line.left, line.top + kMargin, line.right, line.top + kMargin);
+	drawCallTreeNode (context, 0, flameRect, size.bottom - kMargin);
+}
+
+} // namespace
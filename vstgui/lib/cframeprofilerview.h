@@ -0,0 +1,76 @@
+// This file is part of VSTGUI. It is subject to the license terms
+// in the LICENSE file found in the top-level directory of this
+// distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
+
+#ifndef __cframeprofilerview__
+#define __cframeprofilerview__
+
+#include "vstguifwd.h"
+#include "cview.h"
+#include "cframeprofiler.h"
+#include <vector>
+
+namespace VSTGUI {
+
+//-----------------------------------------------------------------------------
+// CFrameProfilerView Declaration
+//! @brief overlay showing the statistics of a frame profiler
+///
+/// Shows the paint times, the dirty and painted areas, the invalidations and the frame clock
+/// jitter of the last refresh interval and a flame graph of the views drawn in this interval.
+/// After each refresh interval the statistics of the profiler are reset. The refresh is driven by the
+/// idle phase of the frame clock of the profiler while the view is attached.
+//-----------------------------------------------------------------------------
+class CFrameProfilerView : public CView, public IFrameClockHandler
+{
+public:
+	CFrameProfilerView (const CRect& size, CFrameProfiler* profiler);
+	~CFrameProfilerView () noexcept override;
+
+	/** add an overlay to the top right corner of the frame, creates a profiler for the frame if it
+	 *	has none */
+	static CFrameProfilerView* attach (CFrame* frame);
+
+	//-----------------------------------------------------------------------------
+	/// @name CFrameProfilerView Methods
+	//-----------------------------------------------------------------------------
+	//@{
+	CFrameProfiler* getProfiler () const { return profiler; }
+
+	/** set the interval in milliseconds after which the statistics are refreshed */
+	void setRefreshInterval (uint32_t milliseconds);
+	uint32_t getRefreshInterval () const { return refreshInterval; }
+
+	/** take the statistics of the profiler and reset them, called after each refresh interval */
+	void refresh ();
+
+	const CFrameProfiler::Statistics& getStatistics () const { return statistics; }
+	const std::vector<CFrameProfiler::ViewStatistics>& getViewStatistics () const
+	{
+		return viewStatistics;
+	}
+	const std::vector<CFrameProfiler::CallTreeNode>& getCallTree () const { return callTree; }
+	//@}
+
+	// overrides
+	void draw (CDrawContext* context) override;
+	bool attached (CView* parent) override;
+	bool removed (CView* parent) override;
+	void onFrameClockTick (CFrameClock::Phase phase) override;
+
+private:
+	void drawCallTreeNode (CDrawContext* context, uint32_t nodeIndex, const CRect& rect,
+	                       CCoord bottom);
+
+	SharedPointer<CFrameProfiler> profiler;
+	uint32_t refreshInterval {500};
+	double lastRefreshTime {-1.};
+	bool clockHandlerAdded {false};
+	CFrameProfiler::Statistics statistics;
+	std::vector<CFrameProfiler::ViewStatistics> viewStatistics;
+	std::vector<CFrameProfiler::CallTreeNode> callTree;
+};
+
+} // namespace
+
+#endif // __cframeprofilerview__
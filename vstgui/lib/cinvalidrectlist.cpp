@@ -0,0 +1,158 @@
+// This file is part of VSTGUI. It is subject to the license terms
+// in the LICENSE file found in the top-level directory of this
+// distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
+
+#include "cinvalidrectlist.h"
+#include <algorithm>
+
+namespace VSTGUI {
+
+//-----------------------------------------------------------------------------
+namespace {
+
+//-----------------------------------------------------------------------------
+inline CCoord area (const CRect& r)
+{
+	return r.getWidth () * r.getHeight ();
+}
+
+//-----------------------------------------------------------------------------
+inline bool intersects (const CRect& r1, const CRect& r2)
+{
+	return r1.left < r2.right && r2.left < r1.right && r1.top < r2.bottom && r2.top < r1.bottom;
+}
+
+//-----------------------------------------------------------------------------
+inline bool contains (const CRect& outer, const CRect& inner)
+{
+	return outer.left <= inner.left && outer.top <= inner.top && outer.right >= inner.right &&
+		   outer.bottom >= inner.bottom;
+}
+
+//-----------------------------------------------------------------------------
+inline CCoord intersectionArea (const CRect& r1, const CRect& r2)
+{
+	if (!intersects (r1, r2))
+		return 0.;
+	CRect r (r1);
+	return area (r.bound (r2));
+}
+
+//-----------------------------------------------------------------------------
+/** appends the parts of r which are not covered by cut as horizontal bands */
+void appendBands (const CRect& r, const CRect& cut, CInvalidRectList::RectList& list)
+{
+	if (cut.top > r.top)
+		list.emplace_back (r.left, r.top, r.right, cut.top);
+	if (cut.bottom < r.bottom)
+		list.emplace_back (r.left, cut.bottom, r.right, r.bottom);
+	auto top = std::max (r.top, cut.top);
+	auto bottom = std::min (r.bottom, cut.bottom);
+	if (cut.left > r.left)
+		list.emplace_back (r.left, top, cut.left, bottom);
+	if (cut.right < r.right)
+		list.emplace_back (cut.right, top, r.right, bottom);
+}
+
+} // anonymous
+
+//-----------------------------------------------------------------------------
+constexpr double CInvalidRectList::kDefaultMergeWasteThreshold;
+
+//-----------------------------------------------------------------------------
+CInvalidRectList::CInvalidRectList (double mergeWasteThreshold)
+{
+	setMergeWasteThreshold (mergeWasteThreshold);
+}
+
+//-----------------------------------------------------------------------------
+void CInvalidRectList::setMergeWasteThreshold (double percent)
+{
+	mergeWasteThreshold = std::min (100., std::max (0., percent));
+}
+
+//-----------------------------------------------------------------------------
+bool CInvalidRectList::shouldMerge (const CRect& r1, const CRect& r2) const
+{
+	CRect united (r1);
+	united.unite (r2);
+	auto unitedArea = area (united);
+	auto coveredArea = area (r1) + area (r2) - intersectionArea (r1, r2);
+	return (unitedArea - coveredArea) <= unitedArea * (mergeWasteThreshold / 100.);
+}
+
+//-----------------------------------------------------------------------------
+bool CInvalidRectList::add (const CRect& rect)
+{
+	if (rect.isEmpty ())
+		return false;
+	++statistics.numAddedRects;
+
+	CRect r (rect);
+	auto it = rects.begin ();
+	while (it != rects.end ())
+	{
+		if (contains (*it, r))
+		{
+			++statistics.numCoalescedRects;
+			return false;
+		}
+		if (contains (r, *it))
+		{
+			it = rects.erase (it);
+		}
+		else if (shouldMerge (*it, r))
+		{
+			if (r == rect)
+				++statistics.numCoalescedRects;
+			r.unite (*it);
+			rects.erase (it);
+			// the rect has grown, so check all rects again
+			it = rects.begin ();
+		}
+		else
+			++it;
+	}
+
+	if (std::any_of (rects.begin (), rects.end (),
+					 [&] (const CRect& other) { return intersects (other, r); }))
+		subtract (r);
+	rects.emplace_back (r);
+	return true;
+}
+
+//-----------------------------------------------------------------------------
+void CInvalidRectList::subtract (const CRect& rect)
+{
+	if (rect.isEmpty ())
+		return;
+	RectList result;
+	result.reserve (rects.size ());
+	for (const auto& r : rects)
+	{
+		if (intersects (r, rect))
+			appendBands (r, rect, result);
+		else
+			result.emplace_back (r);
+	}
+	rects.swap (result);
+}
+
+//-----------------------------------------------------------------------------
+void CInvalidRectList::clear ()
+{
+	rects.clear ();
+}
+
+//-----------------------------------------------------------------------------
+CRect CInvalidRectList::getBounds () const
+{
+	if (rects.empty ())
+		return {};
+	CRect bounds (rects.front ());
+	for (const auto& r : rects)
+		bounds.unite (r);
+	return bounds;
+}
+
+} // namespace
@@ -0,0 +1,71 @@
+// This file is part of VSTGUI. It is subject to the license terms
+// in the LICENSE file found in the top-level directory of this
+// distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
+
+#ifndef __cinvalidrectlist__
+#define __cinvalidrectlist__
+
+#include "crect.h"
+#include <vector>
+
+namespace VSTGUI {
+
+//-----------------------------------------------------------------------------
+/** A region of dirty rectangles
+ *
+ *	The rectangles in the list never overlap, so every pixel is only drawn once. When a new
+ *	rectangle is added it is merged with an existing one if the area of the united rectangle,
+ *	which is covered by none of the two, is smaller than the merge waste threshold (a percentage
+ *	of the united area). Overlapping parts which are not merged are split into bands.
+ */
+class CInvalidRectList
+{
+public:
+	using RectList = std::vector<CRect>;
+	using const_iterator = RectList::const_iterator;
+
+	struct Statistics
+	{
+		/** number of rectangles passed to add () */
+		uint64_t numAddedRects {0};
+		/** number of added rectangles which were already covered or merged with another one */
+		uint64_t numCoalescedRects {0};
+	};
+
+	explicit CInvalidRectList (double mergeWasteThreshold = kDefaultMergeWasteThreshold);
+
+	/** add a rectangle, returns false if the rectangle was already covered by the region */
+	bool add (const CRect& rect);
+	/** remove the area of rect from the region */
+	void subtract (const CRect& rect);
+	/** remove all rectangles */
+	void clear ();
+
+	bool empty () const { return rects.empty (); }
+	size_t size () const { return rects.size (); }
+	const_iterator begin () const { return rects.begin (); }
+	const_iterator end () const { return rects.end (); }
+	const RectList& getRects () const { return rects; }
+	/** returns the bounding box of all rectangles */
+	CRect getBounds () const;
+
+	/** set the merge waste threshold in percent [0..100] */
+	void setMergeWasteThreshold (double percent);
+	double getMergeWasteThreshold () const { return mergeWasteThreshold; }
+
+	const Statistics& getStatistics () const { return statistics; }
+	void resetStatistics () { statistics = {}; }
+
+	static constexpr double kDefaultMergeWasteThreshold = 25.;
+
+private:
+	bool shouldMerge (const CRect& r1, const CRect& r2) const;
+
+	RectList rects;
+	double mergeWasteThreshold;
+	Statistics statistics;
+};
+
+} // namespace
+
+#endif
@@ -88,7 +88,11 @@ void CTextLabel::calculateTruncatedText ()
 	}
 	if (!(textTruncateMode == kTruncateNone || text.empty () || fontID == nullptr || fontID->getPlatformFont () == nullptr || fontID->getPlatformFont ()->getPainter () == nullptr))
 	{
-		CDrawMethods::TextTruncateMode mode = textTruncateMode == kTruncateHead ? CDrawMethods::kTextTruncateHead : CDrawMethods::kTextTruncateTail;
+		CDrawMethods::TextTruncateMode mode = CDrawMethods::kTextTruncateTail;
+		if (textTruncateMode == kTruncateHead)
+			mode = CDrawMethods::kTextTruncateHead;
+		else if (textTruncateMode == kTruncateMiddle)
+			mode = CDrawMethods::kTextTruncateMiddle;
 		truncatedText = CDrawMethods::createTruncatedText (mode, text, fontID, getWidth () - getTextInset ().x * 2.);
 		if (truncatedText == text)
 			truncatedText.clear ();
@@ -340,79 +344,10 @@ void CMultiLineTextLabel::drawStyleChanged ()
 	CTextLabel::drawStyleChanged ();
 }
 
-//------------------------------------------------------------------------
-inline bool isLineBreakSeparator (char32_t c)
-{
-	switch (c)
-	{
-		case '-': return true;
-		case '_': return true;
-		case '/': return true;
-		case '\\': return true;
-		case '.': return true;
-		case ',': return true;
-		case ':': return true;
-		case ';': return true;
-		case '?': return true;
-		case '!': return true;
-		case '*': return true;
-		case '+': return true;
-		case '&': return true;
-	}
-	return false;
-}
-
-//------------------------------------------------------------------------
-void CMultiLineTextLabel::calculateWrapLine  (CDrawContext* context,
-                                       std::pair<UTF8String, double>& element,
-                                       const IFontPainter* const& fontPainter, double lineHeight,
-                                       double lineWidth, double maxWidth, const CPoint& textInset,
-                                       CCoord& y)
-{
-	auto start = element.first.begin ();
-	auto lastSeparator = start;
-	auto pos = start;
-	while (pos != element.first.end () && *pos != 0)
-	{
-		if (isspace (*pos))
-			lastSeparator = pos;
-		else if (isLineBreakSeparator (*pos))
-			lastSeparator = ++pos;
-		if (pos == element.first.end ())
-			break;
-		UTF8String tmp ({start.base (), ++(pos.base ())});
-		auto width = fontPainter->getStringWidth (context, tmp.getPlatformString ());
-		if (width > maxWidth)
-		{
-			if (lastSeparator == element.first.end ())
-				lastSeparator = pos;
-			if (start == lastSeparator)
-				lastSeparator = pos;
-			lines.emplace_back (
-			    Line {CRect (textInset.x, y, lineWidth, y + lineHeight + textInset.y),
-			          UTF8String ({start.base (), lastSeparator.base ()})});
-			y += lineHeight;
-			pos = lastSeparator;
-			start = pos;
-			if (isspace (*start))
-				++start;
-			lastSeparator = element.first.end ();
-		}
-		++pos;
-	}
-	if (start != element.first.end ())
-	{
-		lines.emplace_back (Line {CRect (textInset.x, y, lineWidth, y + lineHeight + textInset.y),
-		                          UTF8String ({start.base (), element.first.end ().base ()})});
-		y += lineHeight;
-	}
-}
-
 //------------------------------------------------------------------------
 void CMultiLineTextLabel::recalculateLines (CDrawContext* context)
 {
 	const auto& font = getFont ()->getPlatformFont ();
-	const auto& fontPainter = getFont ()->getFontPainter ();
 	auto ascent = font->getAscent ();
 	auto descent = font->getDescent ();
 	auto leading = font->getLeading ();
@@ -421,47 +356,39 @@ void CMultiLineTextLabel::recalculateLines (CDrawContext* context)
 	const auto& textInset = getTextInset ();
 	auto maxWidth = getWidth () - (textInset.x * 2);
 
-	std::vector<std::pair<UTF8String, CCoord>> elements;
-	std::stringstream stream (getText ().getString ());
-	std::string line;
-	while (std::getline (stream, line, '\n'))
+	switch (lineLayout)
 	{
-		UTF8String str (std::move (line));
-		auto width = fontPainter->getStringWidth (context, str.getPlatformString ());
-		elements.emplace_back (std::move (str), width);
+		case LineLayout::wrap: textLayout.setBreakMode (CTextLayout::BreakMode::greedy); break;
+		case LineLayout::balancedWrap: textLayout.setBreakMode (CTextLayout::BreakMode::balanced); break;
+		default: textLayout.setBreakMode (CTextLayout::BreakMode::none); break;
 	}
+	textLayout.setFont (getFont ());
+	const auto& layoutLines = textLayout.layout (getText (), maxWidth);
 
 	CCoord y = textInset.y;
 
 	auto lineWidth = getWidth () - textInset.x;
 
-	for (auto& element : elements)
+	lines.clear ();
+	lines.reserve (layoutLines.size ());
+	for (const auto& layoutLine : layoutLines)
 	{
 		if (lineLayout == LineLayout::clip)
 		{
 			lines.emplace_back (Line {
-			    CRect (textInset.x, y, element.second + textInset.x, y + lineHeight + textInset.y),
-			    std::move (element.first)});
+			    CRect (textInset.x, y, layoutLine.width + textInset.x, y + lineHeight + textInset.y),
+			    layoutLine.text});
 		}
 		else
 		{
-			if (element.second > maxWidth)
-			{
-				if (lineLayout == LineLayout::truncate)
-				{
-					element.first = CDrawMethods::createTruncatedText (
-					    CDrawMethods::kTextTruncateTail, element.first, fontID, maxWidth);
-				}
-				else // wrap
-				{
-					calculateWrapLine (context, element, fontPainter, lineHeight, lineWidth,
-					                   maxWidth, textInset, y);
-					continue;
-				}
-			}
 			lines.emplace_back (
 			    Line {CRect (textInset.x, y, lineWidth, y + lineHeight + textInset.y),
-			          std::move (element.first)});
+			          layoutLine.text});
+			if (lineLayout == LineLayout::truncate && layoutLine.width > maxWidth)
+			{
+				lines.back ().str = CDrawMethods::createTruncatedText (
+				    CDrawMethods::kTextTruncateTail, layoutLine.text, fontID, maxWidth);
+			}
 		}
 		y += lineHeight;
 	}
@@ -9,6 +9,7 @@
 #include "itextlabellistener.h"
 #include "../dispatchlist.h"
 #include "../cstring.h"
+#include "../ctextlayout.h"
 
 namespace VSTGUI {
 
@@ -38,7 +39,9 @@ public:
 		/** characters will be removed from the beginning of the text */
 		kTruncateHead,
 		/** characters will be removed from the end of the text */
-		kTruncateTail
+		kTruncateTail,
+		/** characters will be removed from the middle of the text */
+		kTruncateMiddle
 	};
 	
 	/** set text truncate mode */
@@ -98,7 +101,9 @@ public:
 		/** truncate lines overflowing the view size width */
 		truncate,
 		/** wrap overflowing words to next line */
-		wrap
+		wrap,
+		/** wrap overflowing words so that the lines have a similar width */
+		balancedWrap
 	};
 	void setLineLayout (LineLayout layout);
 	LineLayout getLineLayout () const { return lineLayout; }
@@ -121,7 +126,6 @@ public:
 	void setValue (float val) override;
 private:
 	void drawStyleChanged () override;
-	void calculateWrapLine  (CDrawContext *context, std::pair<UTF8String, double> &element, const IFontPainter *const &fontPainter, double lineHeight, double lineWidth, double maxWidth, const CPoint &textInset, CCoord &y);
 	
 	void recalculateLines (CDrawContext* context);
 	void recalculateHeight ();
@@ -136,6 +140,7 @@ private:
 	};
 	using Lines = std::vector<Line>;
 	Lines lines;
+	CTextLayout textLayout;
 };
 
 } // namespace
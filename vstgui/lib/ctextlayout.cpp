@@ -0,0 +1,338 @@
+// This file is part of VSTGUI. It is subject to the license terms
+// in the LICENSE file found in the top-level directory of this
+// distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
+
+#include "ctextlayout.h"
+#include "platform/iplatformfont.h"
+#include <limits>
+
+namespace VSTGUI {
+
+//------------------------------------------------------------------------
+static bool isLineBreakWhitespace (char32_t c)
+{
+	return c == ' ' || c == '\t' || c == '\r';
+}
+
+//------------------------------------------------------------------------
+static bool isLineBreakSeparator (char32_t c)
+{
+	switch (c)
+	{
+		case '-': return true;
+		case '_': return true;
+		case '/': return true;
+		case '\\': return true;
+		case '.': return true;
+		case ',': return true;
+		case ':': return true;
+		case ';': return true;
+		case '?': return true;
+		case '!': return true;
+		case '*': return true;
+		case '+': return true;
+		case '&': return true;
+	}
+	return false;
+}
+
+//------------------------------------------------------------------------
+// CTextLayout
+//------------------------------------------------------------------------
+/*! @class CTextLayout
+*/
+//------------------------------------------------------------------------
+CTextLayout::CTextLayout ()
+{
+	asciiAdvances.fill (-1.);
+}
+
+//------------------------------------------------------------------------
+void CTextLayout::setFont (CFontRef newFont)
+{
+	if (font == newFont)
+		return;
+	font = newFont;
+	valid = false;
+}
+
+//------------------------------------------------------------------------
+void CTextLayout::setStringWidthFunction (const StringWidthFunction& func)
+{
+	stringWidthFunction = func;
+	invalidate ();
+}
+
+//------------------------------------------------------------------------
+void CTextLayout::setBreakMode (BreakMode mode)
+{
+	if (breakMode == mode)
+		return;
+	breakMode = mode;
+	valid = false;
+}
+
+//------------------------------------------------------------------------
+void CTextLayout::invalidate ()
+{
+	valid = false;
+	measuredFontName = "";
+	asciiAdvances.fill (-1.);
+	advances.clear ();
+}
+
+//------------------------------------------------------------------------
+CCoord CTextLayout::getMaxLineWidth () const
+{
+	CCoord maxWidth {};
+	for (const auto& line : lines)
+	{
+		if (line.width > maxWidth)
+			maxWidth = line.width;
+	}
+	return maxWidth;
+}
+
+//------------------------------------------------------------------------
+void CTextLayout::updateMeasuring ()
+{
+	if (stringWidthFunction || !font)
+		return;
+	// the font may have been changed since the last layout
+	if (font->getName () != measuredFontName || font->getSize () != measuredFontSize ||
+	    font->getStyle () != measuredFontStyle)
+	{
+		invalidate ();
+		measuredFontName = font->getName ();
+		measuredFontSize = font->getSize ();
+		measuredFontStyle = font->getStyle ();
+	}
+}
+
+//------------------------------------------------------------------------
+CCoord CTextLayout::getStringWidth (const UTF8String& str) const
+{
+	if (stringWidthFunction)
+		return stringWidthFunction (str);
+	if (auto painter = font ? font->getFontPainter () : nullptr)
+		return painter->getStringWidth (nullptr, str.getPlatformString (), true);
+	return 0.;
+}
+
+//------------------------------------------------------------------------
+CCoord CTextLayout::getAdvance (char32_t character, const std::string& text, size_t begin,
+                                size_t end)
+{
+	CCoord* advance;
+	if (character < asciiAdvances.size ())
+		advance = &asciiAdvances[character];
+	else
+	{
+		auto it = advances.find (character);
+		if (it == advances.end ())
+			it = advances.emplace (character, -1.).first;
+		advance = &it->second;
+	}
+	if (*advance < 0.)
+		*advance = getStringWidth (UTF8String (text.substr (begin, end - begin)));
+	return *advance;
+}
+
+//------------------------------------------------------------------------
+const CTextLayout::Lines& CTextLayout::layout (const UTF8String& text, CCoord maxWidth)
+{
+	updateMeasuring ();
+	if (valid && layoutText == text && (breakMode == BreakMode::none || layoutWidth == maxWidth))
+		return lines;
+
+	lines.clear ();
+	const auto& str = text.getString ();
+	size_t begin = 0;
+	while (begin < str.size ())
+	{
+		auto end = str.find ('\n', begin);
+		if (end == std::string::npos)
+			end = str.size ();
+		layoutParagraph (str, begin, end, maxWidth);
+		begin = end + 1;
+	}
+	layoutText = text;
+	layoutWidth = maxWidth;
+	valid = true;
+	return lines;
+}
+
+//------------------------------------------------------------------------
+void CTextLayout::layoutParagraph (const std::string& text, size_t begin, size_t end,
+                                   CCoord maxWidth)
+{
+	UTF8String paragraph (text.substr (begin, end - begin));
+	auto width = getStringWidth (paragraph);
+	if (breakMode == BreakMode::none || width <= maxWidth)
+	{
+		lines.emplace_back (Line {begin, std::move (paragraph), width});
+		return;
+	}
+
+	collectSegments (text, begin, end, maxWidth);
+	if (breakMode == BreakMode::balanced)
+		breakBalanced (maxWidth);
+	else
+		breakGreedy (maxWidth);
+
+	// the summed up advances don't include kerning, so check the real width of each line and move
+	// the last segments to the next line if it does not fit
+	for (size_t lineIndex = 0; lineIndex < breaks.size (); ++lineIndex)
+	{
+		auto first = breaks[lineIndex];
+		auto last = lineIndex + 1 < breaks.size () ? breaks[lineIndex + 1] : segments.size ();
+		auto offset = segments[first].begin;
+		UTF8String lineText;
+		CCoord lineWidth;
+		while (true)
+		{
+			lineText = text.substr (offset, segments[last - 1].end - offset);
+			lineWidth = getStringWidth (lineText);
+			if (lineWidth <= maxWidth || last - first == 1)
+				break;
+			--last;
+		}
+		if (lineIndex + 1 < breaks.size ())
+			breaks[lineIndex + 1] = last;
+		else if (last < segments.size ())
+			breaks.emplace_back (last);
+		lines.emplace_back (Line {offset, std::move (lineText), lineWidth});
+	}
+}
+
+//------------------------------------------------------------------------
+void CTextLayout::collectSegments (const std::string& text, size_t begin, size_t end,
+                                   CCoord maxWidth)
+{
+	using Iterator = UTF8CodePointIterator<std::string::const_iterator>;
+
+	// a segment is a word including a trailing separator followed by its whitespace, a line can be
+	// broken after every segment
+	segments.clear ();
+	Segment segment {begin, begin, begin, 0., 0.};
+	bool segmentComplete = false;
+	Iterator it (text.begin () + static_cast<std::ptrdiff_t> (begin));
+	Iterator endIt (text.begin () + static_cast<std::ptrdiff_t> (end));
+	while (it != endIt)
+	{
+		auto character = *it;
+		auto characterBegin = static_cast<size_t> (it.base () - text.begin ());
+		++it;
+		auto characterEnd = static_cast<size_t> (it.base () - text.begin ());
+		auto advance = getAdvance (character, text, characterBegin, characterEnd);
+		if (isLineBreakWhitespace (character))
+		{
+			segment.spaceWidth += advance;
+			segment.next = characterEnd;
+			segmentComplete = true;
+			continue;
+		}
+		if (segmentComplete)
+		{
+			segments.emplace_back (segment);
+			segment = {characterBegin, characterBegin, characterBegin, 0., 0.};
+			segmentComplete = false;
+		}
+		segment.width += advance;
+		segment.end = segment.next = characterEnd;
+		if (isLineBreakSeparator (character))
+			segmentComplete = true;
+	}
+	if (segment.next != segment.begin)
+		segments.emplace_back (segment);
+
+	// split words which are wider than the maximum width between their characters
+	for (size_t index = 0; index < segments.size (); ++index)
+	{
+		if (segments[index].width <= maxWidth)
+			continue;
+		auto word = segments[index];
+		Segments pieces;
+		Segment piece {word.begin, word.begin, word.begin, 0., 0.};
+		Iterator wordIt (text.begin () + static_cast<std::ptrdiff_t> (word.begin));
+		Iterator wordEnd (text.begin () + static_cast<std::ptrdiff_t> (word.end));
+		while (wordIt != wordEnd)
+		{
+			auto character = *wordIt;
+			auto characterBegin = static_cast<size_t> (wordIt.base () - text.begin ());
+			++wordIt;
+			auto characterEnd = static_cast<size_t> (wordIt.base () - text.begin ());
+			auto advance = getAdvance (character, text, characterBegin, characterEnd);
+			if (piece.width + advance > maxWidth && piece.end != piece.begin)
+			{
+				pieces.emplace_back (piece);
+				piece = {characterBegin, characterBegin, characterBegin, 0., 0.};
+			}
+			piece.width += advance;
+			piece.end = piece.next = characterEnd;
+		}
+		piece.next = word.next;
+		piece.spaceWidth = word.spaceWidth;
+		pieces.emplace_back (piece);
+		segments.erase (segments.begin () + static_cast<std::ptrdiff_t> (index));
+		segments.insert (segments.begin () + static_cast<std::ptrdiff_t> (index), pieces.begin (),
+		                 pieces.end ());
+		index += pieces.size () - 1;
+	}
+}
+
+//------------------------------------------------------------------------
+void CTextLayout::breakGreedy (CCoord maxWidth)
+{
+	breaks.clear ();
+	size_t index = 0;
+	while (index < segments.size ())
+	{
+		breaks.emplace_back (index);
+		auto width = segments[index].width;
+		++index;
+		while (index < segments.size ())
+		{
+			auto newWidth = width + segments[index - 1].spaceWidth + segments[index].width;
+			if (newWidth > maxWidth)
+				break;
+			width = newWidth;
+			++index;
+		}
+	}
+}
+
+//------------------------------------------------------------------------
+void CTextLayout::breakBalanced (CCoord maxWidth)
+{
+	// cost[i] is the minimal cost to layout the segments from i to the end, nextBreak[i] the first
+	// segment of the line following the line starting with segment i
+	auto numSegments = segments.size ();
+	std::vector<double> cost (numSegments + 1, std::numeric_limits<double>::max ());
+	std::vector<size_t> nextBreak (numSegments + 1, numSegments);
+	cost[numSegments] = 0.;
+	for (auto first = numSegments; first-- > 0;)
+	{
+		CCoord width = 0.;
+		for (auto last = first; last < numSegments; ++last)
+		{
+			if (last > first)
+				width += segments[last - 1].spaceWidth;
+			width += segments[last].width;
+			if (width > maxWidth && last > first)
+				break;
+			auto freeSpace = maxWidth - width;
+			auto lineCost = last == numSegments - 1 ? 0. : freeSpace * freeSpace;
+			if (lineCost + cost[last + 1] < cost[first])
+			{
+				cost[first] = lineCost + cost[last + 1];
+				nextBreak[first] = last + 1;
+			}
+		}
+	}
+	breaks.clear ();
+	for (size_t index = 0; index < numSegments; index = nextBreak[index])
+		breaks.emplace_back (index);
+}
+
+} // namespace
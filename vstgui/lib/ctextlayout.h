@@ -0,0 +1,126 @@
+// This file is part of VSTGUI. It is subject to the license terms
+// in the LICENSE file found in the top-level directory of this
+// distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
+
+#ifndef __ctextlayout__
+#define __ctextlayout__
+
+#include "vstguifwd.h"
+#include "cfont.h"
+#include "cstring.h"
+#include <array>
+#include <functional>
+#include <unordered_map>
+#include <vector>
+
+namespace VSTGUI {
+
+//-----------------------------------------------------------------------------
+// CTextLayout Declaration
+//! @brief breaks a text into lines which fit into a maximum width
+///
+/// The text is split into paragraphs at line feeds. Paragraphs wider than the maximum width are
+/// broken at whitespace, after punctuation or, for words which don't fit at all, between
+/// characters. The advance of each character is measured only once per font and every line is
+/// measured once to take kerning into account, so the layout needs a number of measurements linear
+/// to the length of the text.
+///
+/// The result of the last layout is cached until the text, the font, the maximum width or the break
+/// mode changes.
+//-----------------------------------------------------------------------------
+class CTextLayout
+{
+public:
+	enum class BreakMode {
+		/** only break at line feeds */
+		none,
+		/** put as many words on a line as fit */
+		greedy,
+		/** minimize the squared free space of all lines except the last one, results in lines
+		 *	with a similar width */
+		balanced
+	};
+
+	struct Line
+	{
+		/** byte offset of the line in the text */
+		size_t offset;
+		/** the text of the line without the whitespace at the break */
+		UTF8String text;
+		/** the width of the text */
+		CCoord width;
+	};
+	using Lines = std::vector<Line>;
+
+	/** measures a string instead of the font painter, e.g. for custom text rendering */
+	using StringWidthFunction = std::function<CCoord (const UTF8String& str)>;
+
+	CTextLayout ();
+
+	//-----------------------------------------------------------------------------
+	/// @name CTextLayout Methods
+	//-----------------------------------------------------------------------------
+	//@{
+	/** set the font used for measuring */
+	void setFont (CFontRef font);
+	CFontRef getFont () const { return font; }
+
+	/** set a custom function to measure strings, the font is not used for measuring afterwards */
+	void setStringWidthFunction (const StringWidthFunction& func);
+
+	void setBreakMode (BreakMode mode);
+	BreakMode getBreakMode () const { return breakMode; }
+
+	/** layout the text or return the cached lines if nothing has changed since the last call */
+	const Lines& layout (const UTF8String& text, CCoord maxWidth);
+
+	/** the lines of the last layout */
+	const Lines& getLines () const { return lines; }
+	/** the maximum width of the lines of the last layout */
+	CCoord getMaxLineWidth () const;
+
+	/** forget the cached lines and character advances */
+	void invalidate ();
+	//@}
+
+private:
+	struct Segment
+	{
+		size_t begin;
+		size_t end;
+		size_t next;
+		CCoord width;
+		CCoord spaceWidth;
+	};
+	using Segments = std::vector<Segment>;
+
+	void updateMeasuring ();
+	CCoord getStringWidth (const UTF8String& str) const;
+	CCoord getAdvance (char32_t character, const std::string& text, size_t begin, size_t end);
+	void layoutParagraph (const std::string& text, size_t begin, size_t end, CCoord maxWidth);
+	void collectSegments (const std::string& text, size_t begin, size_t end, CCoord maxWidth);
+	void breakGreedy (CCoord maxWidth);
+	void breakBalanced (CCoord maxWidth);
+
+	SharedPointer<CFontDesc> font;
+	UTF8String measuredFontName;
+	CCoord measuredFontSize {0.};
+	int32_t measuredFontStyle {0};
+	StringWidthFunction stringWidthFunction;
+	BreakMode breakMode {BreakMode::greedy};
+
+	std::array<CCoord, 128> asciiAdvances;
+	std::unordered_map<char32_t, CCoord> advances;
+
+	bool valid {false};
+	UTF8String layoutText;
+	CCoord layoutWidth {0.};
+	Lines lines;
+
+	Segments segments;
+	std::vector<size_t> breaks;
+};
+
+} // namespace
+
+#endif // __ctextlayout__
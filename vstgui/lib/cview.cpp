@@ -6,7 +6,9 @@
 #include "cdrawcontext.h"
 #include "cbitmap.h"
 #include "cframe.h"
-#include "cvstguitimer.h"
+#include "cframeclock.h"
+#include "cframeprofiler.h"
+#include "cviewlayercache.h"
 #include "cgraphicspath.h"
 #include "dispatchlist.h"
 #include "idatapackage.h"
@@ -93,7 +95,7 @@ protected:
 };
 
 //-----------------------------------------------------------------------------
-class IdleViewUpdater
+class IdleViewUpdater : public IFrameClockHandler
 {
 public:
 	static void add (CView* view)
@@ -120,11 +122,25 @@ protected:
 	
 	IdleViewUpdater ()
 	{
-		timer = makeOwned<CVSTGUITimer> ([this] (CVSTGUITimer*) { onTimer (); }, 1000/CView::idleRate);
+		CFrameClock::instance ().add (CFrameClock::Phase::idle, this);
 	}
-	
-	void onTimer ()
+
+public:
+	~IdleViewUpdater () noexcept override
+	{
+		CFrameClock::instance ().remove (CFrameClock::Phase::idle, this);
+	}
+
+protected:
+	void onFrameClockTick (CFrameClock::Phase phase) override
 	{
+		// the clock ticks with the frame rate, the views are idled with the idle rate
+		const auto& clock = CFrameClock::instance ();
+		auto idleInterval = 1000. / CView::idleRate;
+		if (clock.getTickTime () - lastIdleTime < idleInterval - clock.getFrameInterval () / 2.)
+			return;
+		lastIdleTime = clock.getTickTime ();
+
 		inTimer = true;
 		for (ViewContainer::const_iterator it = views.begin (); it != views.end ();)
 		{
@@ -136,8 +152,8 @@ protected:
 		if (views.empty ())
 			gInstance = nullptr;
 	}
-	SharedPointer<CVSTGUITimer> timer;
 	ViewContainer views;
+	double lastIdleTime {0.};
 	bool inTimer {false};
 	
 	static std::unique_ptr<IdleViewUpdater> gInstance;
@@ -188,6 +204,7 @@ struct CView::Impl
 	int32_t viewFlags {0};
 	int32_t autosizeFlags {kAutosizeNone};
 	float alphaValue {1.f};
+	bool cacheAsBitmap {false};
 	CFrame* parentFrame {nullptr};
 	CView* parentView {nullptr};
 	
@@ -220,6 +237,7 @@ CView::CView (const CView& v)
 	pImpl->viewFlags = v.pImpl->viewFlags;
 	pImpl->autosizeFlags = v.pImpl->autosizeFlags;
 	pImpl->alphaValue = v.pImpl->alphaValue;
+	pImpl->cacheAsBitmap = v.pImpl->cacheAsBitmap;
 	pImpl->background = v.pImpl->background;
 	pImpl->disabledBackground = v.pImpl->disabledBackground;
 	setHitTestPath (v.getHitTestPath ());
@@ -248,6 +266,7 @@ void CView::beforeDelete ()
 
 	vstgui_assert (isAttached () == false, "View is still attached");
 
+	invalidateLayerCache ();
 	setHitTestPath (nullptr);
 	setDropTarget (nullptr);
 
@@ -274,7 +293,15 @@ void CView::beforeDelete ()
 //-----------------------------------------------------------------------------
 void CView::setMouseableArea (const CRect& rect)
 {
+	if (pImpl->mouseableArea == rect)
+		return;
+	CRect oldArea = pImpl->mouseableArea;
 	pImpl->mouseableArea = rect;
+	if (pImpl->viewListeners)
+	{
+		pImpl->viewListeners->forEach (
+		    [&] (IViewListener* listener) { listener->viewMouseableAreaChanged (this, oldArea); });
+	}
 }
 
 //-----------------------------------------------------------------------------
@@ -372,6 +399,8 @@ void CView::setWantsIdle (bool state)
 //-----------------------------------------------------------------------------
 void CView::setDirty (bool state)
 {
+	if (state)
+		invalidateLayerCache ();
 	if (kDirtyCallAlwaysOnMainThread)
 	{
 		if (state)
@@ -434,6 +463,7 @@ bool CView::removed (CView* parent)
 	}
 	if (pImpl->parentFrame)
 		pImpl->parentFrame->onViewRemoved (this);
+	invalidateLayerCache ();
 	pImpl->parentView = nullptr;
 	pImpl->parentFrame = nullptr;
 	setViewFlag (kIsAttached, false);
@@ -552,13 +582,43 @@ CGraphicsTransform CView::getGlobalTransform () const
  */
 void CView::invalidRect (const CRect& rect)
 {
+	invalidateLayerCache ();
 	if (isAttached () && hasViewFlag (kVisible))
 	{
 		vstgui_assert (pImpl->parentView);
+#if VSTGUI_ENABLE_FRAME_PROFILER
+		if (auto frame = getFrame ())
+		{
+			if (auto profiler = frame->getProfiler ())
+				profiler->addInvalidation (this, rect);
+		}
+#endif
 		pImpl->parentView->invalidRect (rect);
 	}
 }
 
+//-----------------------------------------------------------------------------
+void CView::setCacheAsBitmap (bool state)
+{
+	if (pImpl->cacheAsBitmap == state)
+		return;
+	invalidateLayerCache ();
+	pImpl->cacheAsBitmap = state;
+}
+
+//-----------------------------------------------------------------------------
+bool CView::getCacheAsBitmap () const
+{
+	return pImpl->cacheAsBitmap;
+}
+
+//-----------------------------------------------------------------------------
+void CView::invalidateLayerCache ()
+{
+	if (pImpl->cacheAsBitmap)
+		CViewLayerCache::instance ().removeLayer (this);
+}
+
 //-----------------------------------------------------------------------------
 /**
  * @param pContext draw context in which to draw
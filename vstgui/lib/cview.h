@@ -77,6 +77,11 @@ public:
 	/** mark whole view as invalid */
 	virtual void invalid () { setDirty (false); invalidRect (getViewSize ()); }
 
+	/** render the view once into a bitmap and draw the bitmap until the view or one of its
+	 *	subviews is invalidated. Per default this is disabled. @see CViewLayerCache */
+	void setCacheAsBitmap (bool state);
+	bool getCacheAsBitmap () const;
+
 	/** set visibility state */
 	virtual void setVisible (bool state);
 	/** get visibility state */
@@ -394,6 +399,7 @@ protected:
 	void setViewFlag (int32_t bit, bool state);
 	
 	void setAlphaValueNoInvalidate (float value);
+	void invalidateLayerCache ();
 	void setParentFrame (CFrame* frame);
 	void setParentView (CView* parent);
 
@@ -6,16 +6,21 @@
 #include "coffscreencontext.h"
 #include "cbitmap.h"
 #include "cframe.h"
+#include "cframeprofiler.h"
 #include "ccolor.h"
 #include "ifocusdrawing.h"
 #include "itouchevent.h"
 #include "iviewlistener.h"
 #include "cgraphicspath.h"
+#include "cviewlayercache.h"
 #include "controls/ccontrol.h"
 #include "dragging.h"
 
 #include <algorithm>
 #include <cassert>
+#include <cmath>
+#include <unordered_map>
+#include <vector>
 
 namespace VSTGUI {
 
@@ -26,12 +31,177 @@ const CViewAttributeID kCViewContainerMouseDownViewAttribute = 'vcmd';
 const CViewAttributeID kCViewContainerLastDrawnFocusAttribute = 'vclf';
 const CViewAttributeID kCViewContainerBackgroundOffsetAttribute = 'vcbo';
 
+//-----------------------------------------------------------------------------
+/** Uniform grid over the child views of a container.
+ *
+ *	Every cell holds the z-order indices of the child views overlapping the cell in ascending
+ *	order, so lookups can walk the candidates top-down like the child view list.
+ */
+class ChildViewGrid
+{
+public:
+	using IndexList = std::vector<uint32_t>;
+	using ViewArray = std::vector<CView*>;
+
+	template<typename ViewList>
+	void build (const ViewList& children);
+
+	/** returns the z-order indices of the views which may contain the point */
+	const IndexList& getIndicesAt (const CPoint& p) const;
+	/** collects the z-order indices of the views which may intersect the rect */
+	void getIndicesIn (const CRect& r, IndexList& result) const;
+
+	CView* getView (uint32_t index) const { return views[index]; }
+	/** returns the z-order index of the view or -1 if it is not a child */
+	int32_t getIndexOf (const CView* view) const;
+
+	static CRect getIndexRect (const CView* view);
+
+private:
+	uint32_t cellColumn (CCoord x) const;
+	uint32_t cellRow (CCoord y) const;
+
+	static constexpr uint32_t kMaxCellsPerAxis = 64;
+	static constexpr uint32_t kViewsPerCell = 4;
+
+	ViewArray views;
+	std::unordered_map<const CView*, uint32_t> viewIndices;
+	std::vector<IndexList> cells;
+	IndexList empty;
+	CRect bounds;
+	CCoord cellWidth {1.};
+	CCoord cellHeight {1.};
+	uint32_t numColumns {0};
+	uint32_t numRows {0};
+};
+
+//-----------------------------------------------------------------------------
+constexpr uint32_t ChildViewGrid::kMaxCellsPerAxis;
+constexpr uint32_t ChildViewGrid::kViewsPerCell;
+
+//-----------------------------------------------------------------------------
+CRect ChildViewGrid::getIndexRect (const CView* view)
+{
+	const auto& viewSize = view->getViewSize ();
+	const auto& mouseableArea = view->getMouseableArea ();
+	if (mouseableArea.isEmpty ())
+		return viewSize;
+	if (viewSize.isEmpty ())
+		return mouseableArea;
+	CRect r (viewSize);
+	return r.unite (mouseableArea);
+}
+
+//-----------------------------------------------------------------------------
+template<typename ViewList>
+void ChildViewGrid::build (const ViewList& children)
+{
+	views.clear ();
+	viewIndices.clear ();
+	cells.clear ();
+	bounds = {};
+	views.reserve (children.size ());
+	viewIndices.reserve (children.size ());
+	for (const auto& child : children)
+	{
+		auto r = getIndexRect (child);
+		if (!r.isEmpty ())
+		{
+			if (bounds.isEmpty ())
+				bounds = r;
+			else
+				bounds.unite (r);
+		}
+		viewIndices.emplace (child, static_cast<uint32_t> (views.size ()));
+		views.emplace_back (child);
+	}
+	if (bounds.isEmpty ())
+	{
+		numColumns = numRows = 0;
+		return;
+	}
+	auto numCells = std::max<double> (1., views.size () / kViewsPerCell);
+	auto aspect = bounds.getWidth () / bounds.getHeight ();
+	numColumns = static_cast<uint32_t> (std::round (std::sqrt (numCells * aspect)));
+	numColumns = std::min (kMaxCellsPerAxis, std::max (1u, numColumns));
+	numRows = static_cast<uint32_t> (std::ceil (numCells / numColumns));
+	numRows = std::min (kMaxCellsPerAxis, std::max (1u, numRows));
+	cellWidth = bounds.getWidth () / numColumns;
+	cellHeight = bounds.getHeight () / numRows;
+	cells.resize (numColumns * numRows);
+	for (uint32_t index = 0; index < views.size (); ++index)
+	{
+		auto r = getIndexRect (views[index]);
+		if (r.isEmpty ())
+			continue;
+		auto col1 = cellColumn (r.right);
+		auto row1 = cellRow (r.bottom);
+		for (auto row = cellRow (r.top); row <= row1; ++row)
+		{
+			for (auto col = cellColumn (r.left); col <= col1; ++col)
+				cells[row * numColumns + col].emplace_back (index);
+		}
+	}
+}
+
+//-----------------------------------------------------------------------------
+uint32_t ChildViewGrid::cellColumn (CCoord x) const
+{
+	auto col = std::floor ((x - bounds.left) / cellWidth);
+	return static_cast<uint32_t> (std::min<CCoord> (numColumns - 1, std::max<CCoord> (0., col)));
+}
+
+//-----------------------------------------------------------------------------
+uint32_t ChildViewGrid::cellRow (CCoord y) const
+{
+	auto row = std::floor ((y - bounds.top) / cellHeight);
+	return static_cast<uint32_t> (std::min<CCoord> (numRows - 1, std::max<CCoord> (0., row)));
+}
+
+//-----------------------------------------------------------------------------
+auto ChildViewGrid::getIndicesAt (const CPoint& p) const -> const IndexList&
+{
+	if (cells.empty () || !bounds.pointInside (p))
+		return empty;
+	return cells[cellRow (p.y) * numColumns + cellColumn (p.x)];
+}
+
+//-----------------------------------------------------------------------------
+void ChildViewGrid::getIndicesIn (const CRect& r, IndexList& result) const
+{
+	result.clear ();
+	if (cells.empty () || !r.rectOverlap (bounds))
+		return;
+	auto col1 = cellColumn (r.right);
+	auto row1 = cellRow (r.bottom);
+	for (auto row = cellRow (r.top); row <= row1; ++row)
+	{
+		for (auto col = cellColumn (r.left); col <= col1; ++col)
+		{
+			const auto& cell = cells[row * numColumns + col];
+			result.insert (result.end (), cell.begin (), cell.end ());
+		}
+	}
+	std::sort (result.begin (), result.end ());
+	result.erase (std::unique (result.begin (), result.end ()), result.end ());
+}
+
+//-----------------------------------------------------------------------------
+int32_t ChildViewGrid::getIndexOf (const CView* view) const
+{
+	auto it = viewIndices.find (view);
+	if (it == viewIndices.end ())
+		return -1;
+	return static_cast<int32_t> (it->second);
+}
+
 //-----------------------------------------------------------------------------
 // CViewContainer Implementation
 //-----------------------------------------------------------------------------
-struct CViewContainer::Impl
+struct CViewContainer::Impl : ViewListenerAdapter
 {
 	using ViewContainerListenerDispatcher = DispatchList<IViewContainerListener*>;
+	using ViewArray = ChildViewGrid::ViewArray;
 	
 	ViewContainerListenerDispatcher viewContainerListeners;
 	CGraphicsTransform transform;
@@ -40,6 +210,109 @@ struct CViewContainer::Impl
 	
 	CDrawStyle backgroundColorDrawStyle {kDrawFilledAndStroked};
 	CColor backgroundColor {kBlackCColor};
+
+	std::unique_ptr<ChildViewGrid> childViewGrid;
+	bool childViewGridDirty {true};
+
+	void viewSizeChanged (CView* view, const CRect& oldSize) override
+	{
+		childViewGridDirty = true;
+	}
+	void viewMouseableAreaChanged (CView* view, const CRect& oldArea) override
+	{
+		childViewGridDirty = true;
+	}
+
+	void onChildAdded (CView* view)
+	{
+		if (childViewGrid)
+		{
+			view->registerViewListener (this);
+			childViewGridDirty = true;
+		}
+	}
+
+	void onChildRemoved (CView* view)
+	{
+		if (childViewGrid)
+		{
+			view->unregisterViewListener (this);
+			childViewGridDirty = true;
+		}
+	}
+
+	const ChildViewGrid& getChildViewGrid ()
+	{
+		if (childViewGridDirty)
+		{
+			childViewGrid->build (children);
+			childViewGridDirty = false;
+		}
+		return *childViewGrid;
+	}
+
+	/** calls proc for the child views which may contain the point, top-down, until proc returns
+	 *	true */
+	template<typename Proc>
+	void forEachChildAt (const CPoint& where, Proc proc)
+	{
+		if (childViewGrid)
+		{
+			// copy the candidates, proc may change the children
+			const auto& grid = getChildViewGrid ();
+			const auto& indices = grid.getIndicesAt (where);
+			ViewArray candidates;
+			candidates.reserve (indices.size ());
+			for (auto it = indices.rbegin (), end = indices.rend (); it != end; ++it)
+				candidates.emplace_back (grid.getView (*it));
+			for (auto view : candidates)
+			{
+				if (proc (view))
+					return;
+			}
+			return;
+		}
+		for (auto it = children.rbegin (), end = children.rend (); it != end; ++it)
+		{
+			if (proc (*it))
+				return;
+		}
+	}
+
+	/** calls proc for the child views which may intersect the rect, bottom-up. The view
+	 *	alwaysInclude is visited at its z-order position even if it does not intersect the rect */
+	template<typename Proc>
+	void forEachChildIn (const CRect& r, const CView* alwaysInclude, Proc proc)
+	{
+		if (childViewGrid)
+		{
+			const auto& grid = getChildViewGrid ();
+			grid.getIndicesIn (r, drawIndices);
+			if (alwaysInclude)
+			{
+				auto index = grid.getIndexOf (alwaysInclude);
+				if (index >= 0)
+				{
+					auto pos = std::lower_bound (drawIndices.begin (), drawIndices.end (),
+					                             static_cast<uint32_t> (index));
+					if (pos == drawIndices.end () || *pos != static_cast<uint32_t> (index))
+						drawIndices.insert (pos, static_cast<uint32_t> (index));
+				}
+			}
+			// copy the candidates, drawing may change the children
+			ViewArray candidates;
+			candidates.reserve (drawIndices.size ());
+			for (auto index : drawIndices)
+				candidates.emplace_back (grid.getView (index));
+			for (auto view : candidates)
+				proc (view);
+			return;
+		}
+		for (const auto& child : children)
+			proc (child);
+	}
+
+	ChildViewGrid::IndexList drawIndices;
 };
 
 //------------------------------------------------------------------------
@@ -147,6 +420,7 @@ CViewContainer::CViewContainer (const CViewContainer& v)
 	pImpl->backgroundColorDrawStyle = v.pImpl->backgroundColorDrawStyle;
 	pImpl->backgroundColor = v.pImpl->backgroundColor;
 	setBackgroundOffset (v.getBackgroundOffset ());
+	setChildViewIndexEnabled (v.getChildViewIndexEnabled ());
 	for (auto& view : v.pImpl->children)
 		addView (static_cast<CView*> (view->newCopy ()));
 }
@@ -266,6 +540,39 @@ const CGraphicsTransform& CViewContainer::getTransform () const
 	return pImpl->transform;
 }
 
+//-----------------------------------------------------------------------------
+/**
+ * The index is a grid over the mouseable areas and sizes of the child views, so that hit testing
+ * and drawing only look at the child views near the point or the update rect instead of all of
+ * them. Useful for containers with many child views. The children must not hit outside of their
+ * mouseable area.
+ * @param state true to enable the index
+ */
+void CViewContainer::setChildViewIndexEnabled (bool state)
+{
+	if (state == getChildViewIndexEnabled ())
+		return;
+	if (state)
+	{
+		pImpl->childViewGrid = std::unique_ptr<ChildViewGrid> (new ChildViewGrid);
+		for (const auto& child : pImpl->children)
+			child->registerViewListener (pImpl.get ());
+	}
+	else
+	{
+		for (const auto& child : pImpl->children)
+			child->unregisterViewListener (pImpl.get ());
+		pImpl->childViewGrid = nullptr;
+	}
+	pImpl->childViewGridDirty = true;
+}
+
+//-----------------------------------------------------------------------------
+bool CViewContainer::getChildViewIndexEnabled () const
+{
+	return pImpl->childViewGrid != nullptr;
+}
+
 //-----------------------------------------------------------------------------
 void CViewContainer::setAutosizingEnabled (bool state)
 {
@@ -518,6 +825,7 @@ bool CViewContainer::addView (CView *pView, CView* pBefore)
 	}
 
 	pView->setSubviewState (true);
+	pImpl->onChildAdded (pView);
 
 	pImpl->viewContainerListeners.forEach ([&] (IViewContainerListener* listener) {
 		listener->viewContainerViewAdded (this, pView);
@@ -566,6 +874,7 @@ bool CViewContainer::removeAll (bool withForget)
 			view->removed (this);
 		pImpl->children.erase (it);
 		view->setSubviewState (false);
+		pImpl->onChildRemoved (view);
 		pImpl->viewContainerListeners.forEach ([&] (IViewContainerListener* listener) {
 			listener->viewContainerViewRemoved (this, view);
 		});
@@ -593,6 +902,7 @@ bool CViewContainer::removeView (CView *pView, bool withForget)
 		if (isAttached ())
 			pView->removed (this);
 		pView->setSubviewState (false);
+		pImpl->onChildRemoved (pView);
 		pImpl->viewContainerListeners.forEach ([&] (IViewContainerListener* listener) {
 			listener->viewContainerViewRemoved (this, pView);
 		});
@@ -694,6 +1004,7 @@ bool CViewContainer::changeViewZOrder (CView* view, uint32_t newIndex)
 				pImpl->children.splice (src, pImpl->children, dest);
 			else
 				pImpl->children.splice (dest, pImpl->children, src);
+			pImpl->childViewGridDirty = true;
 			pImpl->viewContainerListeners.forEach ([&] (IViewContainerListener* listener) {
 				listener->viewContainerViewZOrderChanged (this, view);
 			});
@@ -730,9 +1041,17 @@ bool CViewContainer::invalidateDirtyViews ()
 //-----------------------------------------------------------------------------
 void CViewContainer::invalid ()
 {
+	invalidateLayerCache ();
 	if (!isVisible ())
 		return;
 	CRect _rect (getViewSize ());
+#if VSTGUI_ENABLE_FRAME_PROFILER
+	if (auto frame = getFrame ())
+	{
+		if (auto profiler = frame->getProfiler ())
+			profiler->addInvalidation (this, _rect);
+	}
+#endif
 	if (auto parent = getParentView ())
 		parent->invalidRect (_rect);
 }
@@ -740,6 +1059,7 @@ void CViewContainer::invalid ()
 //-----------------------------------------------------------------------------
 void CViewContainer::invalidRect (const CRect& rect)
 {
+	invalidateLayerCache ();
 	if (!isVisible ())
 		return;
 	CRect _rect (rect);
@@ -831,9 +1151,15 @@ void CViewContainer::drawRect (CDrawContext* pContext, const CRect& updateRect)
 	CView* _focusView = nullptr;
 	IFocusDrawing* _focusDrawing = nullptr;
 	auto frame = getFrame ();
-	if (frame && frame->focusDrawingEnabled () && isChild (frame->getFocusView (), false) && frame->getFocusView ()->isVisible () && frame->getFocusView ()->wantsFocus ())
+#if VSTGUI_ENABLE_FRAME_PROFILER
+	auto profiler = frame ? frame->getProfiler () : nullptr;
+#endif
+	// only a direct child is drawn with its focus here, checking the parent avoids searching the
+	// children in every paint
+	auto frameFocusView = frame ? frame->getFocusView () : nullptr;
+	if (frameFocusView && frame->focusDrawingEnabled () && frameFocusView->getParentView () == this && frameFocusView->isVisible () && frameFocusView->wantsFocus ())
 	{
-		_focusView = frame->getFocusView ();
+		_focusView = frameFocusView;
 		_focusDrawing = dynamic_cast<IFocusDrawing*> (_focusView);
 	}
 
@@ -843,9 +1169,8 @@ void CViewContainer::drawRect (CDrawContext* pContext, const CRect& updateRect)
 		getTransform ().inverse ().transform (clientRect);
 		getTransform ().transform (oldClip2);
 		
-		// draw each view
-		for (const auto& pV : pImpl->children)
-		{
+		// draw each view which intersects the update rect
+		pImpl->forEachChildIn (clientRect, _focusView, [&] (CView* pV) {
 			if (pV->isVisible ())
 			{
 				if (frame && _focusDrawing && _focusView == pV && !_focusDrawing->drawFocusOnTop ())
@@ -876,15 +1201,20 @@ void CViewContainer::drawRect (CDrawContext* pContext, const CRect& updateRect)
 					CRect viewSize = pV->getViewSize ();
 					viewSize.bound (newClip);
 					if (viewSize.getWidth () == 0 || viewSize.getHeight () == 0)
-						continue;
+						return;
 					pContext->setClipRect (viewSize);
 					float globalContextAlpha = pContext->getGlobalAlpha ();
 					pContext->setGlobalAlpha (globalContextAlpha * pV->getAlphaValue ());
-					pV->drawRect (pContext, viewSize);
+#if VSTGUI_ENABLE_FRAME_PROFILER
+					CFrameProfiler::DrawViewScope drawViewScope (profiler, pV, viewSize);
+#endif
+					if (!pV->getCacheAsBitmap () ||
+					    !CViewLayerCache::instance ().drawView (pV, pContext))
+						pV->drawRect (pContext, viewSize);
 					pContext->setGlobalAlpha (globalContextAlpha);
 				}
 			}
-		}
+		});
 	}
 	
 	pContext->setClipRect (oldClip2);
@@ -946,21 +1276,21 @@ bool CViewContainer::hitTestSubViews (const CPoint& where, const CButtonState& b
 	where2.offset (-getViewSize ().left, -getViewSize ().top);
 	getTransform ().inverse ().transform (where2);
 
-	for (auto it = pImpl->children.rbegin (), end = pImpl->children.rend (); it != end; ++it)
-	{
-		const auto& pV = *it;
+	bool result = false;
+	pImpl->forEachChildAt (where2, [&] (CView* pV) {
 		if (pV && pV->isVisible () && pV->getMouseEnabled () && pV->hitTest (where2, buttons))
 		{
 			if (auto container = pV->asViewContainer ())
 			{
 				if (container->hitTestSubViews (where2, buttons))
-					return true;
+					result = true;
 			}
 			else
-				return true;
+				result = true;
 		}
-	}
-	return false;
+		return result;
+	});
+	return result;
 }
 
 //-----------------------------------------------------------------------------
@@ -984,9 +1314,9 @@ CMouseEventResult CViewContainer::onMouseDown (CPoint &where, const CButtonState
 	where2.offset (-getViewSize ().left, -getViewSize ().top);
 	getTransform ().inverse ().transform (where2);
 
-	for (auto it = pImpl->children.rbegin (), end = pImpl->children.rend (); it != end; ++it)
-	{
-		auto pV = *it;
+	auto mouseResult = kMouseEventNotHandled;
+	pImpl->forEachChildAt (where2, [&] (CView* view) {
+		SharedPointer<CView> pV (view);
 		if (pV && pV->isVisible () && pV->getMouseEnabled () && pV->hitTest (where2, buttons))
 		{
 			if (buttons & (kAlt | kShift | kControl | kApple | kRButton))
@@ -995,7 +1325,10 @@ CMouseEventResult CViewContainer::onMouseDown (CPoint &where, const CButtonState
 				if (control && control->getListener ())
 				{
 					if (control->getListener ()->controlModifierClicked (control, buttons) != 0)
-						return kMouseEventHandled;
+					{
+						mouseResult = kMouseEventHandled;
+						return true;
+					}
 				}
 			}
 
@@ -1009,13 +1342,18 @@ CMouseEventResult CViewContainer::onMouseDown (CPoint &where, const CButtonState
 			{
 				if (pV->getNbReference () > 1 && result == kMouseEventHandled)
 					setMouseDownView (pV);
-				return result;
+				mouseResult = result;
+				return true;
 			}
 			if (!pV->getTransparency ())
-				return result;
+			{
+				mouseResult = result;
+				return true;
+			}
 		}
-	}
-	return kMouseEventNotHandled;
+		return false;
+	});
+	return mouseResult;
 }
 
 //-----------------------------------------------------------------------------
@@ -1075,21 +1413,25 @@ CMouseEventResult CViewContainer::onMouseCancel ()
 //-----------------------------------------------------------------------------
 bool CViewContainer::onWheel (const CPoint &where, const CMouseWheelAxis &axis, const float &distance, const CButtonState &buttons)
 {
-	for (auto it = pImpl->children.rbegin (), end = pImpl->children.rend (); it != end; ++it)
-	{
-		const auto& pV = *it;
-		CPoint where2 (where);
-		where2.offset (-getViewSize ().left, -getViewSize ().top);
-		getTransform ().inverse ().transform (where2);
+	CPoint where2 (where);
+	where2.offset (-getViewSize ().left, -getViewSize ().top);
+	getTransform ().inverse ().transform (where2);
+
+	bool result = false;
+	pImpl->forEachChildAt (where2, [&] (CView* pV) {
 		if (pV && pV->isVisible () && pV->getMouseEnabled () && pV->getMouseableArea ().pointInside (where2))
 		{
 			if (pV->onWheel (where2, axis, distance, buttons))
+			{
+				result = true;
 				return true;
+			}
 			if (!pV->getTransparency ())
-				return false;
+				return true;
 		}
-	}
-	return false;
+		return false;
+	});
+	return result;
 }
 
 //-----------------------------------------------------------------------------
@@ -1292,33 +1634,34 @@ CView* CViewContainer::getViewAt (const CPoint& p, const GetViewOptions& options
 	where.offset (-getViewSize ().left, -getViewSize ().top);
 	getTransform ().inverse ().transform (where);
 
-	for (auto it = pImpl->children.rbegin (), end = pImpl->children.rend (); it != end; ++it)
-	{
-		const auto& pV = *it;
+	CView* result = nullptr;
+	pImpl->forEachChildAt (where, [&] (CView* pV) {
 		if (pV && pV->getMouseableArea ().pointInside (where))
 		{
 			if (!options.getIncludeInvisible () && pV->isVisible () == false)
-				continue;
+				return false;
 			if (options.getMouseEnabled ())
 			{
 				if (pV->getMouseEnabled () == false)
-					continue;
+					return false;
 			}
 			if (options.getDeep ())
 			{
 				if (auto container = pV->asViewContainer ())
 				{
 					CView* view = container->getViewAt (where, options);
-					return options.getIncludeViewContainer () ? (view ? view : container) : view;
+					result = options.getIncludeViewContainer () ? (view ? view : container) : view;
+					return true;
 				}
 			}
 			if (!options.getIncludeViewContainer () && pV->asViewContainer ())
-				continue;
-			return pV;
+				return false;
+			result = pV;
+			return true;
 		}
-	}
-
-	return nullptr;
+		return false;
+	});
+	return result;
 }
 
 //-----------------------------------------------------------------------------
@@ -1336,17 +1679,15 @@ bool CViewContainer::getViewsAt (const CPoint& p, ViewList& views, const GetView
 	where.offset (-getViewSize ().left, -getViewSize ().top);
 	getTransform ().inverse ().transform (where);
 
-	for (auto it = pImpl->children.rbegin (), end = pImpl->children.rend (); it != end; ++it)
-	{
-		const auto& pV = *it;
+	pImpl->forEachChildAt (where, [&] (CView* pV) {
 		if (pV && pV->getMouseableArea ().pointInside (where))
 		{
 			if (!options.getIncludeInvisible () && pV->isVisible () == false)
-				continue;
+				return false;
 			if (options.getMouseEnabled ())
 			{
 				if (pV->getMouseEnabled () == false)
-					continue;
+					return false;
 			}
 			if (options.getDeep ())
 			{
@@ -1356,12 +1697,13 @@ bool CViewContainer::getViewsAt (const CPoint& p, ViewList& views, const GetView
 			if (options.getIncludeViewContainer () == false)
 			{
 				if (pV->asViewContainer ())
-					continue;
+					return false;
 			}
 			views.emplace_back (pV);
 			result = true;
 		}
-	}
+		return false;
+	});
 
 	return result;
 }
@@ -1378,28 +1720,27 @@ CViewContainer* CViewContainer::getContainerAt (const CPoint& p, const GetViewOp
 	where.offset (-getViewSize ().left, -getViewSize ().top);
 	getTransform ().inverse ().transform (where);
 
-	for (auto it = pImpl->children.rbegin (), end = pImpl->children.rend (); it != end; ++it)
-	{
-		const auto& pV = *it;
+	CViewContainer* result = const_cast<CViewContainer*>(this);
+	pImpl->forEachChildAt (where, [&] (CView* pV) {
 		if (pV && pV->getMouseableArea ().pointInside (where))
 		{
 			if (!options.getIncludeInvisible () && pV->isVisible () == false)
-				continue;
+				return false;
 			if (options.getMouseEnabled ())
 			{
 				if (pV->getMouseEnabled() == false)
-					continue;
+					return false;
 			}
 			if (options.getDeep ())
 			{
 				if (CViewContainer* container = pV->asViewContainer ())
-					return container->getContainerAt (where, options);
+					result = container->getContainerAt (where, options);
 			}
-			break;
+			return true;
 		}
-	}
-
-	return const_cast<CViewContainer*>(this);
+		return false;
+	});
+	return result;
 }
 
 //-----------------------------------------------------------------------------
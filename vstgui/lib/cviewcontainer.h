@@ -91,6 +91,10 @@ public:
 
 	virtual bool hitTestSubViews (const CPoint& where, const CButtonState& buttons = -1);
 
+	/** enable or disable a spatial index of the child views to speed up hit testing and drawing. Per default this is disabled. */
+	void setChildViewIndexEnabled (bool state);
+	bool getChildViewIndexEnabled () const;
+
 	/** enable or disable autosizing subviews. Per default this is enabled. */
 	virtual void setAutosizingEnabled (bool state);
 	bool getAutosizingEnabled () const { return hasViewFlag (kAutosizeSubviews); }
@@ -0,0 +1,225 @@
+// This file is part of VSTGUI. It is subject to the license terms
+// in the LICENSE file found in the top-level directory of this
+// distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
+
+#include "cviewlayercache.h"
+#include "cbitmap.h"
+#include "coffscreencontext.h"
+#include "cview.h"
+#include <cmath>
+#include <list>
+#include <unordered_map>
+
+namespace VSTGUI {
+
+//-----------------------------------------------------------------------------
+struct CViewLayerCache::Impl
+{
+	struct Layer
+	{
+		const CView* view;
+		SharedPointer<CBitmap> bitmap;
+		CPoint size;
+		double scaleFactor;
+		uint64_t memory;
+	};
+	/** most recently drawn layer first */
+	using LayerList = std::list<Layer>;
+	using LayerMap = std::unordered_map<const CView*, LayerList::iterator>;
+
+	LayerList layers;
+	LayerMap layerMap;
+	uint64_t memoryBudget {kDefaultMemoryBudget};
+	uint64_t memoryUsage {0};
+	Statistics statistics;
+	CreateContextFunc createContextFunc;
+
+	void remove (LayerMap::iterator it)
+	{
+		memoryUsage -= it->second->memory;
+		layers.erase (it->second);
+		layerMap.erase (it);
+	}
+
+	void shrinkTo (uint64_t budget)
+	{
+		while (memoryUsage > budget && !layers.empty ())
+		{
+			remove (layerMap.find (layers.back ().view));
+			++statistics.numEvictions;
+		}
+	}
+};
+
+//-----------------------------------------------------------------------------
+constexpr uint64_t CViewLayerCache::kDefaultMemoryBudget;
+
+//-----------------------------------------------------------------------------
+CViewLayerCache& CViewLayerCache::instance ()
+{
+	static CViewLayerCache gInstance;
+	return gInstance;
+}
+
+//-----------------------------------------------------------------------------
+CViewLayerCache::CViewLayerCache ()
+{
+	pImpl = std::unique_ptr<Impl> (new Impl ());
+}
+
+//-----------------------------------------------------------------------------
+CViewLayerCache::~CViewLayerCache () noexcept = default;
+
+//-----------------------------------------------------------------------------
+void CViewLayerCache::setMemoryBudget (uint64_t bytes)
+{
+	pImpl->memoryBudget = bytes;
+	pImpl->shrinkTo (bytes);
+}
+
+//-----------------------------------------------------------------------------
+uint64_t CViewLayerCache::getMemoryBudget () const
+{
+	return pImpl->memoryBudget;
+}
+
+//-----------------------------------------------------------------------------
+uint64_t CViewLayerCache::getMemoryUsage () const
+{
+	return pImpl->memoryUsage;
+}
+
+//-----------------------------------------------------------------------------
+size_t CViewLayerCache::getNumLayers () const
+{
+	return pImpl->layers.size ();
+}
+
+//-----------------------------------------------------------------------------
+uint64_t CViewLayerCache::calculateLayerMemory (const CPoint& size, double scaleFactor)
+{
+	auto width = static_cast<uint64_t> (std::ceil (size.x * scaleFactor));
+	auto height = static_cast<uint64_t> (std::ceil (size.y * scaleFactor));
+	return width * height * 4;
+}
+
+//-----------------------------------------------------------------------------
+double CViewLayerCache::getLayerScaleFactor (CDrawContext* context)
+{
+	auto scaleFactor = context->getScaleFactor ();
+	const auto& matrix = context->getCurrentTransform ();
+	if (matrix.m11 == matrix.m22)
+	{
+		auto matrixScale = std::floor (matrix.m11 + 0.5);
+		if (matrixScale != 0.)
+			scaleFactor *= matrixScale;
+	}
+	return scaleFactor;
+}
+
+//-----------------------------------------------------------------------------
+CBitmap* CViewLayerCache::getLayer (const CView* view, double scaleFactor)
+{
+	auto it = pImpl->layerMap.find (view);
+	if (it == pImpl->layerMap.end ())
+	{
+		++pImpl->statistics.numMisses;
+		return nullptr;
+	}
+	auto layer = it->second;
+	if (layer->scaleFactor != scaleFactor || layer->size != view->getViewSize ().getSize ())
+	{
+		pImpl->remove (it);
+		++pImpl->statistics.numMisses;
+		return nullptr;
+	}
+	pImpl->layers.splice (pImpl->layers.begin (), pImpl->layers, layer);
+	++pImpl->statistics.numHits;
+	return layer->bitmap;
+}
+
+//-----------------------------------------------------------------------------
+bool CViewLayerCache::setLayer (const CView* view, CBitmap* bitmap, double scaleFactor)
+{
+	removeLayer (view);
+	auto size = view->getViewSize ().getSize ();
+	auto memory = calculateLayerMemory (size, scaleFactor);
+	if (memory > pImpl->memoryBudget)
+		return false;
+	pImpl->shrinkTo (pImpl->memoryBudget - memory);
+	pImpl->layers.emplace_front (Impl::Layer {view, bitmap, size, scaleFactor, memory});
+	pImpl->layerMap.emplace (view, pImpl->layers.begin ());
+	pImpl->memoryUsage += memory;
+	return true;
+}
+
+//-----------------------------------------------------------------------------
+void CViewLayerCache::removeLayer (const CView* view)
+{
+	auto it = pImpl->layerMap.find (view);
+	if (it != pImpl->layerMap.end ())
+		pImpl->remove (it);
+}
+
+//-----------------------------------------------------------------------------
+void CViewLayerCache::clear ()
+{
+	pImpl->layers.clear ();
+	pImpl->layerMap.clear ();
+	pImpl->memoryUsage = 0;
+}
+
+//-----------------------------------------------------------------------------
+auto CViewLayerCache::getStatistics () const -> const Statistics&
+{
+	return pImpl->statistics;
+}
+
+//-----------------------------------------------------------------------------
+void CViewLayerCache::resetStatistics ()
+{
+	pImpl->statistics = {};
+}
+
+//-----------------------------------------------------------------------------
+void CViewLayerCache::setCreateContextFunc (CreateContextFunc&& func)
+{
+	pImpl->createContextFunc = std::move (func);
+}
+
+//-----------------------------------------------------------------------------
+bool CViewLayerCache::drawView (CView* view, CDrawContext* context)
+{
+	auto scaleFactor = getLayerScaleFactor (context);
+	if (view->isDirty ())
+		removeLayer (view);
+	auto viewSize = view->getViewSize ();
+	SharedPointer<CBitmap> layer = getLayer (view, scaleFactor);
+	if (!layer)
+	{
+		if (calculateLayerMemory (viewSize.getSize (), scaleFactor) > pImpl->memoryBudget)
+			return false;
+		auto offscreen =
+		    pImpl->createContextFunc ?
+		        pImpl->createContextFunc (view, viewSize.getSize (), scaleFactor) :
+		        COffscreenContext::create (view->getFrame (), viewSize.getWidth (),
+		                                   viewSize.getHeight (), scaleFactor);
+		if (!offscreen)
+			return false;
+		offscreen->beginDraw ();
+		{
+			CDrawContext::Transform transform (
+			    *offscreen, CGraphicsTransform ().translate (-viewSize.left, -viewSize.top));
+			view->drawRect (offscreen, viewSize);
+		}
+		offscreen->endDraw ();
+		layer = offscreen->getBitmap ();
+		if (!layer)
+			return false;
+		setLayer (view, layer, scaleFactor);
+	}
+	context->drawBitmap (layer, viewSize);
+	return true;
+}
+
+} // namespace
@@ -0,0 +1,84 @@
+// This file is part of VSTGUI. It is subject to the license terms
+// in the LICENSE file found in the top-level directory of this
+// distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
+
+#ifndef __cviewlayercache__
+#define __cviewlayercache__
+
+#include "vstguifwd.h"
+#include "cpoint.h"
+#include <functional>
+#include <memory>
+
+namespace VSTGUI {
+
+//-----------------------------------------------------------------------------
+/** Global cache for the rendered layers of views with the cache as bitmap mode enabled
+ *
+ *	A layer is kept until the view or one of its subviews is invalidated, the size of the view
+ *	or the scale factor changes. All layers share one memory budget, if it is exceeded the least
+ *	recently drawn layers are released first.
+ *
+ *	@see CView::setCacheAsBitmap
+ */
+class CViewLayerCache
+{
+public:
+	static CViewLayerCache& instance ();
+
+	struct Statistics
+	{
+		/** number of times a view was drawn from its layer */
+		uint64_t numHits {0};
+		/** number of times a layer had to be rendered */
+		uint64_t numMisses {0};
+		/** number of layers released because of the memory budget */
+		uint64_t numEvictions {0};
+	};
+
+	/** set the memory budget in bytes for all layers, layers are released if necessary */
+	void setMemoryBudget (uint64_t bytes);
+	uint64_t getMemoryBudget () const;
+	/** returns the memory in bytes used by all layers */
+	uint64_t getMemoryUsage () const;
+	size_t getNumLayers () const;
+
+	/** draw the view via its layer, the layer is rendered first if needed.
+	 *	Returns false if no layer could be created, the view must then be drawn directly. */
+	bool drawView (CView* view, CDrawContext* context);
+
+	/** returns the layer of the view if it matches the scale factor and the size of the view */
+	CBitmap* getLayer (const CView* view, double scaleFactor);
+	/** store the layer of the view, returns false if it does not fit into the memory budget */
+	bool setLayer (const CView* view, CBitmap* bitmap, double scaleFactor);
+	void removeLayer (const CView* view);
+	void clear ();
+
+	const Statistics& getStatistics () const;
+	void resetStatistics ();
+
+	/** returns the memory needed for a layer of the size at the scale factor */
+	static uint64_t calculateLayerMemory (const CPoint& size, double scaleFactor);
+	/** returns the scale factor a layer drawn into the context should use */
+	static double getLayerScaleFactor (CDrawContext* context);
+
+	/** creates the offscreen context a layer is rendered into */
+	using CreateContextFunc = std::function<SharedPointer<COffscreenContext> (
+	    CView* view, const CPoint& size, double scaleFactor)>;
+	/** replace how layer contexts are created, by default COffscreenContext::create is used with
+	 *	the frame of the view. Pass nullptr to restore the default. */
+	void setCreateContextFunc (CreateContextFunc&& func);
+
+	static constexpr uint64_t kDefaultMemoryBudget = 64 * 1024 * 1024;
+
+private:
+	CViewLayerCache ();
+	~CViewLayerCache () noexcept;
+
+	struct Impl;
+	std::unique_ptr<Impl> pImpl;
+};
+
+} // namespace
+
+#endif // __cviewlayercache__
@@ -21,6 +21,8 @@ public:
 	virtual ~IViewListener () noexcept = default;
 
 	virtual void viewSizeChanged (CView* view, const CRect& oldSize) = 0;
+	/** optional, the default implementation does nothing */
+	virtual void viewMouseableAreaChanged (CView* view, const CRect& oldArea) {}
 	virtual void viewAttached (CView* view) = 0;
 	virtual void viewRemoved (CView* view) = 0;
 	virtual void viewLostFocus (CView* view) = 0;
@@ -70,6 +72,7 @@ class ViewListenerAdapter : public IViewListener
 {
 public:
 	void viewSizeChanged (CView* view, const CRect& oldSize) override {}
+	void viewMouseableAreaChanged (CView* view, const CRect& oldArea) override {}
 	void viewAttached (CView* view) override {}
 	void viewRemoved (CView* view) override {}
 	void viewLostFocus (CView* view) override {}
@@ -3,10 +3,17 @@
 // distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
 
 #include "fileresourceinputstream.h"
+#include <cstring>
 
 #if WINDOWS
 	#define fseeko _fseeki64
 	#define ftello _ftelli64
+	#include <windows.h>
+#else
+	#include <fcntl.h>
+	#include <sys/mman.h>
+	#include <sys/stat.h>
+	#include <unistd.h>
 #endif
 
 //-----------------------------------------------------------------------------
@@ -71,5 +78,125 @@ int64_t FileResourceInputStream::tell ()
 	return ftello (fileHandle);
 }
 
+//-----------------------------------------------------------------------------
+//-----------------------------------------------------------------------------
+//-----------------------------------------------------------------------------
+#if WINDOWS
+//-----------------------------------------------------------------------------
+MappedFileResourceInputStream::Ptr MappedFileResourceInputStream::create (const std::string& path)
+{
+	auto numChars = MultiByteToWideChar (CP_UTF8, 0, path.data (), -1, nullptr, 0);
+	if (numChars <= 0)
+		return nullptr;
+	std::wstring widePath (static_cast<size_t> (numChars), 0);
+	MultiByteToWideChar (CP_UTF8, 0, path.data (), -1, &widePath[0], numChars);
+	auto file = CreateFileW (widePath.data (), GENERIC_READ, FILE_SHARE_READ, nullptr,
+	                         OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+	if (file == INVALID_HANDLE_VALUE)
+		return nullptr;
+	Ptr result;
+	LARGE_INTEGER fileSize;
+	if (GetFileSizeEx (file, &fileSize) && fileSize.QuadPart > 0)
+	{
+		if (auto mapping = CreateFileMappingW (file, nullptr, PAGE_READONLY, 0, 0, nullptr))
+		{
+			if (auto data = MapViewOfFile (mapping, FILE_MAP_READ, 0, 0, 0))
+				result = Ptr (new MappedFileResourceInputStream (
+				    data, static_cast<uint64_t> (fileSize.QuadPart)));
+			CloseHandle (mapping);
+		}
+	}
+	CloseHandle (file);
+	return result;
+}
+
+//-----------------------------------------------------------------------------
+MappedFileResourceInputStream::~MappedFileResourceInputStream () noexcept
+{
+	UnmapViewOfFile (data);
+}
+
+#else
+//-----------------------------------------------------------------------------
+MappedFileResourceInputStream::Ptr MappedFileResourceInputStream::create (const std::string& path)
+{
+	auto fd = ::open (path.data (), O_RDONLY);
+	if (fd == -1)
+		return nullptr;
+	Ptr result;
+	struct stat fileStat;
+	if (fstat (fd, &fileStat) == 0 && S_ISREG (fileStat.st_mode) && fileStat.st_size > 0)
+	{
+		auto size = static_cast<size_t> (fileStat.st_size);
+		auto data = mmap (nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+		if (data != MAP_FAILED)
+		{
+			// the whole file is read sequentially by the parsers
+			madvise (data, size, MADV_SEQUENTIAL);
+			result = Ptr (new MappedFileResourceInputStream (data, size));
+		}
+	}
+	close (fd);
+	return result;
+}
+
+//-----------------------------------------------------------------------------
+MappedFileResourceInputStream::~MappedFileResourceInputStream () noexcept
+{
+	munmap (const_cast<void*> (data), static_cast<size_t> (dataSize));
+}
+
+#endif
+
+//-----------------------------------------------------------------------------
+MappedFileResourceInputStream::MappedFileResourceInputStream (const void* data, uint64_t size)
+: data (data), dataSize (size)
+{
+}
+
+//-----------------------------------------------------------------------------
+uint32_t MappedFileResourceInputStream::readRaw (void* buffer, uint32_t size)
+{
+	auto available = dataSize - pos;
+	if (size > available)
+		size = static_cast<uint32_t> (available);
+	memcpy (buffer, static_cast<const uint8_t*> (data) + pos, size);
+	pos += size;
+	return size;
+}
+
+//-----------------------------------------------------------------------------
+int64_t MappedFileResourceInputStream::seek (int64_t newPos, SeekMode mode)
+{
+	switch (mode)
+	{
+		case SeekMode::Set:
+			break;
+		case SeekMode::Current:
+			newPos += static_cast<int64_t> (pos);
+			break;
+		case SeekMode::End:
+			newPos += static_cast<int64_t> (dataSize);
+			break;
+	}
+	if (newPos < 0 || static_cast<uint64_t> (newPos) > dataSize)
+		return kStreamSeekError;
+	pos = static_cast<uint64_t> (newPos);
+	return newPos;
+}
+
+//-----------------------------------------------------------------------------
+int64_t MappedFileResourceInputStream::tell ()
+{
+	return static_cast<int64_t> (pos);
+}
+
+//-----------------------------------------------------------------------------
+const void* MappedFileResourceInputStream::getMappedData (uint64_t& size) const
+{
+	size = dataSize;
+	return data;
+}
+
 //-----------------------------------------------------------------------------
 } // VSTGUI
@@ -28,5 +28,27 @@ private:
 	FILE* fileHandle;
 };
 
+//-----------------------------------------------------------------------------
+/** read only resource stream which maps the whole file into memory */
+class MappedFileResourceInputStream : public IPlatformResourceInputStream
+{
+public:
+	/** returns nullptr if the file cannot be mapped (i.e. it is empty or not a regular file) */
+	static Ptr create (const std::string& path);
+
+private:
+	MappedFileResourceInputStream (const void* data, uint64_t size);
+	~MappedFileResourceInputStream () noexcept override;
+
+	uint32_t readRaw (void* buffer, uint32_t size) override;
+	int64_t seek (int64_t pos, SeekMode mode) override;
+	int64_t tell () override;
+	const void* getMappedData (uint64_t& size) const override;
+
+	const void* data;
+	uint64_t dataSize;
+	uint64_t pos {0};
+};
+
 //-----------------------------------------------------------------------------
 } // VSTGUI
@@ -21,6 +21,15 @@ public:
 	virtual int64_t seek (int64_t pos, SeekMode mode) = 0;
 	virtual int64_t tell () = 0;
 
+	/** returns the whole content of the stream if it is backed by contiguous memory (i.e. a memory
+	 *	mapped file), otherwise nullptr. The memory is valid as long as the stream exists.
+	 */
+	virtual const void* getMappedData (uint64_t& size) const
+	{
+		size = 0;
+		return nullptr;
+	}
+
 	using Ptr = std::unique_ptr<IPlatformResourceInputStream>;
 	static Ptr create (const CResourceDescription& desc);
 };
@@ -48,6 +48,19 @@ inline bool needPixelAlignment (CDrawMode mode)
 	return (mode.integralMode () && mode.modeIgnoringIntegralMode () == kAntiAliasing);
 }
 
+//------------------------------------------------------------------------
+struct SaveCairoMatrix
+{
+	SaveCairoMatrix (ContextHandle& h) : h (h) { cairo_get_matrix (h, &matrix); }
+	~SaveCairoMatrix () { cairo_set_matrix (h, &matrix); }
+private:
+	ContextHandle& h;
+	cairo_matrix_t matrix;
+};
+
+//------------------------------------------------------------------------
+bool gDrawStateCaching = true;
+
 //------------------------------------------------------------------------
 } // anonymous
 
@@ -65,25 +78,19 @@ DrawBlock::DrawBlock (Context& context) : context (context)
 	}
 	else
 	{
-		cairo_save (context.getCairo ());
-		cairo_rectangle (context.getCairo (), clip.left, clip.top, clip.getWidth (),
-						 clip.getHeight ());
-		cairo_clip (context.getCairo ());
-		auto matrix = convert (ct);
-		cairo_set_matrix (context.getCairo (), &matrix);
 		auto antialiasMode = context.getDrawMode ().modeIgnoringIntegralMode () == kAntiAliasing ?
 								 CAIRO_ANTIALIAS_BEST :
 								 CAIRO_ANTIALIAS_NONE;
-		cairo_set_antialias (context.getCairo (), antialiasMode);
+		context.applyDrawState (clip, ct, antialiasMode);
 	}
 }
 
 //------------------------------------------------------------------------
 DrawBlock::~DrawBlock ()
 {
-	if (!clipIsEmpty)
+	if (!clipIsEmpty && !gDrawStateCaching)
 	{
-		cairo_restore (context.getCairo ());
+		context.resetDrawState ();
 	}
 }
 
@@ -93,6 +100,18 @@ DrawBlock DrawBlock::begin (Context& context)
 	return DrawBlock (context);
 }
 
+//-----------------------------------------------------------------------------
+void Context::setDrawStateCaching (bool state)
+{
+	gDrawStateCaching = state;
+}
+
+//-----------------------------------------------------------------------------
+bool Context::getDrawStateCaching ()
+{
+	return gDrawStateCaching;
+}
+
 //-----------------------------------------------------------------------------
 Context::Context (const CRect& rect, const SurfaceHandle& surface) : super (rect), surface (surface)
 {
@@ -136,6 +155,7 @@ void Context::beginDraw ()
 //-----------------------------------------------------------------------------
 void Context::endDraw ()
 {
+	resetDrawState ();
 	cairo_restore (cr);
 	if (surface)
 		cairo_surface_flush (surface);
@@ -155,12 +175,67 @@ void Context::restoreGlobalState ()
 	super::restoreGlobalState ();
 }
 
+//-----------------------------------------------------------------------------
+void Context::applyDrawState (const CRect& clip, const CGraphicsTransform& tm,
+							  cairo_antialias_t antialias)
+{
+	if (drawState.applied)
+	{
+		if (drawState.clip == clip && drawState.matrix == tm && drawState.antialias == antialias)
+			return;
+		if (drawState.clip == clip)
+		{
+			// the clip is set in device space and stays valid, only update the rest
+			if (drawState.matrix != tm)
+			{
+				auto matrix = convert (drawState.matrix = tm);
+				cairo_set_matrix (cr, &matrix);
+			}
+			if (drawState.antialias != antialias)
+				cairo_set_antialias (cr, drawState.antialias = antialias);
+			return;
+		}
+		resetDrawState ();
+	}
+	cairo_save (cr);
+	cairo_rectangle (cr, clip.left, clip.top, clip.getWidth (), clip.getHeight ());
+	cairo_clip (cr);
+	drawState.clip = clip;
+	drawState.matrix = tm;
+	auto matrix = convert (drawState.matrix);
+	cairo_set_matrix (cr, &matrix);
+	drawState.antialias = antialias;
+	cairo_set_antialias (cr, antialias);
+	drawState.applied = true;
+}
+
+//-----------------------------------------------------------------------------
+void Context::resetDrawState ()
+{
+	if (!drawState.applied)
+		return;
+	cairo_restore (cr);
+	drawState.applied = false;
+	// the source and the dash pattern were set after the save and are restored now
+	sourceColor.valid = false;
+	dashApplied = false;
+}
+
 //-----------------------------------------------------------------------------
 void Context::setSourceColor (CColor color)
 {
-	auto alpha = color.alpha / 255.;
-	alpha *= getGlobalAlpha ();
-	cairo_set_source_rgba (cr, color.red / 255., color.green / 255., color.blue / 255., alpha);
+	SourceColor newColor;
+	newColor.red = color.red / 255.;
+	newColor.green = color.green / 255.;
+	newColor.blue = color.blue / 255.;
+	newColor.alpha = (color.alpha / 255.) * getGlobalAlpha ();
+	if (sourceColor.valid && sourceColor.red == newColor.red &&
+		sourceColor.green == newColor.green && sourceColor.blue == newColor.blue &&
+		sourceColor.alpha == newColor.alpha)
+		return;
+	cairo_set_source_rgba (cr, newColor.red, newColor.green, newColor.blue, newColor.alpha);
+	sourceColor = newColor;
+	sourceColor.valid = true;
 	checkCairoStatus (cr);
 }
 
@@ -173,6 +248,12 @@ void Context::setupCurrentStroke ()
 	{
 		cairo_set_dash (cr, style.getDashLengths ().data (), style.getDashLengths ().size (),
 						style.getDashPhase ());
+		dashApplied = true;
+	}
+	else if (dashApplied)
+	{
+		cairo_set_dash (cr, nullptr, 0, 0.);
+		dashApplied = false;
 	}
 	cairo_line_cap_t lineCap;
 	switch (style.getLineCap ())
@@ -344,6 +425,7 @@ void Context::drawArc (const CRect& rect, const float startAngle1, const float e
 {
 	if (auto cd = DrawBlock::begin (*this))
 	{
+		SaveCairoMatrix saveMatrix (cr);
 		CPoint center = rect.getCenter ();
 		cairo_translate (cr, center.x, center.y);
 		cairo_scale (cr, 2.0 / rect.getWidth (), 2.0 / rect.getHeight ());
@@ -357,6 +439,7 @@ void Context::drawEllipse (const CRect& rect, const CDrawStyle drawStyle)
 {
 	if (auto cd = DrawBlock::begin (*this))
 	{
+		SaveCairoMatrix saveMatrix (cr);
 		CPoint center = rect.getCenter ();
 		cairo_translate (cr, center.x, center.y);
 		cairo_scale (cr, 2.0 / rect.getWidth (), 2.0 / rect.getHeight ());
@@ -389,6 +472,7 @@ void Context::drawBitmap (CBitmap* bitmap, const CRect& dest, const CPoint& offs
                 auto cairoBitmap = bitmap->getBestPlatformBitmapForScaleFactor (transformedScaleFactor).cast<Bitmap> ();
 		if (cairoBitmap)
 		{
+			SaveCairoState saveState (cr);
 			cairo_translate (cr, dest.left, dest.top);
 			cairo_rectangle (cr, 0, 0, dest.getWidth (), dest.getHeight ());
 			cairo_clip (cr);
@@ -427,6 +511,7 @@ void Context::clearRect (const CRect& rect)
 		cairo_set_operator (cr, CAIRO_OPERATOR_CLEAR);
 		cairo_rectangle (cr, rect.left, rect.top, rect.getWidth (), rect.getHeight ());
 		cairo_fill (cr);
+		cairo_set_operator (cr, CAIRO_OPERATOR_OVER);
 	}
 	checkCairoStatus (cr);
 }
@@ -452,6 +537,7 @@ void Context::drawGraphicsPath (CGraphicsPath* path, CDrawContext::PathDrawMode
 	{
 		if (auto cd = DrawBlock::begin (*this))
 		{
+			SaveCairoMatrix saveMatrix (cr);
 			auto p = cairoPath->getPath (
 				cr, needPixelAlignment (getDrawMode ()) ? &getCurrentTransform () : nullptr);
 			if (transformation)
@@ -477,6 +563,7 @@ void Context::drawGraphicsPath (CGraphicsPath* path, CDrawContext::PathDrawMode
 					setSourceColor (getFillColor ());
 					cairo_set_fill_rule (cr, CAIRO_FILL_RULE_EVEN_ODD);
 					cairo_fill (cr);
+					cairo_set_fill_rule (cr, CAIRO_FILL_RULE_WINDING);
 					break;
 				}
 				case PathDrawMode::kPathStroked:
@@ -506,10 +593,12 @@ void Context::fillLinearGradient (CGraphicsPath* path, const CGradient& gradient
 				auto p = cairoPath->getPath (cr);
 				cairo_append_path (cr, p);
 				cairo_set_source (cr, cairoGradient->getLinearGradient (startPoint, endPoint));
+				invalidateSourceColor ();
 				if (evenOdd)
 				{
 					cairo_set_fill_rule (cr, CAIRO_FILL_RULE_EVEN_ODD);
 					cairo_fill (cr);
+					cairo_set_fill_rule (cr, CAIRO_FILL_RULE_WINDING);
 				}
 				else
 				{
@@ -58,14 +58,49 @@ public:
 	void beginDraw () override;
 	void endDraw () override;
 
+	/** set the source color, if it differs from the current source color */
+	void setSourceColor (CColor color);
+	/** must be called after the source was changed without setSourceColor */
+	void invalidateSourceColor () { sourceColor.valid = false; }
+
+	/** the clip, matrix and antialias state of consecutive draw blocks is only applied to cairo
+	 *	if it changed. If disabled every draw block saves, sets up and restores the cairo state.
+	 */
+	static void setDrawStateCaching (bool state);
+	static bool getDrawStateCaching ();
+
 private:
+	friend struct DrawBlock;
+
 	void init () override;
-	void setSourceColor (CColor color);
 	void setupCurrentStroke ();
 	void draw (CDrawStyle drawstyle);
 
+	void applyDrawState (const CRect& clip, const CGraphicsTransform& tm,
+	                     cairo_antialias_t antialias);
+	void resetDrawState ();
+
+	struct DrawState
+	{
+		CRect clip;
+		CGraphicsTransform matrix;
+		cairo_antialias_t antialias {CAIRO_ANTIALIAS_DEFAULT};
+		bool applied {false};
+	};
+	struct SourceColor
+	{
+		double red {0.};
+		double green {0.};
+		double blue {0.};
+		double alpha {0.};
+		bool valid {false};
+	};
+
 	SurfaceHandle surface;
 	ContextHandle cr;
+	DrawState drawState;
+	SourceColor sourceColor;
+	bool dashApplied {false};
 };
 
 //------------------------------------------------------------------------
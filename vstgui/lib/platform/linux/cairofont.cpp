@@ -9,8 +9,15 @@
 #include <cairo/cairo-ft.h>
 #include <fontconfig/fontconfig.h>
 #include <freetype2/ft2build.h>
+#include <sys/stat.h>
 #include <unordered_map>
+#include <algorithm>
 #include <cassert>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <list>
+#include <vector>
 
 #include FT_FREETYPE_H
 
@@ -76,6 +83,8 @@ struct CairoFontFace
 	CairoFontFace () noexcept {}
 	CairoFontFace (const std::string& path) : path (path) {}
 
+	const std::string& getPath () const { return path; }
+
 	CairoFontFace (const CairoFontFace& o) { assert (false); }
 	CairoFontFace& operator= (const CairoFontFace& o) = delete;
 
@@ -107,6 +116,21 @@ private:
 	std::string path;
 };
 
+//------------------------------------------------------------------------
+struct CatalogSettings
+{
+	FontCatalog::Mode mode {FontCatalog::Mode::Full};
+	std::string cachePath;
+	bool cachePathSet {false};
+	FontCatalog::Statistics statistics;
+
+	static CatalogSettings& instance ()
+	{
+		static CatalogSettings gInstance;
+		return gInstance;
+	}
+};
+
 //------------------------------------------------------------------------
 class FontList
 {
@@ -124,29 +148,78 @@ public:
 
 	using Fonts = std::unordered_map<std::string, FontFamily>;
 
-	std::vector<std::string> fontFamilyNames ()
+	/** all installed font families, loads the complete catalog in lazy mode */
+	const Fonts& getFonts ()
 	{
-		std::vector<std::string> result;
-		for (auto e : fonts)
-			result.push_back (e.first);
-		return result;
+		if (!catalogLoaded)
+			loadCatalog ();
+		return fonts;
 	}
 
-	const Fonts& getFonts () const { return fonts; }
+	/** in lazy mode only the requested family is resolved */
+	const FontFamily* findFamily (const std::string& name)
+	{
+		if (!catalogLoaded)
+		{
+			if (CatalogSettings::instance ().mode == FontCatalog::Mode::Lazy)
+				resolveFamily (name);
+			else
+				loadCatalog ();
+		}
+		auto it = fonts.find (name);
+		if (it == fonts.end () || it->second.styles.empty ())
+			return nullptr;
+		return &it->second;
+	}
 
-	void clear () { fonts.clear (); }
+	/** the font faces are kept alive, as the scaled fonts created from them reference them */
+	void reset ()
+	{
+		retireFonts ();
+		catalogLoaded = false;
+		if (lazyConfig)
+			FcConfigDestroy (lazyConfig);
+		lazyConfig = nullptr;
+	}
+
+	void clear ()
+	{
+		reset ();
+		retiredFonts.clear ();
+	}
 
 private:
-	FontList ()
+	FontList () = default;
+	~FontList ()
 	{
-		FcInit ();
-		auto config = FcInitLoadConfigAndFonts ();
-		auto pattern = FcPatternCreate ();
-		auto objectSet = FcObjectSetBuild (FC_FAMILY, FC_FILE, FC_STYLE, nullptr);
-		auto fontList = FcFontList (config, pattern, objectSet);
-		for (auto i = 0; i < fontList->nfont; ++i)
+		if (lazyConfig)
+			FcConfigDestroy (lazyConfig);
+	}
+
+	size_t countFamilies () const
+	{
+		return static_cast<size_t> (std::count_if (fonts.begin (), fonts.end (), [] (const Fonts::value_type& e) {
+			return !e.second.styles.empty ();
+		}));
+	}
+
+	void retireFonts ()
+	{
+		if (!fonts.empty ())
+			retiredFonts.emplace_back (std::move (fonts));
+		fonts.clear ();
+	}
+
+	void addFont (const std::string& family, const std::string& style, const std::string& file)
+	{
+		fonts[family].styles.emplace (style, CairoFontFace {file});
+	}
+
+	void addFonts (FcFontSet* fontSet, const std::string* familyName = nullptr)
+	{
+		for (auto i = 0; i < fontSet->nfont; ++i)
 		{
-			auto font = fontList->fonts[i];
+			auto font = fontSet->fonts[i];
 			FcChar8* family;
 			FcChar8* file;
 			FcChar8* style;
@@ -154,31 +227,174 @@ private:
 				FcPatternGetString (font, FC_FILE, 0, &file) == FcResultMatch &&
 				FcPatternGetString (font, FC_STYLE, 0, &style) == FcResultMatch)
 			{
-				std::string familyStr (reinterpret_cast<const char*> (family));
-				std::string fileStr (reinterpret_cast<const char*> (file));
-				std::string styleStr (reinterpret_cast<const char*> (style));
-				auto it = fonts.find (familyStr);
-				if (it == fonts.end ())
-				{
-					FontFamily fam;
-					fam.styles.emplace (styleStr, CairoFontFace {fileStr});
-					fonts.emplace (familyStr, std::move (fam));
-				}
-				else
-					it->second.styles.emplace (styleStr, CairoFontFace {fileStr});
+				addFont (familyName ? *familyName : reinterpret_cast<const char*> (family),
+						 reinterpret_cast<const char*> (style), reinterpret_cast<const char*> (file));
 			}
 		}
-		FcFontSetDestroy (fontList);
+	}
+
+	static FcFontSet* listFonts (FcConfig* config, FcPattern* pattern)
+	{
+		auto objectSet = FcObjectSetBuild (FC_FAMILY, FC_FILE, FC_STYLE, nullptr);
+		auto fontSet = FcFontList (config, pattern, objectSet);
 		FcObjectSetDestroy (objectSet);
-		FcPatternDestroy (pattern);
+		return fontSet;
+	}
+
+	/** appends the paths and modification times of the list entries to key, the list is consumed */
+	static void appendModificationTimes (std::string& key, FcStrList* list)
+	{
+		if (!list)
+			return;
+		while (auto entry = FcStrListNext (list))
+		{
+			struct stat entryStat;
+			if (stat (reinterpret_cast<const char*> (entry), &entryStat) != 0)
+				continue;
+			key += reinterpret_cast<const char*> (entry);
+			key += '=' + std::to_string (entryStat.st_mtim.tv_sec) + '.' +
+				   std::to_string (entryStat.st_mtim.tv_nsec) + ';';
+		}
+		FcStrListDone (list);
+	}
+
+	/** the modification times of the font directories, the configuration files and the
+	 *	fontconfig cache directories. A font directory changes when fonts are installed or
+	 *	removed, even if fontconfig has not updated its caches yet.
+	 */
+	static std::string cacheKey (FcConfig* config)
+	{
+		std::string key;
+		appendModificationTimes (key, FcConfigGetFontDirs (config));
+		appendModificationTimes (key, FcConfigGetConfigFiles (config));
+		appendModificationTimes (key, FcConfigGetCacheDirs (config));
+		return key;
+	}
+
+	bool readCatalogCache (const std::string& path, const std::string& key)
+	{
+		std::ifstream stream (path);
+		std::string line;
+		if (!std::getline (stream, line) || line != kCatalogCacheHeader)
+			return false;
+		if (!std::getline (stream, line) || line != key)
+			return false;
+		while (std::getline (stream, line))
+		{
+			auto pos1 = line.find ('\t');
+			auto pos2 = line.find ('\t', pos1 + 1);
+			if (pos1 == std::string::npos || pos2 == std::string::npos)
+			{
+				fonts.clear ();
+				return false;
+			}
+			addFont (line.substr (0, pos1), line.substr (pos1 + 1, pos2 - pos1 - 1),
+					 line.substr (pos2 + 1));
+		}
+		return true;
+	}
+
+	void writeCatalogCache (const std::string& path, const std::string& key) const
+	{
+		auto dirEnd = path.rfind ('/');
+		if (dirEnd != std::string::npos && dirEnd > 0)
+			createDirectories (path.substr (0, dirEnd));
+		auto tmpPath = path + ".tmp";
+		{
+			std::ofstream stream (tmpPath, std::ios::trunc);
+			if (!stream)
+				return;
+			stream << kCatalogCacheHeader << '\n' << key << '\n';
+			for (auto& family : fonts)
+			{
+				for (auto& style : family.second.styles)
+					stream << family.first << '\t' << style.first << '\t' << style.second.getPath ()
+						   << '\n';
+			}
+			if (!stream)
+				return;
+		}
+		rename (tmpPath.data (), path.data ());
+	}
+
+	static void createDirectories (const std::string& path)
+	{
+		for (auto pos = path.find ('/', 1); ; pos = path.find ('/', pos + 1))
+		{
+			mkdir (path.substr (0, pos).data (), 0755);
+			if (pos == std::string::npos)
+				break;
+		}
+	}
+
+	void loadCatalog ()
+	{
+		auto& settings = CatalogSettings::instance ();
+		auto start = std::chrono::steady_clock::now ();
+		retireFonts ();
+		settings.statistics = {};
+		catalogLoaded = true;
+		const auto& cachePath = FontCatalog::getCachePath ();
+		auto config = FcInitLoadConfig ();
+		if (!config)
+			return;
+		auto key = cacheKey (config);
+		if (!cachePath.empty () && !key.empty () && readCatalogCache (cachePath, key))
+		{
+			settings.statistics.loadedFromCache = true;
+		}
+		else if (FcConfigBuildFonts (config))
+		{
+			auto pattern = FcPatternCreate ();
+			auto fontSet = listFonts (config, pattern);
+			addFonts (fontSet);
+			FcFontSetDestroy (fontSet);
+			FcPatternDestroy (pattern);
+			if (!cachePath.empty () && !key.empty ())
+				writeCatalogCache (cachePath, key);
+		}
 		FcConfigDestroy (config);
+		settings.statistics.numFamilies = countFamilies ();
+		settings.statistics.loadTime = std::chrono::duration<double, std::milli> (
+										   std::chrono::steady_clock::now () - start)
+										   .count ();
+	}
+
+	void resolveFamily (const std::string& name)
+	{
+		if (fonts.find (name) != fonts.end ())
+			return;
+		auto& settings = CatalogSettings::instance ();
+		auto start = std::chrono::steady_clock::now ();
+		if (!lazyConfig)
+			lazyConfig = FcInitLoadConfigAndFonts ();
+		if (lazyConfig)
+		{
+			auto pattern = FcPatternCreate ();
+			FcPatternAddString (pattern, FC_FAMILY, reinterpret_cast<const FcChar8*> (name.data ()));
+			auto fontSet = listFonts (lazyConfig, pattern);
+			addFonts (fontSet, &name);
+			FcFontSetDestroy (fontSet);
+			FcPatternDestroy (pattern);
+		}
+		fonts[name]; // remember the family even if it is not installed
+		++settings.statistics.numResolvedFamilies;
+		settings.statistics.numFamilies = countFamilies ();
+		settings.statistics.loadTime += std::chrono::duration<double, std::milli> (
+											std::chrono::steady_clock::now () - start)
+											.count ();
 	}
 
-	~FontList () {}
+	static constexpr auto kCatalogCacheHeader = "vstgui-font-catalog 1";
 
 	Fonts fonts;
+	std::vector<Fonts> retiredFonts;
+	FcConfig* lazyConfig {nullptr};
+	bool catalogLoaded {false};
 };
 
+constexpr decltype (FontList::kCatalogCacheHeader) FontList::kCatalogCacheHeader;
+
 //------------------------------------------------------------------------
 FreeType& FreeType::instance ()
 {
@@ -211,6 +427,141 @@ FreeType::~FreeType ()
 		FT_Done_FreeType (library);
 }
 
+//------------------------------------------------------------------------
+struct GlyphRun
+{
+	/** glyph positions relative to the origin of the string */
+	std::vector<cairo_glyph_t> glyphs;
+	double advance {0.};
+};
+
+//------------------------------------------------------------------------
+class GlyphRunLRUCache
+{
+public:
+	static GlyphRunLRUCache& instance ()
+	{
+		static GlyphRunLRUCache gInstance;
+		return gInstance;
+	}
+
+	/** returns nullptr if the string could not be converted to glyphs */
+	const GlyphRun* get (const ScaledFontHandle& font, const std::string& str)
+	{
+		auto fontIt = fonts.find (font);
+		if (fontIt != fonts.end ())
+		{
+			auto it = fontIt->second.find (str);
+			if (it != fontIt->second.end ())
+			{
+				++statistics.hits;
+				entries.splice (entries.begin (), entries, it->second);
+				return &it->second->run;
+			}
+		}
+		++statistics.misses;
+		Entry entry;
+		if (!shape (font, str, entry.run))
+			return nullptr;
+		if (capacity == 0)
+		{
+			uncachedRun = std::move (entry.run);
+			return &uncachedRun;
+		}
+		if (entries.size () >= capacity)
+		{
+			evictLast ();
+			fontIt = fonts.find (font);
+		}
+		if (fontIt == fonts.end ())
+			fontIt = fonts.emplace (font, RunMap ()).first;
+		entry.font = font;
+		entries.emplace_front (std::move (entry));
+		auto it = fontIt->second.emplace (str, entries.begin ()).first;
+		entries.front ().str = &it->first;
+		statistics.numRuns = entries.size ();
+		return &entries.front ().run;
+	}
+
+	void setCapacity (size_t numRuns)
+	{
+		capacity = numRuns;
+		while (entries.size () > capacity)
+			evictLast ();
+		statistics.numRuns = entries.size ();
+	}
+	size_t getCapacity () const { return capacity; }
+
+	/** returns the glyphs of the run moved to the origin, valid until the next call */
+	const std::vector<cairo_glyph_t>& position (const GlyphRun& run, const CPoint& origin)
+	{
+		positionedGlyphs.resize (run.glyphs.size ());
+		for (auto i = 0u; i < run.glyphs.size (); ++i)
+		{
+			positionedGlyphs[i].index = run.glyphs[i].index;
+			positionedGlyphs[i].x = run.glyphs[i].x + origin.x;
+			positionedGlyphs[i].y = run.glyphs[i].y + origin.y;
+		}
+		return positionedGlyphs;
+	}
+
+	const Cairo::GlyphRunCache::Statistics& getStatistics () const { return statistics; }
+
+	void clear ()
+	{
+		fonts.clear ();
+		entries.clear ();
+		statistics = {};
+	}
+
+private:
+	struct Entry
+	{
+		/** keeps the scaled font alive, so that its address can not be reused by another font */
+		ScaledFontHandle font;
+		const std::string* str {nullptr};
+		GlyphRun run;
+	};
+	using EntryList = std::list<Entry>;
+	using RunMap = std::unordered_map<std::string, EntryList::iterator>;
+
+	static bool shape (cairo_scaled_font_t* font, const std::string& str, GlyphRun& run)
+	{
+		cairo_glyph_t* glyphs = nullptr;
+		int numGlyphs = 0;
+		auto status = cairo_scaled_font_text_to_glyphs (font, 0., 0., str.data (),
+														static_cast<int> (str.size ()), &glyphs,
+														&numGlyphs, nullptr, nullptr, nullptr);
+		if (status != CAIRO_STATUS_SUCCESS)
+			return false;
+		cairo_text_extents_t extents {};
+		cairo_scaled_font_glyph_extents (font, glyphs, numGlyphs, &extents);
+		run.glyphs.assign (glyphs, glyphs + numGlyphs);
+		run.advance = extents.x_advance;
+		cairo_glyph_free (glyphs);
+		return true;
+	}
+
+	void evictLast ()
+	{
+		if (entries.empty ())
+			return;
+		auto& entry = entries.back ();
+		auto fontIt = fonts.find (entry.font);
+		fontIt->second.erase (*entry.str);
+		if (fontIt->second.empty ())
+			fonts.erase (fontIt);
+		entries.pop_back ();
+	}
+
+	EntryList entries;
+	std::unordered_map<cairo_scaled_font_t*, RunMap> fonts;
+	size_t capacity {1024};
+	GlyphRun uncachedRun;
+	std::vector<cairo_glyph_t> positionedGlyphs;
+	Cairo::GlyphRunCache::Statistics statistics;
+};
+
 //------------------------------------------------------------------------
 } // anonymous
 
@@ -225,19 +576,19 @@ struct Font::Impl
 Font::Font (UTF8StringPtr name, const CCoord& size, const int32_t& style)
 {
 	impl = std::unique_ptr<Impl> (new Impl);
-	auto& map = FontList::instance ().getFonts ();
-	auto it = map.find (name);
-	if (it == map.end ())
+	auto& fontList = FontList::instance ();
+	auto family = fontList.findFamily (name);
+	if (!family)
 	{
 		static constexpr auto defaults = {"Liberation Sans", "Noto Sans", "Ubuntu", "FreeSans"};
 		for (auto& defName : defaults)
 		{
-			it = map.find (defName); // default font
-			if (it != map.end ())
+			family = fontList.findFamily (defName); // default font
+			if (family)
 				break;
 		}
 	}
-	if (it != map.end ())
+	if (family)
 	{
 		cairo_matrix_t matrix, ctm;
 		cairo_matrix_init_scale (&matrix, size, size);
@@ -246,21 +597,21 @@ Font::Font (UTF8StringPtr name, const CCoord& size, const int32_t& style)
 		cairo_font_options_set_hint_style (options, CAIRO_HINT_STYLE_NONE);
 		cairo_font_options_set_hint_metrics (options, CAIRO_HINT_METRICS_ON);
 
-		auto styleIt = it->second.styles.find ("Regular");
+		auto styleIt = family->styles.find ("Regular");
 		if (style & kBoldFace)
 		{
 			if (style & kItalicFace)
-				styleIt = it->second.styles.find ("Bold Italic");
+				styleIt = family->styles.find ("Bold Italic");
 			else
-				styleIt = it->second.styles.find ("Bold");
+				styleIt = family->styles.find ("Bold");
 		}
 		else if (style & kItalicFace)
 		{
-			styleIt = it->second.styles.find ("Italic");
+			styleIt = family->styles.find ("Italic");
 		}
-		if (styleIt == it->second.styles.end ())
-			styleIt = it->second.styles.find ("Regular");
-		if (styleIt != it->second.styles.end ())
+		if (styleIt == family->styles.end ())
+			styleIt = family->styles.find ("Regular");
+		if (styleIt != family->styles.end ())
 		{
 			impl->font = ScaledFontHandle (
 				cairo_scaled_font_create (styleIt->second, &matrix, &ctm, options));
@@ -331,14 +682,20 @@ void Font::drawString (CDrawContext* context, IPlatformString* string, const CPo
 		{
 			if (auto linuxString = dynamic_cast<LinuxString*> (string))
 			{
-				auto color = cairoContext->getFontColor ();
 				const auto& cr = cairoContext->getCairo ();
-				auto alpha = color.alpha * cairoContext->getGlobalAlpha ();
-				cairo_set_source_rgba (cr, color.red / 255., color.green / 255., color.blue / 255.,
-									   alpha);
-				cairo_move_to (cr, p.x, p.y);
+				cairoContext->setSourceColor (cairoContext->getFontColor ());
 				cairo_set_scaled_font (cr, impl->font);
-				cairo_show_text (cr, linuxString->get ().data ());
+				auto& cache = GlyphRunLRUCache::instance ();
+				if (auto run = cache.get (impl->font, linuxString->get ()))
+				{
+					const auto& glyphs = cache.position (*run, p);
+					cairo_show_glyphs (cr, glyphs.data (), static_cast<int> (glyphs.size ()));
+				}
+				else
+				{
+					cairo_move_to (cr, p.x, p.y);
+					cairo_show_text (cr, linuxString->get ().data ());
+				}
 			}
 		}
 	}
@@ -349,6 +706,8 @@ CCoord Font::getStringWidth (CDrawContext* context, IPlatformString* string, boo
 {
 	if (auto linuxString = dynamic_cast<LinuxString*> (string))
 	{
+		if (auto run = GlyphRunLRUCache::instance ().get (impl->font, linuxString->get ()))
+			return run->advance;
 		cairo_text_extents_t e;
 		cairo_scaled_font_text_extents (impl->font, linuxString->get ().data (), &e);
 		return e.x_advance;
@@ -356,6 +715,90 @@ CCoord Font::getStringWidth (CDrawContext* context, IPlatformString* string, boo
 	return 0;
 }
 
+//------------------------------------------------------------------------
+namespace FontCatalog {
+
+//------------------------------------------------------------------------
+void setMode (Mode mode)
+{
+	CatalogSettings::instance ().mode = mode;
+}
+
+//------------------------------------------------------------------------
+Mode getMode ()
+{
+	return CatalogSettings::instance ().mode;
+}
+
+//------------------------------------------------------------------------
+void setCachePath (const std::string& path)
+{
+	auto& settings = CatalogSettings::instance ();
+	settings.cachePath = path;
+	settings.cachePathSet = true;
+}
+
+//------------------------------------------------------------------------
+const std::string& getCachePath ()
+{
+	auto& settings = CatalogSettings::instance ();
+	if (!settings.cachePathSet)
+	{
+		settings.cachePathSet = true;
+		if (auto xdgCacheHome = getenv ("XDG_CACHE_HOME"))
+			settings.cachePath = xdgCacheHome;
+		else if (auto home = getenv ("HOME"))
+			settings.cachePath = std::string (home) + "/.cache";
+		if (!settings.cachePath.empty ())
+			settings.cachePath += "/vstgui/fontcatalog";
+	}
+	return settings.cachePath;
+}
+
+//------------------------------------------------------------------------
+const Statistics& getStatistics ()
+{
+	return CatalogSettings::instance ().statistics;
+}
+
+//------------------------------------------------------------------------
+void reset ()
+{
+	FontList::instance ().reset ();
+	CatalogSettings::instance ().statistics = {};
+}
+
+} // FontCatalog
+
+//------------------------------------------------------------------------
+namespace GlyphRunCache {
+
+//------------------------------------------------------------------------
+void setCapacity (size_t numRuns)
+{
+	GlyphRunLRUCache::instance ().setCapacity (numRuns);
+}
+
+//------------------------------------------------------------------------
+size_t getCapacity ()
+{
+	return GlyphRunLRUCache::instance ().getCapacity ();
+}
+
+//------------------------------------------------------------------------
+const Statistics& getStatistics ()
+{
+	return GlyphRunLRUCache::instance ().getStatistics ();
+}
+
+//------------------------------------------------------------------------
+void clear ()
+{
+	GlyphRunLRUCache::instance ().clear ();
+}
+
+} // GlyphRunCache
+
 //------------------------------------------------------------------------
 } // Cairo
 
@@ -6,6 +6,7 @@
 
 #include "../iplatformfont.h"
 #include <memory>
+#include <string>
 
 //------------------------------------------------------------------------
 namespace VSTGUI {
@@ -36,6 +37,71 @@ private:
 	std::unique_ptr<Impl> impl;
 };
 
+//------------------------------------------------------------------------
+/** Settings and statistics of the fontconfig font catalog */
+namespace FontCatalog {
+
+//------------------------------------------------------------------------
+enum class Mode
+{
+	/** list all installed fonts on first use, or read them from the catalog cache if it is valid */
+	Full,
+	/** only resolve the requested font families via fontconfig */
+	Lazy
+};
+
+/** must be set before the first font is created or after a reset */
+void setMode (Mode mode);
+Mode getMode ();
+
+/** the catalog cache is written after a full font listing and is valid as long as the
+ *	fontconfig cache directories are unchanged. An empty path disables the cache.
+ *	Defaults to $XDG_CACHE_HOME/vstgui/fontcatalog.
+ */
+void setCachePath (const std::string& path);
+const std::string& getCachePath ();
+
+struct Statistics
+{
+	/** time to load the catalog in milliseconds */
+	double loadTime {0.};
+	size_t numFamilies {0};
+	/** number of font families resolved in lazy mode */
+	size_t numResolvedFamilies {0};
+	bool loadedFromCache {false};
+};
+const Statistics& getStatistics ();
+
+/** forget the loaded catalog, the next font creation loads it again. Fonts created before stay valid. */
+void reset ();
+
+} // FontCatalog
+
+//------------------------------------------------------------------------
+/** Least recently used cache of the shaped glyph runs and advances of drawn and measured strings
+ *
+ *	The cache is keyed by the cairo scaled font and the UTF-8 string and is shared between all
+ *	fonts. It must only be used from the UI thread.
+ */
+namespace GlyphRunCache {
+
+/** maximum number of cached glyph runs, zero disables the cache. Defaults to 1024. */
+void setCapacity (size_t numRuns);
+size_t getCapacity ();
+
+struct Statistics
+{
+	uint64_t hits {0};
+	uint64_t misses {0};
+	size_t numRuns {0};
+};
+const Statistics& getStatistics ();
+
+/** remove all cached glyph runs and reset the statistics */
+void clear ();
+
+} // GlyphRunCache
+
 //------------------------------------------------------------------------
 } // Cairo
 } // VSTGUI
@@ -5,6 +5,8 @@
 #include "x11frame.h"
 #include "../../cbuttonstate.h"
 #include "../../cframe.h"
+#include "../../cframeclock.h"
+#include "../../cinvalidrectlist.h"
 #include "../../crect.h"
 #include "../../dragging.h"
 #include "../../vstkeycode.h"
@@ -21,6 +23,7 @@
 #include "x11utils.h"
 #include <cassert>
 #include <iostream>
+#include <memory>
 #include <unordered_map>
 #include <X11/Xlib.h>
 #include <xcb/xcb.h>
@@ -95,29 +98,6 @@ inline uint32_t translateModifiers (int state)
 //------------------------------------------------------------------------
 } // anonymous
 
-//------------------------------------------------------------------------
-struct RedrawTimerHandler
-	: ITimerHandler
-	, NonAtomicReferenceCounted
-{
-	using RedrawCallback = std::function<void()>;
-
-	RedrawTimerHandler (uint64_t delay, RedrawCallback&& redrawCallback)
-		: redrawCallback (std::move (redrawCallback))
-	{
-		RunLoop::instance ().get ()->registerTimer (delay, this);
-	}
-	~RedrawTimerHandler () noexcept { RunLoop::instance ().get ()->unregisterTimer (this); }
-
-	void onTimer () override
-	{
-		SharedPointer<RedrawTimerHandler> Self (this);
-		Self->redrawCallback ();
-	}
-
-	RedrawCallback redrawCallback;
-};
-
 //------------------------------------------------------------------------
 struct DrawHandler
 {
@@ -140,10 +120,9 @@ struct DrawHandler
 		drawContext = makeOwned<Cairo::Context> (r, backBuffer);
 	}
 
-	template<typename RectList, typename Proc>
-	void draw (const RectList& dirtyRects, Proc proc)
+	template<typename Proc>
+	void draw (const CInvalidRectList& dirtyRects, Proc proc)
 	{
-		CRect copyRect;
 		drawContext->beginDraw ();
 		for (auto rect : dirtyRects)
 		{
@@ -151,13 +130,32 @@ struct DrawHandler
 			drawContext->saveGlobalState ();
 			proc (drawContext, rect);
 			drawContext->restoreGlobalState ();
-			if (copyRect.isEmpty ())
-				copyRect = rect;
-			else
-				copyRect.unite (rect);
 		}
 		drawContext->endDraw ();
-		blitBackbufferToWindow (copyRect);
+		blitBackbufferToWindow (dirtyRects);
+		xcb_flush (RunLoop::instance ().getXcbConnection ());
+	}
+
+	void scroll (const CRect& src, const CPoint& distance)
+	{
+		CRect dest (src);
+		dest.offset (distance);
+		Cairo::ContextHandle context (cairo_create (backBuffer));
+		cairo_rectangle (context, dest.left, dest.top, dest.getWidth (), dest.getHeight ());
+		cairo_clip (context);
+		// cairo does not support a surface being source and destination at the same time, so
+		// the pixels are copied via an intermediate group surface of the size of dest
+		cairo_push_group (context);
+		cairo_set_source_surface (context, backBuffer, distance.x, distance.y);
+		cairo_paint (context);
+		cairo_pop_group_to_source (context);
+		cairo_set_operator (context, CAIRO_OPERATOR_SOURCE);
+		cairo_paint (context);
+		cairo_surface_flush (backBuffer);
+
+		CInvalidRectList blitRects;
+		blitRects.add (dest);
+		blitBackbufferToWindow (blitRects);
 		xcb_flush (RunLoop::instance ().getXcbConnection ());
 	}
 
@@ -166,14 +164,16 @@ private:
 	Cairo::SurfaceHandle backBuffer;
 	SharedPointer<Cairo::Context> drawContext;
 
-	void blitBackbufferToWindow (const CRect& rect)
+	void blitBackbufferToWindow (const CInvalidRectList& rects)
 	{
 		Cairo::ContextHandle windowContext (cairo_create (windowSurface));
-		cairo_rectangle (windowContext, rect.left, rect.top, rect.getWidth (), rect.getHeight ());
+		// the rects never overlap, so only the dirty pixels are copied
+		for (const auto& rect : rects)
+			cairo_rectangle (windowContext, rect.left, rect.top, rect.getWidth (),
+							 rect.getHeight ());
 		cairo_clip (windowContext);
 		cairo_set_source_surface (windowContext, backBuffer, 0, 0);
-		cairo_rectangle (windowContext, rect.left, rect.top, rect.getWidth (), rect.getHeight ());
-		cairo_fill (windowContext);
+		cairo_paint (windowContext);
 		cairo_surface_flush (windowSurface);
 	}
 };
@@ -250,28 +250,36 @@ private:
 };
 
 //------------------------------------------------------------------------
-struct Frame::Impl : IFrameEventHandler
+struct Frame::Impl : IFrameEventHandler, IFrameClockHandler
 {
-	using RectList = std::vector<CRect>;
-
 	ChildWindow window;
 	DrawHandler drawHandler;
 	DoubleClickDetector doubleClickDetector;
 	IPlatformFrameCallback* frame;
-	SharedPointer<RedrawTimerHandler> redrawTimer;
-	RectList dirtyRects;
+	bool paintScheduled{false};
+	CInvalidRectList dirtyRects;
+	RedrawStatistics redrawStatistics;
 	CCursorType currentCursor{kCursorDefault};
 	uint32_t pointerGrabed{0};
+	std::unique_ptr<CDirtyViewInvalidator> dirtyViewInvalidator;
 
 	//------------------------------------------------------------------------
 	Impl (::Window parent, CPoint size, IPlatformFrameCallback* frame)
 		: window (parent, size), drawHandler (window), frame (frame)
 	{
 		RunLoop::instance ().registerWindowEventHandler (window.getID (), this);
+		if (auto cframe = dynamic_cast<CFrame*> (frame))
+			dirtyViewInvalidator = std::unique_ptr<CDirtyViewInvalidator> (new CDirtyViewInvalidator (cframe));
 	}
 
 	//------------------------------------------------------------------------
-	~Impl () noexcept { RunLoop::instance ().unregisterWindowEventHandler (window.getID ()); }
+	~Impl () noexcept
+	{
+		dirtyViewInvalidator = nullptr;
+		if (paintScheduled)
+			CFrameClock::instance ().remove (CFrameClock::Phase::paint, this);
+		RunLoop::instance ().unregisterWindowEventHandler (window.getID ());
+	}
 
 	//------------------------------------------------------------------------
 	void setSize (const CRect& size)
@@ -279,7 +287,8 @@ struct Frame::Impl : IFrameEventHandler
 		window.setSize (size);
 		drawHandler.onSizeChanged (size.getSize ());
 		dirtyRects.clear ();
-		dirtyRects.push_back (size);
+		dirtyRects.add (size);
+		schedulePaint ();
 	}
 
 	//------------------------------------------------------------------------
@@ -305,6 +314,8 @@ struct Frame::Impl : IFrameEventHandler
 	//------------------------------------------------------------------------
 	void redraw ()
 	{
+		++redrawStatistics.numRedraws;
+		redrawStatistics.numDrawnRects += dirtyRects.size ();
 		drawHandler.draw (dirtyRects, [&](CDrawContext* context, const CRect& rect) {
 			frame->platformDrawRect (context, rect);
 		});
@@ -314,14 +325,76 @@ struct Frame::Impl : IFrameEventHandler
 	//------------------------------------------------------------------------
 	void invalidRect (CRect r)
 	{
-		dirtyRects.emplace_back (r);
-		if (redrawTimer)
+		++redrawStatistics.numInvalidRects;
+		dirtyRects.add (r);
+		schedulePaint ();
+	}
+
+	//------------------------------------------------------------------------
+	/** the dirty rects are painted in the next tick of the frame clock, after the animations and
+	 *	idle views had the chance to invalidate more areas */
+	void schedulePaint ()
+	{
+		if (paintScheduled)
 			return;
-		redrawTimer = makeOwned<RedrawTimerHandler> (16, [this]() {
-			if (dirtyRects.empty ())
-				return;
+		paintScheduled = true;
+		CFrameClock::instance ().add (CFrameClock::Phase::paint, this);
+	}
+
+	//------------------------------------------------------------------------
+	void onFrameClockTick (CFrameClock::Phase phase) override
+	{
+		if (!dirtyRects.empty ())
 			redraw ();
-		});
+		if (dirtyRects.empty ())
+		{
+			paintScheduled = false;
+			CFrameClock::instance ().remove (CFrameClock::Phase::paint, this);
+		}
+	}
+
+	//------------------------------------------------------------------------
+	bool scrollRect (const CRect& src, const CPoint& distance)
+	{
+		CRect windowRect;
+		windowRect.setSize (window.getSize ());
+		CRect srcRect (src);
+		srcRect.bound (windowRect);
+		CRect dest (srcRect);
+		dest.offset (distance);
+		dest.bound (windowRect);
+		if (dest.isEmpty ())
+			return false;
+		srcRect = dest;
+		srcRect.offset (-distance.x, -distance.y);
+
+		// areas not yet drawn into the back buffer are moved together with the pixels
+		std::vector<CRect> movedDirtyRects;
+		for (const auto& r : dirtyRects)
+		{
+			CRect moved (r);
+			moved.bound (srcRect);
+			if (moved.isEmpty ())
+				continue;
+			moved.offset (distance);
+			movedDirtyRects.emplace_back (moved);
+		}
+
+		drawHandler.scroll (srcRect, distance);
+		++redrawStatistics.numScrolls;
+
+		for (const auto& r : movedDirtyRects)
+			invalidRect (r);
+
+		// invalidate the area uncovered by the scroll operation
+		CRect scrollArea (srcRect);
+		scrollArea.unite (dest);
+		CInvalidRectList exposedRects (0.);
+		exposedRects.add (scrollArea);
+		exposedRects.subtract (dest);
+		for (const auto& r : exposedRects)
+			invalidRect (r);
+		return true;
 	}
 
 	//------------------------------------------------------------------------
@@ -568,6 +641,8 @@ Frame::Frame (IPlatformFrameCallback* frame,
 	}
 
 	impl = std::unique_ptr<Impl> (new Impl (parent, {size.getWidth (), size.getHeight ()}, frame));
+	if (cfg && cfg->compressMotionEvents)
+		RunLoop::instance ().setCompressMotionEvents (impl->window.getID (), true);
 
 	frame->platformOnActivate (true);
 }
@@ -641,9 +716,7 @@ bool Frame::invalidRect (const CRect& rect)
 //------------------------------------------------------------------------
 bool Frame::scrollRect (const CRect& src, const CPoint& distance)
 {
-	(void)src;
-	(void)distance;
-	return false;
+	return impl->scrollRect (src, distance);
 }
 
 //------------------------------------------------------------------------
@@ -672,6 +745,12 @@ uint32_t Frame::getX11WindowID () const
 	return impl->window.getID ();
 }
 
+//------------------------------------------------------------------------
+RedrawStatistics Frame::getRedrawStatistics () const
+{
+	return impl->redrawStatistics;
+}
+
 //------------------------------------------------------------------------
 SharedPointer<IPlatformTextEdit> Frame::createPlatformTextEdit (IPlatformTextEditCallback* textEdit)
 {
@@ -765,6 +844,8 @@ Frame::CreateIResourceInputStreamFunc Frame::createResourceInputStreamFunc =
 	auto path = Platform::getInstance ().getPath ();
 	path += "/Contents/Resources/";
 	path += desc.u.name;
+	if (auto stream = MappedFileResourceInputStream::create (path))
+		return stream;
 	return FileResourceInputStream::create (path);
 };
 
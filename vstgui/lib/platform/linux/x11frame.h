@@ -70,6 +70,7 @@ private:
 	Optional<UTF8String> convertCurrentKeyEventToText () override;
 
 	uint32_t getX11WindowID () const override;
+	RedrawStatistics getRedrawStatistics () const override;
 
 	void optionMenuPopupStarted () override;
 	void optionMenuPopupStopped () override;
@@ -3,6 +3,7 @@
 // distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
 
 #include "x11platform.h"
+#include "../../cbitmapfilter.h"
 #include "../../cfileselector.h"
 #include "../../cframe.h"
 #include "../../cstring.h"
@@ -16,6 +17,7 @@
 #include <locale>
 #include <link.h>
 #include <unordered_map>
+#include <unordered_set>
 #include <codecvt>
 #include <xcb/xcb.h>
 #include <xcb/xcb_cursor.h>
@@ -184,6 +186,8 @@ struct RunLoop::Impl : IEventHandler
 	std::array<xcb_cursor_t, CCursorType::kCursorIBeam + 1> cursors{{XCB_CURSOR_NONE}};
 	VstKeyCode lastUnprocessedKeyEvent;
 	uint32_t lastUtf32KeyEventChar{0};
+	EventStatistics eventStatistics;
+	std::unordered_set<uint32_t> compressMotionEventWindows;
 
 	void init (const SharedPointer<IRunLoop>& inRunLoop)
 	{
@@ -214,6 +218,7 @@ struct RunLoop::Impl : IEventHandler
 	{
 		if (--useCount != 0)
 			return;
+		BitmapFilter::Tiling::stopWorkers ();
 		if (xcbConnection)
 		{
 			if (xkbUnprocessedState)
@@ -246,6 +251,7 @@ struct RunLoop::Impl : IEventHandler
 		auto it = windowEventHandlerMap.find (windowId);
 		if (it == windowEventHandlerMap.end ())
 			return;
+		++eventStatistics.numDispatchedEvents;
 		it->second->onEvent (event);
 	}
 
@@ -277,104 +283,164 @@ struct RunLoop::Impl : IEventHandler
 		lastUnprocessedKeyEvent = code;
 	}
 
+	//------------------------------------------------------------------------
+	bool compressMotionEvents (const xcb_generic_event_t* event) const
+	{
+		auto ev = reinterpret_cast<const xcb_motion_notify_event_t*> (event);
+		return compressMotionEventWindows.find (ev->event) != compressMotionEventWindows.end ();
+	}
+
+	//------------------------------------------------------------------------
+	static bool canCompressMotionEvents (const xcb_generic_event_t* event1,
+										 const xcb_generic_event_t* event2)
+	{
+		auto ev1 = reinterpret_cast<const xcb_motion_notify_event_t*> (event1);
+		auto ev2 = reinterpret_cast<const xcb_motion_notify_event_t*> (event2);
+		return ev1->event == ev2->event && ev1->state == ev2->state;
+	}
+
+	//------------------------------------------------------------------------
+	void dispatchAndFree (xcb_generic_event_t* event)
+	{
+		handleEvent (event);
+		std::free (event);
+	}
+
+	//------------------------------------------------------------------------
 	void onEvent () override
 	{
+		xcb_generic_event_t* pendingMotionEvent = nullptr;
 		while (auto event = xcb_poll_for_event (xcbConnection))
 		{
-			auto type = event->response_type & ~0x80;
-			switch (type)
+			++eventStatistics.numReceivedEvents;
+			if (!compressMotionEventWindows.empty ())
 			{
-				case XCB_KEY_PRESS:
-				{
-					auto ev = reinterpret_cast<xcb_key_press_event_t*> (event);
-					onKeyEvent (*ev, true);
-					dispatchEvent (*ev, ev->event);
-					break;
-				}
-				case XCB_KEY_RELEASE:
-				{
-					auto ev = reinterpret_cast<xcb_key_release_event_t*> (event);
-					onKeyEvent (*ev, false);
-					dispatchEvent (*ev, ev->event);
-					break;
-				}
-				case XCB_BUTTON_PRESS:
-				{
-					auto ev = reinterpret_cast<xcb_button_press_event_t*> (event);
-					dispatchEvent (*ev, ev->event);
-					break;
-				}
-				case XCB_BUTTON_RELEASE:
-				{
-					auto ev = reinterpret_cast<xcb_button_release_event_t*> (event);
-					dispatchEvent (*ev, ev->event);
-					break;
-				}
-				case XCB_MOTION_NOTIFY:
-				{
-					auto ev = reinterpret_cast<xcb_motion_notify_event_t*> (event);
-					dispatchEvent (*ev, ev->event);
-					break;
-				}
-				case XCB_ENTER_NOTIFY:
-				{
-					auto ev = reinterpret_cast<xcb_enter_notify_event_t*> (event);
-					dispatchEvent (*ev, ev->event);
-					break;
-				}
-				case XCB_LEAVE_NOTIFY:
+				if ((event->response_type & ~0x80) == XCB_MOTION_NOTIFY &&
+					compressMotionEvents (event))
 				{
-					auto ev = reinterpret_cast<xcb_leave_notify_event_t*> (event);
-					dispatchEvent (*ev, ev->event);
-					break;
+					// only the latest of consecutive motion events is dispatched
+					if (pendingMotionEvent)
+					{
+						if (canCompressMotionEvents (pendingMotionEvent, event))
+						{
+							++eventStatistics.numCompressedEvents;
+							std::free (pendingMotionEvent);
+						}
+						else
+							dispatchAndFree (pendingMotionEvent);
+					}
+					pendingMotionEvent = event;
+					continue;
 				}
-				case XCB_EXPOSE:
+				if (pendingMotionEvent)
 				{
-					auto ev = reinterpret_cast<xcb_expose_event_t*> (event);
-					dispatchEvent (*ev, ev->window);
-					break;
-				}
-				case XCB_UNMAP_NOTIFY:
-				{
-					auto ev = reinterpret_cast<xcb_unmap_notify_event_t*> (event);
-					break;
-				}
-				case XCB_MAP_NOTIFY:
-				{
-					auto ev = reinterpret_cast<xcb_map_notify_event_t*> (event);
-					dispatchEvent (*ev, ev->window);
-					break;
-				}
-				case XCB_CONFIGURE_NOTIFY:
-				{
-					auto ev = reinterpret_cast<xcb_configure_notify_event_t*> (event);
-					break;
-				}
-				case XCB_PROPERTY_NOTIFY:
-				{
-					auto ev = reinterpret_cast<xcb_property_notify_event_t*> (event);
-					dispatchEvent (*ev, ev->window);
-					break;
-				}
-				case XCB_CLIENT_MESSAGE:
-				{
-					auto ev = reinterpret_cast<xcb_client_message_event_t*> (event);
-					dispatchEvent (*ev, ev->window);
-					break;
-				}
-				case XCB_FOCUS_IN:
-				case XCB_FOCUS_OUT:
-				{
-					auto ev = reinterpret_cast<xcb_focus_in_event_t*> (event);
-					dispatchEvent (*ev, ev->event);
-					break;
+					dispatchAndFree (pendingMotionEvent);
+					pendingMotionEvent = nullptr;
 				}
 			}
-			std::free (event);
+			dispatchAndFree (event);
 		}
-		xcb_aux_sync (xcbConnection);
+		if (pendingMotionEvent)
+			dispatchAndFree (pendingMotionEvent);
+		// windows which do not compress their motion events get the server round trip
+		if (compressMotionEventWindows.size () < windowEventHandlerMap.size ())
+			xcb_aux_sync (xcbConnection);
 		xcb_flush (xcbConnection);
 	}
+
+	//------------------------------------------------------------------------
+	void handleEvent (xcb_generic_event_t* event)
+	{
+		auto type = event->response_type & ~0x80;
+		switch (type)
+		{
+			case XCB_KEY_PRESS:
+			{
+				auto ev = reinterpret_cast<xcb_key_press_event_t*> (event);
+				onKeyEvent (*ev, true);
+				dispatchEvent (*ev, ev->event);
+				break;
+			}
+			case XCB_KEY_RELEASE:
+			{
+				auto ev = reinterpret_cast<xcb_key_release_event_t*> (event);
+				onKeyEvent (*ev, false);
+				dispatchEvent (*ev, ev->event);
+				break;
+			}
+			case XCB_BUTTON_PRESS:
+			{
+				auto ev = reinterpret_cast<xcb_button_press_event_t*> (event);
+				dispatchEvent (*ev, ev->event);
+				break;
+			}
+			case XCB_BUTTON_RELEASE:
+			{
+				auto ev = reinterpret_cast<xcb_button_release_event_t*> (event);
+				dispatchEvent (*ev, ev->event);
+				break;
+			}
+			case XCB_MOTION_NOTIFY:
+			{
+				auto ev = reinterpret_cast<xcb_motion_notify_event_t*> (event);
+				dispatchEvent (*ev, ev->event);
+				break;
+			}
+			case XCB_ENTER_NOTIFY:
+			{
+				auto ev = reinterpret_cast<xcb_enter_notify_event_t*> (event);
+				dispatchEvent (*ev, ev->event);
+				break;
+			}
+			case XCB_LEAVE_NOTIFY:
+			{
+				auto ev = reinterpret_cast<xcb_leave_notify_event_t*> (event);
+				dispatchEvent (*ev, ev->event);
+				break;
+			}
+			case XCB_EXPOSE:
+			{
+				auto ev = reinterpret_cast<xcb_expose_event_t*> (event);
+				dispatchEvent (*ev, ev->window);
+				break;
+			}
+			case XCB_UNMAP_NOTIFY:
+			{
+				auto ev = reinterpret_cast<xcb_unmap_notify_event_t*> (event);
+				break;
+			}
+			case XCB_MAP_NOTIFY:
+			{
+				auto ev = reinterpret_cast<xcb_map_notify_event_t*> (event);
+				dispatchEvent (*ev, ev->window);
+				break;
+			}
+			case XCB_CONFIGURE_NOTIFY:
+			{
+				auto ev = reinterpret_cast<xcb_configure_notify_event_t*> (event);
+				break;
+			}
+			case XCB_PROPERTY_NOTIFY:
+			{
+				auto ev = reinterpret_cast<xcb_property_notify_event_t*> (event);
+				dispatchEvent (*ev, ev->window);
+				break;
+			}
+			case XCB_CLIENT_MESSAGE:
+			{
+				auto ev = reinterpret_cast<xcb_client_message_event_t*> (event);
+				dispatchEvent (*ev, ev->window);
+				break;
+			}
+			case XCB_FOCUS_IN:
+			case XCB_FOCUS_OUT:
+			{
+				auto ev = reinterpret_cast<xcb_focus_in_event_t*> (event);
+				dispatchEvent (*ev, ev->event);
+				break;
+			}
+		}
+	}
 };
 
 //------------------------------------------------------------------------
@@ -424,6 +490,7 @@ void RunLoop::unregisterWindowEventHandler (uint32_t windowId)
 	if (it == impl->windowEventHandlerMap.end ())
 		return;
 	impl->windowEventHandlerMap.erase (it);
+	impl->compressMotionEventWindows.erase (windowId);
 }
 
 //------------------------------------------------------------------------
@@ -526,6 +593,28 @@ uint32_t RunLoop::getCursorID (CCursorType cursor)
 	return impl->cursors[cursor];
 }
 
+//------------------------------------------------------------------------
+void RunLoop::setCompressMotionEvents (uint32_t windowId, bool state)
+{
+	if (state)
+		impl->compressMotionEventWindows.emplace (windowId);
+	else
+		impl->compressMotionEventWindows.erase (windowId);
+}
+
+//------------------------------------------------------------------------
+bool RunLoop::getCompressMotionEvents (uint32_t windowId) const
+{
+	return impl->compressMotionEventWindows.find (windowId) !=
+		   impl->compressMotionEventWindows.end ();
+}
+
+//------------------------------------------------------------------------
+RunLoop::EventStatistics RunLoop::getEventStatistics () const
+{
+	return impl->eventStatistics;
+}
+
 //------------------------------------------------------------------------
 VstKeyCode RunLoop::getCurrentKeyEvent () const
 {
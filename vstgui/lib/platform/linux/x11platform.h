@@ -74,6 +74,20 @@ struct RunLoop
 	void registerWindowEventHandler (uint32_t windowId, IFrameEventHandler* handler);
 	void unregisterWindowEventHandler (uint32_t windowId);
 
+	/** when enabled, consecutive motion events of the window are compressed to the latest one.
+	 *	If all registered windows compress their motion events the event loop does not do a server
+	 *	round trip after polling the events. Reset when the window event handler is unregistered. */
+	void setCompressMotionEvents (uint32_t windowId, bool state);
+	bool getCompressMotionEvents (uint32_t windowId) const;
+
+	struct EventStatistics
+	{
+		uint64_t numReceivedEvents{0};
+		uint64_t numDispatchedEvents{0};
+		uint64_t numCompressedEvents{0};
+	};
+	EventStatistics getEventStatistics () const;
+
 	uint32_t getCursorID (CCursorType cursor);
 	VstKeyCode getCurrentKeyEvent () const;
 	Optional<UTF8String> convertCurrentKeyEventToText () const;
@@ -40,6 +40,22 @@ class FrameConfig : public IPlatformFrameConfig
 {
 public:
 	SharedPointer<IRunLoop> runLoop;
+	/** compress consecutive mouse motion events of this frame, the round trip to the X server
+	 *	after each event poll is skipped if all frames compress their motion events */
+	bool compressMotionEvents{false};
+};
+
+//------------------------------------------------------------------------
+struct RedrawStatistics
+{
+	/** number of rectangles passed to invalidRect */
+	uint64_t numInvalidRects {0};
+	/** number of rectangles actually drawn after coalescing */
+	uint64_t numDrawnRects {0};
+	/** number of redraw cycles */
+	uint64_t numRedraws {0};
+	/** number of scroll operations done by moving pixels in the back buffer */
+	uint64_t numScrolls {0};
 };
 
 //------------------------------------------------------------------------
@@ -47,6 +63,8 @@ class IX11Frame
 {
 public:
 	virtual uint32_t getX11WindowID () const = 0;
+	/** returns empty statistics if the frame does not record them */
+	virtual RedrawStatistics getRedrawStatistics () const { return {}; }
 };
 
 //------------------------------------------------------------------------
@@ -6,6 +6,7 @@
 
 #if WINDOWS
 
+#include "../../cbitmapfilter.h"
 #include "../../vstkeycode.h"
 #include "../common/fileresourceinputstream.h"
 #include "../platform_win32.h"
@@ -90,7 +91,10 @@ public:
 	{
 		vstgui_assert (useCount > 0);
 		if (--useCount == 0)
+		{
+			BitmapFilter::Tiling::stopWorkers ();
 			releaseFactory ();
+		}
 	}
 
 private:
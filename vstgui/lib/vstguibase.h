@@ -171,6 +171,10 @@
 	#define VSTGUI_TOUCH_EVENT_HANDLING 0
 #endif
 
+#ifndef VSTGUI_ENABLE_FRAME_PROFILER
+	#define VSTGUI_ENABLE_FRAME_PROFILER 0
+#endif
+
 #if VSTGUI_ENABLE_DEPRECATED_METHODS
 	#define VSTGUI_OVERRIDE_VMETHOD	override
 	#define VSTGUI_FINAL_VMETHOD final
@@ -178,12 +178,14 @@ class CGradient;
 class UTF8String;
 class UTF8StringView;
 class CVSTGUITimer;
+class CFrameProfiler;
 class CMenuItem;
 class CCommandMenuItem;
 class GenericStringListDataBrowserSource;
 
 // views
 class CFrame;
+class CFrameProfilerView;
 class CDataBrowser;
 class CGradientView;
 class CLayeredViewContainer;
@@ -28,7 +28,7 @@
 #include "vstgui/uidescription/delegationcontroller.h"
 #include "vstgui/uidescription/iuidescription.h"
 #include "vstgui/uidescription/uiattributes.h"
-#include <atomic>
+#include <algorithm>
 #include <cassert>
 #include <thread>
 
@@ -89,13 +89,12 @@ inline std::function<uint32_t (CColor)> getColorToInt32 (IPlatformBitmapPixelAcc
 //------------------------------------------------------------------------
 template <typename ReadyCallback>
 inline void calculateMandelbrotBitmap (Model model, SharedPointer<CBitmap> bitmap, CPoint size,
-                                       uint32_t id, const std::atomic<uint32_t>& taskID,
-                                       ReadyCallback readyCallback)
+                                       Async::CancellationToken token, ReadyCallback readyCallback)
 {
 	if (auto pa = owned (CBitmapPixelAccess::create (bitmap)))
 	{
-		const auto numLinesPerTask =
-		    static_cast<uint32_t> (size.y / (std::thread::hardware_concurrency () * 8));
+		const auto numLinesPerTask = std::max (
+		    1u, static_cast<uint32_t> (size.y / (std::thread::hardware_concurrency () * 8)));
 
 		const auto maxIterationInv = 1. / model.getIterations ();
 
@@ -105,10 +104,10 @@ inline void calculateMandelbrotBitmap (Model model, SharedPointer<CBitmap> bitma
 		for (auto y = 0u; y < static_cast<uint32_t> (size.y); y += numLinesPerTask)
 		{
 			++(*counter);
-			auto task = [=, &taskID] () {
+			auto task = [=] () {
 				for (auto i = 0u; i < numLinesPerTask; ++i)
 				{
-					if (y + i >= size.y || taskID != id)
+					if (y + i >= size.y || token.isCancelled ())
 						break;
 					auto pixelPtr = reinterpret_cast<uint32_t*> (
 					    pixelAccess->getAddress () + (y + i) * pixelAccess->getBytesPerRow ());
@@ -118,14 +117,14 @@ inline void calculateMandelbrotBitmap (Model model, SharedPointer<CBitmap> bitma
 						pixelPtr++;
 					});
 				}
-				Async::perform (Async::Context::Main, [readyCallback, counter, bitmap, id] () {
+				Async::perform (Async::Context::Main, token, [readyCallback, counter, bitmap] () {
 					if (--(*counter) == 0)
 					{
-						readyCallback (id, bitmap);
+						readyCallback (bitmap);
 					}
 				});
 			};
-			Async::perform (Async::Context::Background, std::move (task));
+			Async::perform (Async::Context::Background, token, std::move (task));
 		}
 	}
 }
@@ -246,7 +245,7 @@ struct ViewController : DelegationController,
 	void viewWillDelete (CView* view) override
 	{
 		assert (mandelbrotView == view);
-		++taskID; // cancel background calculation
+		calculation.cancel (); // cancel background calculation
 		mandelbrotView->unregisterViewListener (this);
 		mandelbrotView = nullptr;
 	}
@@ -273,11 +272,12 @@ struct ViewController : DelegationController,
 		Value::performSingleEdit (*progressValue, 1.);
 		auto bitmap = makeOwned<CBitmap> (size.x, size.y);
 		bitmap->getPlatformBitmap ()->setScaleFactor (scaleFactor);
-		auto id = ++taskID;
+		calculation.cancel ();
+		calculation = {};
 		auto This = shared (this);
-		calculateMandelbrotBitmap (*model.get (), bitmap, size, id, taskID,
-		                           [This] (uint32_t id, SharedPointer<CBitmap> bitmap) {
-			                           if (id == This->taskID && This->mandelbrotView)
+		calculateMandelbrotBitmap (*model.get (), bitmap, size, calculation,
+		                           [This] (SharedPointer<CBitmap> bitmap) {
+			                           if (This->mandelbrotView)
 			                           {
 				                           This->mandelbrotView->setBackground (bitmap);
 				                           Value::performSingleEdit (*This->progressValue, 0.);
@@ -305,7 +305,7 @@ struct ViewController : DelegationController,
 	CControl* progressControl {nullptr};
 	CView* mandelbrotView {nullptr};
 	double scaleFactor {1.};
-	std::atomic<uint32_t> taskID {0};
+	Async::CancellationToken calculation;
 };
 
 static const Command saveCommand {"File", "Save Bitmap"};
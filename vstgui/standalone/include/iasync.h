@@ -5,7 +5,9 @@
 #pragma once
 
 #include "fwd.h"
+#include <atomic>
 #include <functional>
+#include <memory>
 
 //------------------------------------------------------------------------
 namespace VSTGUI {
@@ -39,6 +41,52 @@ enum class Context
  */
 void perform (Context context, Task&& task);
 
+//------------------------------------------------------------------------
+/** Token to cancel scheduled tasks.
+ *
+ *	Copies of a token share the cancellation state, so a long running task can keep a copy to stop
+ *	early.
+ */
+class CancellationToken
+{
+public:
+	CancellationToken () : cancelled (std::make_shared<std::atomic<bool>> (false)) {}
+
+	/** Cancel all tasks scheduled with this token or a copy of it. */
+	void cancel () { *cancelled = true; }
+	bool isCancelled () const { return *cancelled; }
+
+private:
+	std::shared_ptr<std::atomic<bool>> cancelled;
+};
+
+//------------------------------------------------------------------------
+/** Wrap a task so that it does nothing if the token is cancelled before the task is started.
+ *
+ *	@param token	cancellation token
+ *	@param task		task to be wrapped
+ *	@return the wrapped task
+ */
+inline Task makeCancellable (const CancellationToken& token, Task&& task)
+{
+	return [token, task = std::move (task)] () {
+		if (!token.isCancelled ())
+			task ();
+	};
+}
+
+//------------------------------------------------------------------------
+/** Schedule a task which is skipped if the token is cancelled before the task is started.
+ *
+ *	@param context	background or main thread
+ *	@param token	cancellation token
+ *	@param task		task to be performed
+ */
+inline void perform (Context context, const CancellationToken& token, Task&& task)
+{
+	perform (context, makeCancellable (token, std::move (task)));
+}
+
 //------------------------------------------------------------------------
 } // Async
 } // Standalone
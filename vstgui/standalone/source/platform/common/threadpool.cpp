@@ -0,0 +1,197 @@
+// This file is part of VSTGUI. It is subject to the license terms
+// in the LICENSE file found in the top-level directory of this
+// distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
+
+#include "threadpool.h"
+#include <algorithm>
+
+//------------------------------------------------------------------------
+namespace VSTGUI {
+namespace Standalone {
+namespace Platform {
+
+//------------------------------------------------------------------------
+static thread_local ThreadPool* gCurrentPool {nullptr};
+static thread_local size_t gCurrentWorkerIndex {0};
+
+//------------------------------------------------------------------------
+struct ThreadPool::Worker
+{
+	std::mutex mutex;
+	std::deque<Async::Task> tasks;
+	std::thread thread;
+};
+
+//------------------------------------------------------------------------
+ThreadPool::ThreadPool (uint32_t numThreads)
+{
+	if (numThreads == 0)
+		numThreads = std::max (1u, std::thread::hardware_concurrency ());
+	workers.reserve (numThreads);
+	for (auto index = 0u; index < numThreads; ++index)
+		workers.emplace_back (new Worker);
+	for (auto index = 0u; index < numThreads; ++index)
+		workers[index]->thread = std::thread ([this, index] () { run (index); });
+}
+
+//------------------------------------------------------------------------
+ThreadPool::~ThreadPool () noexcept
+{
+	{
+		std::lock_guard<std::mutex> guard (mutex);
+		stop = true;
+	}
+	wakeUp.notify_all ();
+	for (auto& worker : workers)
+		worker->thread.join ();
+}
+
+//------------------------------------------------------------------------
+void ThreadPool::perform (Async::Task&& task)
+{
+	size_t workerIndex;
+	if (gCurrentPool == this)
+		workerIndex = gCurrentWorkerIndex;
+	else
+		workerIndex = nextWorker++ % workers.size ();
+
+	++numTasks;
+	{
+		auto& worker = *workers[workerIndex];
+		std::lock_guard<std::mutex> guard (worker.mutex);
+		worker.tasks.emplace_back (std::move (task));
+		// the task can only be taken with the mutex of its queue locked, so the counter is
+		// decremented after it was incremented
+		++numQueuedTasks;
+	}
+	// a worker checks the number of queued tasks with the mutex locked before it waits, so it
+	// cannot miss this notification
+	{
+		std::lock_guard<std::mutex> guard (mutex);
+	}
+	wakeUp.notify_one ();
+}
+
+//------------------------------------------------------------------------
+void ThreadPool::waitUntilIdle ()
+{
+	std::unique_lock<std::mutex> lock (mutex);
+	idle.wait (lock, [this] () { return numTasks == 0; });
+}
+
+//------------------------------------------------------------------------
+bool ThreadPool::takeTask (size_t workerIndex, Async::Task& task)
+{
+	{
+		auto& worker = *workers[workerIndex];
+		std::lock_guard<std::mutex> guard (worker.mutex);
+		if (!worker.tasks.empty ())
+		{
+			task = std::move (worker.tasks.back ());
+			worker.tasks.pop_back ();
+			return true;
+		}
+	}
+	for (auto i = 1u; i < workers.size (); ++i)
+	{
+		auto& worker = *workers[(workerIndex + i) % workers.size ()];
+		std::lock_guard<std::mutex> guard (worker.mutex);
+		if (!worker.tasks.empty ())
+		{
+			task = std::move (worker.tasks.front ());
+			worker.tasks.pop_front ();
+			return true;
+		}
+	}
+	return false;
+}
+
+//------------------------------------------------------------------------
+void ThreadPool::run (size_t workerIndex)
+{
+	gCurrentPool = this;
+	gCurrentWorkerIndex = workerIndex;
+	while (true)
+	{
+		Async::Task task;
+		if (takeTask (workerIndex, task))
+		{
+			--numQueuedTasks;
+			task ();
+			task = nullptr;
+			if (--numTasks == 0)
+			{
+				std::lock_guard<std::mutex> guard (mutex);
+				idle.notify_all ();
+			}
+			continue;
+		}
+		std::unique_lock<std::mutex> lock (mutex);
+		wakeUp.wait (lock, [this] () { return stop || numQueuedTasks != 0; });
+		if (stop && numQueuedTasks == 0)
+			break;
+	}
+	gCurrentPool = nullptr;
+}
+
+//------------------------------------------------------------------------
+LockFreeTaskQueue::~LockFreeTaskQueue () noexcept
+{
+	auto node = head.exchange (nullptr);
+	while (node)
+	{
+		auto next = node->next;
+		delete node;
+		node = next;
+	}
+}
+
+//------------------------------------------------------------------------
+bool LockFreeTaskQueue::push (Async::Task&& task)
+{
+	auto node = new Node {std::move (task), nullptr};
+	auto next = head.load (std::memory_order_relaxed);
+	do
+	{
+		// the node must not be accessed after it was published, it may already be performed
+		node->next = next;
+	} while (!head.compare_exchange_weak (next, node, std::memory_order_release,
+	                                      std::memory_order_relaxed));
+	return next == nullptr;
+}
+
+//------------------------------------------------------------------------
+auto LockFreeTaskQueue::takeAll (std::atomic<Node*>& head) -> Node*
+{
+	// the nodes are linked from the newest to the oldest, reverse them to keep the order
+	Node* first = nullptr;
+	auto node = head.exchange (nullptr, std::memory_order_acquire);
+	while (node)
+	{
+		auto next = node->next;
+		node->next = first;
+		first = node;
+		node = next;
+	}
+	return first;
+}
+
+//------------------------------------------------------------------------
+size_t LockFreeTaskQueue::performAll ()
+{
+	size_t numTasks = 0;
+	auto node = takeAll (head);
+	while (node)
+	{
+		std::unique_ptr<Node> current (node);
+		node = node->next;
+		current->task ();
+		++numTasks;
+	}
+	return numTasks;
+}
+
+//------------------------------------------------------------------------
+} // Platform
+} // Standalone
+} // VSTGUI
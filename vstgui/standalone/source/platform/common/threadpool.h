@@ -0,0 +1,98 @@
+// This file is part of VSTGUI. It is subject to the license terms
+// in the LICENSE file found in the top-level directory of this
+// distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
+
+#pragma once
+
+#include "../../../include/iasync.h"
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+//------------------------------------------------------------------------
+namespace VSTGUI {
+namespace Standalone {
+namespace Platform {
+
+//------------------------------------------------------------------------
+/** A pool of worker threads with one task queue per worker.
+ *
+ *	Tasks scheduled from outside the pool are distributed round robin to the queues. Tasks
+ *	scheduled from a worker are added to the queue of this worker. A worker takes the newest task
+ *	of its own queue, as its data is most likely still in the cache, and if its queue is empty it
+ *	steals the oldest task of another queue.
+ */
+class ThreadPool
+{
+public:
+	/** creates one worker per hardware thread if numThreads is zero */
+	explicit ThreadPool (uint32_t numThreads = 0);
+	/** waits until all scheduled tasks are done */
+	~ThreadPool () noexcept;
+
+	uint32_t getNumThreads () const { return static_cast<uint32_t> (workers.size ()); }
+
+	/** schedule a task, can be called from any thread */
+	void perform (Async::Task&& task);
+
+	/** true if tasks are queued or running */
+	bool isBusy () const { return numTasks != 0; }
+	/** block until all tasks are done, must not be called from a worker */
+	void waitUntilIdle ();
+
+private:
+	struct Worker;
+
+	bool takeTask (size_t workerIndex, Async::Task& task);
+	void run (size_t workerIndex);
+
+	std::vector<std::unique_ptr<Worker>> workers;
+	std::mutex mutex;
+	std::condition_variable wakeUp;
+	std::condition_variable idle;
+	/** number of queued tasks */
+	std::atomic<uint32_t> numQueuedTasks {0};
+	/** number of queued and running tasks */
+	std::atomic<uint32_t> numTasks {0};
+	std::atomic<uint32_t> nextWorker {0};
+	bool stop {false};
+};
+
+//------------------------------------------------------------------------
+/** A lock-free queue of tasks.
+ *
+ *	Tasks can be pushed from any thread, one thread performs all queued tasks at once, e.g. the main
+ *	thread.
+ */
+class LockFreeTaskQueue
+{
+public:
+	LockFreeTaskQueue () = default;
+	~LockFreeTaskQueue () noexcept;
+
+	/** returns true if the queue was empty before, so the consumer needs to be woken up */
+	bool push (Async::Task&& task);
+	/** performs the tasks pushed until now in the order they were pushed and returns their number
+	 */
+	size_t performAll ();
+
+private:
+	struct Node
+	{
+		Async::Task task;
+		Node* next;
+	};
+
+	static Node* takeAll (std::atomic<Node*>& head);
+
+	std::atomic<Node*> head {nullptr};
+};
+
+//------------------------------------------------------------------------
+} // Platform
+} // Standalone
+} // VSTGUI
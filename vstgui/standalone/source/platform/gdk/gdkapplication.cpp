@@ -8,6 +8,7 @@
 #include "../../../../lib/vstkeycode.h"
 #include "../../../../lib/platform/linux/x11frame.h"
 #include "../../../../lib/platform/common/fileresourceinputstream.h"
+#include "gdkasync.h"
 #include "gdkcommondirectories.h"
 #include "gdkpreference.h"
 #include "gdkwindow.h"
@@ -81,6 +82,8 @@ private:
 //------------------------------------------------------------------------
 bool Application::init (int argc, char* argv[])
 {
+	initAsyncHandling ();
+
 	const auto& appInfo = IApplication::instance ().getDelegate ().getInfo ();
 	app = Gtk::Application::create (argc, argv, appInfo.uri.data ());
 	Glib::set_application_name (appInfo.name.getString ());
@@ -102,6 +105,8 @@ bool Application::init (int argc, char* argv[])
 				std::string path (execPath);
 				path += "/Resources/";
 				path += desc.u.name;
+				if (auto stream = MappedFileResourceInputStream::create (path))
+					return stream;
 				return FileResourceInputStream::create (path);
 			};
 
@@ -129,7 +134,9 @@ bool Application::init (int argc, char* argv[])
 //------------------------------------------------------------------------
 int Application::run ()
 {
-	return app->run ();
+	auto result = app->run ();
+	terminateAsyncHandling ();
+	return result;
 }
 
 //------------------------------------------------------------------------
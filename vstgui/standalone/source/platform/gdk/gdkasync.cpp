@@ -2,7 +2,10 @@
 // in the LICENSE file found in the top-level directory of this
 // distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
 
-#include "../../../include/iasync.h"
+#include "gdkasync.h"
+#include "../common/threadpool.h"
+#include <chrono>
+#include <glib.h>
 
 //------------------------------------------------------------------------
 namespace VSTGUI {
@@ -10,6 +13,46 @@ namespace Standalone {
 namespace Platform {
 namespace GDK {
 
+static std::unique_ptr<ThreadPool> gThreadPool;
+static LockFreeTaskQueue gMainTasks;
+
+//------------------------------------------------------------------------
+void initAsyncHandling ()
+{
+	gThreadPool = std::unique_ptr<ThreadPool> (new ThreadPool ());
+}
+
+//------------------------------------------------------------------------
+void terminateAsyncHandling ()
+{
+	if (!gThreadPool)
+		return;
+	// keep performing the main tasks the background tasks schedule until they are all done
+	while (gThreadPool->isBusy ())
+	{
+		if (gMainTasks.performAll () == 0)
+			std::this_thread::sleep_for (std::chrono::milliseconds (1));
+	}
+	gThreadPool = nullptr;
+	gMainTasks.performAll ();
+}
+
+//------------------------------------------------------------------------
+static gboolean performMainTasks (gpointer)
+{
+	gMainTasks.performAll ();
+	return G_SOURCE_REMOVE;
+}
+
+//------------------------------------------------------------------------
+static void postAsyncMainTask (Async::Task&& task)
+{
+	// only the first task added to an empty queue needs to wake up the main context, the following
+	// tasks are performed together with it
+	if (gMainTasks.push (std::move (task)))
+		g_idle_add_full (G_PRIORITY_DEFAULT, performMainTasks, nullptr, nullptr);
+}
+
 //------------------------------------------------------------------------
 } // GDK
 } // Platform
@@ -20,8 +63,22 @@ namespace Async {
 //------------------------------------------------------------------------
 void perform (Context context, Task&& task)
 {
-	// TODO: Not implemented yet
-	task ();
+	switch (context)
+	{
+		case Context::Main:
+		{
+			Platform::GDK::postAsyncMainTask (std::move (task));
+			break;
+		}
+		case Context::Background:
+		{
+			if (Platform::GDK::gThreadPool)
+				Platform::GDK::gThreadPool->perform (std::move (task));
+			else
+				task ();
+			break;
+		}
+	}
 }
 
 //------------------------------------------------------------------------
@@ -0,0 +1,139 @@
+// This file is part of VSTGUI. It is subject to the license terms
+// in the LICENSE file found in the top-level directory of this
+// distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
+
+#include "vstgui/standalone/examples/mandelbrot/source/mandelbrot.h"
+#include "vstgui/standalone/source/platform/common/threadpool.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <numeric>
+#include <thread>
+#include <vector>
+
+namespace VSTGUI { void* soHandle = nullptr; }
+
+using namespace VSTGUI;
+using namespace VSTGUI::Standalone;
+using namespace VSTGUI::Standalone::Platform;
+
+//------------------------------------------------------------------------
+/** the iterations of a mandelbrot image, split into tasks of some lines like the mandelbrot example
+ *	does */
+struct Image
+{
+	Image (uint32_t width, uint32_t height, uint32_t numTasks)
+	: size (width, height)
+	, pixels (width * height)
+	, numLinesPerTask (std::max (1u, height / numTasks))
+	{
+		model.setIterations (1000);
+	}
+
+	template <typename Proc>
+	void forEachTask (Async::CancellationToken token, Proc proc)
+	{
+		for (auto y = 0u; y < static_cast<uint32_t> (size.y); y += numLinesPerTask)
+		{
+			proc ([this, y, token] () {
+				for (auto i = 0u; i < numLinesPerTask; ++i)
+				{
+					if (y + i >= size.y || token.isCancelled ())
+						break;
+					auto pixel = pixels.data () + (y + i) * static_cast<uint32_t> (size.x);
+					Mandelbrot::calculateLine (y + i, size, model, [&] (auto x, auto iterations) {
+						pixel[x] = iterations;
+					});
+				}
+			});
+		}
+	}
+
+	uint64_t checksum () const
+	{
+		return std::accumulate (pixels.begin (), pixels.end (), static_cast<uint64_t> (0));
+	}
+
+	Mandelbrot::Model model;
+	Mandelbrot::Point size;
+	std::vector<uint32_t> pixels;
+	uint32_t numLinesPerTask;
+};
+
+//------------------------------------------------------------------------
+template <typename Proc>
+static double measure (Proc proc)
+{
+	auto start = std::chrono::steady_clock::now ();
+	proc ();
+	return std::chrono::duration<double, std::milli> (std::chrono::steady_clock::now () - start)
+	    .count ();
+}
+
+//------------------------------------------------------------------------
+/** performs the main thread tasks until all tasks reported that they are done, like the GLib main
+ *	context does */
+static void runMainLoop (LockFreeTaskQueue& mainTasks, const uint32_t& numDoneTasks,
+                         uint32_t numTasks)
+{
+	while (numDoneTasks != numTasks)
+	{
+		if (mainTasks.performAll () == 0)
+			std::this_thread::yield ();
+	}
+}
+
+//------------------------------------------------------------------------
+int main ()
+{
+	constexpr auto width = 1280u;
+	constexpr auto height = 800u;
+	ThreadPool pool;
+	const auto numTasks = pool.getNumThreads () * 8;
+	printf ("%ux%u pixels, %u tasks, %u threads\n", width, height, numTasks,
+	        pool.getNumThreads ());
+
+	// the previous implementation performed the background tasks inline
+	Image inlineImage (width, height, numTasks);
+	auto inlineTime = measure ([&] () {
+		inlineImage.forEachTask ({}, [] (Async::Task&& task) { task (); });
+	});
+	printf ("inline:      %8.1f ms\n", inlineTime);
+
+	Image poolImage (width, height, numTasks);
+	LockFreeTaskQueue mainTasks;
+	uint32_t numScheduledTasks = 0;
+	uint32_t numDoneTasks = 0;
+	auto poolTime = measure ([&] () {
+		poolImage.forEachTask ({}, [&] (Async::Task&& task) {
+			++numScheduledTasks;
+			pool.perform ([&, task = std::move (task)] () {
+				task ();
+				mainTasks.push ([&] () { ++numDoneTasks; });
+			});
+		});
+		runMainLoop (mainTasks, numDoneTasks, numScheduledTasks);
+	});
+	printf ("thread pool: %8.1f ms (%.1fx)%s\n", poolTime, inlineTime / poolTime,
+	        poolImage.checksum () == inlineImage.checksum () ? "" : "  (images differ)");
+
+	Image cancelledImage (width, height, numTasks);
+	Async::CancellationToken token;
+	auto cancelTime = measure ([&] () {
+		cancelledImage.forEachTask (token, [&] (Async::Task&& task) {
+			pool.perform (std::move (task));
+		});
+		token.cancel ();
+		pool.waitUntilIdle ();
+	});
+	printf ("cancelled:   %8.1f ms\n", cancelTime);
+
+	if (std::thread::hardware_concurrency () > 1 && poolTime >= inlineTime)
+	{
+		fprintf (stderr, "the thread pool is not faster than the inline run with %u hardware threads\n",
+		         std::thread::hardware_concurrency ());
+		return 1;
+	}
+	return 0;
+}
@@ -5,10 +5,36 @@
 #include "vstgui/uidescription/base64codec.h"
 #include "vstgui/lib/malloc.h"
 
+#include <chrono>
+#include <cstdio>
 #include <random>
 
 using namespace VSTGUI;
 
+//------------------------------------------------------------------------
+static const char* kernelName (Base64Codec::Kernel kernel)
+{
+	switch (kernel)
+	{
+		case Base64Codec::Kernel::Scalar: return "scalar";
+		case Base64Codec::Kernel::SSSE3: return "ssse3";
+		case Base64Codec::Kernel::AVX2: return "avx2";
+		case Base64Codec::Kernel::NEON: return "neon";
+	}
+	return "";
+}
+
+//------------------------------------------------------------------------
+template <typename Proc>
+static double gigabytesPerSecond (size_t numBytes, Proc proc)
+{
+	auto start = std::chrono::steady_clock::now ();
+	proc ();
+	auto seconds = std::chrono::duration<double> (std::chrono::steady_clock::now () - start).count ();
+	return numBytes / seconds / (1024. * 1024. * 1024.);
+}
+
+//------------------------------------------------------------------------
 int main ()
 {
 	Buffer<uint8_t> origData;
@@ -17,13 +43,28 @@ int main ()
 	std::independent_bits_engine<std::default_random_engine, sizeof (uint16_t) * 8, uint16_t> rbe;
 	std::generate (origData.get (), origData.get () + origData.size (), std::ref (rbe));
 
-	auto encoderResult = Base64Codec::encode (origData.get (), origData.size ());
-	auto decoderResult = Base64Codec::decode (encoderResult.data.get (), encoderResult.dataSize);
+	printf ("%-8s %14s %14s\n", "kernel", "encode GB/s", "decode GB/s");
+	for (auto kernel : {Base64Codec::Kernel::Scalar, Base64Codec::Kernel::SSSE3,
+	                    Base64Codec::Kernel::AVX2, Base64Codec::Kernel::NEON})
+	{
+		if (!Base64Codec::setKernel (kernel))
+			continue;
+
+		Base64Codec::Result encoderResult;
+		auto encodeSpeed = gigabytesPerSecond (origData.size (), [&] () {
+			encoderResult = Base64Codec::encode (origData.get (), origData.size ());
+		});
+		Base64Codec::Result decoderResult;
+		auto decodeSpeed = gigabytesPerSecond (encoderResult.dataSize, [&] () {
+			decoderResult = Base64Codec::decode (encoderResult.data.get (), encoderResult.dataSize);
+		});
+		printf ("%-8s %14.2f %14.2f\n", kernelName (kernel), encodeSpeed, decodeSpeed);
 
-	if (origData.size () != decoderResult.dataSize)
-		return -1;
+		if (origData.size () != decoderResult.dataSize)
+			return -1;
 
-	if (memcmp (origData.get (), decoderResult.data.get (), origData.size ()) != 0)
-		return -1;
+		if (memcmp (origData.get (), decoderResult.data.get (), origData.size ()) != 0)
+			return -1;
+	}
 	return 0;
 }
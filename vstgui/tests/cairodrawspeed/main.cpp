@@ -0,0 +1,75 @@
+// This file is part of VSTGUI. It is subject to the license terms 
+// in the LICENSE file found in the top-level directory of this
+// distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
+
+#include "vstgui/lib/platform/linux/cairocontext.h"
+
+#include <chrono>
+#include <cstdio>
+
+namespace VSTGUI { void* soHandle = nullptr; }
+
+using namespace VSTGUI;
+
+//------------------------------------------------------------------------
+/** draws a grid of knob like views, each with its own clip rect and a few primitives */
+static size_t drawKnobPanel (CDrawContext& context, const CRect& surfaceRect)
+{
+	constexpr auto knobSize = 40.;
+	size_t numPrimitives = 0;
+	for (auto y = 0.; y + knobSize <= surfaceRect.getHeight (); y += knobSize)
+	{
+		for (auto x = 0.; x + knobSize <= surfaceRect.getWidth (); x += knobSize)
+		{
+			CRect knob (x, y, x + knobSize, y + knobSize);
+			context.setClipRect (knob);
+			context.setFillColor (kGreyCColor);
+			context.drawRect (knob, kDrawFilled);
+			context.setFrameColor (kBlackCColor);
+			context.drawEllipse (CRect (knob).inset (4, 4), kDrawStroked);
+			context.setFrameColor (kWhiteCColor);
+			context.drawLine (knob.getCenter (), CPoint (knob.left + 8, knob.bottom - 8));
+			for (auto i = 0; i < 8; ++i)
+				context.drawPoint (CPoint (knob.left + 4 + i * 4, knob.bottom - 2), kRedCColor);
+			numPrimitives += 11;
+		}
+	}
+	return numPrimitives;
+}
+
+//------------------------------------------------------------------------
+static double measure (bool drawStateCaching)
+{
+	Cairo::Context::setDrawStateCaching (drawStateCaching);
+
+	CRect surfaceRect (0, 0, 800, 600);
+	Cairo::SurfaceHandle surface (cairo_image_surface_create (
+	    CAIRO_FORMAT_ARGB32, static_cast<int> (surfaceRect.getWidth ()),
+	    static_cast<int> (surfaceRect.getHeight ())));
+	auto context = makeOwned<Cairo::Context> (surfaceRect, surface);
+
+	constexpr auto numFrames = 50;
+	size_t numPrimitives = 0;
+	auto start = std::chrono::steady_clock::now ();
+	for (auto frame = 0; frame < numFrames; ++frame)
+	{
+		context->beginDraw ();
+		numPrimitives += drawKnobPanel (*context, surfaceRect);
+		context->endDraw ();
+	}
+	auto seconds =
+	    std::chrono::duration<double> (std::chrono::steady_clock::now () - start).count ();
+	return numPrimitives / seconds;
+}
+
+//------------------------------------------------------------------------
+int main ()
+{
+	measure (true); // warm up
+
+	auto uncached = measure (false);
+	auto cached = measure (true);
+	printf ("draw state per primitive: %12.0f primitives/s\n", uncached);
+	printf ("cached draw state:        %12.0f primitives/s (%.2fx)\n", cached, cached / uncached);
+	return 0;
+}
@@ -0,0 +1,194 @@
+// This file is part of VSTGUI. It is subject to the license terms
+// in the LICENSE file found in the top-level directory of this
+// distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
+
+#include "vstgui/lib/cdatabrowser.h"
+#include "vstgui/lib/cdrawcontext.h"
+#include "vstgui/lib/idatabrowserdelegate.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+
+namespace VSTGUI { void* soHandle = nullptr; }
+
+using namespace VSTGUI;
+
+//------------------------------------------------------------------------
+/** measures the overhead of the data browser itself, nothing is drawn */
+class NullDrawContext : public CDrawContext
+{
+public:
+	NullDrawContext (const CRect& r) : CDrawContext (r) { init (); }
+
+	void drawLine (const LinePair& line) override {}
+	void drawLines (const LineList& lines) override {}
+	void drawPolygon (const PointList& polygonPointList, const CDrawStyle drawStyle) override {}
+	void drawRect (const CRect& rect, const CDrawStyle drawStyle) override {}
+	void drawArc (const CRect& rect, const float startAngle1, const float endAngle2,
+	              const CDrawStyle drawStyle) override {}
+	void drawEllipse (const CRect& rect, const CDrawStyle drawStyle) override {}
+	void drawPoint (const CPoint& point, const CColor& color) override {}
+	void drawBitmap (CBitmap* bitmap, const CRect& dest, const CPoint& offset, float alpha) override {}
+	void clearRect (const CRect& rect) override {}
+	CGraphicsPath* createGraphicsPath () override { return nullptr; }
+	CGraphicsPath* createTextPath (const CFontRef font, UTF8StringPtr text) override { return nullptr; }
+	void drawGraphicsPath (CGraphicsPath* path, PathDrawMode mode,
+	                       CGraphicsTransform* transformation) override {}
+	void fillLinearGradient (CGraphicsPath* path, const CGradient& gradient, const CPoint& startPoint,
+	                         const CPoint& endPoint, bool evenOdd,
+	                         CGraphicsTransform* transformation) override {}
+	void fillRadialGradient (CGraphicsPath* path, const CGradient& gradient, const CPoint& center,
+	                         CCoord radius, const CPoint& originOffset, bool evenOdd,
+	                         CGraphicsTransform* transformation) override {}
+};
+
+//------------------------------------------------------------------------
+class PresetList : public DataBrowserDelegateAdapter, public NonAtomicReferenceCounted
+{
+public:
+	static constexpr int32_t kNumRows = 1000000;
+
+	int32_t dbGetNumRows (CDataBrowser* browser) override { return kNumRows; }
+	int32_t dbGetNumColumns (CDataBrowser* browser) override { return 4; }
+	CCoord dbGetRowHeight (CDataBrowser* browser) override { return 18.; }
+	CCoord dbGetCurrentColumnWidth (int32_t index, CDataBrowser* browser) override
+	{
+		return index == 0 ? 200. : 100.;
+	}
+	bool dbGetLineWidthAndColor (CCoord& width, CColor& color, CDataBrowser* browser) override
+	{
+		width = 1.;
+		color = kGreyCColor;
+		return true;
+	}
+	void dbDrawCell (CDrawContext* context, const CRect& size, int32_t row, int32_t column,
+	                 int32_t flags, CDataBrowser* browser) override
+	{
+		++numDrawnCells;
+		if (flags & kRowSelected)
+			++numSelectedCells;
+	}
+
+	size_t numDrawnCells {0};
+	size_t numSelectedCells {0};
+};
+
+//------------------------------------------------------------------------
+/** the previous CDataBrowserView::drawRect, which tests every row against the update rect and
+ *	searches every visible row in the selection */
+static void drawLinear (CDrawContext* context, const CRect& viewSize, const CRect& updateRect,
+                        IDataBrowserDelegate* db, CDataBrowser* browser)
+{
+	CCoord lineWidth = 0;
+	CColor lineColor;
+	db->dbGetLineWidthAndColor (lineWidth, lineColor, browser);
+	CCoord rowHeight = db->dbGetRowHeight (browser) + lineWidth;
+	int32_t numRows = db->dbGetNumRows (browser);
+	int32_t numColumns = db->dbGetNumColumns (browser);
+	const auto& selection = browser->getSelection ();
+	CDrawContext::LineList lines;
+	CRect r (viewSize);
+	r.setHeight (rowHeight - lineWidth);
+	for (int32_t row = 0; row < numRows; row++)
+	{
+		CRect testRect (r);
+		testRect.bound (updateRect);
+		if (testRect.isEmpty () == false)
+		{
+			bool isSelected = std::find (selection.begin (), selection.end (), row) != selection.end ();
+			for (int32_t col = 0; col < numColumns; col++)
+			{
+				CCoord columnWidth = db->dbGetCurrentColumnWidth (col, browser);
+				r.setWidth (columnWidth);
+				testRect = r;
+				testRect.bound (updateRect);
+				if (testRect.isEmpty () == false)
+				{
+					context->setClipRect (testRect);
+					db->dbDrawCell (context, r, row, col,
+					                isSelected ? IDataBrowserDelegate::kRowSelected : 0, browser);
+				}
+				r.offset (columnWidth + lineWidth, 0);
+			}
+		}
+		r.left = viewSize.left;
+		r.setWidth (viewSize.getWidth ());
+		lines.emplace_back (r.getBottomLeft (), r.getBottomRight ());
+		r.offset (0, rowHeight);
+	}
+	context->drawLines (lines);
+}
+
+//------------------------------------------------------------------------
+template <typename Proc>
+static double measure (size_t iterations, Proc proc)
+{
+	auto start = std::chrono::steady_clock::now ();
+	for (auto i = 0u; i < iterations; ++i)
+		proc ();
+	return std::chrono::duration<double, std::micro> (std::chrono::steady_clock::now () - start)
+	           .count () /
+	       iterations;
+}
+
+//------------------------------------------------------------------------
+int main ()
+{
+	auto presetList = makeOwned<PresetList> ();
+	CRect browserSize (0, 0, 500, 600);
+	auto browser = makeOwned<CDataBrowser> (
+	    browserSize, presetList, CDataBrowser::kDrawRowLines | CDataBrowser::kDrawColumnLines |
+	                                 CDataBrowser::kMultiSelectionStyle |
+	                                 CScrollView::kVerticalScrollbar | CScrollView::kDontDrawFrame);
+	browser->recalculateLayout ();
+	NullDrawContext context (browserSize);
+
+	constexpr auto middleRow = PresetList::kNumRows / 2;
+	constexpr auto numSelectedRows = 10000;
+	// a sample browser where every 50th sample is selected
+	for (auto i = 0; i < numSelectedRows; ++i)
+		browser->selectRow (middleRow - numSelectedRows * 25 + i * 50);
+
+	// draw the rows of the browser directly, like the scroll container does when the middle of the
+	// list is visible
+	auto rowsView = browser->getView (0);
+	auto rowBounds = browser->getCellBounds (CDataBrowser::Cell (middleRow, 0));
+	CRect visibleRect (0, rowBounds.top, browserSize.getWidth (),
+	                   rowBounds.top + browserSize.getHeight ());
+	auto viewSize = rowsView->getViewSize ();
+
+	constexpr auto iterations = 20u;
+	printf ("%d rows, %zu selected, %.0fx%.0f visible\n", PresetList::kNumRows,
+	        browser->getSelection ().size (), visibleRect.getWidth (), visibleRect.getHeight ());
+
+	presetList->numDrawnCells = presetList->numSelectedCells = 0;
+	auto linearTime = measure (iterations, [&] () {
+		drawLinear (&context, viewSize, visibleRect, presetList, browser);
+	});
+	auto linearCells = presetList->numDrawnCells / iterations;
+	auto linearSelectedCells = presetList->numSelectedCells / iterations;
+
+	presetList->numDrawnCells = presetList->numSelectedCells = 0;
+	auto drawTime = measure (iterations, [&] () { rowsView->drawRect (&context, visibleRect); });
+	auto drawnCells = presetList->numDrawnCells / iterations;
+	auto selectedCells = presetList->numSelectedCells / iterations;
+	printf ("draw visible rows:      linear %10.1f us, visible range %8.1f us (%.0fx)%s\n",
+	        linearTime, drawTime, linearTime / drawTime,
+	        linearCells == drawnCells && drawnCells > 0 && linearSelectedCells == selectedCells ?
+	            "" :
+	            "  (drawn cells differ)");
+
+	auto hitTestTime = measure (iterations * 1000, [&] () {
+		browser->getCellAt (CPoint (450, 5));
+	});
+	printf ("hit test cell:          %10.3f us\n", hitTestTime);
+
+	auto selectTime = measure (1, [&] () {
+		browser->unselectAll ();
+		for (auto i = 0; i < numSelectedRows; ++i)
+			browser->selectRow (middleRow - numSelectedRows / 2 + i);
+	});
+	printf ("select %d rows:      %10.1f us\n", numSelectedRows, selectTime);
+	return 0;
+}
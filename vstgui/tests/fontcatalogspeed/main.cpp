@@ -0,0 +1,60 @@
+// This file is part of VSTGUI. It is subject to the license terms 
+// in the LICENSE file found in the top-level directory of this
+// distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
+
+#include "vstgui/lib/cstring.h"
+#include "vstgui/lib/platform/linux/cairofont.h"
+
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <unistd.h>
+#include <vector>
+
+namespace VSTGUI { void* soHandle = nullptr; }
+
+using namespace VSTGUI;
+
+//------------------------------------------------------------------------
+static void run (const char* title, Cairo::FontCatalog::Mode mode, const std::string& cachePath,
+                 const std::vector<std::string>& families)
+{
+	Cairo::FontCatalog::setMode (mode);
+	Cairo::FontCatalog::setCachePath (cachePath);
+	Cairo::FontCatalog::reset ();
+
+	auto start = std::chrono::steady_clock::now ();
+	size_t numFonts = 0;
+	for (const auto& family : families)
+	{
+		if (IPlatformFont::create (UTF8String (family), 12, 0))
+			++numFonts;
+	}
+	auto time = std::chrono::duration<double, std::milli> (std::chrono::steady_clock::now () - start).count ();
+
+	const auto& stats = Cairo::FontCatalog::getStatistics ();
+	printf ("%-20s %9.2f ms (catalog %9.2f ms, %zu families%s), %zu of %zu fonts created\n", title,
+	        time, stats.loadTime, stats.numFamilies, stats.loadedFromCache ? ", from cache" : "",
+	        numFonts, families.size ());
+}
+
+//------------------------------------------------------------------------
+int main (int argc, char* argv[])
+{
+	std::vector<std::string> families;
+	for (auto i = 1; i < argc; ++i)
+		families.emplace_back (argv[i]);
+	if (families.empty ())
+		families = {"Liberation Sans", "DejaVu Sans", "Noto Sans"};
+
+	auto cachePath = "/tmp/vstgui-fontcatalogspeed-" + std::to_string (getpid ());
+
+	run ("full (warm up)", Cairo::FontCatalog::Mode::Full, "", families);
+	run ("full", Cairo::FontCatalog::Mode::Full, "", families);
+	run ("full, write cache", Cairo::FontCatalog::Mode::Full, cachePath, families);
+	run ("full, read cache", Cairo::FontCatalog::Mode::Full, cachePath, families);
+	run ("lazy", Cairo::FontCatalog::Mode::Lazy, "", families);
+
+	unlink (cachePath.data ());
+	return 0;
+}
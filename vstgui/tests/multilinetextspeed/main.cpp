@@ -0,0 +1,158 @@
+// This file is part of VSTGUI. It is subject to the license terms
+// in the LICENSE file found in the top-level directory of this
+// distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
+
+#include "vstgui/lib/cfont.h"
+#include "vstgui/lib/cstring.h"
+#include "vstgui/lib/ctextlayout.h"
+#include "vstgui/lib/platform/iplatformfont.h"
+
+#include <cctype>
+#include <chrono>
+#include <cstdio>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace VSTGUI { void* soHandle = nullptr; }
+
+using namespace VSTGUI;
+
+//------------------------------------------------------------------------
+static bool isLineBreakSeparator (char32_t c)
+{
+	switch (c)
+	{
+		case '-': case '_': case '/': case '\\': case '.': case ',': case ':':
+		case ';': case '?': case '!': case '*': case '+': case '&':
+			return true;
+	}
+	return false;
+}
+
+//------------------------------------------------------------------------
+/** the previous CMultiLineTextLabel wrapping, which measures every prefix of a paragraph */
+static std::vector<UTF8String> wrapLinear (const UTF8String& text, const IFontPainter* painter,
+                                           CCoord maxWidth)
+{
+	std::vector<UTF8String> lines;
+	std::stringstream stream (text.getString ());
+	std::string line;
+	while (std::getline (stream, line, '\n'))
+	{
+		UTF8String element (std::move (line));
+		auto width = painter->getStringWidth (nullptr, element.getPlatformString ());
+		if (width <= maxWidth)
+		{
+			lines.emplace_back (std::move (element));
+			continue;
+		}
+		auto start = element.begin ();
+		auto lastSeparator = start;
+		auto pos = start;
+		while (pos != element.end () && *pos != 0)
+		{
+			if (isspace (*pos))
+				lastSeparator = pos;
+			else if (isLineBreakSeparator (*pos))
+				lastSeparator = ++pos;
+			if (pos == element.end ())
+				break;
+			UTF8String tmp ({start.base (), ++(pos.base ())});
+			if (painter->getStringWidth (nullptr, tmp.getPlatformString ()) > maxWidth)
+			{
+				if (lastSeparator == element.end () || start == lastSeparator)
+					lastSeparator = pos;
+				lines.emplace_back (UTF8String ({start.base (), lastSeparator.base ()}));
+				pos = lastSeparator;
+				start = pos;
+				if (isspace (*start))
+					++start;
+				lastSeparator = element.end ();
+			}
+			++pos;
+		}
+		if (start != element.end ())
+			lines.emplace_back (UTF8String ({start.base (), element.end ().base ()}));
+	}
+	return lines;
+}
+
+//------------------------------------------------------------------------
+static std::string makeText (size_t length)
+{
+	static const char* words[] = {"The",     "preset",  "browser", "shows", "all",   "sounds",
+	                              "of",      "the",     "current", "bank,", "sorted", "by",
+	                              "category", "and",    "author.", "Double-click", "a", "preset",
+	                              "to",      "load",    "it;",     "drag",  "it",    "onto",
+	                              "a",       "track",   "to",      "create", "a",    "new",
+	                              "instrument."};
+	std::string text;
+	auto index = 0u;
+	while (text.size () < length)
+	{
+		if (!text.empty ())
+			text += (index % 60 == 0) ? "\n" : " ";
+		text += words[index++ % (sizeof (words) / sizeof (words[0]))];
+	}
+	return text;
+}
+
+//------------------------------------------------------------------------
+template <typename Proc>
+static double measure (size_t iterations, Proc proc)
+{
+	auto start = std::chrono::steady_clock::now ();
+	for (auto i = 0u; i < iterations; ++i)
+		proc ();
+	return std::chrono::duration<double, std::micro> (std::chrono::steady_clock::now () - start)
+	           .count () /
+	       iterations;
+}
+
+//------------------------------------------------------------------------
+int main (int argc, char* argv[])
+{
+	auto font = makeOwned<CFontDesc> (argc > 1 ? argv[1] : "Liberation Sans", 12);
+	auto painter = font->getFontPainter ();
+	if (!painter)
+	{
+		printf ("font not available\n");
+		return 1;
+	}
+	constexpr auto maxWidth = 300.;
+	constexpr auto iterations = 10u;
+
+	printf ("%8s %14s %14s %14s %14s\n", "length", "linear (us)", "greedy (us)", "balanced (us)",
+	        "relayout (us)");
+	for (auto length : {256u, 1024u, 4096u, 16384u})
+	{
+		UTF8String text (makeText (length));
+		auto linearTime = measure (iterations, [&] () { wrapLinear (text, painter, maxWidth); });
+		// a new layout each time, so that the character advances are measured again
+		auto greedyTime = measure (iterations, [&] () {
+			CTextLayout layout;
+			layout.setFont (font);
+			layout.layout (text, maxWidth);
+		});
+		auto balancedTime = measure (iterations, [&] () {
+			CTextLayout layout;
+			layout.setFont (font);
+			layout.setBreakMode (CTextLayout::BreakMode::balanced);
+			layout.layout (text, maxWidth);
+		});
+		// resizing a label back and forth only needs to break the lines again
+		CTextLayout layout;
+		layout.setFont (font);
+		auto relayoutTime = measure (iterations, [&] () {
+			layout.layout (text, maxWidth);
+			layout.layout (text, maxWidth - 50.);
+		}) / 2.;
+		auto linearLines = wrapLinear (text, painter, maxWidth);
+		const auto& lines = layout.layout (text, maxWidth);
+		printf ("%8zu %14.1f %14.1f %14.1f %14.1f%s\n", text.length (), linearTime, greedyTime,
+		        balancedTime, relayoutTime,
+		        linearLines.size () == lines.size () ? "" : "  (line count differs)");
+	}
+	return 0;
+}
@@ -0,0 +1,111 @@
+// This file is part of VSTGUI. It is subject to the license terms 
+// in the LICENSE file found in the top-level directory of this
+// distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
+
+#include "vstgui/lib/cdrawmethods.h"
+#include "vstgui/lib/cfont.h"
+#include "vstgui/lib/cstring.h"
+#include "vstgui/lib/platform/iplatformfont.h"
+
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+namespace VSTGUI { void* soHandle = nullptr; }
+
+using namespace VSTGUI;
+
+//------------------------------------------------------------------------
+/** the previous implementation, which removes one character after another */
+static UTF8String createTruncatedTextLinear (CDrawMethods::TextTruncateMode mode,
+                                             const UTF8String& text, CFontRef font, CCoord maxWidth)
+{
+	auto painter = font->getPlatformFont ()->getPainter ();
+	CCoord width = painter->getStringWidth (nullptr, text.getPlatformString (), true);
+	if (width <= maxWidth)
+		return text;
+	std::string truncatedText;
+	UTF8String result;
+	auto left = text.begin ();
+	auto right = text.end ();
+	while (width > maxWidth && left != right)
+	{
+		if (mode == CDrawMethods::kTextTruncateHead)
+		{
+			++left;
+			truncatedText = "..";
+		}
+		else
+		{
+			--right;
+			truncatedText = "";
+		}
+		truncatedText += {left.base (), right.base ()};
+		if (mode == CDrawMethods::kTextTruncateTail)
+			truncatedText += "..";
+		result = truncatedText;
+		width = painter->getStringWidth (nullptr, result.getPlatformString (), true);
+	}
+	return result;
+}
+
+//------------------------------------------------------------------------
+static std::string makePath (size_t length)
+{
+	std::string path;
+	auto index = 0;
+	while (path.size () < length)
+		path += "/Users/Shared/Projects/Session " + std::to_string (index++);
+	path.resize (length);
+	return path + "/Audio/Take.wav";
+}
+
+//------------------------------------------------------------------------
+template <typename Proc>
+static double measure (size_t iterations, Proc proc)
+{
+	auto start = std::chrono::steady_clock::now ();
+	for (auto i = 0u; i < iterations; ++i)
+		proc ();
+	return std::chrono::duration<double, std::micro> (std::chrono::steady_clock::now () - start)
+	           .count () /
+	       iterations;
+}
+
+//------------------------------------------------------------------------
+int main (int argc, char* argv[])
+{
+	auto font = makeOwned<CFontDesc> (argc > 1 ? argv[1] : "Liberation Sans", 12);
+	if (!font->getPlatformFont () || !font->getPlatformFont ()->getPainter ())
+	{
+		printf ("font not available\n");
+		return 1;
+	}
+	constexpr auto maxWidth = 200.;
+	constexpr auto iterations = 20u;
+
+	printf ("%8s %14s %14s %14s\n", "length", "linear (us)", "tail (us)", "middle (us)");
+	for (auto length : {64u, 128u, 256u, 512u, 1024u, 2048u})
+	{
+		UTF8String text (makePath (length));
+		auto linearTime = measure (iterations, [&] () {
+			createTruncatedTextLinear (CDrawMethods::kTextTruncateTail, text, font, maxWidth);
+		});
+		auto tailTime = measure (iterations, [&] () {
+			CDrawMethods::createTruncatedText (CDrawMethods::kTextTruncateTail, text, font, maxWidth);
+		});
+		auto middleTime = measure (iterations, [&] () {
+			CDrawMethods::createTruncatedText (CDrawMethods::kTextTruncateMiddle, text, font,
+			                                   maxWidth);
+		});
+		auto linear = createTruncatedTextLinear (CDrawMethods::kTextTruncateTail, text, font, maxWidth);
+		auto tail = CDrawMethods::createTruncatedText (CDrawMethods::kTextTruncateTail, text, font, maxWidth);
+		printf ("%8zu %14.1f %14.1f %14.1f%s\n", text.length (), linearTime, tailTime, middleTime,
+		        linear == tail ? "" : "  (results differ)");
+	}
+	printf ("\n%s\n", CDrawMethods::createTruncatedText (CDrawMethods::kTextTruncateMiddle,
+	                                                     UTF8String (makePath (256)), font,
+	                                                     maxWidth).data ());
+	return 0;
+}
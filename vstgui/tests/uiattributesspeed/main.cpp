@@ -0,0 +1,264 @@
+// This file is part of VSTGUI. It is subject to the license terms 
+// in the LICENSE file found in the top-level directory of this
+// distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
+
+#include "vstgui/lib/cpoint.h"
+#include "vstgui/lib/crect.h"
+#include "vstgui/lib/cresourcedescription.h"
+#include "vstgui/lib/cstring.h"
+#include "vstgui/lib/cview.h"
+#include "vstgui/uidescription/cstream.h"
+#include "vstgui/uidescription/uiattributes.h"
+#include "vstgui/uidescription/uidescription.h"
+#include "vstgui/uidescription/uiviewfactory.h"
+#include "vstgui/uidescription/xmlparser.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace VSTGUI { void* soHandle = nullptr; }
+
+using namespace VSTGUI;
+
+//------------------------------------------------------------------------
+/** the previous UIAttributes implementation: a hash map and stream based parsing on each access */
+class LegacyAttributes
+{
+public:
+	explicit LegacyAttributes (UTF8StringPtr* attributes)
+	{
+		for (auto i = 0; attributes[i] && attributes[i + 1]; i += 2)
+			map.emplace (attributes[i], attributes[i + 1]);
+	}
+
+	const std::string* getAttributeValue (const std::string& name) const
+	{
+		auto it = map.find (name);
+		return it != map.end () ? &it->second : nullptr;
+	}
+
+	bool getDoubleAttribute (const std::string& name, double& value) const
+	{
+		if (auto str = getAttributeValue (name))
+		{
+			std::istringstream sstream (*str);
+			sstream.imbue (std::locale::classic ());
+			sstream.precision (40);
+			sstream >> value;
+			return true;
+		}
+		return false;
+	}
+
+	bool getBooleanAttribute (const std::string& name, bool& value) const
+	{
+		if (auto str = getAttributeValue (name))
+		{
+			if (*str == "true" || *str == "false")
+			{
+				value = *str == "true";
+				return true;
+			}
+		}
+		return false;
+	}
+
+	bool getPointAttribute (const std::string& name, CPoint& p) const
+	{
+		std::vector<std::string> subStrings;
+		if (!split (name, subStrings) || subStrings.size () != 2)
+			return false;
+		p.x = UTF8StringView (subStrings[0].c_str ()).toDouble ();
+		p.y = UTF8StringView (subStrings[1].c_str ()).toDouble ();
+		return true;
+	}
+
+	bool getRectAttribute (const std::string& name, CRect& r) const
+	{
+		std::vector<std::string> subStrings;
+		if (!split (name, subStrings) || subStrings.size () != 4)
+			return false;
+		r.left = UTF8StringView (subStrings[0].c_str ()).toDouble ();
+		r.top = UTF8StringView (subStrings[1].c_str ()).toDouble ();
+		r.right = UTF8StringView (subStrings[2].c_str ()).toDouble ();
+		r.bottom = UTF8StringView (subStrings[3].c_str ()).toDouble ();
+		return true;
+	}
+
+private:
+	bool split (const std::string& name, std::vector<std::string>& subStrings) const
+	{
+		auto str = getAttributeValue (name);
+		if (!str || str->find (',') == std::string::npos)
+			return false;
+		size_t start = 0;
+		size_t pos = str->find (',', start);
+		while (pos != std::string::npos)
+		{
+			subStrings.emplace_back (*str, start, pos - start);
+			start = pos + 1;
+			pos = str->find (',', start);
+		}
+		subStrings.emplace_back (*str, start, std::string::npos);
+		return true;
+	}
+
+	std::unordered_map<std::string, std::string> map;
+};
+
+//------------------------------------------------------------------------
+template <typename Attributes>
+struct Collector : Xml::IHandler
+{
+	std::vector<std::unique_ptr<Attributes>> elements;
+	bool viewsOnly {false};
+
+	void startXmlElement (Xml::Parser*, IdStringPtr elementName, UTF8StringPtr* attributes) override
+	{
+		if (viewsOnly && strcmp (elementName, "view") != 0 && strcmp (elementName, "template") != 0)
+			return;
+		elements.emplace_back (new Attributes (attributes));
+	}
+	void endXmlElement (Xml::Parser*, IdStringPtr) override {}
+	void xmlCharData (Xml::Parser*, const int8_t*, int32_t) override {}
+	void xmlComment (Xml::Parser*, IdStringPtr) override {}
+};
+
+//------------------------------------------------------------------------
+/** reads the attributes like the view creators do when a view is created */
+template <typename Attributes>
+static double createViews (const Attributes& attributes)
+{
+	static const std::string kDoubles[] = {"opacity", "frame-width", "wheel-inc-value",
+	                                       "min-value", "max-value", "default-value",
+	                                       "round-rect-radius", "value-precision", "text-rotation"};
+	static const std::string kBools[] = {"transparent", "mouse-enabled", "wants-focus", "autosize",
+	                                     "style-shadow-text"};
+	static const std::string kStrings[] = {"class", "name", "font", "font-color", "frame-color",
+	                                       "control-tag", "text-alignment"};
+	double sum = 0.;
+	CPoint p;
+	CRect r;
+	if (attributes.getPointAttribute ("origin", p))
+		sum += p.x + p.y;
+	if (attributes.getPointAttribute ("size", p))
+		sum += p.x + p.y;
+	if (attributes.getPointAttribute ("text-shadow-offset", p))
+		sum += p.x + p.y;
+	if (attributes.getRectAttribute ("text-inset", r))
+		sum += r.left;
+	for (const auto& name : kDoubles)
+	{
+		double value;
+		if (attributes.getDoubleAttribute (name, value))
+			sum += value;
+	}
+	for (const auto& name : kBools)
+	{
+		bool value;
+		if (attributes.getBooleanAttribute (name, value) && value)
+			sum += 1.;
+	}
+	for (const auto& name : kStrings)
+	{
+		if (auto value = attributes.getAttributeValue (name))
+			sum += value->size ();
+	}
+	return sum;
+}
+
+//------------------------------------------------------------------------
+template <typename Attributes>
+static void run (const char* title, const std::string& path, uint32_t numInstances)
+{
+	CFileStream file;
+	if (!file.open (path.data (), CFileStream::kReadMode))
+		return;
+	Xml::InputStreamContentProvider provider (file);
+	Collector<Attributes> collector;
+	Xml::Parser parser;
+	if (!parser.parse (&provider, &collector))
+		return;
+
+	double sum = 0.;
+	auto start = std::chrono::steady_clock::now ();
+	for (const auto& element : collector.elements)
+		sum += createViews (*element);
+	auto first = std::chrono::duration<double, std::micro> (std::chrono::steady_clock::now () - start).count ();
+	start = std::chrono::steady_clock::now ();
+	for (auto i = 1u; i < numInstances; ++i)
+	{
+		for (const auto& element : collector.elements)
+			sum += createViews (*element);
+	}
+	auto repeated = std::chrono::duration<double, std::micro> (std::chrono::steady_clock::now () - start).count ();
+	printf ("%-16s first pass %9.1f µs, following passes %9.1f µs each (%zu elements, checksum %g)\n",
+	        title, first, repeated / (numInstances - 1), collector.elements.size (), sum / numInstances);
+}
+
+//------------------------------------------------------------------------
+/** creates a view of every view and template node of the file through the view factory, the same
+ *	attributes are used in every pass like a UIDescription does when a template is instantiated
+ *	more than once
+ */
+static void runViewFactory (const std::string& path, uint32_t numInstances)
+{
+	UIDescription description (CResourceDescription (path.data ()));
+	if (!description.parse ())
+		return;
+	CFileStream file;
+	if (!file.open (path.data (), CFileStream::kReadMode))
+		return;
+	Xml::InputStreamContentProvider provider (file);
+	Collector<UIAttributes> collector;
+	collector.viewsOnly = true;
+	Xml::Parser parser;
+	if (!parser.parse (&provider, &collector))
+		return;
+
+	UIViewFactory factory;
+	uint32_t numViews = 0;
+	auto createViews = [&] () {
+		for (const auto& element : collector.elements)
+		{
+			if (auto view = factory.createView (*element, &description))
+			{
+				++numViews;
+				view->forget ();
+			}
+		}
+	};
+	auto start = std::chrono::steady_clock::now ();
+	createViews ();
+	auto first = std::chrono::duration<double, std::micro> (std::chrono::steady_clock::now () - start).count ();
+	start = std::chrono::steady_clock::now ();
+	for (auto i = 1u; i < numInstances; ++i)
+		createViews ();
+	auto repeated = std::chrono::duration<double, std::micro> (std::chrono::steady_clock::now () - start).count ();
+	printf ("%-16s first pass %9.1f µs, following passes %9.1f µs each (%u views)\n", "createView",
+	        first, repeated / (numInstances - 1), numViews / numInstances);
+}
+
+//------------------------------------------------------------------------
+int main (int argc, char* argv[])
+{
+	std::string path;
+	if (argc > 1)
+		path = argv[1];
+	else
+	{
+		path = __FILE__;
+		removeLastPathComponent (path);
+		path += "/../../uidescription/editing/uidescriptioneditor.uidesc";
+	}
+	printf ("%s\n", path.data ());
+	run<LegacyAttributes> ("legacy", path, 100);
+	run<UIAttributes> ("UIAttributes", path, 100);
+	runViewFactory (path, 100);
+	return 0;
+}
@@ -0,0 +1,150 @@
+// This file is part of VSTGUI. It is subject to the license terms 
+// in the LICENSE file found in the top-level directory of this
+// distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
+
+#include "vstgui/lib/cresourcedescription.h"
+#include "vstgui/uidescription/binaryuidescription.h"
+#include "vstgui/uidescription/cstream.h"
+#include "vstgui/uidescription/xmlparser.h"
+
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <unistd.h>
+
+namespace VSTGUI { void* soHandle = nullptr; }
+
+using namespace VSTGUI;
+
+//------------------------------------------------------------------------
+static std::string createUIDesc (size_t minSize)
+{
+	std::string xml = "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+	                  "<vstgui-ui-description version=\"1\">\n\t<bitmaps>\n";
+	std::string base64Line (76, 'A');
+	for (auto i = 0; i < 8; ++i)
+	{
+		xml += "\t\t<bitmap name=\"bitmap" + std::to_string (i) + "\" path=\"bitmap" +
+		       std::to_string (i) + ".png\">\n\t\t\t<data encoding=\"base64\">\n";
+		for (auto line = 0; line < 2000; ++line)
+			xml += "\t\t\t\t" + base64Line + "\n";
+		xml += "\t\t\t</data>\n\t\t</bitmap>\n";
+	}
+	xml += "\t</bitmaps>\n\t<colors>\n";
+	for (auto i = 0; i < 256; ++i)
+		xml += "\t\t<color name=\"color" + std::to_string (i) + "\" rgba=\"#" +
+		       std::to_string (100000 + i) + "ff\"/>\n";
+	xml += "\t</colors>\n";
+	for (auto templateIndex = 0; xml.size () < minSize; ++templateIndex)
+	{
+		xml += "\t<template class=\"CViewContainer\" name=\"template" +
+		       std::to_string (templateIndex) + "\" origin=\"0, 0\" size=\"800, 600\">\n";
+		for (auto i = 0; i < 100; ++i)
+		{
+			auto pos = std::to_string (i * 8) + ", " + std::to_string (i * 6);
+			xml += "\t\t<view class=\"CTextLabel\" origin=\"" + pos +
+			       "\" size=\"80, 20\" font-color=\"color" + std::to_string (i) +
+			       "\" title=\"Label " + std::to_string (i) + "\" text-alignment=\"left\"/>\n";
+		}
+		xml += "\t</template>\n";
+	}
+	xml += "</vstgui-ui-description>\n";
+	return xml;
+}
+
+//------------------------------------------------------------------------
+template <typename Proc>
+static void measure (const char* title, Proc proc)
+{
+	static constexpr auto kIterations = 10;
+	proc (); // warm up
+	auto start = std::chrono::steady_clock::now ();
+	bool result = true;
+	for (auto i = 0; i < kIterations; ++i)
+		result = proc () && result;
+	auto time = std::chrono::duration<double, std::milli> (std::chrono::steady_clock::now () - start).count ();
+	printf ("%-36s %9.2f ms%s\n", title, time / kIterations, result ? "" : " (failed)");
+}
+
+//------------------------------------------------------------------------
+struct NullHandler : Xml::IHandler
+{
+	void startXmlElement (Xml::Parser*, IdStringPtr, UTF8StringPtr*) override {}
+	void endXmlElement (Xml::Parser*, IdStringPtr) override {}
+	void xmlCharData (Xml::Parser*, const int8_t*, int32_t) override {}
+	void xmlComment (Xml::Parser*, IdStringPtr) override {}
+};
+
+//------------------------------------------------------------------------
+int main (int argc, char* argv[])
+{
+	auto basePath = "/tmp/vstgui-uidescloadspeed-" + std::to_string (getpid ());
+	auto xmlPath = basePath + ".uidesc";
+	auto compressedPath = basePath + "-compressed.uidesc";
+	auto binaryPath = basePath + "-binary.uidesc";
+
+	auto xml = createUIDesc (5 * 1024 * 1024);
+	{
+		CFileStream file;
+		if (!file.open (xmlPath.data (), CFileStream::kWriteMode | CFileStream::kTruncateMode))
+			return -1;
+		file.writeRaw (xml.data (), static_cast<uint32_t> (xml.size ()));
+	}
+	{
+		CompressedUIDescription desc (CResourceDescription (xmlPath.data ()));
+		BinaryUIDescription binaryDesc (CResourceDescription (xmlPath.data ()));
+		if (!desc.parse () || !binaryDesc.parse ())
+			return -1;
+		desc.save (compressedPath.data (), CompressedUIDescription::kForceWriteCompressedDesc |
+		                                       CompressedUIDescription::kNoPlainXmlFileBackup);
+		binaryDesc.save (binaryPath.data (), BinaryUIDescription::kForceWriteBinaryDesc |
+		                                         CompressedUIDescription::kNoPlainXmlFileBackup);
+	}
+	printf ("uidesc size: %.2f MB\n\n", xml.size () / (1024. * 1024.));
+
+	measure ("xml parser, streamed from file", [&] () {
+		CFileStream file;
+		if (!file.open (xmlPath.data (), CFileStream::kReadMode))
+			return false;
+		Xml::InputStreamContentProvider provider (file);
+		NullHandler handler;
+		Xml::Parser parser;
+		return parser.parse (&provider, &handler);
+	});
+	measure ("xml parser, in place from mapping", [&] () {
+		CMappedFileInputStream file;
+		if (!file.open (xmlPath.data ()))
+			return false;
+		size_t size;
+		auto data = file.getMappedData (size);
+		Xml::MemoryContentProvider provider (data, static_cast<uint32_t> (size));
+		NullHandler handler;
+		Xml::Parser parser;
+		return parser.parse (&provider, &handler);
+	});
+	measure ("uidesc, streamed from file", [&] () {
+		CFileStream file;
+		if (!file.open (xmlPath.data (), CFileStream::kReadMode))
+			return false;
+		Xml::InputStreamContentProvider provider (file);
+		UIDescription desc (&provider);
+		return desc.parse ();
+	});
+	measure ("uidesc, mapped", [&] () {
+		UIDescription desc (CResourceDescription (xmlPath.data ()));
+		return desc.parse ();
+	});
+	measure ("compressed uidesc, mapped", [&] () {
+		CompressedUIDescription desc (CResourceDescription (compressedPath.data ()));
+		return desc.parse () && desc.getOriginalIsCompressed ();
+	});
+	measure ("binary uidesc, mapped", [&] () {
+		BinaryUIDescription desc (CResourceDescription (binaryPath.data ()));
+		return desc.parse () && desc.getOriginalIsBinary ();
+	});
+
+	unlink (xmlPath.data ());
+	unlink (compressedPath.data ());
+	unlink (binaryPath.data ());
+	return 0;
+}
@@ -0,0 +1,83 @@
+// This file is part of VSTGUI. It is subject to the license terms 
+// in the LICENSE file found in the top-level directory of this
+// distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
+
+#include "../unittests.h"
+#include "../../../lib/cstring.h"
+#include "../../../lib/platform/iplatformstring.h"
+#include "../../../lib/platform/linux/cairofont.h"
+
+namespace VSTGUI {
+
+namespace {
+
+//------------------------------------------------------------------------
+CCoord stringWidth (IPlatformFont* font, UTF8StringPtr str)
+{
+	auto string = IPlatformString::createWithUTF8String (str);
+	return font->getPainter ()->getStringWidth (nullptr, string);
+}
+
+//------------------------------------------------------------------------
+/** restores the capacity of the glyph run cache when a test ends, even if an expectation fails */
+struct GlyphRunCacheCapacityGuard
+{
+	GlyphRunCacheCapacityGuard () : capacity (Cairo::GlyphRunCache::getCapacity ()) {}
+	~GlyphRunCacheCapacityGuard () { Cairo::GlyphRunCache::setCapacity (capacity); }
+
+	size_t capacity;
+};
+
+} // anonymous
+
+//------------------------------------------------------------------------
+TESTCASE(CairoGlyphRunCacheTest,
+
+	TEST(cachedWidthsAreReused,
+		auto font = IPlatformFont::create (UTF8String ("Liberation Sans"), 12, 0);
+		if (!font)
+			return true; // no font installed
+		Cairo::GlyphRunCache::clear ();
+		auto width = stringWidth (font, "-6.0 dB");
+		EXPECT(width > 0.);
+		EXPECT(Cairo::GlyphRunCache::getStatistics ().misses == 1);
+		EXPECT(stringWidth (font, "-6.0 dB") == width);
+		EXPECT(stringWidth (font, "440 Hz") > 0.);
+		EXPECT(Cairo::GlyphRunCache::getStatistics ().hits == 1);
+		EXPECT(Cairo::GlyphRunCache::getStatistics ().misses == 2);
+		EXPECT(Cairo::GlyphRunCache::getStatistics ().numRuns == 2);
+	);
+
+	TEST(leastRecentlyUsedRunIsEvicted,
+		auto font = IPlatformFont::create (UTF8String ("Liberation Sans"), 12, 0);
+		if (!font)
+			return true; // no font installed
+		GlyphRunCacheCapacityGuard capacityGuard;
+		Cairo::GlyphRunCache::clear ();
+		Cairo::GlyphRunCache::setCapacity (2);
+		stringWidth (font, "a");
+		stringWidth (font, "b");
+		stringWidth (font, "a");
+		stringWidth (font, "c");
+		EXPECT(Cairo::GlyphRunCache::getStatistics ().numRuns == 2);
+		stringWidth (font, "a");
+		EXPECT(Cairo::GlyphRunCache::getStatistics ().hits == 2);
+		stringWidth (font, "b");
+		EXPECT(Cairo::GlyphRunCache::getStatistics ().misses == 4);
+	);
+
+	TEST(disabledCacheStillMeasures,
+		auto font = IPlatformFont::create (UTF8String ("Liberation Sans"), 12, 0);
+		if (!font)
+			return true; // no font installed
+		GlyphRunCacheCapacityGuard capacityGuard;
+		Cairo::GlyphRunCache::clear ();
+		auto width = stringWidth (font, "440 Hz");
+		Cairo::GlyphRunCache::setCapacity (0);
+		EXPECT(Cairo::GlyphRunCache::getStatistics ().numRuns == 0);
+		EXPECT(stringWidth (font, "440 Hz") == width);
+		EXPECT(Cairo::GlyphRunCache::getStatistics ().numRuns == 0);
+	);
+);
+
+} // VSTGUI
@@ -0,0 +1,462 @@
+// This file is part of VSTGUI. It is subject to the license terms
+// in the LICENSE file found in the top-level directory of this
+// distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
+
+#include "../../../lib/cbitmapfilter.h"
+#include "../../../lib/cbitmap.h"
+#include "../../../lib/ccolor.h"
+#include "../unittests.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <vector>
+
+namespace VSTGUI {
+
+namespace {
+
+//------------------------------------------------------------------------
+SharedPointer<CBitmap> createBitmap (uint32_t width, uint32_t height, const CColor& color)
+{
+	auto bitmap = owned (new CBitmap (width, height));
+	auto accessor = owned (CBitmapPixelAccess::create (bitmap));
+	do
+	{
+		accessor->setColor (color);
+	} while (++(*accessor));
+	return bitmap;
+}
+
+//------------------------------------------------------------------------
+CColor getPixel (CBitmap* bitmap, uint32_t x, uint32_t y)
+{
+	auto accessor = owned (CBitmapPixelAccess::create (bitmap));
+	accessor->setPosition (x, y);
+	CColor color;
+	accessor->getColor (color);
+	return color;
+}
+
+//------------------------------------------------------------------------
+void setPixel (CBitmap* bitmap, uint32_t x, uint32_t y, const CColor& color)
+{
+	auto accessor = owned (CBitmapPixelAccess::create (bitmap));
+	accessor->setPosition (x, y);
+	accessor->setColor (color);
+}
+
+//------------------------------------------------------------------------
+SharedPointer<BitmapFilter::IFilter> createFilter (IdStringPtr name, CBitmap* bitmap)
+{
+	auto filter = owned (BitmapFilter::Factory::getInstance ().createFilter (name));
+	if (filter)
+		filter->setProperty (BitmapFilter::Standard::Property::kInputBitmap, bitmap);
+	return filter;
+}
+
+//------------------------------------------------------------------------
+bool runFilter (IdStringPtr name, CBitmap* bitmap, int32_t radius)
+{
+	auto filter = owned (BitmapFilter::Factory::getInstance ().createFilter (name));
+	if (!filter)
+		return false;
+	filter->setProperty (BitmapFilter::Standard::Property::kInputBitmap, bitmap);
+	filter->setProperty (BitmapFilter::Standard::Property::kRadius, radius);
+	return filter->run (true);
+}
+
+//------------------------------------------------------------------------
+SharedPointer<CBitmap> createPatternBitmap (uint32_t width, uint32_t height)
+{
+	auto bitmap = owned (new CBitmap (width, height));
+	auto accessor = owned (CBitmapPixelAccess::create (bitmap));
+	do
+	{
+		auto x = accessor->getX ();
+		auto y = accessor->getY ();
+		accessor->setColor (CColor (static_cast<uint8_t> (x * 7), static_cast<uint8_t> (y * 5),
+		                            static_cast<uint8_t> ((x * y) % 256), 255));
+	} while (++(*accessor));
+	return bitmap;
+}
+
+//------------------------------------------------------------------------
+/** records the threads the rows are processed on */
+class RowThreadsFilter : public BitmapFilter::FilterBase
+{
+public:
+	RowThreadsFilter (bool tileSafe) : FilterBase ("") { setTileSafe (tileSafe); }
+
+	bool run (bool replace) override
+	{
+		processRowBands (100, 100, [this] (uint32_t firstRow, uint32_t lastRow) {
+			std::lock_guard<std::mutex> guard (mutex);
+			threads.insert (std::this_thread::get_id ());
+		});
+		return true;
+	}
+
+	std::mutex mutex;
+	std::set<std::thread::id> threads;
+};
+
+//------------------------------------------------------------------------
+/** raw pixel bytes from a linear congruential generator */
+SharedPointer<CBitmap> createNoiseBitmap (uint32_t width, uint32_t height)
+{
+	auto bitmap = owned (new CBitmap (width, height));
+	auto accessor = owned (CBitmapPixelAccess::create (bitmap));
+	uint32_t seed = 1234;
+	for (auto y = 0u; y < height; ++y)
+	{
+		auto row = accessor->getRowAddress (y);
+		for (auto x = 0u; x < width * 4; ++x)
+		{
+			seed = seed * 1664525u + 1013904223u;
+			row[x] = static_cast<uint8_t> (seed >> 24);
+		}
+	}
+	return bitmap;
+}
+
+//------------------------------------------------------------------------
+SharedPointer<CBitmap> runTiledFilter (IdStringPtr name, uint32_t maxThreads)
+{
+	BitmapFilter::Tiling::setMaxThreads (maxThreads);
+	auto filter = createFilter (name, createPatternBitmap (61, 47));
+	filter->setProperty (BitmapFilter::Standard::Property::kRadius, (int32_t)5);
+	filter->setProperty (BitmapFilter::Standard::Property::kOutputRect, CRect (0, 0, 83, 29));
+	if (!filter->run (false))
+		return nullptr;
+	return shared (dynamic_cast<CBitmap*> (
+	    filter->getProperty (BitmapFilter::Standard::Property::kOutputBitmap).getObject ()));
+}
+
+//------------------------------------------------------------------------
+bool equalPixels (CBitmap* b1, CBitmap* b2)
+{
+	auto a1 = owned (CBitmapPixelAccess::create (b1));
+	auto a2 = owned (CBitmapPixelAccess::create (b2));
+	if (a1->getBitmapWidth () != a2->getBitmapWidth () ||
+	    a1->getBitmapHeight () != a2->getBitmapHeight ())
+		return false;
+	do
+	{
+		uint32_t v1, v2;
+		a1->getValue (v1);
+		a2->getValue (v2);
+		if (v1 != v2)
+			return false;
+	} while (++(*a1) && ++(*a2));
+	return true;
+}
+
+//------------------------------------------------------------------------
+std::vector<uint8_t> getPixelBytes (CBitmap* bitmap)
+{
+	auto accessor = owned (CBitmapPixelAccess::create (bitmap));
+	auto rowSize = accessor->getBitmapWidth () * 4;
+	std::vector<uint8_t> bytes (rowSize * accessor->getBitmapHeight ());
+	for (auto y = 0u; y < accessor->getBitmapHeight (); ++y)
+		memcpy (bytes.data () + y * rowSize, accessor->getRowAddress (y), rowSize);
+	return bytes;
+}
+
+//------------------------------------------------------------------------
+/** scalar version of one pass of the separable blur filters, rounds by adding 0.5 and truncating */
+std::vector<uint8_t> referenceBlurPass (const std::vector<uint8_t>& src, int32_t width,
+                                        int32_t height, bool horizontal,
+                                        const std::vector<float>& weights, float scale)
+{
+	std::vector<uint8_t> dst (src.size ());
+	auto halfSize = static_cast<int32_t> (weights.size () / 2);
+	for (auto y = 0; y < height; ++y)
+	{
+		for (auto x = 0; x < width; ++x)
+		{
+			for (auto c = 0; c < 4; ++c)
+			{
+				auto sum = 0.f;
+				for (auto i = -halfSize; i <= halfSize; ++i)
+				{
+					auto sx = horizontal ? std::min (width - 1, std::max (0, x + i)) : x;
+					auto sy = horizontal ? y : std::min (height - 1, std::max (0, y + i));
+					float value = src[(sy * width + sx) * 4 + c];
+					sum += value * weights[i + halfSize];
+				}
+				auto result = std::min (255.f, std::max (0.f, sum * scale + 0.5f));
+				dst[(y * width + x) * 4 + c] = static_cast<uint8_t> (result);
+			}
+		}
+	}
+	return dst;
+}
+
+//------------------------------------------------------------------------
+std::vector<uint8_t> referenceBlur (CBitmap* bitmap, const std::vector<float>& weights, float scale)
+{
+	auto accessor = owned (CBitmapPixelAccess::create (bitmap));
+	auto width = static_cast<int32_t> (accessor->getBitmapWidth ());
+	auto height = static_cast<int32_t> (accessor->getBitmapHeight ());
+	auto pixels = getPixelBytes (bitmap);
+	pixels = referenceBlurPass (pixels, width, height, true, weights, scale);
+	return referenceBlurPass (pixels, width, height, false, weights, scale);
+}
+
+//------------------------------------------------------------------------
+std::vector<float> gaussianWeights (int32_t radius)
+{
+	auto sigma = std::max (0.5, radius / 3.);
+	std::vector<float> weights;
+	float sum = 0.f;
+	for (auto i = -radius; i <= radius; ++i)
+	{
+		weights.push_back (static_cast<float> (std::exp (-(i * i) / (2. * sigma * sigma))));
+		sum += weights.back ();
+	}
+	for (auto& w : weights)
+		w /= sum;
+	return weights;
+}
+
+} // anonymous
+
+TESTCASE(CBitmapFilterTest,
+
+	static uint32_t maxThreads = 0;
+	static uint32_t minPixels = 0;
+
+	SETUP(
+		maxThreads = BitmapFilter::Tiling::getMaxThreads ();
+		minPixels = BitmapFilter::Tiling::getMinPixels ();
+	);
+
+	TEARDOWN(
+		BitmapFilter::Tiling::setMaxThreads (maxThreads);
+		BitmapFilter::Tiling::setMinPixels (minPixels);
+	);
+
+	TEST(boxBlurKeepsUniformColor,
+		auto bitmap = createBitmap (20, 10, CColor (40, 80, 120, 255));
+		EXPECT(runFilter (BitmapFilter::Standard::kBoxBlur, bitmap, 4));
+		EXPECT(getPixel (bitmap, 0, 0) == CColor (40, 80, 120, 255));
+		EXPECT(getPixel (bitmap, 10, 5) == CColor (40, 80, 120, 255));
+		EXPECT(getPixel (bitmap, 19, 9) == CColor (40, 80, 120, 255));
+	);
+
+	TEST(boxBlurSpreadsPixel,
+		auto bitmap = createBitmap (11, 11, kTransparentCColor);
+		setPixel (bitmap, 5, 5, CColor (255, 255, 255, 255));
+		EXPECT(runFilter (BitmapFilter::Standard::kBoxBlur, bitmap, 2));
+		// radius 2 is a 3x3 box
+		auto center = getPixel (bitmap, 5, 5);
+		EXPECT(center.alpha == 28);
+		EXPECT(getPixel (bitmap, 4, 4) == center);
+		EXPECT(getPixel (bitmap, 6, 6) == center);
+		EXPECT(getPixel (bitmap, 7, 5).alpha == 0);
+		EXPECT(getPixel (bitmap, 5, 3).alpha == 0);
+	);
+
+	TEST(rowAccess,
+		auto bitmap = createBitmap (7, 3, kTransparentCColor);
+		auto accessor = owned (CBitmapPixelAccess::create (bitmap));
+		EXPECT(accessor->isAlphaPremultiplied ());
+		EXPECT(accessor->getBytesPerRow () >= 7 * 4);
+		EXPECT(accessor->getPixelFormat () == accessor->getPlatformBitmapPixelAccess ()->getPixelFormat ());
+		uint32_t value = 0x01020304;
+		memcpy (accessor->getRowAddress (2) + 5 * 4, &value, sizeof (value));
+		accessor->setPosition (5, 2);
+		uint32_t value2 = 0;
+		accessor->getValue (value2);
+		EXPECT(value == value2);
+	);
+
+	TEST(setColorKeepsAlpha,
+		auto bitmap = createBitmap (7, 3, CColor (10, 20, 30, 255));
+		setPixel (bitmap, 5, 1, CColor (0, 0, 0, 0));
+		auto filter = createFilter (BitmapFilter::Standard::kSetColor, bitmap);
+		filter->setProperty (BitmapFilter::Standard::Property::kInputColor, CColor (200, 100, 50, 255));
+		filter->setProperty (BitmapFilter::Standard::Property::kIgnoreAlphaColorValue, (int32_t)1);
+		EXPECT(filter->run (true));
+		EXPECT(getPixel (bitmap, 0, 0) == CColor (200, 100, 50, 255));
+		EXPECT(getPixel (bitmap, 6, 2) == CColor (200, 100, 50, 255));
+		EXPECT(getPixel (bitmap, 5, 1) == CColor (0, 0, 0, 0));
+	);
+
+	TEST(setColorPremultipliesWithAlpha,
+		auto bitmap = createBitmap (7, 1, CColor (0, 0, 0, 128));
+		auto filter = createFilter (BitmapFilter::Standard::kSetColor, bitmap);
+		filter->setProperty (BitmapFilter::Standard::Property::kInputColor, CColor (255, 255, 0, 255));
+		EXPECT(filter->run (true));
+		EXPECT(getPixel (bitmap, 1, 0) == CColor (128, 128, 0, 128));
+		EXPECT(getPixel (bitmap, 6, 0) == CColor (128, 128, 0, 128));
+	);
+
+	TEST(setColorWithAlpha,
+		auto bitmap = createBitmap (5, 1, CColor (10, 20, 30, 255));
+		auto filter = createFilter (BitmapFilter::Standard::kSetColor, bitmap);
+		filter->setProperty (BitmapFilter::Standard::Property::kInputColor, CColor (255, 0, 0, 51));
+		filter->setProperty (BitmapFilter::Standard::Property::kIgnoreAlphaColorValue, (int32_t)0);
+		EXPECT(filter->run (true));
+		EXPECT(getPixel (bitmap, 4, 0) == CColor (51, 0, 0, 51));
+	);
+
+	TEST(grayscale,
+		auto bitmap = createBitmap (7, 2, CColor (100, 150, 200, 255));
+		setPixel (bitmap, 6, 1, CColor (0, 255, 0, 255));
+		auto filter = createFilter (BitmapFilter::Standard::kGrayscale, bitmap);
+		EXPECT(filter->run (true));
+		EXPECT(getPixel (bitmap, 0, 0) == CColor (140, 140, 140, 255));
+		EXPECT(getPixel (bitmap, 5, 1) == CColor (140, 140, 140, 255));
+		EXPECT(getPixel (bitmap, 6, 1) == CColor (150, 150, 150, 255));
+	);
+
+	TEST(replaceColor,
+		auto bitmap = createBitmap (7, 2, kRedCColor);
+		setPixel (bitmap, 2, 0, kGreenCColor);
+		setPixel (bitmap, 6, 1, kGreenCColor);
+		auto filter = createFilter (BitmapFilter::Standard::kReplaceColor, bitmap);
+		filter->setProperty (BitmapFilter::Standard::Property::kInputColor, kGreenCColor);
+		filter->setProperty (BitmapFilter::Standard::Property::kOutputColor, kBlueCColor);
+		EXPECT(filter->run (true));
+		EXPECT(getPixel (bitmap, 2, 0) == kBlueCColor);
+		EXPECT(getPixel (bitmap, 6, 1) == kBlueCColor);
+		EXPECT(getPixel (bitmap, 3, 0) == kRedCColor);
+		EXPECT(getPixel (bitmap, 5, 1) == kRedCColor);
+	);
+
+	TEST(rowBandsCoverAllRows,
+		BitmapFilter::Tiling::setMinPixels (0);
+		BitmapFilter::Tiling::setMaxThreads (3);
+		std::vector<uint32_t> rows (101, 0);
+		std::set<std::thread::id> threads;
+		std::mutex mutex;
+		BitmapFilter::Tiling::processRowBands (10, 101, [&] (uint32_t firstRow, uint32_t lastRow) {
+			for (auto y = firstRow; y < lastRow; ++y)
+				++rows[y];
+			std::lock_guard<std::mutex> guard (mutex);
+			threads.insert (std::this_thread::get_id ());
+		});
+		EXPECT(std::all_of (rows.begin (), rows.end (), [] (uint32_t count) { return count == 1; }));
+		EXPECT(threads.size () <= 3);
+	);
+
+	TEST(smallBitmapsStayOnCallingThread,
+		BitmapFilter::Tiling::setMinPixels (1000);
+		BitmapFilter::Tiling::setMaxThreads (4);
+		uint32_t numCalls = 0;
+		BitmapFilter::Tiling::processRowBands (10, 99, [&] (uint32_t firstRow, uint32_t lastRow) {
+			EXPECT(firstRow == 0);
+			EXPECT(lastRow == 99);
+			++numCalls;
+		});
+		EXPECT(numCalls == 1);
+		BitmapFilter::Tiling::setMaxThreads (0);
+		EXPECT(BitmapFilter::Tiling::getMaxThreads () == 1);
+	);
+
+	TEST(workersRestartAfterStop,
+		BitmapFilter::Tiling::setMinPixels (0);
+		BitmapFilter::Tiling::setMaxThreads (3);
+		for (auto i = 0; i < 2; ++i)
+		{
+			std::vector<uint32_t> rows (50, 0);
+			BitmapFilter::Tiling::processRowBands (10, 50, [&] (uint32_t firstRow, uint32_t lastRow) {
+				for (auto y = firstRow; y < lastRow; ++y)
+					++rows[y];
+			});
+			EXPECT(std::all_of (rows.begin (), rows.end (), [] (uint32_t count) { return count == 1; }));
+			BitmapFilter::Tiling::stopWorkers ();
+		}
+		BitmapFilter::Tiling::stopWorkers ();
+	);
+
+	TEST(onlyTileSafeFiltersUseWorkers,
+		BitmapFilter::Tiling::setMinPixels (0);
+		BitmapFilter::Tiling::setMaxThreads (4);
+		auto filter = makeOwned<RowThreadsFilter> (false);
+		EXPECT(filter->isTileSafe () == false);
+		filter->run (false);
+		EXPECT(filter->threads.size () == 1);
+		EXPECT(*filter->threads.begin () == std::this_thread::get_id ());
+		for (auto name : {BitmapFilter::Standard::kBoxBlur, BitmapFilter::Standard::kGaussianBlur,
+		                  BitmapFilter::Standard::kSetColor, BitmapFilter::Standard::kGrayscale,
+		                  BitmapFilter::Standard::kReplaceColor, BitmapFilter::Standard::kScaleLinear,
+		                  BitmapFilter::Standard::kScaleBilinear})
+		{
+			auto standardFilter = owned (BitmapFilter::Factory::getInstance ().createFilter (name));
+			auto filterBase = dynamic_cast<BitmapFilter::FilterBase*> (standardFilter.get ());
+			EXPECT(filterBase);
+			EXPECT(filterBase->isTileSafe ());
+		}
+	);
+
+	TEST(tiledFiltersMatchSingleThreaded,
+		BitmapFilter::Tiling::setMinPixels (0);
+		for (auto name : {BitmapFilter::Standard::kBoxBlur, BitmapFilter::Standard::kGaussianBlur,
+		                  BitmapFilter::Standard::kGrayscale, BitmapFilter::Standard::kScaleLinear,
+		                  BitmapFilter::Standard::kScaleBilinear})
+		{
+			auto single = runTiledFilter (name, 1);
+			auto tiled = runTiledFilter (name, 4);
+			EXPECT(single);
+			EXPECT(tiled);
+			EXPECT(equalPixels (single, tiled));
+		}
+	);
+
+	TEST(boxBlurMatchesScalarReference,
+		for (auto radius : {2, 5, 8})
+		{
+			auto bitmap = createNoiseBitmap (200, 100);
+			auto halfSize = radius / 2;
+			std::vector<float> weights (static_cast<size_t> (halfSize * 2 + 1), 1.f);
+			auto expected = referenceBlur (bitmap, weights, 1.f / static_cast<float> (halfSize * 2 + 1));
+			EXPECT(runFilter (BitmapFilter::Standard::kBoxBlur, bitmap, radius));
+			EXPECT(getPixelBytes (bitmap) == expected);
+		}
+	);
+
+	TEST(gaussianBlurMatchesScalarReference,
+		for (auto radius : {1, 2, 3, 6})
+		{
+			// rounding differences only show up in a few pixels of larger bitmaps
+			auto bitmap = createNoiseBitmap (200, 100);
+			auto expected = referenceBlur (bitmap, gaussianWeights (radius), 1.f);
+			EXPECT(runFilter (BitmapFilter::Standard::kGaussianBlur, bitmap, radius));
+			EXPECT(getPixelBytes (bitmap) == expected);
+		}
+	);
+
+	TEST(gaussianBlurIsRegistered,
+		auto& factory = BitmapFilter::Factory::getInstance ();
+		auto filter = owned (factory.createFilter (BitmapFilter::Standard::kGaussianBlur));
+		EXPECT(filter);
+		EXPECT(filter->getPropertyType (BitmapFilter::Standard::Property::kRadius) == BitmapFilter::Property::kInteger);
+	);
+
+	TEST(gaussianBlurIsSymmetricAndDecreasing,
+		auto bitmap = createBitmap (21, 21, kTransparentCColor);
+		setPixel (bitmap, 10, 10, CColor (255, 255, 255, 255));
+		EXPECT(runFilter (BitmapFilter::Standard::kGaussianBlur, bitmap, 6));
+		auto center = getPixel (bitmap, 10, 10).alpha;
+		EXPECT(center > 0);
+		EXPECT(getPixel (bitmap, 8, 10) == getPixel (bitmap, 12, 10));
+		EXPECT(getPixel (bitmap, 10, 8) == getPixel (bitmap, 8, 10));
+		EXPECT(getPixel (bitmap, 9, 10).alpha < center);
+		EXPECT(getPixel (bitmap, 8, 10).alpha < getPixel (bitmap, 9, 10).alpha);
+		EXPECT(getPixel (bitmap, 10, 17).alpha == 0);
+	);
+
+	TEST(gaussianBlurKeepsUniformColor,
+		auto bitmap = createBitmap (16, 16, CColor (200, 100, 50, 255));
+		EXPECT(runFilter (BitmapFilter::Standard::kGaussianBlur, bitmap, 3));
+		EXPECT(getPixel (bitmap, 0, 0) == CColor (200, 100, 50, 255));
+		EXPECT(getPixel (bitmap, 8, 8) == CColor (200, 100, 50, 255));
+	);
+);
+
+} // VSTGUI
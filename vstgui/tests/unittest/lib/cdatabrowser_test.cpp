@@ -0,0 +1,155 @@
+// This file is part of VSTGUI. It is subject to the license terms
+// in the LICENSE file found in the top-level directory of this
+// distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
+
+#include "../../../lib/cdatabrowser.h"
+#include "../../../lib/cdrawcontext.h"
+#include "../../../lib/idatabrowserdelegate.h"
+#include "../unittests.h"
+#include <vector>
+
+namespace VSTGUI {
+
+namespace {
+
+//------------------------------------------------------------------------
+class NullDrawContext : public CDrawContext
+{
+public:
+	NullDrawContext (const CRect& r) : CDrawContext (r) { init (); }
+
+	void drawLine (const LinePair& line) override {}
+	void drawLines (const LineList& lines) override {}
+	void drawPolygon (const PointList& polygonPointList, const CDrawStyle drawStyle) override {}
+	void drawRect (const CRect& rect, const CDrawStyle drawStyle) override {}
+	void drawArc (const CRect& rect, const float startAngle1, const float endAngle2, const CDrawStyle drawStyle) override {}
+	void drawEllipse (const CRect& rect, const CDrawStyle drawStyle) override {}
+	void drawPoint (const CPoint& point, const CColor& color) override {}
+	void drawBitmap (CBitmap* bitmap, const CRect& dest, const CPoint& offset, float alpha) override {}
+	void clearRect (const CRect& rect) override {}
+	CGraphicsPath* createGraphicsPath () override { return nullptr; }
+	CGraphicsPath* createTextPath (const CFontRef font, UTF8StringPtr text) override { return nullptr; }
+	void drawGraphicsPath (CGraphicsPath* path, PathDrawMode mode, CGraphicsTransform* transformation) override {}
+	void fillLinearGradient (CGraphicsPath* path, const CGradient& gradient, const CPoint& startPoint, const CPoint& endPoint, bool evenOdd, CGraphicsTransform* transformation) override {}
+	void fillRadialGradient (CGraphicsPath* path, const CGradient& gradient, const CPoint& center, CCoord radius, const CPoint& originOffset, bool evenOdd, CGraphicsTransform* transformation) override {}
+};
+
+//------------------------------------------------------------------------
+/** 1000 rows of 10 pixels, the columns are 50, 30 and 20 pixels wide */
+class Delegate : public DataBrowserDelegateAdapter, public NonAtomicReferenceCounted
+{
+public:
+	struct DrawnCell
+	{
+		int32_t row;
+		int32_t column;
+		bool selected;
+	};
+
+	int32_t dbGetNumRows (CDataBrowser* browser) override { return 1000; }
+	int32_t dbGetNumColumns (CDataBrowser* browser) override { return 3; }
+	CCoord dbGetRowHeight (CDataBrowser* browser) override { return 10.; }
+	CCoord dbGetCurrentColumnWidth (int32_t index, CDataBrowser* browser) override
+	{
+		return index == 0 ? 50. : (index == 1 ? 30. : 20.);
+	}
+	void dbDrawCell (CDrawContext* context, const CRect& size, int32_t row, int32_t column,
+	                 int32_t flags, CDataBrowser* browser) override
+	{
+		drawnCells.emplace_back (
+		    DrawnCell {row, column, (flags & IDataBrowserDelegate::kRowSelected) != 0});
+	}
+	void dbSelectionChanged (CDataBrowser* browser) override { ++numSelectionChanges; }
+
+	std::vector<DrawnCell> drawnCells;
+	int32_t numSelectionChanges {0};
+};
+
+static const CDataBrowser::Selection multiSelection = {5, 2, 900};
+
+} // anonymous
+
+//------------------------------------------------------------------------
+TESTCASE(CDataBrowserTest,
+
+	static Delegate* delegate = nullptr;
+	static CDataBrowser* browser = nullptr;
+
+	SETUP(
+		delegate = new Delegate ();
+		browser = new CDataBrowser (CRect (0, 0, 100, 100), delegate, CDataBrowser::kMultiSelectionStyle | CScrollView::kDontDrawFrame);
+		browser->recalculateLayout ();
+		delegate->forget ();
+	);
+
+	TEARDOWN(
+		browser->forget ();
+		browser = nullptr;
+		delegate = nullptr;
+	);
+
+	TEST(cellBounds,
+		EXPECT(browser->getCellBounds (CDataBrowser::Cell (3, 0)) == CRect (0, 30, 50, 40));
+		EXPECT(browser->getCellBounds (CDataBrowser::Cell (3, 2)) == CRect (80, 30, 100, 40));
+	);
+
+	TEST(cellAt,
+		auto cell = browser->getCellAt (CPoint (55, 25));
+		EXPECT(cell.row == 2);
+		EXPECT(cell.column == 1);
+		cell = browser->getCellAt (CPoint (80, 95));
+		EXPECT(cell.row == 9);
+		EXPECT(cell.column == 2);
+	);
+
+	TEST(onlyVisibleRowsAreDrawn,
+		NullDrawContext context (CRect (0, 0, 100, 100));
+		browser->drawRect (&context, CRect (0, 20, 100, 40));
+		EXPECT(delegate->drawnCells.size () == 6);
+		EXPECT(delegate->drawnCells.front ().row == 2);
+		EXPECT(delegate->drawnCells.back ().row == 3);
+		EXPECT(delegate->drawnCells.back ().column == 2);
+	);
+
+	TEST(selectedRowsAreDrawnSelected,
+		browser->selectRow (3);
+		EXPECT(browser->isRowSelected (3));
+		EXPECT(browser->isRowSelected (2) == false);
+		NullDrawContext context (CRect (0, 0, 100, 100));
+		browser->drawRect (&context, CRect (0, 20, 100, 40));
+		for (const auto& cell : delegate->drawnCells)
+			EXPECT(cell.selected == (cell.row == 3));
+	);
+
+	TEST(multiSelection,
+		browser->selectRow (5);
+		browser->selectRow (2);
+		browser->selectRow (900);
+		browser->selectRow (5);
+		EXPECT(browser->getSelection () == multiSelection);
+		EXPECT(browser->getSelectedRow () == 5);
+		EXPECT(delegate->numSelectionChanges == 3);
+		browser->unselectRow (2);
+		EXPECT(browser->isRowSelected (2) == false);
+		EXPECT(browser->getSelection ().size () == 2);
+		browser->unselectAll ();
+		EXPECT(browser->getSelection ().empty ());
+		EXPECT(browser->isRowSelected (5) == false);
+		EXPECT(browser->isRowSelected (900) == false);
+	);
+
+	TEST(exclusiveSelection,
+		browser->selectRow (5);
+		browser->selectRow (7);
+		browser->setSelectedRow (7);
+		EXPECT(browser->getSelection ().size () == 1);
+		EXPECT(browser->getSelectedRow () == 7);
+		EXPECT(browser->isRowSelected (5) == false);
+		browser->setSelectedRow (2000);
+		EXPECT(browser->getSelectedRow () == 999);
+		EXPECT(browser->isRowSelected (7) == false);
+		EXPECT(browser->isRowSelected (999));
+	);
+);
+
+} // VSTGUI
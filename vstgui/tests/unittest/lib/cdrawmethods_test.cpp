@@ -0,0 +1,111 @@
+// This file is part of VSTGUI. It is subject to the license terms
+// in the LICENSE file found in the top-level directory of this
+// distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
+
+#include "../../../lib/cdrawmethods.h"
+#include "../../../lib/cfont.h"
+#include "../../../lib/platform/iplatformfont.h"
+#include "../unittests.h"
+#include "platform_helper.h"
+
+namespace VSTGUI {
+
+namespace {
+
+//------------------------------------------------------------------------
+/** every character is 10 pixels wide */
+class FixedWidthPlatformFont : public IPlatformFont, public IFontPainter
+{
+public:
+	static constexpr CCoord kCharWidth = 10.;
+
+	double getAscent () const override { return 8.; }
+	double getDescent () const override { return 2.; }
+	double getLeading () const override { return 0.; }
+	double getCapHeight () const override { return 7.; }
+	const IFontPainter* getPainter () const override { return this; }
+
+	void drawString (CDrawContext* context, IPlatformString* string, const CPoint& p, bool antialias = true) const override {}
+	CCoord getStringWidth (CDrawContext* context, IPlatformString* string, bool antialias = true) const override
+	{
+		CCoord width = 0.;
+		for (auto c : UnitTest::getPlatformStringText (string))
+		{
+			// count the code points, not the bytes
+			if ((c & 0xC0) != 0x80)
+				width += kCharWidth;
+		}
+		return width;
+	}
+};
+
+//------------------------------------------------------------------------
+class FixedWidthFont : public CFontDesc
+{
+public:
+	FixedWidthFont () : CFontDesc ("FixedWidth", 10.)
+	{
+		platformFont = makeOwned<FixedWidthPlatformFont> ();
+	}
+};
+
+//------------------------------------------------------------------------
+static std::string truncate (CDrawMethods::TextTruncateMode mode, const UTF8String& text,
+                             CCoord maxWidth, uint32_t flags = 0)
+{
+	auto font = makeOwned<FixedWidthFont> ();
+	return CDrawMethods::createTruncatedText (mode, text, font, maxWidth, CPoint (0, 0), flags)
+	    .getString ();
+}
+
+} // anonymous
+
+using namespace CDrawMethods;
+
+//------------------------------------------------------------------------
+TESTCASE(CDrawMethodsTest,
+
+	TEST(textWhichFitsIsNotTruncated,
+		EXPECT(truncate (kTextTruncateTail, "abcdefghij", 100.) == "abcdefghij");
+		EXPECT(truncate (kTextTruncateNone, "abcdefghij", 50.) == "abcdefghij");
+		EXPECT(truncate (kTextTruncateTail, "", 0.) == "");
+	);
+
+	TEST(truncateHead,
+		EXPECT(truncate (kTextTruncateHead, "abcdefghij", 60.) == "..ghij");
+		EXPECT(truncate (kTextTruncateHead, "abcdefghij", 99.) == "..defghij");
+	);
+
+	TEST(truncateTail,
+		EXPECT(truncate (kTextTruncateTail, "abcdefghij", 60.) == "abcd..");
+		EXPECT(truncate (kTextTruncateTail, "abcdefghij", 69.) == "abcd..");
+	);
+
+	TEST(truncateMiddle,
+		EXPECT(truncate (kTextTruncateMiddle, "abcdefghij", 60.) == "ab..ij");
+		EXPECT(truncate (kTextTruncateMiddle, "abcdefghij", 70.) == "abc..ij");
+	);
+
+	TEST(truncateKeepsCodePoints,
+		EXPECT(truncate (kTextTruncateTail, u8"äöüabc", 50.) == u8"äöü..");
+		EXPECT(truncate (kTextTruncateHead, u8"abcäöü", 50.) == u8"..äöü");
+	);
+
+	TEST(textInsetReducesWidth,
+		auto font = makeOwned<FixedWidthFont> ();
+		auto result = createTruncatedText (kTextTruncateTail, "abcdefghij", font, 100., CPoint (10, 0));
+		EXPECT(result.getString () == "abcdef..");
+	);
+
+	TEST(placeholderOnly,
+		EXPECT(truncate (kTextTruncateTail, "abcdefghij", 25.) == "..");
+		EXPECT(truncate (kTextTruncateMiddle, "abcdefghij", 5.) == "..");
+	);
+
+	TEST(returnEmptyIfTruncationIsPlaceholderOnly,
+		EXPECT(truncate (kTextTruncateTail, "abcdefghij", 25., kReturnEmptyIfTruncationIsPlaceholderOnly) == "");
+		EXPECT(truncate (kTextTruncateHead, "abcdefghij", 30., kReturnEmptyIfTruncationIsPlaceholderOnly) == "..j");
+	);
+);
+
+} // VSTGUI
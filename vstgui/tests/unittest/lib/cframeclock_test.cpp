@@ -0,0 +1,155 @@
+// This file is part of VSTGUI. It is subject to the license terms
+// in the LICENSE file found in the top-level directory of this
+// distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
+
+#include "../../../lib/cframe.h"
+#include "../../../lib/cframeclock.h"
+#include "../unittests.h"
+#include <vector>
+
+namespace VSTGUI {
+
+namespace {
+
+using Phase = CFrameClock::Phase;
+
+//------------------------------------------------------------------------
+struct Handler : IFrameClockHandler
+{
+	std::vector<Phase>& calls;
+	CFrameClock* removeFromClock {nullptr};
+
+	Handler (std::vector<Phase>& calls) : calls (calls) {}
+
+	void onFrameClockTick (Phase phase) override
+	{
+		calls.emplace_back (phase);
+		if (removeFromClock)
+			removeFromClock->remove (phase, this);
+	}
+};
+
+//------------------------------------------------------------------------
+struct IdleView : CView
+{
+	IdleView () : CView (CRect (0, 0, 10, 10)) { setWantsIdle (true); }
+
+	void onIdle () override { ++numIdleCalls; }
+
+	uint32_t numIdleCalls {0};
+};
+
+//------------------------------------------------------------------------
+/** restores CView::kDirtyCallAlwaysOnMainThread when a test ends */
+struct DirtyCallGuard
+{
+	DirtyCallGuard (bool state) : previous (CView::kDirtyCallAlwaysOnMainThread)
+	{
+		CView::kDirtyCallAlwaysOnMainThread = state;
+	}
+	~DirtyCallGuard () { CView::kDirtyCallAlwaysOnMainThread = previous; }
+
+	bool previous;
+};
+
+static const std::vector<Phase> allPhases = {Phase::animate, Phase::idle, Phase::invalidate,
+                                             Phase::paint};
+static const std::vector<Phase> animateAndPaint = {Phase::animate, Phase::paint, Phase::animate,
+                                                   Phase::paint};
+
+} // anonymous
+
+//------------------------------------------------------------------------
+TESTCASE(CFrameClockTest,
+
+	TEST(phasesAreCalledInOrder,
+		std::vector<Phase> calls;
+		Handler handler (calls);
+		CFrameClock clock;
+		clock.add (Phase::paint, &handler);
+		clock.add (Phase::invalidate, &handler);
+		clock.add (Phase::animate, &handler);
+		clock.add (Phase::idle, &handler);
+		clock.tick (0.);
+		EXPECT(calls == allPhases);
+		clock.remove (Phase::idle, &handler);
+		clock.remove (Phase::invalidate, &handler);
+		calls.clear ();
+		clock.tick (16.);
+		clock.tick (32.);
+		EXPECT(calls == animateAndPaint);
+	);
+
+	TEST(handlerCanRemoveItselfWhileTicking,
+		std::vector<Phase> calls;
+		Handler handler (calls);
+		CFrameClock clock;
+		handler.removeFromClock = &clock;
+		clock.add (Phase::animate, &handler);
+		clock.tick (0.);
+		clock.tick (16.);
+		EXPECT(calls.size () == 1);
+	);
+
+	TEST(framePacingStatistics,
+		CFrameClock clock;
+		clock.setFrameInterval (10);
+		clock.tick (100.);
+		clock.tick (110.);
+		clock.tick (120.);
+		// two frames are missing
+		clock.tick (150.);
+		const auto& statistics = clock.getStatistics ();
+		EXPECT(statistics.numTicks == 4);
+		EXPECT(statistics.numLateTicks == 1);
+		EXPECT(statistics.numDroppedFrames == 2);
+		EXPECT(statistics.lastInterval == 30.);
+		EXPECT(statistics.maxInterval == 30.);
+		EXPECT(statistics.getAverageInterval () == 50. / 3.);
+		EXPECT(clock.getTickTime () == 150.);
+		clock.resetStatistics ();
+		EXPECT(clock.getStatistics ().numTicks == 0);
+	);
+
+	TEST(idleViewsAreCalledWithIdleRate,
+		auto frame = owned (new CFrame (CRect (0, 0, 100, 100), nullptr));
+		auto view = new IdleView ();
+		frame->addView (view);
+		frame->attached (frame);
+		auto& clock = CFrameClock::instance ();
+		auto time = clock.getTickTime () + 1000.;
+		// the clock ticks with 60 Hz, the views are idled with 30 Hz
+		for (auto i = 0; i < 6; ++i)
+			clock.tick (time + i * 16.);
+		EXPECT(view->numIdleCalls == 3);
+		frame->removeAll ();
+		frame->removed (frame);
+	);
+
+	TEST(clockStopsWhenViewsInvalidateThemselves,
+		DirtyCallGuard dirtyCallGuard (true);
+		auto frame = owned (new CFrame (CRect (0, 0, 100, 100), nullptr));
+		CFrameClock clock;
+		CDirtyViewInvalidator invalidator (frame, clock);
+		EXPECT(clock.isRunning () == false);
+	);
+
+	TEST(dirtyViewsAreInvalidatedEveryTick,
+		DirtyCallGuard dirtyCallGuard (false);
+		auto frame = owned (new CFrame (CRect (0, 0, 100, 100), nullptr));
+		CFrameClock clock;
+		{
+			CDirtyViewInvalidator invalidator (frame, clock);
+			EXPECT(clock.isRunning ());
+			clock.tick (0.);
+			EXPECT(clock.isRunning ());
+			// switching to views invalidating themselves removes the invalidator from the clock
+			CView::kDirtyCallAlwaysOnMainThread = true;
+			clock.tick (16.);
+			EXPECT(clock.isRunning () == false);
+		}
+		EXPECT(clock.isRunning () == false);
+	);
+);
+
+} // VSTGUI
@@ -0,0 +1,269 @@
+// This file is part of VSTGUI. It is subject to the license terms
+// in the LICENSE file found in the top-level directory of this
+// distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
+
+#include "../../../lib/cdrawcontext.h"
+#include "../../../lib/cframe.h"
+#include "../../../lib/cframeprofiler.h"
+#include "../../../lib/cframeprofilerview.h"
+#include "../unittests.h"
+#include <string>
+
+namespace VSTGUI {
+
+namespace {
+
+//------------------------------------------------------------------------
+class NullDrawContext : public CDrawContext
+{
+public:
+	NullDrawContext (const CRect& r) : CDrawContext (r) { init (); }
+
+	void drawLine (const LinePair& line) override {}
+	void drawLines (const LineList& lines) override {}
+	void drawPolygon (const PointList& polygonPointList, const CDrawStyle drawStyle) override {}
+	void drawRect (const CRect& rect, const CDrawStyle drawStyle) override {}
+	void drawArc (const CRect& rect, const float startAngle1, const float endAngle2, const CDrawStyle drawStyle) override {}
+	void drawEllipse (const CRect& rect, const CDrawStyle drawStyle) override {}
+	void drawPoint (const CPoint& point, const CColor& color) override {}
+	void drawBitmap (CBitmap* bitmap, const CRect& dest, const CPoint& offset, float alpha) override {}
+	void clearRect (const CRect& rect) override {}
+	CGraphicsPath* createGraphicsPath () override { return nullptr; }
+	CGraphicsPath* createTextPath (const CFontRef font, UTF8StringPtr text) override { return nullptr; }
+	void drawGraphicsPath (CGraphicsPath* path, PathDrawMode mode, CGraphicsTransform* transformation) override {}
+	void fillLinearGradient (CGraphicsPath* path, const CGradient& gradient, const CPoint& startPoint, const CPoint& endPoint, bool evenOdd, CGraphicsTransform* transformation) override {}
+	void fillRadialGradient (CGraphicsPath* path, const CGradient& gradient, const CPoint& center, CCoord radius, const CPoint& originOffset, bool evenOdd, CGraphicsTransform* transformation) override {}
+};
+
+//------------------------------------------------------------------------
+/** draws a container with one view twice */
+static void drawContainerWithView (CFrameProfiler& profiler, CViewContainer* container,
+                                   CView* view)
+{
+	for (auto i = 0; i < 2; ++i)
+	{
+		CFrameProfiler::PaintScope paintScope (&profiler, CRect (0, 0, 100, 100));
+		CFrameProfiler::DrawViewScope containerScope (&profiler, container, CRect (0, 0, 100, 100));
+		CFrameProfiler::DrawViewScope viewScope (&profiler, view, CRect (0, 0, 10, 10));
+	}
+}
+
+//------------------------------------------------------------------------
+static bool contains (const std::string& str, const char* part)
+{
+	return str.find (part) != std::string::npos;
+}
+
+} // anonymous
+
+//------------------------------------------------------------------------
+TESTCASE(CFrameProfilerTest,
+
+	TEST(paintsAndViewDraws,
+		CFrameClock clock;
+		CFrameProfiler profiler (clock);
+		auto container = owned (new CViewContainer (CRect (0, 0, 100, 100)));
+		auto view = owned (new CView (CRect (0, 0, 10, 10)));
+		drawContainerWithView (profiler, container, view);
+		const auto& statistics = profiler.getStatistics ();
+		EXPECT(statistics.numPaints == 2);
+		EXPECT(statistics.numViewDraws == 4);
+		EXPECT(statistics.paintedArea == 20000.);
+		const auto& viewStatistics = profiler.getViewStatistics ();
+		EXPECT(viewStatistics.size () == 2);
+		EXPECT(viewStatistics[0].name == "CViewContainer");
+		EXPECT(viewStatistics[0].numDraws == 2);
+		EXPECT(viewStatistics[1].name == "CView");
+		EXPECT(viewStatistics[1].numDraws == 2);
+		EXPECT(viewStatistics[0].drawTime >= viewStatistics[1].drawTime);
+		EXPECT(profiler.getTraceEvents ().size () == 6);
+	);
+
+	TEST(callTreeMergesEqualPaths,
+		CFrameClock clock;
+		CFrameProfiler profiler (clock);
+		auto container = owned (new CViewContainer (CRect (0, 0, 100, 100)));
+		auto view = owned (new CView (CRect (0, 0, 10, 10)));
+		drawContainerWithView (profiler, container, view);
+		const auto& callTree = profiler.getCallTree ();
+		EXPECT(callTree.size () == 3);
+		EXPECT(callTree[0].view == CFrameProfiler::kRootIndex);
+		EXPECT(callTree[0].count == 2);
+		EXPECT(callTree[0].children.size () == 1);
+		EXPECT(callTree[1].view == 0);
+		EXPECT(callTree[1].count == 2);
+		EXPECT(callTree[1].children.size () == 1);
+		EXPECT(callTree[2].view == 1);
+		EXPECT(callTree[2].parent == 1);
+		EXPECT(callTree[2].count == 2);
+		EXPECT(callTree[0].time >= callTree[1].time);
+		EXPECT(callTree[1].time >= callTree[2].time);
+	);
+
+	TEST(invalidations,
+		CFrameClock clock;
+		CFrameProfiler profiler (clock);
+		auto view = owned (new CView (CRect (0, 0, 10, 10)));
+		profiler.addInvalidation (view, CRect (0, 0, 10, 10));
+		profiler.addDirtyRect (CRect (0, 0, 10, 10));
+		profiler.addDirtyRect (CRect (0, 0, 20, 10));
+		const auto& statistics = profiler.getStatistics ();
+		EXPECT(statistics.numInvalidations == 2);
+		EXPECT(statistics.dirtyArea == 300.);
+		EXPECT(profiler.getViewStatistics ()[0].numInvalidations == 1);
+		EXPECT(profiler.getViewStatistics ()[0].invalidatedArea == 100.);
+		profiler.beginPaint (CRect (0, 0, 20, 10));
+		profiler.endPaint ();
+		EXPECT(profiler.getTraceEvents ().back ().dirtyArea == 300.);
+	);
+
+	TEST(frameClockJitter,
+		CFrameClock clock;
+		clock.setFrameInterval (10);
+		CFrameProfiler profiler (clock);
+		clock.tick (100.);
+		clock.tick (110.);
+		clock.tick (125.);
+		const auto& statistics = profiler.getStatistics ();
+		EXPECT(statistics.numTicks == 3);
+		EXPECT(statistics.totalJitter == 5.);
+		EXPECT(statistics.maxJitter == 5.);
+		EXPECT(statistics.getAverageJitter () == 2.5);
+	);
+
+	TEST(resetStatisticsRestartsJitter,
+		CFrameClock clock;
+		clock.setFrameInterval (10);
+		CFrameProfiler profiler (clock);
+		clock.tick (100.);
+		clock.tick (115.);
+		profiler.resetStatistics ();
+		clock.tick (200.);
+		clock.tick (210.);
+		const auto& statistics = profiler.getStatistics ();
+		EXPECT(statistics.numTicks == 2);
+		EXPECT(statistics.totalJitter == 0.);
+		EXPECT(statistics.getAverageJitter () == 0.);
+	);
+
+	TEST(chromeTrace,
+		CFrameClock clock;
+		CFrameProfiler profiler (clock);
+		auto container = owned (new CViewContainer (CRect (0, 0, 100, 100)));
+		auto view = owned (new CView (CRect (0, 0, 10, 10)));
+		drawContainerWithView (profiler, container, view);
+		profiler.addInvalidation (view, CRect (0, 0, 10, 10));
+		clock.tick (0.);
+		clock.tick (16.);
+		auto trace = profiler.getChromeTrace ();
+		EXPECT(trace.find ("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[") == 0);
+		EXPECT(contains (trace, "{\"name\":\"paint\",\"cat\":\"frame\",\"ph\":\"X\""));
+		EXPECT(contains (trace, "{\"name\":\"CViewContainer\",\"cat\":\"draw\",\"ph\":\"X\""));
+		EXPECT(contains (trace, "{\"name\":\"area\",\"cat\":\"frame\",\"ph\":\"C\""));
+		EXPECT(contains (trace, "\"args\":{\"source\":\"CView\""));
+		EXPECT(contains (trace, "\"args\":{\"interval\":16.000,\"jitter\":0.000}"));
+		EXPECT(trace.find ("]}") == trace.size () - 3);
+	);
+
+	TEST(maxNumTraceEvents,
+		CFrameClock clock;
+		CFrameProfiler profiler (clock);
+		profiler.setMaxNumTraceEvents (3);
+		for (auto i = 0; i < 5; ++i)
+		{
+			profiler.beginPaint (CRect (0, 0, 10, 10 * (i + 1)));
+			profiler.endPaint ();
+		}
+		EXPECT(profiler.getTraceEvents ().size () == 3);
+		EXPECT(profiler.getTraceEvents ().front ().rect.getHeight () == 30.);
+		EXPECT(profiler.getStatistics ().numPaints == 5);
+	);
+
+	TEST(resetStatisticsKeepsTraceEvents,
+		CFrameClock clock;
+		CFrameProfiler profiler (clock);
+		auto container = owned (new CViewContainer (CRect (0, 0, 100, 100)));
+		auto view = owned (new CView (CRect (0, 0, 10, 10)));
+		drawContainerWithView (profiler, container, view);
+		profiler.resetStatistics ();
+		EXPECT(profiler.getStatistics ().numPaints == 0);
+		EXPECT(profiler.getViewStatistics ()[1].name == "CView");
+		EXPECT(profiler.getViewStatistics ()[1].numDraws == 0);
+		EXPECT(profiler.getCallTree ()[2].count == 0);
+		EXPECT(profiler.getTraceEvents ().size () == 6);
+		profiler.clearTraceEvents ();
+		EXPECT(profiler.getTraceEvents ().empty ());
+	);
+
+	TEST(profilerViewTakesStatistics,
+		auto frame = owned (new CFrame (CRect (0, 0, 500, 500), nullptr));
+		auto profilerView = CFrameProfilerView::attach (frame);
+		auto profiler = frame->getProfiler ();
+		EXPECT(profiler);
+		EXPECT(profilerView->getProfiler () == profiler);
+		EXPECT(profilerView->getViewSize ().right == 496.);
+		profiler->beginPaint (CRect (0, 0, 10, 10));
+		profiler->endPaint ();
+		profilerView->refresh ();
+		EXPECT(profilerView->getStatistics ().numPaints == 1);
+		EXPECT(profiler->getStatistics ().numPaints == 0);
+		NullDrawContext context (frame->getViewSize ());
+		profilerView->draw (&context);
+	);
+
+	TEST(profilerViewRefreshesWithFrameClock,
+		CFrameClock clock;
+		clock.setFrameInterval (10);
+		auto profiler = makeOwned<CFrameProfiler> (clock);
+		auto frame = owned (new CFrame (CRect (0, 0, 500, 500), nullptr));
+		frame->setProfiler (profiler);
+		auto profilerView = CFrameProfilerView::attach (frame);
+		EXPECT(profilerView->getProfiler () == profiler);
+		profilerView->setRefreshInterval (100);
+		frame->attached (frame);
+		clock.tick (0.);
+		profiler->beginPaint (CRect (0, 0, 10, 10));
+		profiler->endPaint ();
+		clock.tick (50.);
+		EXPECT(profilerView->getStatistics ().numPaints == 0);
+		clock.tick (96.);
+		EXPECT(profilerView->getStatistics ().numPaints == 1);
+		EXPECT(profilerView->getStatistics ().numTicks == 3);
+		EXPECT(profiler->getStatistics ().numPaints == 0);
+		frame->removeAll ();
+		frame->removed (frame);
+		clock.tick (300.);
+		EXPECT(profiler->getStatistics ().numTicks == 1);
+	);
+);
+
+#if VSTGUI_ENABLE_FRAME_PROFILER
+//------------------------------------------------------------------------
+TESTCASE(CFrameProfilerHooksTest,
+
+	TEST(frameRecordsDrawnViews,
+		CFrameClock clock;
+		auto profiler = makeOwned<CFrameProfiler> (clock);
+		auto frame = owned (new CFrame (CRect (0, 0, 100, 100), nullptr));
+		frame->setProfiler (profiler);
+		auto container = new CViewContainer (CRect (0, 0, 50, 50));
+		container->addView (new CView (CRect (0, 0, 10, 10)));
+		container->addView (new CView (CRect (20, 0, 30, 10)));
+		frame->addView (container);
+		frame->attached (frame);
+		NullDrawContext context (frame->getViewSize ());
+		frame->drawRect (&context, CRect (0, 0, 100, 100));
+		EXPECT(profiler->getStatistics ().numPaints == 1);
+		EXPECT(profiler->getStatistics ().numViewDraws == 3);
+		const auto& callTree = profiler->getCallTree ();
+		EXPECT(callTree.size () == 3);
+		EXPECT(callTree[2].count == 2);
+		container->getView (0)->invalid ();
+		EXPECT(profiler->getViewStatistics ()[1].numInvalidations == 1);
+		frame->removeAll ();
+		frame->removed (frame);
+	);
+);
+#endif
+
+} // VSTGUI
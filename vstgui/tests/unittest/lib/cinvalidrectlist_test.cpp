@@ -0,0 +1,127 @@
+// This file is part of VSTGUI. It is subject to the license terms
+// in the LICENSE file found in the top-level directory of this
+// distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
+
+#include "../../../lib/cinvalidrectlist.h"
+#include "../unittests.h"
+
+namespace VSTGUI {
+
+namespace {
+
+//------------------------------------------------------------------------
+bool noOverlaps (const CInvalidRectList& list)
+{
+	for (auto it = list.begin (); it != list.end (); ++it)
+	{
+		for (auto it2 = it + 1; it2 != list.end (); ++it2)
+		{
+			CRect r (*it);
+			r.bound (*it2);
+			if (!r.isEmpty ())
+				return false;
+		}
+	}
+	return true;
+}
+
+//------------------------------------------------------------------------
+CCoord totalArea (const CInvalidRectList& list)
+{
+	CCoord result = 0.;
+	for (const auto& r : list)
+		result += r.getWidth () * r.getHeight ();
+	return result;
+}
+
+} // anonymous
+
+TESTCASE(CInvalidRectListTest,
+
+	TEST(addEmptyRect,
+		CInvalidRectList list;
+		EXPECT(list.add (CRect ()) == false)
+		EXPECT(list.empty ())
+	);
+
+	TEST(addContainedRect,
+		CInvalidRectList list;
+		EXPECT(list.add (CRect (0, 0, 100, 100)))
+		EXPECT(list.add (CRect (10, 10, 20, 20)) == false)
+		EXPECT(list.size () == 1)
+		EXPECT(list.getStatistics ().numAddedRects == 2)
+		EXPECT(list.getStatistics ().numCoalescedRects == 1)
+	);
+
+	TEST(addContainingRect,
+		CInvalidRectList list;
+		list.add (CRect (10, 10, 20, 20));
+		list.add (CRect (30, 30, 40, 40));
+		list.add (CRect (0, 0, 100, 100));
+		EXPECT(list.size () == 1)
+		EXPECT(*list.begin () == CRect (0, 0, 100, 100))
+	);
+
+	TEST(mergeAdjacentRects,
+		CInvalidRectList list (0.);
+		list.add (CRect (0, 0, 50, 10));
+		list.add (CRect (50, 0, 100, 10));
+		EXPECT(list.size () == 1)
+		EXPECT(*list.begin () == CRect (0, 0, 100, 10))
+	);
+
+	TEST(mergeWithSmallWaste,
+		CInvalidRectList list (25.);
+		list.add (CRect (0, 0, 10, 10));
+		list.add (CRect (12, 0, 22, 10));
+		EXPECT(list.size () == 1)
+		EXPECT(*list.begin () == CRect (0, 0, 22, 10))
+	);
+
+	TEST(noMergeWithLargeWaste,
+		CInvalidRectList list (25.);
+		list.add (CRect (0, 0, 10, 10));
+		list.add (CRect (90, 90, 100, 100));
+		EXPECT(list.size () == 2)
+		EXPECT(list.getBounds () == CRect (0, 0, 100, 100))
+	);
+
+	TEST(overlappingRectsAreSplit,
+		CInvalidRectList list (0.);
+		list.add (CRect (0, 0, 100, 100));
+		list.add (CRect (50, 50, 150, 150));
+		EXPECT(noOverlaps (list))
+		EXPECT(totalArea (list) == 100. * 100. * 2. - 50. * 50.)
+	);
+
+	TEST(subtract,
+		CInvalidRectList list;
+		list.add (CRect (0, 0, 100, 100));
+		list.subtract (CRect (25, 25, 75, 75));
+		EXPECT(list.size () == 4)
+		EXPECT(noOverlaps (list))
+		EXPECT(totalArea (list) == 100. * 100. - 50. * 50.)
+		list.subtract (CRect (0, 0, 100, 100));
+		EXPECT(list.empty ())
+	);
+
+	TEST(clearKeepsStatistics,
+		CInvalidRectList list;
+		list.add (CRect (0, 0, 10, 10));
+		list.clear ();
+		EXPECT(list.empty ())
+		EXPECT(list.getStatistics ().numAddedRects == 1)
+		list.resetStatistics ();
+		EXPECT(list.getStatistics ().numAddedRects == 0)
+	);
+
+	TEST(mergeWasteThresholdIsClamped,
+		CInvalidRectList list;
+		list.setMergeWasteThreshold (200.);
+		EXPECT(list.getMergeWasteThreshold () == 100.)
+		list.setMergeWasteThreshold (-1.);
+		EXPECT(list.getMergeWasteThreshold () == 0.)
+	);
+);
+
+} // VSTGUI
@@ -0,0 +1,129 @@
+// This file is part of VSTGUI. It is subject to the license terms
+// in the LICENSE file found in the top-level directory of this
+// distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
+
+#include "../unittests.h"
+#include "../../../lib/ctextlayout.h"
+
+namespace VSTGUI {
+
+namespace {
+
+//------------------------------------------------------------------------
+/** every character is 10 wide, a "V" followed by an "A" is 5 wider */
+struct Measure
+{
+	size_t* numCalls {nullptr};
+
+	CCoord operator() (const UTF8String& str) const
+	{
+		if (numCalls)
+			++(*numCalls);
+		CCoord width = 0.;
+		char32_t previous = 0;
+		for (auto c : str)
+		{
+			width += 10.;
+			if (previous == 'V' && c == 'A')
+				width += 5.;
+			previous = c;
+		}
+		return width;
+	}
+};
+
+//------------------------------------------------------------------------
+static std::vector<std::string> layoutLines (CTextLayout& layout, const char* text, CCoord maxWidth)
+{
+	std::vector<std::string> result;
+	for (const auto& line : layout.layout (UTF8String (text), maxWidth))
+		result.emplace_back (line.text.getString ());
+	return result;
+}
+
+static const std::vector<std::string> paragraphLines = {"one", "", "two three"};
+static const std::vector<std::string> greedyLines = {"aaa bb", "cc", "ddddd"};
+static const std::vector<std::string> balancedLines = {"aaa", "bb cc", "ddddd"};
+static const std::vector<std::string> longWordLines = {"abcd", "efgh", "ij k"};
+static const std::vector<std::string> separatorLines = {"left-", "right"};
+static const std::vector<std::string> utf8Lines = {"\xc3\xa4\xc3\xb6", "\xc3\xbc\xc3\x9f"};
+static const std::vector<std::string> kerningLines = {"VA", "V"};
+
+} // anonymous
+
+//------------------------------------------------------------------------
+TESTCASE(CTextLayoutTest,
+
+	TEST(noBreakSplitsAtLineFeeds,
+		CTextLayout layout;
+		layout.setStringWidthFunction (Measure ());
+		layout.setBreakMode (CTextLayout::BreakMode::none);
+		EXPECT(layoutLines (layout, "one\n\ntwo three\n", 20.) == paragraphLines);
+		EXPECT(layout.getLines ()[2].offset == 5);
+		EXPECT(layout.getLines ()[2].width == 90.);
+		EXPECT(layout.getMaxLineWidth () == 90.);
+		EXPECT(layoutLines (layout, "", 20.).empty ());
+	);
+
+	TEST(greedyBreak,
+		CTextLayout layout;
+		layout.setStringWidthFunction (Measure ());
+		EXPECT(layoutLines (layout, "aaa bb cc ddddd", 60.) == greedyLines);
+		EXPECT(layout.getLines ()[1].offset == 7);
+		EXPECT(layout.getLines ()[1].width == 20.);
+	);
+
+	TEST(balancedBreak,
+		CTextLayout layout;
+		layout.setStringWidthFunction (Measure ());
+		layout.setBreakMode (CTextLayout::BreakMode::balanced);
+		EXPECT(layoutLines (layout, "aaa bb cc ddddd", 60.) == balancedLines);
+	);
+
+	TEST(longWordsAreBrokenBetweenCharacters,
+		CTextLayout layout;
+		layout.setStringWidthFunction (Measure ());
+		EXPECT(layoutLines (layout, "abcdefghij k", 40.) == longWordLines);
+	);
+
+	TEST(breakAfterSeparator,
+		CTextLayout layout;
+		layout.setStringWidthFunction (Measure ());
+		EXPECT(layoutLines (layout, "left-right", 60.) == separatorLines);
+	);
+
+	TEST(utf8Characters,
+		CTextLayout layout;
+		layout.setStringWidthFunction (Measure ());
+		EXPECT(layoutLines (layout, "\xc3\xa4\xc3\xb6 \xc3\xbc\xc3\x9f", 30.) == utf8Lines);
+	);
+
+	TEST(linesAreMeasuredWithKerning,
+		CTextLayout layout;
+		layout.setStringWidthFunction (Measure ());
+		// the advances of "VA V" sum up to 40, but the line is 45 wide
+		EXPECT(layoutLines (layout, "VA V", 40.) == kerningLines);
+		EXPECT(layout.getLines ()[0].width == 25.);
+	);
+
+	TEST(layoutIsCached,
+		size_t numCalls = 0;
+		CTextLayout layout;
+		Measure measure;
+		measure.numCalls = &numCalls;
+		layout.setStringWidthFunction (measure);
+		layoutLines (layout, "aaa bb cc dd eeeeee", 60.);
+		auto numFirstLayoutCalls = numCalls;
+		layoutLines (layout, "aaa bb cc dd eeeeee", 60.);
+		EXPECT(numCalls == numFirstLayoutCalls);
+		// the advances of the characters are not measured again
+		layoutLines (layout, "aaa bb cc dd eeeeee", 70.);
+		EXPECT(numCalls - numFirstLayoutCalls < numFirstLayoutCalls);
+		layout.setBreakMode (CTextLayout::BreakMode::balanced);
+		numFirstLayoutCalls = numCalls;
+		layoutLines (layout, "aaa bb cc dd eeeeee", 70.);
+		EXPECT(numCalls > numFirstLayoutCalls);
+	);
+);
+
+} // VSTGUI
@@ -61,6 +61,18 @@ struct ViewListener : public IViewListener
 	bool willDeleteCalled {false};
 };
 
+struct MouseableAreaListener : public ViewListenerAdapter
+{
+	void viewMouseableAreaChanged (CView* view, const CRect& oldArea) override
+	{
+		++numCalls;
+		lastOldArea = oldArea;
+	}
+
+	uint32_t numCalls {0};
+	CRect lastOldArea;
+};
+
 } // anonymous
 
 TESTCASE(CViewTest,
@@ -184,6 +196,18 @@ TESTCASE(CViewTest,
 		EXPECT(listener.lostFocusCalled);
 		EXPECT(listener.willDeleteCalled);
 	);
+
+	TEST(mouseableAreaChangedListener,
+		MouseableAreaListener listener;
+		View v;
+		v.registerViewListener (&listener);
+		v.setMouseableArea (CRect (1, 2, 3, 4));
+		EXPECT(listener.numCalls == 1);
+		EXPECT(listener.lastOldArea == CRect (0, 0, 10, 10));
+		v.setMouseableArea (CRect (1, 2, 3, 4));
+		EXPECT(listener.numCalls == 1);
+		v.unregisterViewListener (&listener);
+	);
 	
 	TEST(coordCalculations,
 		auto parent = owned (new CViewContainer (CRect (0, 0, 100, 100)));
@@ -6,7 +6,10 @@
 #include "../../../lib/iviewlistener.h"
 #include "../../../lib/ccolor.h"
 #include "../../../lib/dragging.h"
+#include "../../../lib/cdrawcontext.h"
 #include "../unittests.h"
+#include <chrono>
+#include <cmath>
 #include <vector>
 
 namespace VSTGUI {
@@ -107,6 +110,55 @@ public:
 	
  };
 
+//------------------------------------------------------------------------
+class NullDrawContext : public CDrawContext
+{
+public:
+	NullDrawContext (const CRect& r) : CDrawContext (r) { init (); }
+
+	void drawLine (const LinePair& line) override {}
+	void drawLines (const LineList& lines) override {}
+	void drawPolygon (const PointList& polygonPointList, const CDrawStyle drawStyle) override {}
+	void drawRect (const CRect& rect, const CDrawStyle drawStyle) override {}
+	void drawArc (const CRect& rect, const float startAngle1, const float endAngle2, const CDrawStyle drawStyle) override {}
+	void drawEllipse (const CRect& rect, const CDrawStyle drawStyle) override {}
+	void drawPoint (const CPoint& point, const CColor& color) override {}
+	void drawBitmap (CBitmap* bitmap, const CRect& dest, const CPoint& offset, float alpha) override {}
+	void clearRect (const CRect& rect) override {}
+	CGraphicsPath* createGraphicsPath () override { return nullptr; }
+	CGraphicsPath* createTextPath (const CFontRef font, UTF8StringPtr text) override { return nullptr; }
+	void drawGraphicsPath (CGraphicsPath* path, PathDrawMode mode, CGraphicsTransform* transformation) override {}
+	void fillLinearGradient (CGraphicsPath* path, const CGradient& gradient, const CPoint& startPoint, const CPoint& endPoint, bool evenOdd, CGraphicsTransform* transformation) override {}
+	void fillRadialGradient (CGraphicsPath* path, const CGradient& gradient, const CPoint& center, CCoord radius, const CPoint& originOffset, bool evenOdd, CGraphicsTransform* transformation) override {}
+};
+
+//------------------------------------------------------------------------
+class DrawOrderView : public CView
+{
+public:
+	DrawOrderView (const CRect& r, std::vector<CView*>& drawOrder) : CView (r), drawOrder (drawOrder) {}
+
+	void draw (CDrawContext* pContext) override
+	{
+		drawOrder.emplace_back (this);
+	}
+
+	std::vector<CView*>& drawOrder;
+};
+
+//------------------------------------------------------------------------
+void addGridOfViews (CViewContainer* container, uint32_t numViews, std::vector<CView*>& drawOrder)
+{
+	auto numColumns = static_cast<uint32_t> (std::ceil (std::sqrt (numViews)));
+	for (auto i = 0u; i < numViews; ++i)
+	{
+		CRect r (0, 0, 10, 10);
+		r.offset ((i % numColumns) * 10., (i / numColumns) * 10.);
+		container->addView (new DrawOrderView (r, drawOrder));
+	}
+	container->setViewSize (CRect (0, 0, numColumns * 10., numColumns * 10.));
+}
+
 } // anonymous
 
 TESTCASE(CViewContainerTest,
@@ -544,7 +596,111 @@ TESTCASE(CViewContainerTest,
 		EXPECT(res == c1);
 	);
 	
+	TEST(childViewIndexKeepsZOrder,
+		container->setChildViewIndexEnabled (true);
+		for (auto i = 0; i < 100; ++i)
+		{
+			CCoord x = (i % 10) * 20.;
+			CCoord y = (i / 10) * 20.;
+			container->addView (new CView (CRect (x, y, x + 20., y + 20.)));
+		}
+		auto v1 = new TestView1 ();
+		auto v2 = new TestView1 ();
+		container->addView (v1);
+		container->addView (v2);
+		EXPECT(container->getViewAt (CPoint (5, 5)) == v2);
+		EXPECT(container->getViewAt (CPoint (45, 45)) == container->getView (22));
+		CViewContainer::ViewList views;
+		container->getViewsAt (CPoint (5, 5), views);
+		EXPECT(views.size () == 3);
+		EXPECT(views.front () == v2);
+		EXPECT(views.back () == container->getView (0));
+		container->changeViewZOrder (v2, 0);
+		EXPECT(container->getViewAt (CPoint (5, 5)) == v1);
+		EXPECT(container->hitTestSubViews (CPoint (195, 195)));
+	);
+
+	TEST(childViewIndexUpdatesOnChanges,
+		container->setChildViewIndexEnabled (true);
+		auto v1 = new TestView1 ();
+		container->addView (v1);
+		container->addView (new CView (CRect (100, 100, 200, 200)));
+		EXPECT(container->getViewAt (CPoint (5, 5)) == v1);
+		v1->setViewSize (CRect (50, 50, 60, 60));
+		EXPECT(container->getViewAt (CPoint (5, 5)) == v1);
+		v1->setMouseableArea (CRect (50, 50, 60, 60));
+		EXPECT(container->getViewAt (CPoint (5, 5)) == nullptr);
+		EXPECT(container->getViewAt (CPoint (55, 55)) == v1);
+		container->removeView (v1, false);
+		EXPECT(container->getViewAt (CPoint (55, 55)) == nullptr);
+		v1->setViewSize (CRect (150, 150, 160, 160));
+		EXPECT(container->getViewAt (CPoint (155, 155)) != v1);
+		v1->forget ();
+		container->setChildViewIndexEnabled (false);
+		EXPECT(container->getChildViewIndexEnabled () == false);
+		EXPECT(container->getViewAt (CPoint (155, 155)) == container->getView (0));
+	);
+
 ); // TESTCASE
 
+TESTCASE(CViewContainerDrawTest,
+
+	TEST(drawOnlyIntersectingViews,
+		std::vector<CView*> drawOrder;
+		auto container = owned (new CViewContainer (CRect ()));
+		container->setChildViewIndexEnabled (true);
+		addGridOfViews (container, 100, drawOrder);
+		NullDrawContext drawContext (container->getViewSize ());
+		container->drawRect (&drawContext, CRect (12, 12, 18, 18));
+		EXPECT(drawOrder.size () == 1);
+		EXPECT(drawOrder.front () == container->getView (11));
+		drawOrder.clear ();
+		container->drawRect (&drawContext, CRect (5, 5, 15, 15));
+		EXPECT(drawOrder.size () == 4);
+	);
+
+	TEST(drawOrderIsKept,
+		std::vector<CView*> drawOrder;
+		auto container = owned (new CViewContainer (CRect ()));
+		addGridOfViews (container, 100, drawOrder);
+		for (auto i = 0; i < 10; ++i)
+			container->addView (new DrawOrderView (CRect (5, 5, 35, 35), drawOrder));
+		container->changeViewZOrder (container->getView (3), 105);
+		NullDrawContext drawContext (container->getViewSize ());
+		container->drawRect (&drawContext, CRect (0, 0, 40, 40));
+		auto expected = drawOrder;
+		drawOrder.clear ();
+		container->setChildViewIndexEnabled (true);
+		container->drawRect (&drawContext, CRect (0, 0, 40, 40));
+		EXPECT(drawOrder == expected);
+	);
+
+	TEST(benchmarkSmallUpdateRect,
+		for (auto numViews : {100u, 1000u, 10000u})
+		{
+			for (auto indexEnabled : {false, true})
+			{
+				std::vector<CView*> drawOrder;
+				auto container = owned (new CViewContainer (CRect ()));
+				container->setChildViewIndexEnabled (indexEnabled);
+				addGridOfViews (container, numViews, drawOrder);
+				NullDrawContext drawContext (container->getViewSize ());
+				constexpr auto numFrames = 200;
+				// the first frame builds the index
+				container->drawRect (&drawContext, CRect (12, 12, 18, 18));
+				drawOrder.clear ();
+				auto start = std::chrono::steady_clock::now ();
+				for (auto i = 0; i < numFrames; ++i)
+					container->drawRect (&drawContext, CRect (12, 12, 18, 18));
+				auto duration = std::chrono::duration_cast<std::chrono::nanoseconds> (
+				    std::chrono::steady_clock::now () - start);
+				EXPECT(drawOrder.size () == numFrames);
+				context->print ("%5u children, index %s: %8.2f µs per frame", numViews,
+				                indexEnabled ? "on " : "off", duration.count () / 1000. / numFrames);
+			}
+		}
+	);
+);
+
 } // namespaces
 
@@ -0,0 +1,205 @@
+// This file is part of VSTGUI. It is subject to the license terms
+// in the LICENSE file found in the top-level directory of this
+// distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
+
+#include "../../../lib/cviewlayercache.h"
+#include "../../../lib/cbitmap.h"
+#include "../../../lib/cframe.h"
+#include "../../../lib/coffscreencontext.h"
+#include "../unittests.h"
+
+namespace VSTGUI {
+
+namespace {
+
+//------------------------------------------------------------------------
+class MockContext : public COffscreenContext
+{
+public:
+	MockContext (CBitmap* bitmap) : COffscreenContext (bitmap) { init (); }
+
+	void drawLine (const LinePair& line) override {}
+	void drawLines (const LineList& lines) override {}
+	void drawPolygon (const PointList& polygonPointList, const CDrawStyle drawStyle) override {}
+	void drawRect (const CRect& rect, const CDrawStyle drawStyle) override {}
+	void drawArc (const CRect& rect, const float startAngle1, const float endAngle2, const CDrawStyle drawStyle) override {}
+	void drawEllipse (const CRect& rect, const CDrawStyle drawStyle) override {}
+	void drawPoint (const CPoint& point, const CColor& color) override {}
+	void drawBitmap (CBitmap* bitmap, const CRect& dest, const CPoint& offset, float alpha) override
+	{
+		drawnBitmaps.push_back (bitmap);
+	}
+	void clearRect (const CRect& rect) override {}
+	CGraphicsPath* createGraphicsPath () override { return nullptr; }
+	CGraphicsPath* createTextPath (const CFontRef font, UTF8StringPtr text) override { return nullptr; }
+	void drawGraphicsPath (CGraphicsPath* path, PathDrawMode mode, CGraphicsTransform* transformation) override {}
+	void fillLinearGradient (CGraphicsPath* path, const CGradient& gradient, const CPoint& startPoint, const CPoint& endPoint, bool evenOdd, CGraphicsTransform* transformation) override {}
+	void fillRadialGradient (CGraphicsPath* path, const CGradient& gradient, const CPoint& center, CCoord radius, const CPoint& originOffset, bool evenOdd, CGraphicsTransform* transformation) override {}
+
+	std::vector<CBitmap*> drawnBitmaps;
+};
+
+//------------------------------------------------------------------------
+class CountingView : public CView
+{
+public:
+	CountingView (const CRect& size) : CView (size) {}
+
+	void draw (CDrawContext* context) override
+	{
+		++numDraws;
+		CView::draw (context);
+	}
+
+	uint32_t numDraws {0};
+};
+
+} // anonymous
+
+TESTCASE(CViewLayerCacheTest,
+
+	static CViewLayerCache* cache = nullptr;
+
+	SETUP(
+		cache = &CViewLayerCache::instance ();
+		cache->clear ();
+		cache->resetStatistics ();
+	);
+
+	TEARDOWN(
+		cache->setCreateContextFunc (nullptr);
+		cache->setMemoryBudget (CViewLayerCache::kDefaultMemoryBudget);
+		cache->clear ();
+		cache->resetStatistics ();
+	);
+
+	TEST(memoryAccounting,
+		auto view = owned (new CView (CRect (0, 0, 10, 10)));
+		auto bitmap = owned (new CBitmap (CPoint (10, 10), 2.));
+		EXPECT(cache->setLayer (view, bitmap, 2.));
+		EXPECT(cache->getNumLayers () == 1);
+		EXPECT(cache->getMemoryUsage () == 20 * 20 * 4);
+		EXPECT(cache->getLayer (view, 2.) == bitmap);
+		EXPECT(cache->getStatistics ().numHits == 1);
+		cache->removeLayer (view);
+		EXPECT(cache->getNumLayers () == 0);
+		EXPECT(cache->getMemoryUsage () == 0);
+	);
+
+	TEST(scaleFactorOrSizeChangeInvalidatesLayer,
+		auto view = owned (new CView (CRect (0, 0, 10, 10)));
+		auto bitmap = owned (new CBitmap (CPoint (10, 10), 1.));
+		cache->setLayer (view, bitmap, 1.);
+		EXPECT(cache->getLayer (view, 2.) == nullptr);
+		EXPECT(cache->getNumLayers () == 0);
+		cache->setLayer (view, bitmap, 1.);
+		view->setViewSize (CRect (0, 0, 20, 10));
+		EXPECT(cache->getLayer (view, 1.) == nullptr);
+		EXPECT(cache->getStatistics ().numMisses == 2);
+	);
+
+	TEST(leastRecentlyUsedLayerIsEvicted,
+		cache->setMemoryBudget (CViewLayerCache::calculateLayerMemory (CPoint (10, 10), 1.) * 2);
+		auto v1 = owned (new CView (CRect (0, 0, 10, 10)));
+		auto v2 = owned (new CView (CRect (0, 0, 10, 10)));
+		auto v3 = owned (new CView (CRect (0, 0, 10, 10)));
+		auto bitmap = owned (new CBitmap (CPoint (10, 10), 1.));
+		cache->setLayer (v1, bitmap, 1.);
+		cache->setLayer (v2, bitmap, 1.);
+		EXPECT(cache->getLayer (v1, 1.));
+		cache->setLayer (v3, bitmap, 1.);
+		EXPECT(cache->getNumLayers () == 2);
+		EXPECT(cache->getStatistics ().numEvictions == 1);
+		EXPECT(cache->getLayer (v1, 1.));
+		EXPECT(cache->getLayer (v2, 1.) == nullptr);
+		EXPECT(cache->getLayer (v3, 1.));
+		cache->setMemoryBudget (0);
+		EXPECT(cache->getNumLayers () == 0);
+		EXPECT(cache->getMemoryUsage () == 0);
+	);
+
+	TEST(layerLargerThanBudgetIsNotStored,
+		cache->setMemoryBudget (100);
+		auto view = owned (new CView (CRect (0, 0, 10, 10)));
+		auto bitmap = owned (new CBitmap (CPoint (10, 10), 1.));
+		EXPECT(cache->setLayer (view, bitmap, 1.) == false);
+		EXPECT(cache->getNumLayers () == 0);
+	);
+
+	TEST(drawViewRendersLayerOnce,
+		uint32_t numLayerContexts = 0;
+		cache->setCreateContextFunc ([&] (CView*, const CPoint& size, double scaleFactor) {
+			++numLayerContexts;
+			auto bitmap = owned (new CBitmap (size, scaleFactor));
+			return SharedPointer<COffscreenContext> (makeOwned<MockContext> (bitmap));
+		});
+		auto view = owned (new CountingView (CRect (10, 10, 30, 30)));
+		view->setCacheAsBitmap (true);
+		auto screenBitmap = owned (new CBitmap (CPoint (100, 100), 1.));
+		MockContext context (screenBitmap);
+
+		EXPECT(cache->drawView (view, &context));
+		EXPECT(numLayerContexts == 1);
+		EXPECT(view->numDraws == 1);
+		EXPECT(context.drawnBitmaps.size () == 1);
+		SharedPointer<CBitmap> layer = cache->getLayer (view, 1.);
+		EXPECT(layer);
+		EXPECT(context.drawnBitmaps[0] == layer);
+
+		cache->resetStatistics ();
+		EXPECT(cache->drawView (view, &context));
+		EXPECT(numLayerContexts == 1);
+		EXPECT(view->numDraws == 1);
+		EXPECT(context.drawnBitmaps.size () == 2);
+		EXPECT(context.drawnBitmaps[1] == layer);
+		EXPECT(cache->getStatistics ().numHits == 1);
+		EXPECT(cache->getStatistics ().numMisses == 0);
+
+		view->invalid ();
+		EXPECT(cache->drawView (view, &context));
+		EXPECT(numLayerContexts == 2);
+		EXPECT(view->numDraws == 2);
+		EXPECT(context.drawnBitmaps.size () == 3);
+		EXPECT(context.drawnBitmaps[2] != layer);
+		EXPECT(cache->getStatistics ().numMisses == 1);
+		view->setCacheAsBitmap (false);
+	);
+
+	TEST(drawViewFailsWithoutLayerContext,
+		auto view = owned (new CountingView (CRect (0, 0, 10, 10)));
+		view->setCacheAsBitmap (true);
+		auto screenBitmap = owned (new CBitmap (CPoint (100, 100), 1.));
+		MockContext context (screenBitmap);
+		EXPECT(cache->drawView (view, &context) == false);
+		EXPECT(view->numDraws == 0);
+		EXPECT(context.drawnBitmaps.empty ());
+		EXPECT(cache->getNumLayers () == 0);
+	);
+
+	TEST(invalidatingSubviewReleasesLayer,
+		auto frame = owned (new CFrame (CRect (0, 0, 100, 100), nullptr));
+		auto container = new CViewContainer (CRect (0, 0, 50, 50));
+		auto view = new CView (CRect (0, 0, 10, 10));
+		container->addView (view);
+		frame->addView (container);
+		frame->attached (frame);
+		container->setCacheAsBitmap (true);
+		auto bitmap = owned (new CBitmap (CPoint (50, 50), 1.));
+		cache->setLayer (container, bitmap, 1.);
+		view->invalid ();
+		EXPECT(cache->getNumLayers () == 0);
+		cache->setLayer (container, bitmap, 1.);
+		container->invalid ();
+		EXPECT(cache->getNumLayers () == 0);
+		cache->setLayer (container, bitmap, 1.);
+		container->setCacheAsBitmap (false);
+		EXPECT(cache->getNumLayers () == 0);
+		container->setCacheAsBitmap (true);
+		cache->setLayer (container, bitmap, 1.);
+		frame->removeView (container);
+		EXPECT(cache->getNumLayers () == 0);
+		frame->removed (frame);
+	);
+);
+
+} // VSTGUI
@@ -4,6 +4,7 @@
 
 #include "../../../lib/vstguibase.h"
 #include "../../../lib/platform/iplatformframe.h"
+#include <string>
 
 namespace VSTGUI {
 namespace UnitTest {
@@ -17,6 +18,9 @@ struct PlatformParentHandle : public CBaseObject
 	virtual void forceRedraw () = 0;
 };
 
+/** the UTF-8 text of a platform string */
+std::string getPlatformStringText (IPlatformString* string);
+
 } // UnitTest
 } // VSTGUI
 
@@ -3,6 +3,7 @@
 // distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
 
 #include "platform_helper.h"
+#include "../../../lib/platform/linux/linuxstring.h"
 
 namespace VSTGUI {
 namespace UnitTest {
@@ -27,6 +28,13 @@ void PlatformParentHandle::forceRedraw ()
 
 }
 
+std::string getPlatformStringText (IPlatformString* string)
+{
+	if (auto linuxString = dynamic_cast<LinuxString*> (string))
+		return linuxString->get ();
+	return {};
+}
+
 } // UnitTest
 } // VSTGUI
 
@@ -3,6 +3,7 @@
 // distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
 
 #include "platform_helper.h"
+#include "../../../lib/platform/mac/macstring.h"
 #import <Cocoa/Cocoa.h>
 
 namespace VSTGUI {
@@ -44,6 +45,14 @@ SharedPointer<PlatformParentHandle> PlatformParentHandle::create ()
 	return owned (dynamic_cast<PlatformParentHandle*> (new MacParentHandle ()));
 }
 
+std::string getPlatformStringText (IPlatformString* string)
+{
+	auto macString = dynamic_cast<MacString*> (string);
+	if (!macString || !macString->getCFString ())
+		return {};
+	return [(NSString*)macString->getCFString () UTF8String];
+}
+
 } // UnitTest
 } // VSTGUI
 
@@ -4,6 +4,7 @@
 
 #include "platform_helper.h"
 #include "../../../lib/platform/win32/win32support.h"
+#include "../../../lib/platform/win32/winstring.h"
 #include <windows.h>
 
 namespace VSTGUI {
@@ -80,6 +81,15 @@ SharedPointer<PlatformParentHandle> PlatformParentHandle::create()
 	return owned (dynamic_cast<PlatformParentHandle*> (new WinPlatformHandle ()));
 }
 
+std::string getPlatformStringText (IPlatformString* string)
+{
+	auto winString = dynamic_cast<WinString*> (string);
+	if (!winString || !winString->getWideString ())
+		return {};
+	UTF8StringHelper helper (winString->getWideString ());
+	return helper.getUTF8String ();
+}
+
 } // UnitTest
 } // VSTGUI
 
@@ -0,0 +1,200 @@
+// This file is part of VSTGUI. It is subject to the license terms
+// in the LICENSE file found in the top-level directory of this
+// distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
+
+#include "../unittests.h"
+#include "../../../standalone/source/platform/common/threadpool.h"
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <thread>
+#include <vector>
+
+namespace VSTGUI {
+using namespace Standalone;
+using namespace Standalone::Platform;
+
+namespace {
+
+//------------------------------------------------------------------------
+/** blocks a worker of a pool until it is released */
+struct WorkerBlocker
+{
+	std::promise<void> started;
+	std::promise<void> released;
+
+	/** returns when the worker is blocked */
+	void block (ThreadPool& pool)
+	{
+		auto future = released.get_future ().share ();
+		pool.perform ([this, future] () {
+			started.set_value ();
+			future.wait ();
+		});
+		started.get_future ().wait ();
+	}
+	void release () { released.set_value (); }
+};
+
+//------------------------------------------------------------------------
+void performNested (ThreadPool& pool, std::atomic<uint32_t>& counter, uint32_t depth)
+{
+	++counter;
+	if (depth == 0)
+		return;
+	for (auto i = 0; i < 2; ++i)
+		pool.perform ([&pool, &counter, depth] () { performNested (pool, counter, depth - 1); });
+}
+
+} // anonymous
+
+//------------------------------------------------------------------------
+TESTCASE(ThreadPoolTest,
+
+	TEST(performsAllTasks,
+		ThreadPool pool (4);
+		EXPECT(pool.getNumThreads () == 4);
+		std::atomic<uint32_t> counter {0};
+		for (auto i = 0; i < 1000; ++i)
+			pool.perform ([&counter] () { ++counter; });
+		pool.waitUntilIdle ();
+		EXPECT(counter == 1000);
+		EXPECT(pool.isBusy () == false);
+	);
+
+	TEST(workerTakesNewestTaskFirst,
+		ThreadPool pool (1);
+		WorkerBlocker blocker;
+		blocker.block (pool);
+		std::vector<int> order;
+		for (auto i = 0; i < 3; ++i)
+			pool.perform ([&order, i] () { order.push_back (i); });
+		blocker.release ();
+		pool.waitUntilIdle ();
+		EXPECT(order.size () == 3);
+		EXPECT(order[0] == 2);
+		EXPECT(order[1] == 1);
+		EXPECT(order[2] == 0);
+	);
+
+	TEST(nestedTasks,
+		ThreadPool pool (4);
+		std::atomic<uint32_t> counter {0};
+		pool.perform ([&pool, &counter] () { performNested (pool, counter, 6); });
+		pool.waitUntilIdle ();
+		EXPECT(counter == 127);
+	);
+
+	TEST(cancelledTasksAreSkipped,
+		ThreadPool pool (1);
+		WorkerBlocker blocker;
+		blocker.block (pool);
+		Async::CancellationToken token;
+		Async::CancellationToken otherToken;
+		std::atomic<uint32_t> counter {0};
+		std::atomic<uint32_t> otherCounter {0};
+		for (auto i = 0; i < 10; ++i)
+		{
+			pool.perform (Async::makeCancellable (token, [&counter] () { ++counter; }));
+			pool.perform (Async::makeCancellable (otherToken, [&otherCounter] () { ++otherCounter; }));
+		}
+		token.cancel ();
+		EXPECT(token.isCancelled ());
+		blocker.release ();
+		pool.waitUntilIdle ();
+		EXPECT(counter == 0);
+		EXPECT(otherCounter == 10);
+	);
+
+	TEST(waitUntilIdleWaitsForRunningTasks,
+		ThreadPool pool (2);
+		std::atomic<bool> done {false};
+		pool.perform ([&done] () {
+			std::this_thread::sleep_for (std::chrono::milliseconds (20));
+			done = true;
+		});
+		EXPECT(pool.isBusy ());
+		pool.waitUntilIdle ();
+		EXPECT(done);
+		EXPECT(pool.isBusy () == false);
+	);
+
+	TEST(destructorPerformsQueuedTasks,
+		std::atomic<uint32_t> counter {0};
+		{
+			ThreadPool pool (2);
+			for (auto i = 0; i < 100; ++i)
+				pool.perform ([&counter] () { ++counter; });
+		}
+		EXPECT(counter == 100);
+	);
+);
+
+//------------------------------------------------------------------------
+TESTCASE(LockFreeTaskQueueTest,
+
+	TEST(performsInPushOrder,
+		LockFreeTaskQueue queue;
+		std::vector<int> order;
+		EXPECT(queue.push ([&order] () { order.push_back (0); }));
+		EXPECT(queue.push ([&order] () { order.push_back (1); }) == false);
+		EXPECT(queue.push ([&order] () { order.push_back (2); }) == false);
+		EXPECT(queue.performAll () == 3);
+		EXPECT(order.size () == 3);
+		EXPECT(order[0] == 0);
+		EXPECT(order[1] == 1);
+		EXPECT(order[2] == 2);
+		EXPECT(queue.performAll () == 0);
+		EXPECT(queue.push ([] () {}));
+	);
+
+	TEST(tasksPushedWhilePerformingAreKept,
+		LockFreeTaskQueue queue;
+		uint32_t counter = 0;
+		queue.push ([&queue, &counter] () {
+			++counter;
+			queue.push ([&counter] () { ++counter; });
+		});
+		EXPECT(queue.performAll () == 1);
+		EXPECT(counter == 1);
+		EXPECT(queue.performAll () == 1);
+		EXPECT(counter == 2);
+	);
+
+	TEST(pushFromManyThreads,
+		LockFreeTaskQueue queue;
+		std::vector<std::vector<int>> orders (4);
+		std::vector<std::thread> threads;
+		for (auto t = 0u; t < orders.size (); ++t)
+		{
+			threads.emplace_back ([&queue, &orders, t] () {
+				for (auto i = 0; i < 1000; ++i)
+					queue.push ([&orders, t, i] () { orders[t].push_back (i); });
+			});
+		}
+		size_t numPerformed = 0;
+		while (numPerformed < 4000)
+			numPerformed += queue.performAll ();
+		for (auto& thread : threads)
+			thread.join ();
+		EXPECT(numPerformed == 4000);
+		for (const auto& order : orders)
+		{
+			EXPECT(order.size () == 1000);
+			for (auto i = 0u; i < order.size (); ++i)
+				EXPECT(order[i] == static_cast<int> (i));
+		}
+	);
+
+	TEST(destructorDeletesQueuedTasks,
+		auto shared = std::make_shared<int> (0);
+		{
+			LockFreeTaskQueue queue;
+			queue.push ([shared] () {});
+			EXPECT(shared.use_count () == 2);
+		}
+		EXPECT(shared.use_count () == 1);
+	);
+);
+
+} // VSTGUI
@@ -4,7 +4,9 @@
 
 #include "../unittests.h"
 #include "../../../uidescription/base64codec.h"
+#include <cstring>
 #include <string>
+#include <vector>
 
 namespace VSTGUI {
 
@@ -69,6 +71,42 @@ TESTCASE(Base64CodecTest,
 		 EXPECT (ptr[4] == 0x0D);
 		 EXPECT (ptr[5] == 0x0A);
 	);
+
+	TEST(kernelsMatchScalarCode,
+		 std::vector<uint8_t> data (300);
+		 for (auto i = 0u; i < data.size (); ++i)
+			 data[i] = static_cast<uint8_t> (i * 31 + (i >> 3));
+		 auto defaultKernel = Base64Codec::getKernel ();
+		 for (auto kernel : {Base64Codec::Kernel::SSSE3, Base64Codec::Kernel::AVX2, Base64Codec::Kernel::NEON})
+		 {
+			 if (!Base64Codec::setKernel (kernel))
+				 continue;
+			 for (auto size = 0u; size < data.size (); ++size)
+			 {
+				 Base64Codec::setKernel (Base64Codec::Kernel::Scalar);
+				 auto expected = Base64Codec::encode (data.data (), size);
+				 Base64Codec::setKernel (kernel);
+				 auto encoded = Base64Codec::encode (data.data (), size);
+				 EXPECT (encoded.dataSize == expected.dataSize);
+				 EXPECT (memcmp (encoded.data.get (), expected.data.get (), expected.dataSize) == 0);
+				 auto decoded = Base64Codec::decode (encoded.data.get (), encoded.dataSize);
+				 EXPECT (decoded.dataSize == size);
+				 EXPECT (memcmp (decoded.data.get (), data.data (), size) == 0);
+			 }
+		 }
+		 Base64Codec::setKernel (defaultKernel);
+	);
+
+	TEST(decodeStopsVectorKernelAtPadding,
+		 std::string test ("QUJDRA==QUJDRA==QUJDRA==QUJDRA==QUJDRA==QUJDRA==QUJDRA==QUJDRA==");
+		 auto defaultKernel = Base64Codec::getKernel ();
+		 Base64Codec::setKernel (Base64Codec::Kernel::Scalar);
+		 auto expected = Base64Codec::decode (test);
+		 Base64Codec::setKernel (defaultKernel);
+		 auto result = Base64Codec::decode (test);
+		 EXPECT (result.dataSize == expected.dataSize);
+		 EXPECT (memcmp (result.data.get (), expected.data.get (), expected.dataSize) == 0);
+	);
 );
 
 }
@@ -0,0 +1,149 @@
+// This file is part of VSTGUI. It is subject to the license terms
+// in the LICENSE file found in the top-level directory of this
+// distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
+
+#include "../unittests.h"
+#include "../../../uidescription/binaryuidescription.h"
+#include "../../../uidescription/uiattributes.h"
+#include "../../../uidescription/xmlparser.h"
+#include "../../../lib/cresourcedescription.h"
+#include "../../../lib/ccolor.h"
+#include <string>
+#include <vector>
+
+namespace VSTGUI {
+
+namespace {
+
+constexpr auto binaryTestUIDesc = R"(
+<vstgui-ui-description version="1">
+	<!-- comment -->
+	<variables>
+		<var name="v1" value="10"/>
+	</variables>
+	<bitmaps>
+		<bitmap name="b1" path="b1.png">
+			<data encoding="base64">
+				iVBORw0KGgoAAAANSUhEUgAAAAEAAAABCAYAAAAfFcSJAAAADUlEQVR42mP8z8BQDwAEhQGAhKmMIQAAAABJRU5ErkJggg==
+			</data>
+		</bitmap>
+	</bitmaps>
+	<fonts>
+		<font font-name="Arial" name="f1" size="8"/>
+	</fonts>
+	<colors>
+		<color name="c1" rgba="#ff0000ff"/>
+		<color name="c2" rgba="#00ff00ff"/>
+	</colors>
+	<control-tags>
+		<control-tag name="t1" tag="1234"/>
+	</control-tags>
+	<template class="CViewContainer" name="view" size="100, 100">
+		<view class="CView" origin="0, 0" size="10, 10"/>
+		<view class="CView" origin="10, 0" size="10, 10"/>
+	</template>
+</vstgui-ui-description>
+)";
+
+//------------------------------------------------------------------------
+class TestBinaryUIDescription : public BinaryUIDescription
+{
+public:
+	TestBinaryUIDescription () : BinaryUIDescription (CResourceDescription ("")) {}
+	TestBinaryUIDescription (Xml::IContentProvider* xmlContentProvider)
+	: BinaryUIDescription (CResourceDescription (""))
+	{
+		setXmlContentProvider (xmlContentProvider);
+	}
+
+	std::string toXml ()
+	{
+		CMemoryStream stream (1024, 1024, false);
+		saveToStream (stream, kWriteImagesIntoXMLFile);
+		return std::string (reinterpret_cast<const char*> (stream.getBuffer ()),
+		                    static_cast<size_t> (stream.tell ()));
+	}
+};
+
+//------------------------------------------------------------------------
+std::vector<uint8_t> toBinary (TestBinaryUIDescription& desc)
+{
+	CMemoryStream stream (1024, 1024, true, kLittleEndianByteOrder);
+	if (!desc.saveBinary (stream))
+		return {};
+	auto data = reinterpret_cast<const uint8_t*> (stream.getBuffer ());
+	return std::vector<uint8_t> (data, data + stream.tell ());
+}
+
+} // anonymous
+
+//------------------------------------------------------------------------
+TESTCASE(BinaryUIDescriptionTest,
+
+	TEST(roundTripMatchesXmlLoader,
+		Xml::MemoryContentProvider provider (binaryTestUIDesc, static_cast<uint32_t> (strlen (binaryTestUIDesc)));
+		TestBinaryUIDescription xmlDesc (&provider);
+		EXPECT(xmlDesc.parse ());
+		EXPECT(xmlDesc.getOriginalIsBinary () == false);
+		auto binary = toBinary (xmlDesc);
+		EXPECT(BinaryUIDescription::isBinaryDescription (binary.data (), binary.size ()));
+
+		TestBinaryUIDescription binaryDesc;
+		EXPECT(binaryDesc.parseBinary (binary.data (), binary.size ()));
+		EXPECT(binaryDesc.getOriginalIsBinary ());
+		auto xml = binaryDesc.toXml ();
+		EXPECT(xml == xmlDesc.toXml ());
+		EXPECT(xml.find ("iVBORw0KGgoAAAANSUhEUgAAAAEAAAAB") != std::string::npos);
+		EXPECT(xml.find ("<!-- comment -->") != std::string::npos);
+		EXPECT(toBinary (binaryDesc) == binary);
+
+		CColor color;
+		EXPECT(binaryDesc.getColor ("c2", color));
+		EXPECT(color == kGreenCColor);
+		EXPECT(binaryDesc.getTagForName ("t1") == 1234);
+		double value;
+		EXPECT(binaryDesc.getVariable ("v1", value));
+		EXPECT(value == 10.);
+		auto attributes = binaryDesc.getViewAttributes ("view");
+		EXPECT(attributes);
+		EXPECT(*attributes->getAttributeValue ("class") == "CViewContainer");
+	);
+
+	TEST(bitmapDataIsStoredDecoded,
+		Xml::MemoryContentProvider provider (binaryTestUIDesc, static_cast<uint32_t> (strlen (binaryTestUIDesc)));
+		TestBinaryUIDescription xmlDesc (&provider);
+		EXPECT(xmlDesc.parse ());
+		auto binary = toBinary (xmlDesc);
+		std::string binaryString (binary.begin (), binary.end ());
+		EXPECT(binaryString.find ("iVBORw0KGgoAAAANSUhEUgAAAAEAAAAB") == std::string::npos);
+		EXPECT(binaryString.find ("\x89PNG\r\n") != std::string::npos);
+
+		TestBinaryUIDescription binaryDesc;
+		EXPECT(binaryDesc.parseBinary (binary.data (), binary.size ()));
+		EXPECT(binaryDesc.toXml () == xmlDesc.toXml ());
+		EXPECT(toBinary (binaryDesc) == binary);
+	);
+
+	TEST(xmlDataIsNotBinary,
+		EXPECT(BinaryUIDescription::isBinaryDescription (binaryTestUIDesc, strlen (binaryTestUIDesc)) == false);
+		TestBinaryUIDescription desc;
+		EXPECT(desc.parseBinary (binaryTestUIDesc, strlen (binaryTestUIDesc)) == false);
+	);
+
+	TEST(truncatedDataIsRejected,
+		Xml::MemoryContentProvider provider (binaryTestUIDesc, static_cast<uint32_t> (strlen (binaryTestUIDesc)));
+		TestBinaryUIDescription xmlDesc (&provider);
+		xmlDesc.parse ();
+		auto binary = toBinary (xmlDesc);
+		for (auto size : {binary.size () / 2, binary.size () - 1})
+		{
+			TestBinaryUIDescription desc;
+			EXPECT(desc.parseBinary (binary.data (), size) == false);
+		}
+		binary.back () = 0xff;
+		TestBinaryUIDescription desc;
+		EXPECT(desc.parseBinary (binary.data (), binary.size ()) == false);
+	);
+);
+
+} // VSTGUI
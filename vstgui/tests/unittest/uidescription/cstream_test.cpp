@@ -4,6 +4,10 @@
 
 #include "../unittests.h"
 #include "../../../uidescription/cstream.h"
+#include "../../../uidescription/base64codec.h"
+#include <cstdio>
+#include <cstring>
+#include <vector>
 
 namespace VSTGUI {
 
@@ -136,4 +140,69 @@ TESTCASE(CMemoryStreamTests,
 	
 );
 
+TESTCASE(Base64StreamTests,
+
+	TEST(encodeInChunks,
+		std::vector<uint8_t> data (1000);
+		for (auto i = 0u; i < data.size (); ++i)
+			data[i] = static_cast<uint8_t> (i * 7);
+		auto expected = Base64Codec::encode (data.data (), data.size ());
+		CMemoryStream target (1024, 1024, false);
+		{
+			Base64EncodingOutputStream stream (target);
+			uint32_t pos = 0;
+			uint32_t chunk = 1;
+			while (pos < data.size ())
+			{
+				auto size = std::min<uint32_t> (chunk++, static_cast<uint32_t> (data.size ()) - pos);
+				EXPECT(stream.writeRaw (data.data () + pos, size) == size);
+				pos += size;
+			}
+		}
+		EXPECT(target.tell () == expected.dataSize);
+		EXPECT(memcmp (target.getBuffer (), expected.data.get (), expected.dataSize) == 0);
+	);
+);
+
+//------------------------------------------------------------------------
+TESTCASE(CMappedFileInputStreamTests,
+
+	TEST(readSeekAndMappedData,
+		constexpr auto path = "cmappedfileinputstream_test.tmp";
+		std::vector<uint8_t> data (10000);
+		for (auto i = 0u; i < data.size (); ++i)
+			data[i] = static_cast<uint8_t> (i * 7);
+		{
+			CFileStream file;
+			EXPECT(file.open (path, CFileStream::kWriteMode | CFileStream::kBinaryMode | CFileStream::kTruncateMode));
+			EXPECT(file.writeRaw (data.data (), static_cast<uint32_t> (data.size ())) == data.size ());
+		}
+		{
+			CMappedFileInputStream stream;
+			EXPECT(stream.open (path));
+			size_t size;
+			auto mapped = stream.getMappedData (size);
+			EXPECT(size == data.size ());
+			EXPECT(memcmp (mapped, data.data (), size) == 0);
+
+			uint8_t buffer[16];
+			EXPECT(stream.seek (9990, SeekableStream::kSeekSet) == 9990);
+			EXPECT(stream.readRaw (buffer, 16) == 10);
+			EXPECT(memcmp (buffer, data.data () + 9990, 10) == 0);
+			EXPECT(stream.readRaw (buffer, 16) == 0);
+			EXPECT(stream.seek (1, SeekableStream::kSeekEnd) == kStreamSeekError);
+			stream.rewind ();
+			EXPECT(stream.tell () == 0);
+		}
+		std::remove (path);
+	);
+
+	TEST(openFailsForMissingFile,
+		CMappedFileInputStream stream;
+		EXPECT(stream.open ("this file does not exist") == false);
+		size_t size;
+		EXPECT(stream.getMappedData (size) == nullptr);
+	);
+);
+
 } // VSTGUI
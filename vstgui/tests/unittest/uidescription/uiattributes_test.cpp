@@ -7,10 +7,19 @@
 #include "../../../uidescription/cstream.h"
 #include "../../../lib/cpoint.h"
 #include "../../../lib/crect.h"
+#include <locale>
+#include <sstream>
 
 namespace VSTGUI {
 
 static UTF8StringPtr attributes [] = {"K1", "V1", "K2", "V2", nullptr};
+static UTF8StringPtr duplicateAttributes [] = {"K2", "V2", "K1", "V1", "K2", "V3", nullptr};
+static UTF8StringPtr doubleStrings [] = {
+	"0", "-0", "3.45", " 12.5", "+7", ".5", "5.", "1e3", "1.5E-3", "-2.5e+2",
+	"0.1000000000000000055511151231257827021182", "123456789012345678", "1e300", "1e", "1.2.3",
+	"12px", "abc", "", "  ", "-", "4.9406564584124654e-324"
+};
+static const double roundTripDoubles [] = {0.1, 1. / 3., -1234.5678, 1e-10, 6.02214076e23};
 
 TESTCASE(UIAttributesTest,
 
@@ -133,6 +142,80 @@ TESTCASE(UIAttributesTest,
 		UIAttributes a;
 		EXPECT(a.restore(s) == false);
 	);
+
+	TEST(typedValueIsInvalidatedBySetAttribute,
+		UIAttributes a;
+		a.setAttribute ("Key", "10, 20");
+		CPoint p;
+		EXPECT(a.getPointAttribute ("Key", p));
+		EXPECT(p == CPoint (10, 20));
+		a.setAttribute ("Key", "30, 40");
+		EXPECT(a.getPointAttribute ("Key", p));
+		EXPECT(p == CPoint (30, 40));
+		a.setAttribute ("Key", "50");
+		EXPECT(a.getPointAttribute ("Key", p) == false);
+		double d;
+		EXPECT(a.getDoubleAttribute ("Key", d));
+		EXPECT(d == 50.);
+		a.setAttribute ("Other", "1, 2, 3, 4");
+		CRect r;
+		EXPECT(a.getRectAttribute ("Other", r));
+		EXPECT(r == CRect (1, 2, 3, 4));
+		a.removeAttribute ("Key");
+		EXPECT(a.getRectAttribute ("Other", r));
+		EXPECT(r == CRect (1, 2, 3, 4));
+	);
+
+	TEST(doubleParsingMatchesStream,
+		for (auto str : doubleStrings)
+		{
+			std::istringstream stream (str);
+			stream.imbue (std::locale::classic ());
+			double expected;
+			stream >> expected;
+			UIAttributes a;
+			a.setAttribute ("Key", str);
+			double value;
+			EXPECT(a.getDoubleAttribute ("Key", value));
+			EXPECT(value == expected);
+		}
+	);
+
+	TEST(doubleAttributeRoundTrip,
+		UIAttributes a;
+		for (auto v : roundTripDoubles)
+		{
+			a.setDoubleAttribute ("Key", v);
+			double value;
+			EXPECT(a.getDoubleAttribute ("Key", value));
+			EXPECT(value == v);
+		}
+	);
+
+	TEST(stringArrayValues,
+		UIAttributes a;
+		a.setAttribute ("Key", "a,,b,");
+		UIAttributes::StringArray array;
+		EXPECT(a.getStringArrayAttribute ("Key", array));
+		EXPECT(array.size () == 3);
+		EXPECT(array[0] == "a");
+		EXPECT(array[1].empty ());
+		EXPECT(array[2] == "b");
+		EXPECT(UIAttributes::createStringArrayValue (UIAttributes::StringArray ()).empty ());
+	);
+
+	TEST(insertionOrder,
+		UIAttributes a (duplicateAttributes);
+		a.setAttribute ("K0", "V0");
+		UIAttributes::StringArray names;
+		for (auto& v : a)
+			names.push_back (v.first);
+		EXPECT(names.size () == 3);
+		EXPECT(names[0] == "K2");
+		EXPECT(names[1] == "K1");
+		EXPECT(names[2] == "K0");
+		EXPECT(*a.getAttributeValue ("K2") == "V2");
+	);
 );
 
 } // VSTGUI
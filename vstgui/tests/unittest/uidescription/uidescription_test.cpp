@@ -56,6 +56,22 @@ constexpr auto bitmapNodesUIDesc = R"(
 </vstgui-ui-description>
 )";
 
+constexpr auto bitmapDataNodesUIDesc = R"(
+<vstgui-ui-description version="1">
+	<bitmaps>
+		<bitmap name="b1" path="b1.png">
+			<data encoding="base64">iVBORw0KGgoAAAANSUhEUgAAAAEAAAABCAYAAAAfFcSJAAAADUlEQVR42mP8z8BQDwAEhQGAhKmMIQAAAABJRU5ErkJggg==</data>
+		</bitmap>
+		<bitmap name="b2" path="b2.png">
+			<data encoding="base64">iVBORw0KGgoAAAANSUhEUgAAAAEAAAABCAYAAAAfFcSJAAAADUlEQVR42mP8z8BQDwAEhQGAhKmMIQAAAABJRU5ErkJggg==</data>
+		</bitmap>
+		<bitmap name="b3" path="b3.png">
+			<data encoding="base64">iVBORw0KGgoAAAANSUhEUgAAAAEAAAABCAYAAAAfFcSJAAAADUlEQVR42mP8z8BQDwAEhQGAhKmMIQAAAABJRU5ErkJggg==</data>
+		</bitmap>
+	</bitmaps>
+</vstgui-ui-description>
+)";
+
 constexpr auto tagNodesUIDesc = R"(
 <vstgui-ui-description version="1">
 	<control-tags>
@@ -99,6 +115,23 @@ constexpr auto variableNodesUIDesc = R"(
 </vstgui-ui-description>
 )";
 
+constexpr auto expressionNodesUIDesc = R"(
+<vstgui-ui-description version="1">
+	<control-tags>
+		<control-tag name="t1" tag="100"/>
+		<control-tag name="t2" tag="tag.t1 + 1"/>
+	</control-tags>
+	<variables>
+		<var name="v1" type="string" value="tag.t1 * 2"/>
+		<var name="v2" type="string" value="var.v1 + 1"/>
+		<var name="v3" type="string" value="tag.t2 - 1"/>
+		<var name="v4" type="string" value="(1 + 2) * 3"/>
+		<var name="cycle1" type="string" value="var.cycle2 + 1"/>
+		<var name="cycle2" type="string" value="var.cycle1 + 1"/>
+	</variables>
+</vstgui-ui-description>
+)";
+
 constexpr auto withAllNodesUIDesc = R"(<?xml version="1.0" encoding="UTF-8"?>
 <vstgui-ui-description version="1">
 	<colors>
@@ -176,6 +209,13 @@ constexpr auto createViewUIDesc = R"(
 </vstgui-ui-description>
 )";
 
+constexpr auto shadowedTemplateUIDesc = R"(
+<vstgui-ui-description version="1">
+	<custom name="view"/>
+	<template class="CViewContainer" name="view" origin="0, 0" size="400, 235"/>
+</vstgui-ui-description>
+)";
+
 constexpr auto restoreViewUIDesc = R"(
 <vstgui-ui-description version="1">
 	<template background-color="~ TransparentCColor" background-color-draw-style="filled and stroked" class="CViewContainer" mouse-enabled="true" name="view" opacity="1" origin="0, 0" size="400, 235" transparent="false">
@@ -417,6 +457,40 @@ TESTCASE(UIDescriptionTests,
 		EXPECT(dynamic_cast<CNinePartTiledBitmap*>(bitmap) == nullptr);
 	);
 	
+	TEST(prefetchBitmaps,
+		Xml::MemoryContentProvider provider (bitmapDataNodesUIDesc, static_cast<uint32_t> (strlen(bitmapDataNodesUIDesc)));
+		UIDescription desc (&provider);
+		EXPECT(desc.parse () == true);
+		EXPECT(desc.getBitmapDecodeInfos ().empty ());
+		desc.prefetchBitmaps ({"b1", "b2"});
+		auto b1 = desc.getBitmap ("b1");
+		EXPECT(b1 && b1->getPlatformBitmap ());
+		EXPECT(b1->getResourceDescription ().u.name == std::string ("b1.png"));
+		auto b3 = desc.getBitmap ("b3");
+		EXPECT(b3 && b3->getPlatformBitmap ());
+		auto b2 = desc.getBitmap ("b2");
+		EXPECT(b2 && b2->getPlatformBitmap ());
+		auto infos = desc.getBitmapDecodeInfos ();
+		EXPECT(infos.size () == 3);
+		for (const auto& info : infos)
+		{
+			EXPECT(info.decodeTime >= 0.);
+			EXPECT(info.waitTime >= 0.);
+			if (info.name == "b3")
+				EXPECT(info.prefetched == false);
+		}
+		desc.prefetchBitmaps ();
+		EXPECT(desc.getBitmap ("b1") == b1);
+	);
+
+	TEST(prefetchedBitmapsAreReleasedWithDescription,
+		Xml::MemoryContentProvider provider (bitmapDataNodesUIDesc, static_cast<uint32_t> (strlen(bitmapDataNodesUIDesc)));
+		auto desc = makeOwned<UIDescription> (&provider);
+		EXPECT(desc->parse () == true);
+		desc->prefetchBitmaps ();
+		desc = nullptr;
+	);
+
 	TEST(tags,
 		Xml::MemoryContentProvider provider (tagNodesUIDesc, static_cast<uint32_t> (strlen(tagNodesUIDesc)));
 		UIDescription desc (&provider);
@@ -525,6 +599,71 @@ TESTCASE(UIDescriptionTests,
 		EXPECT(desc.calculateStringValue ("tag.unknown - 4", value) == false);
 		EXPECT(desc.calculateStringValue ("var.unknown", value) == false);
 		EXPECT(desc.calculateStringValue ("unknown", value) == false);
+		EXPECT(desc.calculateStringValue ("-2 * 3", value));
+		EXPECT(value == -6.);
+		EXPECT(desc.calculateStringValue ("1e-3", value));
+		EXPECT(value == 0.001);
+		EXPECT(desc.calculateStringValue (" 8 / 4 / 2 ", value));
+		EXPECT(value == 1.);
+		EXPECT(desc.calculateStringValue ("2 *", value) == false);
+		EXPECT(desc.calculateStringValue ("", value));
+		EXPECT(value == 0.);
+	);
+
+	TEST(expressionsFollowTagChanges,
+		Xml::MemoryContentProvider provider (expressionNodesUIDesc, static_cast<uint32_t> (strlen(expressionNodesUIDesc)));
+		UIDescription desc (&provider);
+		EXPECT(desc.parse () == true);
+		double value;
+		EXPECT(desc.getVariable ("v1", value));
+		EXPECT(value == 200.);
+		EXPECT(desc.getVariable ("v2", value));
+		EXPECT(value == 201.);
+		EXPECT(desc.getVariable ("v3", value));
+		EXPECT(value == 100.);
+		EXPECT(desc.getVariable ("v4", value));
+		EXPECT(value == 9.);
+		EXPECT(desc.getTagForName ("t2") == 101);
+
+		desc.changeControlTagString ("t1", "10");
+		EXPECT(desc.getTagForName ("t2") == 11);
+		EXPECT(desc.getVariable ("v1", value));
+		EXPECT(value == 20.);
+		EXPECT(desc.getVariable ("v2", value));
+		EXPECT(value == 21.);
+		EXPECT(desc.getVariable ("v3", value));
+		EXPECT(value == 10.);
+
+		desc.changeControlTagString ("t2", "5");
+		EXPECT(desc.getVariable ("v3", value));
+		EXPECT(value == 4.);
+		EXPECT(desc.getVariable ("v1", value));
+		EXPECT(value == 20.);
+
+		desc.changeTagName ("t1", "renamed");
+		EXPECT(desc.getVariable ("v1", value) == false);
+		EXPECT(desc.getVariable ("v2", value) == false);
+		desc.changeTagName ("renamed", "t1");
+		EXPECT(desc.getVariable ("v2", value));
+		EXPECT(value == 21.);
+
+		desc.removeTag ("t1");
+		EXPECT(desc.getVariable ("v1", value) == false);
+		desc.changeControlTagString ("t1", "1", true);
+		EXPECT(desc.getVariable ("v1", value));
+		EXPECT(value == 2.);
+	);
+
+	TEST(cyclicExpressionsFail,
+		Xml::MemoryContentProvider provider (expressionNodesUIDesc, static_cast<uint32_t> (strlen(expressionNodesUIDesc)));
+		UIDescription desc (&provider);
+		EXPECT(desc.parse () == true);
+		double value;
+		EXPECT(desc.getVariable ("cycle1", value) == false);
+		EXPECT(desc.getVariable ("cycle2", value) == false);
+		desc.changeControlTagString ("t1", "tag.t2");
+		EXPECT(desc.getTagForName ("t1") == -1);
+		EXPECT(desc.getVariable ("v1", value) == false);
 	);
 
 	TEST(writeToStream,
@@ -554,6 +693,21 @@ TESTCASE(UIDescriptionTests,
 		 EXPECT(attributes == nullptr);
 	);
 
+	TEST(templateIsNotShadowedByOtherNode,
+		 Xml::MemoryContentProvider provider (shadowedTemplateUIDesc, static_cast<uint32_t> (strlen(shadowedTemplateUIDesc)));
+		 UIDescription desc (&provider);
+		 EXPECT(desc.parse () == true);
+
+		 auto attributes = desc.getViewAttributes ("view");
+		 EXPECT(attributes);
+		 auto classAttr = attributes->getAttributeValue (UIViewCreator::kAttrClass);
+		 EXPECT(classAttr);
+		 EXPECT(*classAttr == "CViewContainer");
+		 EXPECT(desc.changeTemplateName ("view", "view2"));
+		 EXPECT(desc.getViewAttributes ("view") == nullptr);
+		 EXPECT(desc.getViewAttributes ("view2"));
+	);
+
 	TEST(collectTemplateViewNames,
 		 Xml::MemoryContentProvider provider (createViewUIDesc, static_cast<uint32_t> (strlen(createViewUIDesc)));
 		 UIDescription desc (&provider);
@@ -628,6 +782,58 @@ TESTCASE(UIDescriptionTests,
 		 EXPECT(*names.back () == std::string ("addNewTemplate"));
 	);
 	
+	TEST(templateLookupFollowsChanges,
+		 Xml::MemoryContentProvider provider (createViewUIDesc, static_cast<uint32_t> (strlen(createViewUIDesc)));
+		 UIDescription desc (&provider);
+		 EXPECT(desc.parse () == true);
+
+		 EXPECT(desc.duplicateTemplate ("view", "viewcopy"));
+		 EXPECT(desc.getViewAttributes ("viewcopy"));
+		 EXPECT(desc.changeTemplateName ("viewcopy", "copyOfView"));
+		 EXPECT(desc.getViewAttributes ("viewcopy") == nullptr);
+		 EXPECT(desc.getViewAttributes ("copyOfView"));
+		 EXPECT(desc.duplicateTemplate ("copyOfView", "viewcopy"));
+		 Controller controller;
+		 auto view = owned (desc.createView ("viewcopy", &controller));
+		 EXPECT(view);
+		 EXPECT(desc.removeTemplate ("copyOfView"));
+		 EXPECT(desc.getViewAttributes ("copyOfView") == nullptr);
+		 EXPECT(desc.getViewAttributes ("view"));
+		 EXPECT(desc.getViewAttributes ("viewcopy"));
+		 // resources are not templates
+		 desc.changeColor ("color", kRedCColor);
+		 EXPECT(desc.getViewAttributes ("color") == nullptr);
+	);
+
+	TEST(resourceLookupFollowsChanges,
+		Xml::MemoryContentProvider provider (emptyUIDesc, static_cast<uint32_t> (strlen(emptyUIDesc)));
+		UIDescription desc (&provider);
+		EXPECT(desc.parse () == true);
+		double value;
+		EXPECT(desc.getVariable ("v1", value) == false);
+		EXPECT(desc.hasTagName ("t1") == false);
+		EXPECT(desc.changeControlTagString ("t1", "1", true));
+		EXPECT(desc.getTagForName ("t1") == 1);
+		desc.changeTagName ("t1", "t2");
+		EXPECT(desc.hasTagName ("t1") == false);
+		EXPECT(desc.getTagForName ("t2") == 1);
+		desc.removeTag ("t2");
+		EXPECT(desc.getTagForName ("t2") == -1);
+
+		CColor c;
+		desc.changeColor ("c1", kBlueCColor);
+		// a color and a tag with the same name don't get mixed up
+		EXPECT(desc.changeControlTagString ("c1", "2", true));
+		EXPECT(desc.getColor ("c1", c));
+		EXPECT(c == kBlueCColor);
+		EXPECT(desc.getTagForName ("c1") == 2);
+		desc.changeColorName ("c1", "c2");
+		EXPECT(desc.getColor ("c1", c) == false);
+		EXPECT(desc.getColor ("c2", c));
+		EXPECT(desc.hasColorName ("~ BlackCColor"));
+		EXPECT(desc.getTagForName ("c1") == 2);
+	);
+
 	TEST(storeRestoreViews,
 		Xml::MemoryContentProvider provider (createViewUIDesc, static_cast<uint32_t> (strlen(createViewUIDesc)));
 		UIDescription desc (&provider);
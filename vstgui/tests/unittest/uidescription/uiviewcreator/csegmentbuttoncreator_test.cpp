@@ -129,6 +129,9 @@ TESTCASE(CSegmentButtonCreatorTest,
 		testAttribute<CSegmentButton>(kCSegmentButton, kAttrTruncateMode, "tail", &uidesc, [] (CSegmentButton* v) {
 			return v->getTextTruncateMode () == CDrawMethods::kTextTruncateTail;
 		});
+		testAttribute<CSegmentButton>(kCSegmentButton, kAttrTruncateMode, "middle", &uidesc, [] (CSegmentButton* v) {
+			return v->getTextTruncateMode () == CDrawMethods::kTextTruncateMiddle;
+		});
 		testAttribute<CSegmentButton>(kCSegmentButton, kAttrTruncateMode, "", &uidesc, [] (CSegmentButton* v) {
 			return v->getTextTruncateMode () == CDrawMethods::kTextTruncateNone;
 		});
@@ -136,7 +139,7 @@ TESTCASE(CSegmentButtonCreatorTest,
 	
 	TEST(truncateModeValues,
 		DummyUIDescription uidesc;
-		testPossibleValues (kCSegmentButton, kAttrTruncateMode, &uidesc, {"head", "tail", "none"});
+		testPossibleValues (kCSegmentButton, kAttrTruncateMode, &uidesc, {"head", "tail", "middle", "none"});
 	);
 
 	TEST(orientationValues,
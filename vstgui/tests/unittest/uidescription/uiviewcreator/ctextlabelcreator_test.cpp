@@ -30,10 +30,13 @@ TESTCASE(CTextLabelCreatorTest,
 		testAttribute<CTextLabel>(kCTextLabel, kAttrTruncateMode, "tail", &uidesc, [] (CTextLabel* v) {
 			return v->getTextTruncateMode() == CTextLabel::kTruncateTail;
 		});
+		testAttribute<CTextLabel>(kCTextLabel, kAttrTruncateMode, "middle", &uidesc, [] (CTextLabel* v) {
+			return v->getTextTruncateMode() == CTextLabel::kTruncateMiddle;
+		});
 		testAttribute<CTextLabel>(kCTextLabel, kAttrTruncateMode, "", &uidesc, [] (CTextLabel* v) {
 			return v->getTextTruncateMode() == CTextLabel::kTruncateNone;
 		});
-		testPossibleValues (kCTextLabel, kAttrTruncateMode, &uidesc, {"head", "tail", "none"});
+		testPossibleValues (kCTextLabel, kAttrTruncateMode, &uidesc, {"head", "tail", "middle", "none"});
 	);
 );
 
@@ -5,6 +5,7 @@
 #include "../unittests.h"
 #include "../../../uidescription/xmlparser.h"
 #include <string>
+#include <vector>
 
 namespace VSTGUI {
 using namespace Xml;
@@ -14,19 +15,38 @@ namespace {
 struct Handler : public IHandler
 {
 	bool stopOnStartElement {false};
+	std::string events;
+	std::vector<const int8_t*> charDataPointers;
+
 	void startXmlElement (Parser* parser, IdStringPtr elementName, UTF8StringPtr* elementAttributes) override
 	{
 		if (stopOnStartElement)
 			parser->stop ();
+		events += "<";
+		events += elementName;
+		for (auto attr = elementAttributes; attr && *attr; ++attr)
+		{
+			events += " ";
+			events += *attr;
+		}
+		events += ">";
 	}
 	void endXmlElement (Parser* parser, IdStringPtr name) override
 	{
+		events += "</";
+		events += name;
+		events += ">";
 	}
 	void xmlCharData (Parser* parser, const int8_t* data, int32_t length) override
 	{
+		events.append (reinterpret_cast<const char*> (data), static_cast<size_t> (length));
+		charDataPointers.push_back (data);
 	}
 	void xmlComment (Parser* parser, IdStringPtr comment) override
 	{
+		events += "<!--";
+		events += comment;
+		events += "-->";
 	}
 
 };
@@ -89,6 +109,38 @@ TESTCASE(XMLParserTest,
 		EXPECT(p.parse (&provider, &handler) == false);
 	);
 
+	TEST(inPlaceParseMatchesStreamedParse,
+		std::string xml (validXML);
+		for (auto i = 0; i < 10000; ++i)
+			xml.insert (xml.size () - 7, "<child index=\"" + std::to_string (i) + "\">text</child>\n");
+		MemoryContentProvider memoryProvider (xml.data (), static_cast<uint32_t> (xml.size ()));
+		Handler inPlaceHandler;
+		Parser p1;
+		EXPECT(p1.parse (&memoryProvider, &inPlaceHandler) == true);
+
+		CMemoryStream stream (reinterpret_cast<const int8_t*> (xml.data ()), static_cast<uint32_t> (xml.size ()));
+		InputStreamContentProvider streamProvider (stream);
+		Handler streamedHandler;
+		Parser p2;
+		EXPECT(p2.parse (&streamProvider, &streamedHandler) == true);
+		EXPECT(inPlaceHandler.events == streamedHandler.events);
+	);
+
+	TEST(inPlaceParseDoesNotCopyCharData,
+		MemoryContentProvider provider (validXML, static_cast<uint32_t> (strlen (validXML)));
+		Handler handler;
+		Parser p;
+		EXPECT(p.parse (&provider, &handler) == true);
+		EXPECT(handler.charDataPointers.empty () == false);
+		auto begin = reinterpret_cast<const int8_t*> (validXML);
+		for (auto ptr : handler.charDataPointers)
+		{
+			// expat reports normalized line breaks from its own storage
+			if (*ptr != '\n')
+				EXPECT(ptr >= begin && ptr < begin + strlen (validXML));
+		}
+	);
+
 );
 
 } // VSTGUI
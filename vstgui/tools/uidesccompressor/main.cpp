@@ -4,7 +4,7 @@
 
 #include "vstgui/lib/cresourcedescription.h"
 #include "vstgui/lib/cstring.h"
-#include "vstgui/uidescription/compresseduidescription.h"
+#include "vstgui/uidescription/binaryuidescription.h"
 #include <string>
 
 //------------------------------------------------------------------------
@@ -37,6 +37,7 @@ int main (int argv, char* argc[])
 	std::string inputPath;
 	std::string outputPath;
 	bool noCompression = false;
+	bool binary = false;
 	uint32_t compressionLevel = 1;
 	for (auto i = 0; i < argv; ++i)
 	{
@@ -63,23 +64,40 @@ int main (int argv, char* argc[])
 		{
 			noCompression = true;
 		}
+		else if (arg == "--binary")
+		{
+			binary = true;
+		}
 	}
 	if (inputPath.empty () || outputPath.empty ())
 	{
 		printAndTerminate ("No input or output path specified!");
 	}
 	printf ("Copy %s to %s%s\n", inputPath.data (), outputPath.data (),
-	        noCompression ? " [uncompressed]" : "[compressed]");
+	        binary ? " [binary]" : noCompression ? " [uncompressed]" : "[compressed]");
 
-	CompressedUIDescription uiDesc (CResourceDescription (inputPath.data ()));
+	BinaryUIDescription uiDesc (CResourceDescription (inputPath.data ()));
 	if (!uiDesc.parse ())
 	{
 		printAndTerminate ("Parsing failed!");
 	}
 	int32_t flags = UIDescription::kWriteImagesIntoXMLFile;
-	if (noCompression)
+	if (binary)
+	{
+		if (inputPath == outputPath && uiDesc.getOriginalIsBinary () == true)
+			return 0;
+
+		flags |= CompressedUIDescription::kNoPlainXmlFileBackup |
+		         BinaryUIDescription::kForceWriteBinaryDesc;
+		if (!uiDesc.save (outputPath.data (), flags))
+		{
+			printAndTerminate ("saving failed");
+		}
+	}
+	else if (noCompression)
 	{
-		if (inputPath == outputPath && uiDesc.getOriginalIsCompressed () == false)
+		if (inputPath == outputPath && uiDesc.getOriginalIsCompressed () == false &&
+		    uiDesc.getOriginalIsBinary () == false)
 			return 0;
 
 		if (!uiDesc.UIDescription::save (outputPath.data (), flags))
@@ -95,7 +113,7 @@ int main (int argv, char* argc[])
 		flags |= CompressedUIDescription::kNoPlainXmlFileBackup |
 		         CompressedUIDescription::kForceWriteCompressedDesc;
 		uiDesc.setCompressionLevel (compressionLevel);
-		if (!uiDesc.save (outputPath.data (), flags))
+		if (!uiDesc.CompressedUIDescription::save (outputPath.data (), flags))
 		{
 			printAndTerminate ("saving failed");
 		}
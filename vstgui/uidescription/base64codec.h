@@ -6,6 +6,24 @@
 #define __base64codec__
 
 #include "../lib/malloc.h"
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define VSTGUI_BASE64_X86 1
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define VSTGUI_BASE64_NEON 1
+#include <arm_neon.h>
+#endif
+
+#if VSTGUI_BASE64_X86 && (defined(__GNUC__) || defined(__clang__))
+#define VSTGUI_BASE64_TARGET(t) __attribute__ ((target (t)))
+#else
+#define VSTGUI_BASE64_TARGET(t)
+#endif
 
 namespace VSTGUI {
 
@@ -28,70 +46,112 @@ public:
 	template <typename T>
 	static inline Result decode (const T* inBuffer, size_t inBufferSize)
 	{
-		static_assert (sizeof (T) == 1, "T must be one byte type");
 		Result r;
-		r.data.allocate ((inBufferSize * 3 / 4) + 3);
+		r.data.allocate (getMaxDecodedSize (inBufferSize));
+		r.dataSize = static_cast<uint32_t> (decode (inBuffer, inBufferSize, r.data.get ()));
+		return r;
+	}
+
+	static inline Result encode (const void* binaryData, size_t binaryDataSize)
+	{
+		Result r;
+		r.data.allocate ((binaryDataSize * 4) / 3 + 4);
+		r.dataSize = static_cast<uint32_t> (encode (binaryData, binaryDataSize, r.data.get ()));
+		return r;
+	}
+
+	static constexpr size_t getMaxDecodedSize (size_t base64Size) { return (base64Size * 3 / 4) + 3; }
+	static constexpr size_t getEncodedSize (size_t binaryDataSize) { return (binaryDataSize + 2) / 3 * 4; }
+
+	/** decode into a buffer with at least getMaxDecodedSize (inBufferSize) bytes
+	 *	@return number of decoded bytes
+	 */
+	template <typename T>
+	static inline size_t decode (const T* inBuffer, size_t inBufferSize, uint8_t* outBuffer)
+	{
+		static_assert (sizeof (T) == 1, "T must be one byte type");
+		auto input = reinterpret_cast<const uint8_t*> (inBuffer);
+		auto output = outBuffer;
+		decodeBulk (input, inBufferSize, output);
 		uint8_t input1[4];
-		uint8_t input2[4];
-		auto input1Ptr = reinterpret_cast<uint32_t*>(&input1[0]);
-		auto input2Ptr = reinterpret_cast<uint32_t*>(&input2[0]);
-		auto buffer32Ptr = reinterpret_cast<const uint32_t*> (inBuffer);
-		while (inBufferSize > 8)
-		{
-			*input1Ptr = *buffer32Ptr++;
-			*input2Ptr = *buffer32Ptr++;
-			r.dataSize += decodeblock<false> (input1, r.data.get () + r.dataSize);
-			r.dataSize += decodeblock<false> (input2, r.data.get () + r.dataSize);
-			inBufferSize -= 8;
-		}
 		while (inBufferSize > 4)
 		{
-			*input1Ptr = *buffer32Ptr++;
-			r.dataSize += decodeblock<false> (input1, r.data.get () + r.dataSize);
+			memcpy (input1, input, 4);
+			output += decodeblock<false> (input1, output);
+			input += 4;
 			inBufferSize -= 4;
 		}
 		if (inBufferSize > 0)
 		{
 			input1[0] = input1[1] = input1[2] = input1[3] = '=';
-			auto ptr = reinterpret_cast<const uint8_t*>(buffer32Ptr);
-			for (uint32_t j = 0; j < inBufferSize; j++)
-			{
-				input1[j] = *ptr++;
-			}
-			r.dataSize += decodeblock<true> (input1, r.data.get () + r.dataSize);
+			memcpy (input1, input, inBufferSize);
+			output += decodeblock<true> (input1, output);
 		}
-		return r;
+		return static_cast<size_t> (output - outBuffer);
 	}
 
-	static inline Result encode (const void* binaryData, size_t binaryDataSize)
+	/** encode into a buffer with at least getEncodedSize (binaryDataSize) bytes
+	 *	@return number of encoded bytes
+	 */
+	static inline size_t encode (const void* binaryData, size_t binaryDataSize, uint8_t* outBuffer)
 	{
-		Result r;
-		r.data.allocate ((binaryDataSize * 4) / 3 + 4);
-		auto ptr = reinterpret_cast<const uint8_t*> (binaryData);
-		uint8_t input[3];
-		uint32_t i;
-		for (i = 0; i < (binaryDataSize - 3); i += 3)
+		auto input = reinterpret_cast<const uint8_t*> (binaryData);
+		auto output = outBuffer;
+		encodeBulk (input, binaryDataSize, output);
+		while (binaryDataSize > 3)
 		{
-			input[0] = *ptr++;
-			input[1] = *ptr++;
-			input[2] = *ptr++;
-			encodeblock (input, r.data.get () + r.dataSize, 3);
-			r.dataSize += 4;
+			encodeblock (input, output, 3);
+			input += 3;
+			output += 4;
+			binaryDataSize -= 3;
 		}
-		if (i < binaryDataSize)
+		if (binaryDataSize > 0)
 		{
-			input[0] = input[1] = input[2] = 0;
-			uint32_t j;
-			for (j = 0; i < binaryDataSize; i++, j++)
-			{
-				input[j] = *ptr++;
-			}
-			encodeblock (input, r.data.get () + r.dataSize, j);
-			r.dataSize += 4;
+			uint8_t input1[3] = {};
+			memcpy (input1, input, binaryDataSize);
+			encodeblock (input1, output, static_cast<uint32_t> (binaryDataSize));
+			output += 4;
 		}
-		return r;
+		return static_cast<size_t> (output - outBuffer);
 	}
 
+	/** the vector kernels used to encode and decode */
+	enum class Kernel
+	{
+		Scalar,
+		SSSE3,
+		AVX2,
+		NEON
+	};
+
+	/** check if the kernel is available on this cpu */
+	static inline bool isSupported (Kernel kernel)
+	{
+		switch (kernel)
+		{
+			case Kernel::Scalar: return true;
+#if VSTGUI_BASE64_X86
+			case Kernel::SSSE3: return cpuSupportsSSSE3 ();
+			case Kernel::AVX2: return cpuSupportsAVX2 ();
+#elif VSTGUI_BASE64_NEON
+			case Kernel::NEON: return true;
+#endif
+			default: return false;
+		}
+	}
+
+	/** force a kernel, mainly for testing and benchmarking. Returns false if it is not supported. */
+	static inline bool setKernel (Kernel kernel)
+	{
+		if (!isSupported (kernel))
+			return false;
+		currentKernel () = kernel;
+		return true;
+	}
+
+	/** the kernel in use, defaults to the fastest kernel the cpu supports */
+	static inline Kernel getKernel () { return currentKernel (); }
+
 private:
 	template<bool finalBlock = true>
 	static inline uint32_t decodeblock (uint8_t input[4], uint8_t output[3])
@@ -121,7 +181,7 @@ private:
 		return result;
 	}
 
-	static inline void encodeblock (uint8_t input[3], uint8_t output[4], uint32_t len)
+	static inline void encodeblock (const uint8_t input[3], uint8_t output[4], uint32_t len)
 	{
 		static constexpr uint8_t cb64[] =
 			"ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
@@ -132,6 +192,309 @@ private:
 			(len > 1 ? cb64[((input[1] & 0x0f) << 2) | ((input[2] & 0xc0) >> 6)] : '=');
 		output[3] = static_cast<uint8_t>(len > 2 ? cb64[input[2] & 0x3f] : '=');
 	}
+
+	static inline Kernel& currentKernel ()
+	{
+		static Kernel kernel = bestKernel ();
+		return kernel;
+	}
+
+	static inline Kernel bestKernel ()
+	{
+		if (isSupported (Kernel::AVX2))
+			return Kernel::AVX2;
+		if (isSupported (Kernel::SSSE3))
+			return Kernel::SSSE3;
+		if (isSupported (Kernel::NEON))
+			return Kernel::NEON;
+		return Kernel::Scalar;
+	}
+
+	/** decode as many blocks as possible with the vector kernel. At least one character is
+	 *	left for the scalar final block and decoding stops at the first invalid character, so that
+	 *	the result is the same as with the scalar code.
+	 */
+	static inline void decodeBulk (const uint8_t*& input, size_t& inputSize, uint8_t*& output)
+	{
+		switch (getKernel ())
+		{
+#if VSTGUI_BASE64_X86
+			case Kernel::AVX2:
+				decodeAVX2 (input, inputSize, output);
+				decodeSSSE3 (input, inputSize, output);
+				break;
+			case Kernel::SSSE3: decodeSSSE3 (input, inputSize, output); break;
+#elif VSTGUI_BASE64_NEON
+			case Kernel::NEON: decodeNEON (input, inputSize, output); break;
+#endif
+			default: break;
+		}
+	}
+
+	/** encode as many blocks as possible with the vector kernel */
+	static inline void encodeBulk (const uint8_t*& input, size_t& inputSize, uint8_t*& output)
+	{
+		switch (getKernel ())
+		{
+#if VSTGUI_BASE64_X86
+			case Kernel::AVX2:
+				encodeAVX2 (input, inputSize, output);
+				encodeSSSE3 (input, inputSize, output);
+				break;
+			case Kernel::SSSE3: encodeSSSE3 (input, inputSize, output); break;
+#elif VSTGUI_BASE64_NEON
+			case Kernel::NEON: encodeNEON (input, inputSize, output); break;
+#endif
+			default: break;
+		}
+	}
+
+#if VSTGUI_BASE64_X86
+	static inline bool cpuSupportsSSSE3 ()
+	{
+#if defined(_MSC_VER) && !defined(__clang__)
+		int info[4];
+		__cpuid (info, 1);
+		return (info[2] & (1 << 9)) != 0;
+#else
+		return __builtin_cpu_supports ("ssse3");
+#endif
+	}
+
+	static inline bool cpuSupportsAVX2 ()
+	{
+#if defined(_MSC_VER) && !defined(__clang__)
+		int info[4];
+		__cpuid (info, 0);
+		if (info[0] < 7)
+			return false;
+		__cpuid (info, 1);
+		// the OS must save the AVX registers
+		if ((info[2] & (1 << 27)) == 0 || (_xgetbv (0) & 6) != 6)
+			return false;
+		__cpuidex (info, 7, 0);
+		return (info[1] & (1 << 5)) != 0;
+#else
+		return __builtin_cpu_supports ("avx2");
+#endif
+	}
+
+	// The vector kernels follow Wojciech Mula's base64 algorithms: the characters are translated
+	// with nibble lookup tables and the 6 bit values are packed with multiply-add instructions.
+
+	VSTGUI_BASE64_TARGET ("ssse3")
+	static inline void decodeSSSE3 (const uint8_t*& input, size_t& inputSize, uint8_t*& output)
+	{
+		const auto lutLo = _mm_setr_epi8 (0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11,
+		                                  0x11, 0x13, 0x1A, 0x1B, 0x1B, 0x1B, 0x1A);
+		const auto lutHi = _mm_setr_epi8 (0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08, 0x10,
+		                                  0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10);
+		const auto lutRoll = _mm_setr_epi8 (0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0);
+		const auto mask2F = _mm_set1_epi8 (0x2F);
+		const auto pack = _mm_setr_epi8 (2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1);
+		while (inputSize > 16)
+		{
+			auto str = _mm_loadu_si128 (reinterpret_cast<const __m128i*> (input));
+			auto hiNibbles = _mm_and_si128 (_mm_srli_epi32 (str, 4), mask2F);
+			auto loNibbles = _mm_and_si128 (str, mask2F);
+			auto hi = _mm_shuffle_epi8 (lutHi, hiNibbles);
+			auto lo = _mm_shuffle_epi8 (lutLo, loNibbles);
+			if (_mm_movemask_epi8 (_mm_cmpgt_epi8 (_mm_and_si128 (lo, hi), _mm_setzero_si128 ())))
+				break;
+			auto eq2F = _mm_cmpeq_epi8 (str, mask2F);
+			auto roll = _mm_shuffle_epi8 (lutRoll, _mm_add_epi8 (eq2F, hiNibbles));
+			str = _mm_add_epi8 (str, roll);
+			str = _mm_maddubs_epi16 (str, _mm_set1_epi32 (0x01400140));
+			str = _mm_madd_epi16 (str, _mm_set1_epi32 (0x00011000));
+			str = _mm_shuffle_epi8 (str, pack);
+			_mm_storel_epi64 (reinterpret_cast<__m128i*> (output), str);
+			auto last = _mm_cvtsi128_si32 (_mm_srli_si128 (str, 8));
+			memcpy (output + 8, &last, 4);
+			input += 16;
+			inputSize -= 16;
+			output += 12;
+		}
+	}
+
+	VSTGUI_BASE64_TARGET ("ssse3")
+	static inline void encodeSSSE3 (const uint8_t*& input, size_t& inputSize, uint8_t*& output)
+	{
+		const auto shuffle = _mm_set_epi8 (10, 11, 9, 10, 7, 8, 6, 7, 4, 5, 3, 4, 1, 2, 0, 1);
+		const auto lut = _mm_setr_epi8 (65, 71, -4, -4, -4, -4, -4, -4, -4, -4, -4, -4, -19, -16, 0, 0);
+		// 16 bytes are loaded for every 12 bytes of input
+		while (inputSize >= 16)
+		{
+			auto in = _mm_loadu_si128 (reinterpret_cast<const __m128i*> (input));
+			in = _mm_shuffle_epi8 (in, shuffle);
+			auto t0 = _mm_and_si128 (in, _mm_set1_epi32 (0x0FC0FC00));
+			auto t1 = _mm_mulhi_epu16 (t0, _mm_set1_epi32 (0x04000040));
+			auto t2 = _mm_and_si128 (in, _mm_set1_epi32 (0x003F03F0));
+			auto t3 = _mm_mullo_epi16 (t2, _mm_set1_epi32 (0x01000010));
+			auto indices = _mm_or_si128 (t1, t3);
+			auto offsets = _mm_subs_epu8 (indices, _mm_set1_epi8 (51));
+			offsets = _mm_sub_epi8 (offsets, _mm_cmpgt_epi8 (indices, _mm_set1_epi8 (25)));
+			auto out = _mm_add_epi8 (indices, _mm_shuffle_epi8 (lut, offsets));
+			_mm_storeu_si128 (reinterpret_cast<__m128i*> (output), out);
+			input += 12;
+			inputSize -= 12;
+			output += 16;
+		}
+	}
+
+	VSTGUI_BASE64_TARGET ("avx2")
+	static inline void decodeAVX2 (const uint8_t*& input, size_t& inputSize, uint8_t*& output)
+	{
+		const auto lutLo = _mm256_setr_epi8 (
+		    0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x13, 0x1A, 0x1B, 0x1B, 0x1B,
+		    0x1A, 0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x13, 0x1A, 0x1B, 0x1B,
+		    0x1B, 0x1A);
+		const auto lutHi = _mm256_setr_epi8 (
+		    0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10,
+		    0x10, 0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10,
+		    0x10, 0x10);
+		const auto lutRoll = _mm256_setr_epi8 (0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0,
+		                                       0, 0, 0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0,
+		                                       0, 0, 0, 0);
+		const auto mask2F = _mm256_set1_epi8 (0x2F);
+		const auto pack = _mm256_setr_epi8 (2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1,
+		                                    2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1);
+		while (inputSize > 32)
+		{
+			auto str = _mm256_loadu_si256 (reinterpret_cast<const __m256i*> (input));
+			auto hiNibbles = _mm256_and_si256 (_mm256_srli_epi32 (str, 4), mask2F);
+			auto loNibbles = _mm256_and_si256 (str, mask2F);
+			auto hi = _mm256_shuffle_epi8 (lutHi, hiNibbles);
+			auto lo = _mm256_shuffle_epi8 (lutLo, loNibbles);
+			if (_mm256_movemask_epi8 (
+			        _mm256_cmpgt_epi8 (_mm256_and_si256 (lo, hi), _mm256_setzero_si256 ())))
+				break;
+			auto eq2F = _mm256_cmpeq_epi8 (str, mask2F);
+			auto roll = _mm256_shuffle_epi8 (lutRoll, _mm256_add_epi8 (eq2F, hiNibbles));
+			str = _mm256_add_epi8 (str, roll);
+			str = _mm256_maddubs_epi16 (str, _mm256_set1_epi32 (0x01400140));
+			str = _mm256_madd_epi16 (str, _mm256_set1_epi32 (0x00011000));
+			str = _mm256_shuffle_epi8 (str, pack);
+			// each 128 bit lane holds 12 bytes
+			auto lane0 = _mm256_castsi256_si128 (str);
+			auto lane1 = _mm256_extracti128_si256 (str, 1);
+			_mm_storel_epi64 (reinterpret_cast<__m128i*> (output), lane0);
+			auto last = _mm_cvtsi128_si32 (_mm_srli_si128 (lane0, 8));
+			memcpy (output + 8, &last, 4);
+			_mm_storel_epi64 (reinterpret_cast<__m128i*> (output + 12), lane1);
+			last = _mm_cvtsi128_si32 (_mm_srli_si128 (lane1, 8));
+			memcpy (output + 20, &last, 4);
+			input += 32;
+			inputSize -= 32;
+			output += 24;
+		}
+	}
+
+	VSTGUI_BASE64_TARGET ("avx2")
+	static inline void encodeAVX2 (const uint8_t*& input, size_t& inputSize, uint8_t*& output)
+	{
+		const auto shuffle = _mm256_set_epi8 (10, 11, 9, 10, 7, 8, 6, 7, 4, 5, 3, 4, 1, 2, 0, 1,
+		                                      10, 11, 9, 10, 7, 8, 6, 7, 4, 5, 3, 4, 1, 2, 0, 1);
+		const auto lut = _mm256_setr_epi8 (65, 71, -4, -4, -4, -4, -4, -4, -4, -4, -4, -4, -19, -16,
+		                                   0, 0, 65, 71, -4, -4, -4, -4, -4, -4, -4, -4, -4, -4,
+		                                   -19, -16, 0, 0);
+		// two times 16 bytes are loaded for every 24 bytes of input
+		while (inputSize >= 28)
+		{
+			auto lo = _mm_loadu_si128 (reinterpret_cast<const __m128i*> (input));
+			auto hi = _mm_loadu_si128 (reinterpret_cast<const __m128i*> (input + 12));
+			auto in = _mm256_inserti128_si256 (_mm256_castsi128_si256 (lo), hi, 1);
+			in = _mm256_shuffle_epi8 (in, shuffle);
+			auto t0 = _mm256_and_si256 (in, _mm256_set1_epi32 (0x0FC0FC00));
+			auto t1 = _mm256_mulhi_epu16 (t0, _mm256_set1_epi32 (0x04000040));
+			auto t2 = _mm256_and_si256 (in, _mm256_set1_epi32 (0x003F03F0));
+			auto t3 = _mm256_mullo_epi16 (t2, _mm256_set1_epi32 (0x01000010));
+			auto indices = _mm256_or_si256 (t1, t3);
+			auto offsets = _mm256_subs_epu8 (indices, _mm256_set1_epi8 (51));
+			offsets = _mm256_sub_epi8 (offsets, _mm256_cmpgt_epi8 (indices, _mm256_set1_epi8 (25)));
+			auto out = _mm256_add_epi8 (indices, _mm256_shuffle_epi8 (lut, offsets));
+			_mm256_storeu_si256 (reinterpret_cast<__m256i*> (output), out);
+			input += 24;
+			inputSize -= 24;
+			output += 32;
+		}
+	}
+#elif VSTGUI_BASE64_NEON
+	static inline uint8x16_t decodeNEON (uint8x16_t c, uint8x16_t& invalid)
+	{
+		auto upper = vsubq_u8 (c, vdupq_n_u8 ('A'));
+		auto lower = vsubq_u8 (c, vdupq_n_u8 ('a'));
+		auto digit = vsubq_u8 (c, vdupq_n_u8 ('0'));
+		auto isUpper = vcltq_u8 (upper, vdupq_n_u8 (26));
+		auto isLower = vcltq_u8 (lower, vdupq_n_u8 (26));
+		auto isDigit = vcltq_u8 (digit, vdupq_n_u8 (10));
+		auto isPlus = vceqq_u8 (c, vdupq_n_u8 ('+'));
+		auto isSlash = vceqq_u8 (c, vdupq_n_u8 ('/'));
+		auto result = vandq_u8 (isUpper, upper);
+		result = vbslq_u8 (isLower, vaddq_u8 (lower, vdupq_n_u8 (26)), result);
+		result = vbslq_u8 (isDigit, vaddq_u8 (digit, vdupq_n_u8 (52)), result);
+		result = vbslq_u8 (isPlus, vdupq_n_u8 (62), result);
+		result = vbslq_u8 (isSlash, vdupq_n_u8 (63), result);
+		auto valid = vorrq_u8 (vorrq_u8 (isUpper, isLower), vorrq_u8 (isDigit, vorrq_u8 (isPlus, isSlash)));
+		invalid = vorrq_u8 (invalid, vmvnq_u8 (valid));
+		return result;
+	}
+
+	static inline uint8x16_t encodeNEON (uint8x16_t index)
+	{
+		auto result = vaddq_u8 (index, vdupq_n_u8 ('A'));
+		result = vbslq_u8 (vcgeq_u8 (index, vdupq_n_u8 (26)), vaddq_u8 (index, vdupq_n_u8 ('a' - 26)), result);
+		result = vbslq_u8 (vcgeq_u8 (index, vdupq_n_u8 (52)), vsubq_u8 (index, vdupq_n_u8 (52 - '0')), result);
+		result = vbslq_u8 (vceqq_u8 (index, vdupq_n_u8 (62)), vdupq_n_u8 ('+'), result);
+		result = vbslq_u8 (vceqq_u8 (index, vdupq_n_u8 (63)), vdupq_n_u8 ('/'), result);
+		return result;
+	}
+
+	static inline void decodeNEON (const uint8_t*& input, size_t& inputSize, uint8_t*& output)
+	{
+		while (inputSize > 64)
+		{
+			auto str = vld4q_u8 (input);
+			auto invalid = vdupq_n_u8 (0);
+			auto a = decodeNEON (str.val[0], invalid);
+			auto b = decodeNEON (str.val[1], invalid);
+			auto c = decodeNEON (str.val[2], invalid);
+			auto d = decodeNEON (str.val[3], invalid);
+			auto invalid64 = vorr_u8 (vget_low_u8 (invalid), vget_high_u8 (invalid));
+			if (vget_lane_u64 (vreinterpret_u64_u8 (invalid64), 0))
+				break;
+			uint8x16x3_t out;
+			out.val[0] = vorrq_u8 (vshlq_n_u8 (a, 2), vshrq_n_u8 (b, 4));
+			out.val[1] = vorrq_u8 (vshlq_n_u8 (b, 4), vshrq_n_u8 (c, 2));
+			out.val[2] = vorrq_u8 (vshlq_n_u8 (c, 6), d);
+			vst3q_u8 (output, out);
+			input += 64;
+			inputSize -= 64;
+			output += 48;
+		}
+	}
+
+	static inline void encodeNEON (const uint8_t*& input, size_t& inputSize, uint8_t*& output)
+	{
+		while (inputSize >= 48)
+		{
+			auto in = vld3q_u8 (input);
+			auto a = in.val[0];
+			auto b = in.val[1];
+			auto c = in.val[2];
+			uint8x16x4_t out;
+			out.val[0] = encodeNEON (vshrq_n_u8 (a, 2));
+			out.val[1] = encodeNEON (
+			    vorrq_u8 (vshlq_n_u8 (vandq_u8 (a, vdupq_n_u8 (0x03)), 4), vshrq_n_u8 (b, 4)));
+			out.val[2] = encodeNEON (
+			    vorrq_u8 (vshlq_n_u8 (vandq_u8 (b, vdupq_n_u8 (0x0F)), 2), vshrq_n_u8 (c, 6)));
+			out.val[3] = encodeNEON (vandq_u8 (c, vdupq_n_u8 (0x3F)));
+			vst4q_u8 (output, out);
+			input += 48;
+			inputSize -= 48;
+			output += 64;
+		}
+	}
+#endif
 };
 
 } // namespace VSTGUI
@@ -0,0 +1,535 @@
+// This file is part of VSTGUI. It is subject to the license terms
+// in the LICENSE file found in the top-level directory of this
+// distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
+
+#include "../lib/cresourcedescription.h"
+#include "base64codec.h"
+#include "binaryuidescription.h"
+#include "cstream.h"
+#include "xmlparser.h"
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+//------------------------------------------------------------------------
+namespace VSTGUI {
+namespace BinaryUIDesc {
+
+//------------------------------------------------------------------------
+/*	File layout, all numbers are little endian:
+
+	int64	identifier
+	uint32	version
+	uint32	number of strings
+	uint32	string data size
+	uint32	event data size
+	uint32	string offsets [number of strings]
+	char	string data [string data size], zero terminated strings
+	uint8	event data [event data size]
+
+	Event data is a sequence of events starting with an event type byte:
+
+	kStartElement	uint32 name, uint32 number of attributes, (uint32 key, uint32 value) [attributes]
+	kEndElement		uint32 name
+	kCharData		uint32 length, char data [length]
+	kComment		uint32 comment
+	kBinaryData		uint32 length, uint8 data [length]
+	kEndOfEvents
+
+	The base64 encoded image data of bitmaps is stored decoded as kBinaryData (version 2), so that
+	loading the description does not need to decode it.
+*/
+
+static constexpr int64_t kIdentifier = 0x6e62637365646975LL; // 8 byte identifier
+static constexpr uint32_t kVersion = 2;
+static constexpr uint32_t kMinVersion = 1;
+static constexpr size_t kHeaderSize = 24;
+
+enum EventType : uint8_t
+{
+	kEndOfEvents = 0,
+	kStartElement,
+	kEndElement,
+	kCharData,
+	kComment,
+	kBinaryData
+};
+
+//------------------------------------------------------------------------
+inline uint32_t readUInt32 (const uint8_t* ptr)
+{
+	return static_cast<uint32_t> (ptr[0]) | (static_cast<uint32_t> (ptr[1]) << 8) |
+	       (static_cast<uint32_t> (ptr[2]) << 16) | (static_cast<uint32_t> (ptr[3]) << 24);
+}
+
+//------------------------------------------------------------------------
+inline int64_t readInt64 (const uint8_t* ptr)
+{
+	return static_cast<int64_t> (readUInt32 (ptr) | (static_cast<uint64_t> (readUInt32 (ptr + 4)) << 32));
+}
+
+//------------------------------------------------------------------------
+inline void writeUInt32 (std::vector<uint8_t>& buffer, uint32_t value)
+{
+	buffer.push_back (static_cast<uint8_t> (value));
+	buffer.push_back (static_cast<uint8_t> (value >> 8));
+	buffer.push_back (static_cast<uint8_t> (value >> 16));
+	buffer.push_back (static_cast<uint8_t> (value >> 24));
+}
+
+//------------------------------------------------------------------------
+/** records the xml parser events into the binary format */
+class Writer : public Xml::IHandler
+{
+public:
+	bool write (OutputStream& stream);
+
+private:
+	void startXmlElement (Xml::Parser* parser, IdStringPtr elementName, UTF8StringPtr* elementAttributes) override;
+	void endXmlElement (Xml::Parser* parser, IdStringPtr name) override;
+	void xmlCharData (Xml::Parser* parser, const int8_t* data, int32_t length) override;
+	void xmlComment (Xml::Parser* parser, IdStringPtr comment) override;
+
+	uint32_t intern (const char* str);
+	void flushCharData ();
+
+	std::unordered_map<std::string, uint32_t> stringIndices;
+	std::vector<uint32_t> stringOffsets;
+	std::vector<uint8_t> stringData;
+	std::vector<uint8_t> events;
+	std::string charData;
+	std::vector<std::string> elementStack;
+	bool charDataIsBase64Image {false};
+};
+
+//------------------------------------------------------------------------
+uint32_t Writer::intern (const char* str)
+{
+	auto result = stringIndices.emplace (str, static_cast<uint32_t> (stringOffsets.size ()));
+	if (result.second)
+	{
+		stringOffsets.push_back (static_cast<uint32_t> (stringData.size ()));
+		stringData.insert (stringData.end (), str, str + result.first->first.size () + 1);
+	}
+	return result.first->second;
+}
+
+//------------------------------------------------------------------------
+void Writer::flushCharData ()
+{
+	if (charData.empty ())
+		return;
+	if (charDataIsBase64Image)
+	{
+		// only store the decoded data if it encodes back to the same text, otherwise the xml
+		// written from the binary description would differ
+		auto decoded = Base64Codec::decode (charData);
+		auto encoded = Base64Codec::encode (decoded.data.get (), decoded.dataSize);
+		if (encoded.dataSize == charData.size () &&
+		    std::memcmp (encoded.data.get (), charData.data (), charData.size ()) == 0)
+		{
+			events.push_back (kBinaryData);
+			writeUInt32 (events, decoded.dataSize);
+			events.insert (events.end (), decoded.data.get (),
+			               decoded.data.get () + decoded.dataSize);
+			charData.clear ();
+			return;
+		}
+	}
+	events.push_back (kCharData);
+	writeUInt32 (events, static_cast<uint32_t> (charData.size ()));
+	events.insert (events.end (), charData.begin (), charData.end ());
+	charData.clear ();
+}
+
+//------------------------------------------------------------------------
+void Writer::startXmlElement (Xml::Parser* parser, IdStringPtr elementName, UTF8StringPtr* elementAttributes)
+{
+	flushCharData ();
+	uint32_t numAttributes = 0;
+	for (auto attr = elementAttributes; attr && attr[0] && attr[1]; attr += 2)
+		++numAttributes;
+	events.push_back (kStartElement);
+	writeUInt32 (events, intern (elementName));
+	writeUInt32 (events, numAttributes);
+	for (uint32_t i = 0; i < numAttributes * 2; ++i)
+		writeUInt32 (events, intern (elementAttributes[i]));
+
+	charDataIsBase64Image = false;
+	if (!elementStack.empty () && elementStack.back () == "bitmap" &&
+	    std::strcmp (elementName, "data") == 0)
+	{
+		for (uint32_t i = 0; i < numAttributes * 2; i += 2)
+		{
+			if (std::strcmp (elementAttributes[i], "encoding") == 0 &&
+			    std::strcmp (elementAttributes[i + 1], "base64") == 0)
+				charDataIsBase64Image = true;
+		}
+	}
+	elementStack.emplace_back (elementName);
+}
+
+//------------------------------------------------------------------------
+void Writer::endXmlElement (Xml::Parser* parser, IdStringPtr name)
+{
+	flushCharData ();
+	charDataIsBase64Image = false;
+	if (!elementStack.empty ())
+		elementStack.pop_back ();
+	events.push_back (kEndElement);
+	writeUInt32 (events, intern (name));
+}
+
+//------------------------------------------------------------------------
+void Writer::xmlCharData (Xml::Parser* parser, const int8_t* data, int32_t length)
+{
+	// the UIDescription ignores all control and whitespace characters in character data, so we can
+	// drop them here and merge the chunks the xml parser delivers
+	for (int32_t i = 0; i < length; ++i)
+	{
+		if (data[i] >= 0x21)
+			charData.push_back (static_cast<char> (data[i]));
+	}
+}
+
+//------------------------------------------------------------------------
+void Writer::xmlComment (Xml::Parser* parser, IdStringPtr comment)
+{
+	flushCharData ();
+	events.push_back (kComment);
+	writeUInt32 (events, intern (comment));
+}
+
+//------------------------------------------------------------------------
+bool Writer::write (OutputStream& stream)
+{
+	flushCharData ();
+	events.push_back (kEndOfEvents);
+
+	std::vector<uint8_t> header;
+	header.reserve (kHeaderSize + stringOffsets.size () * 4);
+	writeUInt32 (header, static_cast<uint32_t> (kIdentifier));
+	writeUInt32 (header, static_cast<uint32_t> (static_cast<uint64_t> (kIdentifier) >> 32));
+	writeUInt32 (header, kVersion);
+	writeUInt32 (header, static_cast<uint32_t> (stringOffsets.size ()));
+	writeUInt32 (header, static_cast<uint32_t> (stringData.size ()));
+	writeUInt32 (header, static_cast<uint32_t> (events.size ()));
+	for (auto offset : stringOffsets)
+		writeUInt32 (header, offset);
+
+	for (auto block : {&header, &stringData, &events})
+	{
+		auto size = static_cast<uint32_t> (block->size ());
+		if (size && stream.writeRaw (block->data (), size) != size)
+			return false;
+	}
+	return true;
+}
+
+//------------------------------------------------------------------------
+/** replays the events of a binary description directly out of its memory */
+class Reader
+{
+public:
+	using BinaryDataFunc = std::function<void (const void* data, size_t size)>;
+
+	Reader (const void* data, size_t size);
+
+	bool isValid () const { return valid; }
+	/** binary data is passed to binaryDataFunc, it is part of the element started last */
+	bool replay (Xml::Parser& parser, Xml::IHandler& handler,
+	             const BinaryDataFunc& binaryDataFunc) const;
+
+private:
+	bool validate () const;
+	UTF8StringPtr getString (uint32_t index) const
+	{
+		return reinterpret_cast<UTF8StringPtr> (stringData + readUInt32 (stringOffsets + index * 4));
+	}
+
+	const uint8_t* stringOffsets {nullptr};
+	const uint8_t* stringData {nullptr};
+	const uint8_t* events {nullptr};
+	uint32_t numStrings {0};
+	uint32_t stringDataSize {0};
+	uint32_t eventDataSize {0};
+	bool valid {false};
+};
+
+//------------------------------------------------------------------------
+Reader::Reader (const void* data, size_t size)
+{
+	if (!BinaryUIDescription::isBinaryDescription (data, size))
+		return;
+	auto ptr = static_cast<const uint8_t*> (data);
+	auto version = readUInt32 (ptr + 8);
+	if (version < kMinVersion || version > kVersion)
+		return;
+	numStrings = readUInt32 (ptr + 12);
+	stringDataSize = readUInt32 (ptr + 16);
+	eventDataSize = readUInt32 (ptr + 20);
+	if (static_cast<uint64_t> (numStrings) * 4 + stringDataSize + eventDataSize > size - kHeaderSize)
+		return;
+	stringOffsets = ptr + kHeaderSize;
+	stringData = stringOffsets + numStrings * 4;
+	events = stringData + stringDataSize;
+	valid = validate ();
+}
+
+//------------------------------------------------------------------------
+bool Reader::validate () const
+{
+	if (stringDataSize > 0 && stringData[stringDataSize - 1] != 0)
+		return false;
+	for (uint32_t i = 0; i < numStrings; ++i)
+	{
+		if (readUInt32 (stringOffsets + i * 4) >= stringDataSize)
+			return false;
+	}
+	uint32_t pos = 0;
+	uint32_t depth = 0;
+	auto readIndex = [&] (uint32_t& value, uint32_t limit) {
+		if (eventDataSize - pos < 4)
+			return false;
+		value = readUInt32 (events + pos);
+		pos += 4;
+		return value < limit;
+	};
+	while (pos < eventDataSize)
+	{
+		uint32_t value;
+		switch (events[pos++])
+		{
+			case kStartElement:
+			{
+				uint32_t numAttributes;
+				if (!readIndex (value, numStrings) || !readIndex (numAttributes, UINT32_MAX / 8))
+					return false;
+				for (uint32_t i = 0; i < numAttributes * 2; ++i)
+				{
+					if (!readIndex (value, numStrings))
+						return false;
+				}
+				++depth;
+				break;
+			}
+			case kEndElement:
+			{
+				if (depth == 0 || !readIndex (value, numStrings))
+					return false;
+				--depth;
+				break;
+			}
+			case kCharData:
+			case kBinaryData:
+			{
+				if (!readIndex (value, UINT32_MAX) || value > eventDataSize - pos)
+					return false;
+				pos += value;
+				break;
+			}
+			case kComment:
+			{
+				if (!readIndex (value, numStrings))
+					return false;
+				break;
+			}
+			case kEndOfEvents:
+			{
+				return depth == 0 && pos == eventDataSize;
+			}
+			default:
+				return false;
+		}
+	}
+	return false;
+}
+
+//------------------------------------------------------------------------
+bool Reader::replay (Xml::Parser& parser, Xml::IHandler& handler,
+                     const BinaryDataFunc& binaryDataFunc) const
+{
+	if (!valid)
+		return false;
+	std::vector<UTF8StringPtr> attributes;
+	const uint8_t* ptr = events;
+	auto readString = [&] () {
+		auto str = getString (readUInt32 (ptr));
+		ptr += 4;
+		return str;
+	};
+	while (!parser.isStopped ())
+	{
+		switch (*ptr++)
+		{
+			case kStartElement:
+			{
+				auto name = readString ();
+				auto numAttributes = readUInt32 (ptr);
+				ptr += 4;
+				attributes.clear ();
+				for (uint32_t i = 0; i < numAttributes * 2; ++i)
+					attributes.push_back (readString ());
+				attributes.push_back (nullptr);
+				handler.startXmlElement (&parser, name, attributes.data ());
+				break;
+			}
+			case kEndElement:
+			{
+				handler.endXmlElement (&parser, readString ());
+				break;
+			}
+			case kCharData:
+			{
+				auto length = readUInt32 (ptr);
+				ptr += 4;
+				handler.xmlCharData (&parser, reinterpret_cast<const int8_t*> (ptr),
+				                     static_cast<int32_t> (length));
+				ptr += length;
+				break;
+			}
+			case kBinaryData:
+			{
+				auto length = readUInt32 (ptr);
+				ptr += 4;
+				binaryDataFunc (ptr, length);
+				ptr += length;
+				break;
+			}
+			case kComment:
+			{
+				handler.xmlComment (&parser, readString ());
+				break;
+			}
+			default:
+				return true;
+		}
+	}
+	return false;
+}
+
+//------------------------------------------------------------------------
+} // BinaryUIDesc
+
+//------------------------------------------------------------------------
+BinaryUIDescription::BinaryUIDescription (const CResourceDescription& uiDescFile)
+: CompressedUIDescription (uiDescFile)
+{
+}
+
+//------------------------------------------------------------------------
+bool BinaryUIDescription::isBinaryDescription (const void* data, size_t size)
+{
+	return data && size >= BinaryUIDesc::kHeaderSize &&
+	       BinaryUIDesc::readInt64 (static_cast<const uint8_t*> (data)) == BinaryUIDesc::kIdentifier;
+}
+
+//------------------------------------------------------------------------
+bool BinaryUIDescription::parseBinary (const void* data, size_t size)
+{
+	if (parsed ())
+		return false;
+	BinaryUIDesc::Reader reader (data, size);
+	if (!reader.isValid ())
+		return false;
+	Xml::Parser parser;
+	if (!reader.replay (parser, *this,
+	                    [this] (const void* data, size_t size) { setBinaryNodeData (data, size); }))
+		return false;
+	addDefaultNodes ();
+	originalIsBinary = true;
+	return true;
+}
+
+//------------------------------------------------------------------------
+bool BinaryUIDescription::parse ()
+{
+	if (parsed ())
+		return true;
+	CResourceInputStream resStream (kLittleEndianByteOrder);
+	CMappedFileInputStream mappedFileStream (kLittleEndianByteOrder);
+	CResourceInputStream* stream = nullptr;
+	if (resStream.open (getXmlFile ()))
+		stream = &resStream;
+	else if (getXmlFile ().type == CResourceDescription::kStringType &&
+	         mappedFileStream.open (getXmlFile ().u.name))
+		stream = &mappedFileStream;
+	if (stream)
+	{
+		size_t size;
+		auto data = stream->getMappedData (size);
+		if (data)
+		{
+			if (isBinaryDescription (data, size))
+				return parseBinary (data, size);
+			return CompressedUIDescription::parse ();
+		}
+		std::vector<uint8_t> buffer (BinaryUIDesc::kHeaderSize);
+		auto read = stream->readRaw (buffer.data (), static_cast<uint32_t> (buffer.size ()));
+		if (read == buffer.size () && isBinaryDescription (buffer.data (), buffer.size ()))
+		{
+			static constexpr uint32_t kChunkSize = 0x8000;
+			while (read != 0 && read != kStreamIOError)
+			{
+				auto pos = buffer.size ();
+				buffer.resize (pos + kChunkSize);
+				read = stream->readRaw (buffer.data () + pos, kChunkSize);
+				buffer.resize (pos + (read == kStreamIOError ? 0 : read));
+			}
+			return parseBinary (buffer.data (), buffer.size ());
+		}
+	}
+	return CompressedUIDescription::parse ();
+}
+
+//------------------------------------------------------------------------
+bool BinaryUIDescription::saveBinary (OutputStream& stream, int32_t flags)
+{
+	CMemoryStream xmlStream (1024, 1024, false);
+	if (!saveToStream (xmlStream, flags))
+		return false;
+	Xml::MemoryContentProvider xmlContentProvider (xmlStream.getBuffer (),
+	                                               static_cast<uint32_t> (xmlStream.tell ()));
+	BinaryUIDesc::Writer writer;
+	Xml::Parser parser;
+	if (!parser.parse (&xmlContentProvider, &writer))
+		return false;
+	return writer.write (stream);
+}
+
+//------------------------------------------------------------------------
+bool BinaryUIDescription::save (UTF8StringPtr filename, int32_t flags)
+{
+	if (!originalIsBinary && !(flags & kForceWriteBinaryDesc))
+		return CompressedUIDescription::save (filename, flags);
+
+	bool result = false;
+	CFileStream fileStream;
+	if (fileStream.open (filename,
+	                     CFileStream::kWriteMode | CFileStream::kBinaryMode |
+	                         CFileStream::kTruncateMode,
+	                     kLittleEndianByteOrder))
+	{
+		result = saveBinary (fileStream, flags | kWriteImagesIntoXMLFile);
+	}
+	if (!(flags & kNoPlainXmlFileBackup))
+	{
+		// make a xml backup
+		std::string xmlFileName (filename);
+		xmlFileName.append (".xml");
+		CFileStream xmlFileStream;
+		if (xmlFileStream.open (xmlFileName.data (),
+		                        CFileStream::kWriteMode | CFileStream::kTruncateMode,
+		                        kLittleEndianByteOrder))
+		{
+			result = saveToStream (xmlFileStream, flags) && result;
+		}
+	}
+	return result;
+}
+
+//------------------------------------------------------------------------
+} // namespace
@@ -0,0 +1,52 @@
+// This file is part of VSTGUI. It is subject to the license terms
+// in the LICENSE file found in the top-level directory of this
+// distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
+
+#ifndef __binaryuidescription__
+#define __binaryuidescription__
+
+#include "compresseduidescription.h"
+
+//------------------------------------------------------------------------
+namespace VSTGUI {
+
+//------------------------------------------------------------------------
+/** UIDescription which can load and save a precompiled binary format
+ *
+ *	The binary format stores the parser events of the xml description with all element names,
+ *	attribute keys and values interned into one string table. Embedded bitmap data is stored as
+ *	raw character data blocks. Files are memory mapped and the strings are passed directly out of
+ *	the mapped memory to the node tree without any intermediate parsing.
+ *
+ *	If the file is not a binary description, it is loaded as compressed or plain xml description.
+ */
+class BinaryUIDescription : public CompressedUIDescription
+{
+public:
+	BinaryUIDescription (const CResourceDescription& uiDescFile);
+
+	enum SaveFlags
+	{
+		kForceWriteBinaryDesc = 1 << 4
+	};
+
+	bool parse () override;
+	bool save (UTF8StringPtr filename, int32_t flags = kWriteWindowsResourceFile) override;
+
+	/** parse a binary description from memory, the memory needs only be valid during this call */
+	bool parseBinary (const void* data, size_t size);
+	/** write the binary representation of this description to a stream */
+	bool saveBinary (OutputStream& stream, int32_t flags = kWriteImagesIntoXMLFile);
+
+	bool getOriginalIsBinary () const { return originalIsBinary; }
+
+	static bool isBinaryDescription (const void* data, size_t size);
+
+private:
+	bool originalIsBinary {false};
+};
+
+//------------------------------------------------------------------------
+} // namespace
+
+#endif
@@ -28,11 +28,15 @@ public:
 	~ZLibInputStream ();
 
 	bool open (InputStream& stream);
+	/** inflate directly from memory, the memory must be valid the whole lifetime of this object */
+	bool open (const void* data, uint32_t size);
 
 	bool operator>> (std::string& string) override { return false; }
 	uint32_t readRaw (void* buffer, uint32_t size) override;
 
 protected:
+	bool init (const Bytef* input, uint32_t inputSize);
+
 	std::unique_ptr<z_stream> zstream;
 	InputStream* stream {nullptr};
 	std::array<Bytef, 4096> internalBuffer;
@@ -79,16 +83,41 @@ bool CompressedUIDescription::parseWithStream (InputStream& stream)
 	{
 		ZLibInputStream zin;
 		if (zin.open (stream))
-		{
-			Xml::InputStreamContentProvider compressedContentProvider (zin);
-			setXmlContentProvider (&compressedContentProvider);
-			result = UIDescription::parse ();
-			setXmlContentProvider (nullptr);
-		}
+			result = parseWithZLibStream (zin);
 	}
 	return result;
 }
 
+//-----------------------------------------------------------------------------
+bool CompressedUIDescription::parseWithMappedStream (CResourceInputStream& stream)
+{
+	size_t size;
+	auto data = static_cast<const uint8_t*> (stream.getMappedData (size));
+	if (data == nullptr)
+		return parseWithStream (stream);
+	if (size < sizeof (int64_t) || size - sizeof (int64_t) > std::numeric_limits<uint32_t>::max ())
+		return false;
+	int64_t identifier;
+	stream >> identifier;
+	if (identifier != kUIDescIdentifier)
+		return false;
+	// inflate directly from the mapped file
+	ZLibInputStream zin;
+	if (!zin.open (data + sizeof (int64_t), static_cast<uint32_t> (size - sizeof (int64_t))))
+		return false;
+	return parseWithZLibStream (zin);
+}
+
+//-----------------------------------------------------------------------------
+bool CompressedUIDescription::parseWithZLibStream (InputStream& zin)
+{
+	Xml::InputStreamContentProvider compressedContentProvider (zin);
+	setXmlContentProvider (&compressedContentProvider);
+	auto result = UIDescription::parse ();
+	setXmlContentProvider (nullptr);
+	return result;
+}
+
 //-----------------------------------------------------------------------------
 bool CompressedUIDescription::parse ()
 {
@@ -96,9 +125,15 @@ bool CompressedUIDescription::parse ()
 		return true;
 	bool result = false;
 	CResourceInputStream resStream (kLittleEndianByteOrder);
+	CMappedFileInputStream mappedFileStream (kLittleEndianByteOrder);
 	if (resStream.open (getXmlFile ()))
 	{
-		result = parseWithStream (resStream);
+		result = parseWithMappedStream (resStream);
+	}
+	else if (getXmlFile ().type == CResourceDescription::kStringType &&
+	         mappedFileStream.open (getXmlFile ().u.name))
+	{
+		result = parseWithMappedStream (mappedFileStream);
 	}
 	else if (getXmlFile ().type == CResourceDescription::kStringType)
 	{
@@ -183,12 +218,25 @@ bool ZLibInputStream::open (InputStream& _stream)
 	auto read = stream->readRaw (internalBuffer.data (), static_cast<uint32_t> (internalBuffer.size ()));
 	if (read == 0 || read == kStreamIOError)
 		return false;
+	return init (internalBuffer.data (), read);
+}
 
+//-----------------------------------------------------------------------------
+bool ZLibInputStream::open (const void* data, uint32_t size)
+{
+	if (zstream != nullptr || stream != nullptr || size == 0)
+		return false;
+	return init (static_cast<const Bytef*> (data), size);
+}
+
+//-----------------------------------------------------------------------------
+bool ZLibInputStream::init (const Bytef* input, uint32_t inputSize)
+{
 	zstream = std::unique_ptr<z_stream> (new z_stream);
 	memset (zstream.get (), 0, sizeof (z_stream));
 
-	zstream->next_in = internalBuffer.data ();
-	zstream->avail_in = read;
+	zstream->next_in = input;
+	zstream->avail_in = inputSize;
 
 	if (inflateInit (zstream.get ()) != Z_OK)
 	{
@@ -207,7 +255,7 @@ uint32_t ZLibInputStream::readRaw (void* buffer, uint32_t size)
 	zstream->avail_out = size;
 	while (zstream->avail_out > 0)
 	{
-		if (zstream->avail_in == 0)
+		if (zstream->avail_in == 0 && stream)
 		{
 			auto read = stream->readRaw (internalBuffer.data (), static_cast<uint32_t> (internalBuffer.size ()));
 			if (read > 0 && read != kStreamIOError)
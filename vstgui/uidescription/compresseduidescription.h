@@ -30,6 +30,8 @@ public:
 
 private:
 	bool parseWithStream (InputStream& stream);
+	bool parseWithMappedStream (CResourceInputStream& stream);
+	bool parseWithZLibStream (InputStream& zin);
 
 	bool originalIsCompressed {false};
 	uint32_t compressionLevel {1};
@@ -3,8 +3,10 @@
 // distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
 
 #include "cstream.h"
+#include "base64codec.h"
 #include "../lib/cresourcedescription.h"
 #include "../lib/platform/iplatformresourceinputstream.h"
+#include "../lib/platform/common/fileresourceinputstream.h"
 #include <algorithm>
 #include <sstream>
 
@@ -382,6 +384,37 @@ void CResourceInputStream::rewind ()
 		platformStream->seek (0, VSTGUI::SeekMode::Set);
 }
 
+//-----------------------------------------------------------------------------
+const void* CResourceInputStream::getMappedData (size_t& size) const
+{
+	size = 0;
+	if (!platformStream)
+		return nullptr;
+	uint64_t mappedSize;
+	auto data = platformStream->getMappedData (mappedSize);
+	if (data == nullptr || mappedSize > std::numeric_limits<size_t>::max ())
+		return nullptr;
+	size = static_cast<size_t> (mappedSize);
+	return data;
+}
+
+//-----------------------------------------------------------------------------
+//-----------------------------------------------------------------------------
+//-----------------------------------------------------------------------------
+CMappedFileInputStream::CMappedFileInputStream (ByteOrder byteOrder)
+: CResourceInputStream (byteOrder)
+{
+}
+
+//-----------------------------------------------------------------------------
+bool CMappedFileInputStream::open (UTF8StringPtr path)
+{
+	if (platformStream || path == nullptr)
+		return false;
+	platformStream = MappedFileResourceInputStream::create (path);
+	return platformStream != nullptr;
+}
+
 //-----------------------------------------------------------------------------
 template<typename T>
 void endianSwap (T& value)
@@ -606,4 +639,54 @@ bool InputStream::operator>> (double& output)
 	return false;
 }
 
+//-----------------------------------------------------------------------------
+uint32_t Base64EncodingOutputStream::writeRaw (const void* inBuffer, uint32_t size)
+{
+	auto ptr = reinterpret_cast<const uint8_t*> (inBuffer);
+	auto remaining = size;
+	while (numPending > 0 && numPending < 3 && remaining > 0)
+	{
+		pending[numPending++] = *ptr++;
+		--remaining;
+	}
+	if (numPending == 3)
+	{
+		if (!writeEncoded (pending, 3))
+			return kStreamIOError;
+		numPending = 0;
+	}
+	while (remaining >= 3)
+	{
+		auto chunkSize = std::min<uint32_t> (remaining - remaining % 3, kChunkSize);
+		if (!writeEncoded (ptr, chunkSize))
+			return kStreamIOError;
+		ptr += chunkSize;
+		remaining -= chunkSize;
+	}
+	while (remaining > 0)
+	{
+		pending[numPending++] = *ptr++;
+		--remaining;
+	}
+	return size;
+}
+
+//-----------------------------------------------------------------------------
+bool Base64EncodingOutputStream::finish ()
+{
+	if (numPending == 0)
+		return true;
+	auto result = writeEncoded (pending, numPending);
+	numPending = 0;
+	return result;
+}
+
+//-----------------------------------------------------------------------------
+bool Base64EncodingOutputStream::writeEncoded (const uint8_t* data, uint32_t size)
+{
+	static_assert (sizeof (buffer) == Base64Codec::getEncodedSize (kChunkSize), "");
+	auto encodedSize = static_cast<uint32_t> (Base64Codec::encode (data, size, buffer));
+	return stream.writeRaw (buffer, encodedSize) == encodedSize;
+}
+
 } // namespace
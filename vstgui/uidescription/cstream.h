@@ -225,11 +225,26 @@ public:
 	int64_t tell () const override;
 	void rewind () override;
 
+	/** returns the whole resource if the platform stream is memory mapped, otherwise nullptr */
+	const void* getMappedData (size_t& size) const;
+
 	using InputStream::operator>>;
 protected:
 	std::unique_ptr<IPlatformResourceInputStream> platformStream;
 };
 
+/**
+	Read only input stream of a memory mapped file
+ */
+class CMappedFileInputStream : public CResourceInputStream
+{
+public:
+	explicit CMappedFileInputStream (ByteOrder byteOrder = kNativeByteOrder);
+
+	/** fails if the file does not exist, is empty or cannot be mapped */
+	bool open (UTF8StringPtr path);
+};
+
 //------------------------------------------------------------------------
 class BufferedOutputStream : public OutputStream
 {
@@ -278,6 +293,34 @@ private:
 	size_t bufferSize;
 };
 
+//------------------------------------------------------------------------
+/** Output stream which writes the base64 encoding of the written data to another stream
+ *
+ *	The last incomplete block is written on finish or when the stream is destroyed.
+ */
+class Base64EncodingOutputStream : public OutputStream
+{
+public:
+	explicit Base64EncodingOutputStream (OutputStream& stream) : stream (stream) {}
+	~Base64EncodingOutputStream () noexcept override { finish (); }
+	bool operator<< (const std::string& str) override
+	{
+		return writeRaw (str.c_str (), static_cast<uint32_t> (str.size ())) == str.size ();
+	}
+	uint32_t writeRaw (const void* inBuffer, uint32_t size) override;
+	bool finish ();
+
+private:
+	enum { kChunkSize = 3 * 4096 };
+
+	bool writeEncoded (const uint8_t* data, uint32_t size);
+
+	OutputStream& stream;
+	uint8_t buffer[kChunkSize / 3 * 4];
+	uint8_t pending[3];
+	uint32_t numPending {0};
+};
+
 } // namespace
 
 #endif
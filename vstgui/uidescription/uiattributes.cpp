@@ -9,9 +9,149 @@
 #include "../lib/cstring.h"
 #include <sstream>
 #include <algorithm>
+#include <clocale>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
 
 namespace VSTGUI {
 
+namespace {
+
+//-----------------------------------------------------------------------------
+inline bool isSpace (char c)
+{
+	return c == ' ' || (c >= '\t' && c <= '\r');
+}
+
+//-----------------------------------------------------------------------------
+inline bool isDigit (char c)
+{
+	return c >= '0' && c <= '9';
+}
+
+//-----------------------------------------------------------------------------
+/** parses a double the same way as an std::istringstream with the classic locale does.
+ *
+ *	Plain decimal numbers with up to 15 significant digits and small exponents, which is what
+ *	uidesc files contain, are converted exactly with one floating point operation. Everything else
+ *	is passed to the stream.
+ */
+double parseDouble (const char* first, const char* last)
+{
+	static constexpr double kPow10[] = {1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,
+	                                    1e8,  1e9,  1e10, 1e11, 1e12, 1e13, 1e14, 1e15,
+	                                    1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+	static constexpr uint64_t kMaxExactMantissa = 1ull << 53;
+
+	auto ptr = first;
+	while (ptr != last && isSpace (*ptr))
+		++ptr;
+	bool negative = false;
+	if (ptr != last && (*ptr == '-' || *ptr == '+'))
+		negative = *ptr++ == '-';
+	uint64_t mantissa = 0;
+	int32_t exponent = 0;
+	bool exact = true;
+	auto numDigits = 0;
+	auto accumulate = [&] (char c) {
+		++numDigits;
+		if (mantissa > (kMaxExactMantissa - 9) / 10)
+			exact = false;
+		else
+			mantissa = mantissa * 10 + static_cast<uint64_t> (c - '0');
+	};
+	while (ptr != last && isDigit (*ptr))
+		accumulate (*ptr++);
+	if (ptr != last && *ptr == '.')
+	{
+		++ptr;
+		while (ptr != last && isDigit (*ptr))
+		{
+			accumulate (*ptr++);
+			--exponent;
+		}
+	}
+	if (numDigits == 0)
+		exact = false;
+	if (exact && ptr != last && (*ptr == 'e' || *ptr == 'E'))
+	{
+		++ptr;
+		bool negativeExponent = false;
+		if (ptr != last && (*ptr == '-' || *ptr == '+'))
+			negativeExponent = *ptr++ == '-';
+		if (ptr == last || !isDigit (*ptr))
+			exact = false;
+		int32_t value = 0;
+		while (exact && ptr != last && isDigit (*ptr))
+		{
+			value = value * 10 + (*ptr++ - '0');
+			if (value > 1000)
+				exact = false;
+		}
+		exponent += negativeExponent ? -value : value;
+	}
+	// the stream would continue to consume these and maybe fail
+	if (ptr != last && (isDigit (*ptr) || strchr (".eE+-", *ptr)))
+		exact = false;
+	if (exact && exponent >= -22 && exponent <= 22)
+	{
+		auto result = static_cast<double> (mantissa);
+		if (exponent < 0)
+			result /= kPow10[-exponent];
+		else
+			result *= kPow10[exponent];
+		return negative ? -result : result;
+	}
+	return UTF8StringView (std::string (first, last).data ()).toDouble ();
+}
+
+//-----------------------------------------------------------------------------
+/** parses a comma separated list of exactly numValues doubles */
+bool parseDoubles (const std::string& str, double* values, size_t numValues)
+{
+	auto first = str.data ();
+	auto last = first + str.size ();
+	for (size_t i = 0; i < numValues; ++i)
+	{
+		auto separator = std::find (first, last, ',');
+		if ((separator == last) != (i == numValues - 1))
+			return false;
+		values[i] = parseDouble (first, separator);
+		first = separator + 1;
+	}
+	return true;
+}
+
+//-----------------------------------------------------------------------------
+/** appends the value like an std::ostream with the classic locale and the precision does */
+void appendDouble (std::string& str, double value, int precision)
+{
+	char buffer[64];
+	auto length = snprintf (buffer, sizeof (buffer), "%.*g", precision, value);
+	if (length <= 0)
+		return;
+	auto decimalPoint = *localeconv ()->decimal_point;
+	if (decimalPoint != '.')
+		std::replace (buffer, buffer + length, decimalPoint, '.');
+	str.append (buffer, static_cast<size_t> (length));
+}
+
+//-----------------------------------------------------------------------------
+std::string doublesToString (const double* values, size_t numValues)
+{
+	std::string str;
+	for (size_t i = 0; i < numValues; ++i)
+	{
+		if (i > 0)
+			str += ", ";
+		appendDouble (str, values[i], 6);
+	}
+	return str;
+}
+
+} // anonymous
+
 //-----------------------------------------------------------------------------
 //-----------------------------------------------------------------------------
 //-----------------------------------------------------------------------------
@@ -21,88 +161,173 @@ UIAttributes::UIAttributes (UTF8StringPtr* attributes)
 	{
 		int32_t i = 0;
 		while (attributes[i] != nullptr && attributes[i+1] != nullptr)
-		{
-			emplace (attributes[i], attributes[i+1]);
 			i += 2;
+		entries.reserve (static_cast<size_t> (i / 2));
+		for (int32_t j = 0; j < i; j += 2)
+		{
+			if (indexOf (attributes[j]) == entries.size ())
+				entries.emplace_back (attributes[j], attributes[j+1]);
 		}
 	}
 }
 
+//-----------------------------------------------------------------------------
+size_t UIAttributes::indexOf (UTF8StringView name) const
+{
+	auto it = std::find_if (entries.begin (), entries.end (), [&] (const Entry& entry) {
+		return name == UTF8StringView (entry.first);
+	});
+	return static_cast<size_t> (it - entries.begin ());
+}
+
+//-----------------------------------------------------------------------------
+void UIAttributes::invalidateTypedValue (size_t index)
+{
+	if (index < typedValues.size ())
+		typedValues[index].type = TypedValue::Type::None;
+}
+
+//-----------------------------------------------------------------------------
+auto UIAttributes::getTypedValue (const std::string& name, TypedValue::Type type) const -> const TypedValue*
+{
+	auto index = indexOf (name);
+	if (index == entries.size ())
+		return nullptr;
+	if (typedValues.empty ())
+		typedValues.resize (entries.size ());
+	auto& typedValue = typedValues[index];
+	if (typedValue.type == type)
+		return &typedValue;
+	const auto& str = entries[index].second;
+	switch (type)
+	{
+		case TypedValue::Type::Integer:
+		{
+			typedValue.values[0] = static_cast<int32_t> (strtol (str.data (), nullptr, 10));
+			typedValue.valid = true;
+			break;
+		}
+		case TypedValue::Type::Double:
+		{
+			typedValue.values[0] = parseDouble (str.data (), str.data () + str.size ());
+			typedValue.valid = true;
+			break;
+		}
+		case TypedValue::Type::Point:
+		{
+			typedValue.valid = parseDoubles (str, typedValue.values, 2);
+			break;
+		}
+		case TypedValue::Type::Rect:
+		{
+			typedValue.valid = parseDoubles (str, typedValue.values, 4);
+			break;
+		}
+		case TypedValue::Type::None:
+			return nullptr;
+	}
+	typedValue.type = type;
+	return &typedValue;
+}
+
 //-----------------------------------------------------------------------------
 bool UIAttributes::hasAttribute (const std::string& name) const
 {
-	if (getAttributeValue (name) != nullptr)
-		return true;
-	return false;
+	return indexOf (name) != entries.size ();
 }
 
 //-----------------------------------------------------------------------------
 const std::string* UIAttributes::getAttributeValue (const std::string& name) const
 {
-	const_iterator iter = find (name);
-	if (iter != end ())
-		return &iter->second;
+	auto index = indexOf (name);
+	if (index != entries.size ())
+		return &entries[index].second;
 	return nullptr;
 }
 
 //-----------------------------------------------------------------------------
 void UIAttributes::setAttribute (const std::string& name, const std::string& value)
 {
-	iterator iter = find (name);
-	if (iter != end ())
-		iter->second = value;
+	auto index = indexOf (name);
+	if (index != entries.size ())
+	{
+		entries[index].second = value;
+		invalidateTypedValue (index);
+	}
 	else
-		emplace (name, value);
+	{
+		entries.emplace_back (name, value);
+		if (!typedValues.empty ())
+			typedValues.emplace_back ();
+	}
 }
 
 //-----------------------------------------------------------------------------
 void UIAttributes::setAttribute (const std::string& name, std::string&& value)
 {
-	iterator iter = find (name);
-	if (iter != end ())
-		iter->second = std::move (value);
+	auto index = indexOf (name);
+	if (index != entries.size ())
+	{
+		entries[index].second = std::move (value);
+		invalidateTypedValue (index);
+	}
 	else
-		emplace (name, std::move (value));
+	{
+		entries.emplace_back (name, std::move (value));
+		if (!typedValues.empty ())
+			typedValues.emplace_back ();
+	}
 }
 
 //-----------------------------------------------------------------------------
 void UIAttributes::setAttribute (std::string&& name, std::string&& value)
 {
-	iterator iter = find (name);
-	if (iter != end ())
-		iter->second = std::move (value);
+	auto index = indexOf (name);
+	if (index != entries.size ())
+	{
+		entries[index].second = std::move (value);
+		invalidateTypedValue (index);
+	}
 	else
-		emplace (std::move (name), std::move (value));
+	{
+		entries.emplace_back (std::move (name), std::move (value));
+		if (!typedValues.empty ())
+			typedValues.emplace_back ();
+	}
 }
 
 //-----------------------------------------------------------------------------
 void UIAttributes::removeAttribute (const std::string& name)
 {
-	iterator iter = find (name);
-	if (iter != end ())
-		erase (iter);
+	auto index = indexOf (name);
+	if (index == entries.size ())
+		return;
+	entries.erase (entries.begin () + static_cast<ptrdiff_t> (index));
+	if (index < typedValues.size ())
+		typedValues.erase (typedValues.begin () + static_cast<ptrdiff_t> (index));
+}
+
+//-----------------------------------------------------------------------------
+void UIAttributes::removeAll ()
+{
+	entries.clear ();
+	typedValues.clear ();
 }
 
 //-----------------------------------------------------------------------------
 void UIAttributes::setDoubleAttribute (const std::string& name, double value)
 {
-	std::stringstream str;
-	str.imbue (std::locale::classic ());
-	str.precision (40);
-	str << value;
-	setAttribute (name, str.str ());
+	std::string str;
+	appendDouble (str, value, 40);
+	setAttribute (name, std::move (str));
 }
 
 //-----------------------------------------------------------------------------
 bool UIAttributes::getDoubleAttribute (const std::string& name, double& value) const
 {
-	const std::string* str = getAttributeValue (name);
-	if (str)
+	if (auto typedValue = getTypedValue (name, TypedValue::Type::Double))
 	{
-		std::istringstream sstream (*str);
-		sstream.imbue (std::locale::classic ());
-		sstream.precision (40);
-		sstream >> value;
+		value = typedValue->values[0];
 		return true;
 	}
 	return false;
@@ -137,18 +362,15 @@ bool UIAttributes::getBooleanAttribute (const std::string& name, bool& value) co
 //-----------------------------------------------------------------------------
 void UIAttributes::setIntegerAttribute (const std::string& name, int32_t value)
 {
-	std::stringstream str;
-	str << value;
-	setAttribute (name, str.str ());
+	setAttribute (name, std::to_string (value));
 }
 
 //-----------------------------------------------------------------------------
 bool UIAttributes::getIntegerAttribute (const std::string& name, int32_t& value) const
 {
-	const std::string* str = getAttributeValue (name);
-	if (str)
+	if (auto typedValue = getTypedValue (name, TypedValue::Type::Integer))
 	{
-		value = (int32_t)strtol (str->c_str (), nullptr, 10);
+		value = static_cast<int32_t> (typedValue->values[0]);
 		return true;
 	}
 	return false;
@@ -157,38 +379,19 @@ bool UIAttributes::getIntegerAttribute (const std::string& name, int32_t& value)
 //-----------------------------------------------------------------------------
 void UIAttributes::setPointAttribute (const std::string& name, const CPoint& p)
 {
-	std::stringstream str;
-	str << p.x;
-	str << ", ";
-	str << p.y;
-	setAttribute (name, str.str ());
+	const double values[] = {p.x, p.y};
+	setAttribute (name, doublesToString (values, 2));
 }
 
 //-----------------------------------------------------------------------------
 bool UIAttributes::getPointAttribute (const std::string& name, CPoint& p) const
 {
-	const std::string* str = getAttributeValue (name);
-	if (str)
+	auto typedValue = getTypedValue (name, TypedValue::Type::Point);
+	if (typedValue && typedValue->valid)
 	{
-		size_t start = 0;
-		size_t pos = str->find (",", start, 1);
-		if (pos != std::string::npos)
-		{
-			StringArray subStrings;
-			while (pos != std::string::npos)
-			{
-				subStrings.emplace_back (*str, start, pos - start);
-				start = pos+1;
-				pos = str->find (",", start, 1);
-			}
-			subStrings.emplace_back (*str, start, std::string::npos);
-			if (subStrings.size () == 2)
-			{
-				p.x = UTF8StringView (subStrings[0].c_str ()).toDouble ();
-				p.y = UTF8StringView (subStrings[1].c_str ()).toDouble ();
-				return true;
-			}
-		}
+		p.x = typedValue->values[0];
+		p.y = typedValue->values[1];
+		return true;
 	}
 	return false;
 }
@@ -196,44 +399,21 @@ bool UIAttributes::getPointAttribute (const std::string& name, CPoint& p) const
 //-----------------------------------------------------------------------------
 void UIAttributes::setRectAttribute (const std::string& name, const CRect& r)
 {
-	std::stringstream str;
-	str << r.left;
-	str << ", ";
-	str << r.top;
-	str << ", ";
-	str << r.right;
-	str << ", ";
-	str << r.bottom;
-	setAttribute (name, str.str ());
+	const double values[] = {r.left, r.top, r.right, r.bottom};
+	setAttribute (name, doublesToString (values, 4));
 }
 
 //-----------------------------------------------------------------------------
 bool UIAttributes::getRectAttribute (const std::string& name, CRect& r) const
 {
-	const std::string* str = getAttributeValue (name);
-	if (str)
+	auto typedValue = getTypedValue (name, TypedValue::Type::Rect);
+	if (typedValue && typedValue->valid)
 	{
-		size_t start = 0;
-		size_t pos = str->find (",", start, 1);
-		if (pos != std::string::npos)
-		{
-			StringArray subStrings;
-			while (pos != std::string::npos)
-			{
-				subStrings.emplace_back (*str, start, pos - start);
-				start = pos+1;
-				pos = str->find (",", start, 1);
-			}
-			subStrings.emplace_back (*str, start, std::string::npos);
-			if (subStrings.size () == 4)
-			{
-				r.left = UTF8StringView (subStrings[0].c_str ()).toDouble ();
-				r.top = UTF8StringView (subStrings[1].c_str ()).toDouble ();
-				r.right = UTF8StringView (subStrings[2].c_str ()).toDouble ();
-				r.bottom = UTF8StringView (subStrings[3].c_str ()).toDouble ();
-				return true;
-			}
-		}
+		r.left = typedValue->values[0];
+		r.top = typedValue->values[1];
+		r.right = typedValue->values[2];
+		r.bottom = typedValue->values[3];
+		return true;
 	}
 	return false;
 }
@@ -250,11 +430,14 @@ bool UIAttributes::getStringArrayAttribute (const std::string& name, StringArray
 	const std::string* str = getAttributeValue (name);
 	if (str)
 	{
-		std::stringstream ss (*str);
-		std::string item;
-		while (std::getline (ss, item, ','))
+		size_t start = 0;
+		while (start < str->size ())
 		{
-			values.emplace_back (std::move (item));
+			auto pos = str->find (',', start);
+			if (pos == std::string::npos)
+				pos = str->size ();
+			values.emplace_back (*str, start, pos - start);
+			start = pos + 1;
 		}
 		return true;
 	}
@@ -265,13 +448,12 @@ bool UIAttributes::getStringArrayAttribute (const std::string& name, StringArray
 std::string UIAttributes::createStringArrayValue (const StringArray& values)
 {
 	std::string value;
-	size_t numValues = values.size ();
-	for (size_t i = 0; i < numValues - 1; i++)
+	for (const auto& v : values)
 	{
-		value += values[i];
-		value += ',';
+		if (&v != &values.front ())
+			value += ',';
+		value += v;
 	}
-	value += values[numValues-1];
 	return value;
 }
 
@@ -279,13 +461,11 @@ std::string UIAttributes::createStringArrayValue (const StringArray& values)
 bool UIAttributes::store (OutputStream& stream) const
 {
 	if (!(stream << (int32_t)'UIAT')) return false;
-	if (!(stream << (uint32_t)size ())) return false;
-	const_iterator it = begin ();
-	while (it != end ())
+	if (!(stream << (uint32_t)entries.size ())) return false;
+	for (const auto& entry : entries)
 	{
-		if (!(stream << (*it).first)) return false;
-		if (!(stream << (*it).second)) return false;
-		++it;
+		if (!(stream << entry.first)) return false;
+		if (!(stream << entry.second)) return false;
 	}
 	return true;
 }
@@ -8,6 +8,8 @@
 #include "../lib/vstguifwd.h"
 #include "../lib/cstring.h"
 
+#include <string>
+#include <utility>
 #include <vector>
 #include "../lib/platform/std_unorderedmap.h"
 
@@ -15,21 +17,29 @@ namespace VSTGUI {
 class OutputStream;
 class InputStream;
 
-using UIAttributesMap = std::unordered_map<std::string,std::string>;
-
 //-----------------------------------------------------------------------------
-class UIAttributes : public NonAtomicReferenceCounted, private UIAttributesMap
+/** attribute key/value storage of the nodes of a UIDescription
+ *
+ *	The attributes are stored in insertion order in a flat vector as attribute sets are typically
+ *	small. The typed getters cache the parsed value per attribute, so that repeated access (i.e.
+ *	when a template is instantiated more than once) does not parse the string again. Changing an
+ *	attribute invalidates its cached value.
+ */
+class UIAttributes : public NonAtomicReferenceCounted
 {
 public:
 	using StringArray = std::vector<std::string>;
+	using Entry = std::pair<std::string, std::string>;
+	using EntryVector = std::vector<Entry>;
+	using iterator = EntryVector::const_iterator;
+	using const_iterator = EntryVector::const_iterator;
 	
 	explicit UIAttributes (UTF8StringPtr* attributes = nullptr);
 	~UIAttributes () noexcept override = default;
 
-	using UIAttributesMap::begin;
-	using UIAttributesMap::end;
-	using UIAttributesMap::iterator;
-	using UIAttributesMap::const_iterator;
+	const_iterator begin () const { return entries.begin (); }
+	const_iterator end () const { return entries.end (); }
+	size_t size () const { return entries.size (); }
 
 	bool hasAttribute (const std::string& name) const;
 	const std::string* getAttributeValue (const std::string& name) const;
@@ -58,10 +68,35 @@ public:
 	
 	static std::string createStringArrayValue (const StringArray& values);
 	
-	void removeAll () { clear (); }
+	void removeAll ();
 
 	bool store (OutputStream& stream) const;
 	bool restore (InputStream& stream);
+
+private:
+	struct TypedValue
+	{
+		enum class Type : uint8_t
+		{
+			None,
+			Integer,
+			Double,
+			Point,
+			Rect
+		};
+		Type type {Type::None};
+		bool valid {false};
+		double values[4];
+	};
+
+	/** returns size () if there is no attribute with this name */
+	size_t indexOf (UTF8StringView name) const;
+	void invalidateTypedValue (size_t index);
+	const TypedValue* getTypedValue (const std::string& name, TypedValue::Type type) const;
+
+	EntryVector entries;
+	/** parallel to entries, allocated on the first typed access */
+	mutable std::vector<TypedValue> typedValues;
 };
 
 }
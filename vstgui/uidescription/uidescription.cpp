@@ -26,8 +26,16 @@
 #include <sstream>
 #include <fstream>
 #include <algorithm>
+#include <array>
+#include <atomic>
 #include <cassert>
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
 #include <deque>
+#include <map>
+#include <mutex>
+#include <thread>
 
 namespace VSTGUI {
 
@@ -64,8 +72,40 @@ namespace MainNodeNames {
 	static const IdStringPtr kTemplate = "template";
 	static const IdStringPtr kCustom = "custom";
 	static const IdStringPtr kGradient = "gradients";
+
+	/** the main nodes which have at most one instance below the root node */
+	static const IdStringPtr kUniqueNodes[] = {kBitmap, kFont, kColor, kControlTag, kVariable, kCustom, kGradient};
+	static constexpr size_t kNumUniqueNodes = sizeof (kUniqueNodes) / sizeof (kUniqueNodes[0]);
+
+	/** returns the index into kUniqueNodes or kNumUniqueNodes if name is not a unique main node */
+	static size_t indexOfUniqueNode (UTF8StringPtr name)
+	{
+		for (auto i = 0u; i < kNumUniqueNodes; ++i)
+		{
+			if (kUniqueNodes[i] == name)
+				return i;
+		}
+		for (auto i = 0u; i < kNumUniqueNodes; ++i)
+		{
+			if (std::strcmp (kUniqueNodes[i], name) == 0)
+				return i;
+		}
+		return kNumUniqueNodes;
+	}
+
+	/** the main nodes which are taken from the shared resources if available */
+	static bool isSharedResource (size_t uniqueNodeIndex)
+	{
+		if (uniqueNodeIndex >= kNumUniqueNodes)
+			return false;
+		auto name = kUniqueNodes[uniqueNodeIndex];
+		return name == kBitmap || name == kFont || name == kColor || name == kGradient;
+	}
 }
 
+/** the attribute identifying resources and templates */
+static const std::string kNameAttribute = "name";
+
 class UINode;
 
 using UIDescListContainerType = std::vector<UINode*>;
@@ -92,6 +132,7 @@ public:
 	virtual void removeAll ();
 	virtual UINode* findChildNode (UTF8StringView nodeName) const;
 	virtual UINode* findChildNodeWithAttributeValue (const std::string& attributeName, const std::string& attributeValue) const;
+	virtual UINode* findChildNodeByNameAttribute (UTF8StringPtr name) const;
 
 	virtual void nodeAttributeChanged (UINode* child, const std::string& attributeName, const std::string& oldAttributeValue) {}
 
@@ -107,12 +148,26 @@ class UINode : public NonAtomicReferenceCounted
 public:
 	using DataStorage = std::string;
 
+	/** the concrete class of a node, used instead of dynamic_cast when looking up resources */
+	enum class Kind : uint8_t
+	{
+		Generic,
+		Comment,
+		Variable,
+		ControlTag,
+		Bitmap,
+		Font,
+		Color,
+		Gradient
+	};
+
 	UINode (const std::string& name, const SharedPointer<UIAttributes>& attributes = {}, bool needsFastChildNameAttributeLookup = false);
 	UINode (const std::string& name, const SharedPointer<UIDescList>& children, const SharedPointer<UIAttributes>& attributes = {});
 	UINode (const UINode& n);
 	~UINode () noexcept override;
 
 	const std::string& getName () const { return name; }
+	Kind getKind () const { return kind; }
 	DataStorage& getData () { return data; }
 	const DataStorage& getData () const { return data; }
 
@@ -122,11 +177,15 @@ public:
 	void childAttributeChanged (UINode* child, const char* attributeName, const char* oldAttributeValue);
 
 	enum {
-		kNoExport = 1 << 0
+		kNoExport = 1 << 0,
+		kBinaryData = 1 << 1
 	};
 	
 	bool noExport () const { return hasBit (flags, kNoExport); }
 	void noExport (bool state) { setBit (flags, kNoExport, state); }
+	/** the data is not text, it is base64 encoded when written as xml */
+	bool binaryData () const { return hasBit (flags, kBinaryData); }
+	void binaryData (bool state) { setBit (flags, kBinaryData, state); }
 
 	bool operator== (const UINode& n) const { return name == n.name; }
 	
@@ -134,24 +193,476 @@ public:
 	virtual void freePlatformResources () {}
 
 protected:
+	UINode (const std::string& name, const SharedPointer<UIAttributes>& attributes, Kind kind);
+
 	std::string name;
 	DataStorage data;
 	SharedPointer<UIAttributes> attributes;
 	SharedPointer<UIDescList> children;
 	int32_t flags;
+	Kind kind {Kind::Generic};
 };
 
+//-----------------------------------------------------------------------------
+template<typename NodeType>
+inline NodeType* nodeCast (UINode* node)
+{
+	if (node && node->getKind () == NodeType::kKind)
+		return static_cast<NodeType*> (node);
+	return nullptr;
+}
+
 //-----------------------------------------------------------------------------
 class UICommentNode : public UINode
 {
 public:
+	static constexpr Kind kKind = Kind::Comment;
+
 	explicit UICommentNode (const std::string& comment);
 };
 
+namespace UIDescriptionPrivate {
+
+//-----------------------------------------------------------------------------
+/** parses a complete string as a number independent of the global locale, an empty string is 0 */
+static bool parseNumber (const std::string& str, double& result)
+{
+	if (str.empty ())
+	{
+		result = 0.;
+		return true;
+	}
+	std::istringstream stream (str);
+	stream.imbue (std::locale::classic ());
+	double value;
+	stream >> value;
+	if (stream.fail () || stream.peek () != std::istringstream::traits_type::eof ())
+		return false;
+	result = value;
+	return true;
+}
+
+//-----------------------------------------------------------------------------
+/** a variable or control tag expression compiled to a stack program
+ *
+ *	The expression syntax is the one UIDescription::calculateStringValue always supported: numbers,
+ *	"var.name" and "tag.name" references, the operators + - * / and parentheses.
+ */
+class Expression
+{
+public:
+	static std::unique_ptr<Expression> compile (const std::string& str);
+
+	/** evaluates the expression, fails if one of the resolvers fails
+	 *
+	 *	resolveVariable and resolveTag are called as bool (const std::string& name, double& value)
+	 */
+	template<typename VariableResolver, typename TagResolver>
+	bool evaluate (double& result, VariableResolver&& resolveVariable, TagResolver&& resolveTag) const
+	{
+		static constexpr size_t kLocalStackSize = 16;
+		double localStack[kLocalStackSize];
+		std::vector<double> heapStack;
+		auto stack = localStack;
+		if (maxStackDepth > kLocalStackSize)
+		{
+			heapStack.resize (maxStackDepth);
+			stack = heapStack.data ();
+		}
+		size_t stackSize = 0;
+		for (const auto& op : ops)
+		{
+			switch (op.type)
+			{
+				case Op::kNumber:
+				{
+					stack[stackSize++] = op.number;
+					break;
+				}
+				case Op::kVariable:
+				{
+					if (!resolveVariable (names[op.nameIndex], stack[stackSize++]))
+						return false;
+					break;
+				}
+				case Op::kTag:
+				{
+					if (!resolveTag (names[op.nameIndex], stack[stackSize++]))
+						return false;
+					break;
+				}
+				case Op::kAdd:
+				{
+					--stackSize;
+					stack[stackSize - 1] += stack[stackSize];
+					break;
+				}
+				case Op::kSubtract:
+				{
+					--stackSize;
+					stack[stackSize - 1] -= stack[stackSize];
+					break;
+				}
+				case Op::kMultiply:
+				{
+					--stackSize;
+					stack[stackSize - 1] *= stack[stackSize];
+					break;
+				}
+				case Op::kDivide:
+				{
+					--stackSize;
+					stack[stackSize - 1] /= stack[stackSize];
+					break;
+				}
+			}
+		}
+		result = stack[0];
+		return true;
+	}
+
+	/** true if the expression contains "var." or "tag." references */
+	bool hasReferences () const { return !names.empty (); }
+
+private:
+	struct Op
+	{
+		enum Type : uint8_t
+		{
+			kNumber,
+			kVariable,
+			kTag,
+			kAdd,
+			kSubtract,
+			kMultiply,
+			kDivide
+		};
+		Type type;
+		uint32_t nameIndex;
+		double number;
+	};
+
+	class Compiler;
+
+	std::vector<Op> ops;
+	std::vector<std::string> names;
+	size_t maxStackDepth {0};
+};
+
+//-----------------------------------------------------------------------------
+/** builds a tree of the expression with the same precedence rules and quirks as the former token
+ *	list evaluator (a leading + or - applies to 0, trailing + and - are ignored) and flattens it to
+ *	the stack program. Operations on constants are folded.
+ */
+class Expression::Compiler
+{
+public:
+	bool run (const std::string& str, Expression& expression)
+	{
+		double number;
+		if (parseNumber (str, number))
+		{
+			// also covers numbers with a signed exponent, which the tokenizer would split
+			expression.ops.push_back ({Op::kNumber, 0, number});
+			expression.maxStackDepth = 1;
+			return true;
+		}
+		TokenList tokens;
+		if (!tokenize (str, tokens))
+			return false;
+		int32_t root;
+		if (!compute (tokens, root))
+			return false;
+		size_t depth = 0;
+		emit (root, expression, depth);
+		expression.names = std::move (names);
+		return true;
+	}
+
+private:
+	struct Token
+	{
+		enum Type
+		{
+			kOperand,
+			kAdd,
+			kSubtract,
+			kMultiply,
+			kDivide,
+			kOpenParenthesis,
+			kCloseParenthesis
+		};
+		Type type;
+		int32_t node;
+	};
+	using TokenList = std::list<Token>;
+
+	struct Node
+	{
+		Op op;
+		int32_t left;
+		int32_t right;
+	};
+
+	std::vector<Node> nodes;
+	std::vector<std::string> names;
+
+	int32_t addNumber (double value)
+	{
+		nodes.push_back ({{Op::kNumber, 0, value}, -1, -1});
+		return static_cast<int32_t> (nodes.size () - 1);
+	}
+
+	int32_t addReference (Op::Type type, std::string&& name)
+	{
+		uint32_t nameIndex = 0;
+		while (nameIndex < names.size () && names[nameIndex] != name)
+			++nameIndex;
+		if (nameIndex == names.size ())
+			names.emplace_back (std::move (name));
+		nodes.push_back ({{type, nameIndex, 0.}, -1, -1});
+		return static_cast<int32_t> (nodes.size () - 1);
+	}
+
+	int32_t addOperation (Op::Type type, int32_t left, int32_t right)
+	{
+		const auto& l = nodes[static_cast<size_t> (left)].op;
+		const auto& r = nodes[static_cast<size_t> (right)].op;
+		if (l.type == Op::kNumber && r.type == Op::kNumber)
+		{
+			switch (type)
+			{
+				case Op::kAdd: return addNumber (l.number + r.number);
+				case Op::kSubtract: return addNumber (l.number - r.number);
+				case Op::kMultiply: return addNumber (l.number * r.number);
+				case Op::kDivide: return addNumber (l.number / r.number);
+				default: break;
+			}
+		}
+		nodes.push_back ({{type, 0, 0.}, left, right});
+		return static_cast<int32_t> (nodes.size () - 1);
+	}
+
+	bool addOperand (std::string&& str, TokenList& tokens)
+	{
+		double value;
+		if (parseNumber (str, value))
+			tokens.push_back ({Token::kOperand, addNumber (value)});
+		else if (str.find ("tag.") == 0)
+			tokens.push_back ({Token::kOperand, addReference (Op::kTag, str.substr (4))});
+		else if (str.find ("var.") == 0)
+			tokens.push_back ({Token::kOperand, addReference (Op::kVariable, str.substr (4))});
+		else
+		{
+		#if DEBUG
+			DebugPrint ("Substitution failed :%s\n", str.data ());
+		#endif
+			return false;
+		}
+		return true;
+	}
+
+	bool tokenize (const std::string& str, TokenList& tokens)
+	{
+		auto start = str.begin ();
+		for (auto it = str.begin (); it != str.end (); ++it)
+		{
+			Token::Type type;
+			switch (*it)
+			{
+				case '+': type = Token::kAdd; break;
+				case '-': type = Token::kSubtract; break;
+				case '*': type = Token::kMultiply; break;
+				case '/': type = Token::kDivide; break;
+				case '(': type = Token::kOpenParenthesis; break;
+				case ')': type = Token::kCloseParenthesis; break;
+				case ' ':
+				case '\t':
+				case '\n':
+				case '\v':
+				case '\f':
+				case '\r':
+				{
+					if (start != it && !addOperand ({start, it}, tokens))
+						return false;
+					start = it + 1;
+					continue;
+				}
+				default: continue;
+			}
+			if (start != it && !addOperand ({start, it}, tokens))
+				return false;
+			tokens.push_back ({type, -1});
+			start = it + 1;
+		}
+		if (start != str.end () && !addOperand ({start, str.end ()}, tokens))
+			return false;
+		return true;
+	}
+
+	bool compute (TokenList& tokens, int32_t& result)
+	{
+		// first check parentheses
+		int32_t openCount = 0;
+		auto openPosition = tokens.end ();
+		for (auto it = tokens.begin (); it != tokens.end (); ++it)
+		{
+			if (it->type == Token::kOpenParenthesis)
+			{
+				openCount++;
+				if (openCount == 1)
+					openPosition = it;
+			}
+			else if (it->type == Token::kCloseParenthesis)
+			{
+				openCount--;
+				if (openCount == 0)
+				{
+					TokenList tmp (std::next (openPosition), it);
+					int32_t node;
+					if (!compute (tmp, node))
+						return false;
+					it = tokens.erase (openPosition, std::next (it));
+					it = tokens.insert (it, {Token::kOperand, node});
+				}
+			}
+		}
+		// now multiply and divide
+		auto prevToken = tokens.begin ();
+		for (auto it = tokens.begin (); it != tokens.end (); ++it)
+		{
+			if (prevToken == it)
+				continue;
+			if (it->type == Token::kMultiply || it->type == Token::kDivide)
+			{
+				auto type = it->type == Token::kMultiply ? Op::kMultiply : Op::kDivide;
+				auto next = std::next (it);
+				if (prevToken->type != Token::kOperand || next == tokens.end () ||
+				    next->type != Token::kOperand)
+					return false;
+				auto node = addOperation (type, prevToken->node, next->node);
+				it = tokens.erase (prevToken, std::next (next));
+				it = tokens.insert (it, {Token::kOperand, node});
+			}
+			prevToken = it;
+		}
+		// now add and subtract
+		result = addNumber (0.);
+		int32_t lastType = -1;
+		for (const auto& token : tokens)
+		{
+			if (token.type == Token::kOperand)
+			{
+				if (lastType == -1)
+					result = token.node;
+				else if (lastType == Token::kAdd)
+					result = addOperation (Op::kAdd, result, token.node);
+				else if (lastType == Token::kSubtract)
+					result = addOperation (Op::kSubtract, result, token.node);
+				else
+				{
+				#if DEBUG
+					DebugPrint ("Wrong Expression: %d\n", token.type);
+				#endif
+					return false;
+				}
+			}
+			else if (!(lastType == -1 || lastType == Token::kOperand))
+			{
+			#if DEBUG
+				DebugPrint ("Wrong Expression: %d\n", token.type);
+			#endif
+				return false;
+			}
+			lastType = token.type;
+		}
+		return true;
+	}
+
+	void emit (int32_t index, Expression& expression, size_t& depth)
+	{
+		const auto& node = nodes[static_cast<size_t> (index)];
+		if (node.left == -1)
+		{
+			expression.ops.push_back (node.op);
+			expression.maxStackDepth = std::max (expression.maxStackDepth, ++depth);
+			return;
+		}
+		emit (node.left, expression, depth);
+		emit (node.right, expression, depth);
+		expression.ops.push_back (node.op);
+		--depth;
+	}
+};
+
+//-----------------------------------------------------------------------------
+std::unique_ptr<Expression> Expression::compile (const std::string& str)
+{
+	std::unique_ptr<Expression> expression (new Expression);
+	Compiler compiler;
+	if (!compiler.run (str, *expression))
+		return nullptr;
+	return expression;
+}
+
+//-----------------------------------------------------------------------------
+/** the compiled expression of a variable or control tag node and its last value
+ *
+ *	The value stays valid until one of the control tags in tagDependencies changes. Variables can't
+ *	be changed after parsing, so the tags used by referenced variables are included as well.
+ */
+struct ExpressionCache
+{
+	std::unique_ptr<Expression> expression;
+	bool compiled {false};
+	bool valid {false};
+	bool evaluating {false};
+	double value {0.};
+	std::vector<std::string> tagDependencies;
+
+	const Expression* getExpression (const std::string& str)
+	{
+		if (!compiled)
+		{
+			expression = Expression::compile (str);
+			compiled = true;
+		}
+		return expression.get ();
+	}
+
+	void addTagDependency (const std::string& name)
+	{
+		if (std::find (tagDependencies.begin (), tagDependencies.end (), name) == tagDependencies.end ())
+			tagDependencies.push_back (name);
+	}
+
+	bool dependsOnTag (const std::string& name) const
+	{
+		return std::find (tagDependencies.begin (), tagDependencies.end (), name) != tagDependencies.end ();
+	}
+
+	void invalidate ()
+	{
+		valid = false;
+		tagDependencies.clear ();
+	}
+
+	void reset ()
+	{
+		invalidate ();
+		expression = nullptr;
+		compiled = false;
+	}
+};
+
+} // UIDescriptionPrivate
+
 //-----------------------------------------------------------------------------
 class UIVariableNode : public UINode
 {
 public:
+	static constexpr Kind kKind = Kind::Variable;
+
 	UIVariableNode (const std::string& name, const SharedPointer<UIAttributes>& attributes);
 	
 	enum Type {
@@ -164,32 +675,81 @@ public:
 	double getNumber () const;
 	const std::string& getString () const;
 
+	UIDescriptionPrivate::ExpressionCache& getExpressionCache () { return expressionCache; }
+
 protected:
 	Type type;
 	double number;
+	UIDescriptionPrivate::ExpressionCache expressionCache;
 };
 
 //-----------------------------------------------------------------------------
 class UIControlTagNode : public UINode
 {
 public:
+	static constexpr Kind kKind = Kind::ControlTag;
+
 	UIControlTagNode (const std::string& name, const SharedPointer<UIAttributes>& attributes);
 	int32_t getTag ();
 	void setTag (int32_t newTag);
 	
 	const std::string* getTagString () const;
 	void setTagString (const std::string& str);
+
+	UIDescriptionPrivate::ExpressionCache& getExpressionCache () { return expressionCache; }
 	
 protected:
 	int32_t tag;
+	UIDescriptionPrivate::ExpressionCache expressionCache;
+};
+
+//-----------------------------------------------------------------------------
+/** decodes the platform bitmap of a bitmap node, either on a prefetch thread or on the thread
+ *	which needs the bitmap first
+ */
+struct UIBitmapDecodeJob
+{
+	std::string path;
+	std::string absolutePath;
+	std::string imageData;
+	bool imageDataIsBase64 {true};
+	double scaleFactor {0.};
+
+	/** decode the bitmap if no other thread has started decoding it yet */
+	bool run ();
+	/** wait until the bitmap is decoded, decodes it on the calling thread if it was not started yet */
+	const SharedPointer<IPlatformBitmap>& wait (double& waitTime, bool& decodedOnOtherThread);
+	double getDecodeTime () const { return decodeTime; }
+
+private:
+	enum State
+	{
+		kPending,
+		kRunning,
+		kDone
+	};
+
+	SharedPointer<IPlatformBitmap> decode () const;
+
+	std::atomic<State> state {kPending};
+	std::mutex mutex;
+	std::condition_variable condition;
+	SharedPointer<IPlatformBitmap> platformBitmap;
+	double decodeTime {0.};
 };
 
 //-----------------------------------------------------------------------------
 class UIBitmapNode : public UINode
 {
 public:
+	static constexpr Kind kKind = Kind::Bitmap;
+
 	UIBitmapNode (const std::string& name, const SharedPointer<UIAttributes>& attributes);
 	CBitmap* getBitmap (const std::string& pathHint);
+	/** schedule decoding, returns nullptr if the bitmap is already decoded or scheduled */
+	std::shared_ptr<UIBitmapDecodeJob> prefetch (const std::string& pathHint);
+	/** returns false if the bitmap was not decoded yet */
+	bool getDecodeInfo (UIDescription::BitmapDecodeInfo& info) const;
 	void setBitmap (UTF8StringPtr bitmapName);
 	void setNinePartTiledOffset (const CRect* offsets);
 	void invalidBitmap ();
@@ -204,19 +764,27 @@ public:
 	void freePlatformResources () override;
 protected:
 	~UIBitmapNode () noexcept override;
-	CBitmap* createBitmap (const std::string& str, CNinePartTiledDescription* partDesc) const;
+	CBitmap* createBitmap (const std::string& str, CNinePartTiledDescription* partDesc,
+	                       const SharedPointer<IPlatformBitmap>& platformBitmap) const;
 	SharedPointer<IPlatformBitmap> createBitmapFromDataNode () const;
+	std::shared_ptr<UIBitmapDecodeJob> createDecodeJob (const std::string& pathHint) const;
 	static bool imagesEqual (IPlatformBitmap* b1, IPlatformBitmap* b2);
 	UINode* dataNode () const;
+	const std::string* dataNodeImage (bool& base64) const;
 	CBitmap* bitmap;
 	bool filterProcessed;
 	bool scaledBitmapsAdded;
+	std::shared_ptr<UIBitmapDecodeJob> decodeJob;
+	UIDescription::BitmapDecodeInfo decodeInfo;
+	bool decoded {false};
 };
 
 //-----------------------------------------------------------------------------
 class UIFontNode : public UINode
 {
 public:
+	static constexpr Kind kKind = Kind::Font;
+
 	UIFontNode (const std::string& name, const SharedPointer<UIAttributes>& attributes);
 	CFontRef getFont ();
 	void setFont (CFontRef newFont);
@@ -233,6 +801,8 @@ protected:
 class UIColorNode : public UINode
 {
 public:
+	static constexpr Kind kKind = Kind::Color;
+
 	UIColorNode (const std::string& name, const SharedPointer<UIAttributes>& attributes);
 	const CColor& getColor () const { return color; }
 	void setColor (const CColor& newColor);
@@ -244,6 +814,8 @@ protected:
 class UIGradientNode : public UINode
 {
 public:
+	static constexpr Kind kKind = Kind::Gradient;
+
 	UIGradientNode (const std::string& name, const SharedPointer<UIAttributes>& attributes);
 	CGradient* getGradient ();
 	void setGradient (CGradient* g);
@@ -258,25 +830,26 @@ protected:
 class UIDescListWithFastFindAttributeNameChild : public UIDescList
 {
 private:
-	using ChildMap = std::unordered_map<std::string, UINode*>;
+	/** ordered with a transparent comparator, so that lookups don't need a temporary std::string */
+	using ChildMap = std::map<std::string, UINode*, std::less<>>;
 public:
 	UIDescListWithFastFindAttributeNameChild () {}
 	
 	void add (UINode* obj) override
 	{
 		UIDescList::add (obj);
-		const std::string* nameAttributeValue = obj->getAttributes ()->getAttributeValue ("name");
+		const std::string* nameAttributeValue = obj->getAttributes ()->getAttributeValue (kNameAttribute);
 		if (nameAttributeValue)
 			childMap.emplace (*nameAttributeValue, obj);
 	}
 
 	void remove (UINode* obj) override
 	{
-		const std::string* nameAttributeValue = obj->getAttributes ()->getAttributeValue ("name");
+		const std::string* nameAttributeValue = obj->getAttributes ()->getAttributeValue (kNameAttribute);
 		if (nameAttributeValue)
 		{
 			ChildMap::iterator it = childMap.find (*nameAttributeValue);
-			if (it != childMap.end ())
+			if (it != childMap.end () && it->second == obj)
 				childMap.erase (it);
 		}
 		UIDescList::remove (obj);
@@ -290,9 +863,14 @@ public:
 
 	UINode* findChildNodeWithAttributeValue (const std::string& attributeName, const std::string& attributeValue) const override
 	{
-		if (attributeName != "name")
+		if (attributeName != kNameAttribute)
 			return UIDescList::findChildNodeWithAttributeValue (attributeName, attributeValue);
-		ChildMap::const_iterator it = childMap.find (attributeValue);
+		return findChildNodeByNameAttribute (attributeValue.c_str ());
+	}
+
+	UINode* findChildNodeByNameAttribute (UTF8StringPtr name) const override
+	{
+		ChildMap::const_iterator it = childMap.find (name);
 		if (it != childMap.end ())
 			return it->second;
 		return nullptr;
@@ -300,12 +878,12 @@ public:
 
 	void nodeAttributeChanged (UINode* node, const std::string& attributeName, const std::string& oldAttributeValue) override
 	{
-		if (attributeName != "name")
+		if (attributeName != kNameAttribute)
 			return;
 		ChildMap::iterator it = childMap.find (oldAttributeValue);
-		if (it != childMap.end ())
+		if (it != childMap.end () && it->second == node)
 			childMap.erase (it);
-		const std::string* nameAttributeValue = node->getAttributes ()->getAttributeValue ("name");
+		const std::string* nameAttributeValue = node->getAttributes ()->getAttributeValue (kNameAttribute);
 		if (nameAttributeValue)
 			childMap.emplace (*nameAttributeValue, node);
 	}
@@ -385,6 +963,18 @@ UINode* UIDescList::findChildNodeWithAttributeValue (const std::string& attribut
 	return nullptr;
 }
 
+//-----------------------------------------------------------------------------
+UINode* UIDescList::findChildNodeByNameAttribute (UTF8StringPtr name) const
+{
+	for (const auto& node : *this)
+	{
+		const std::string* nameAttributeValue = node->getAttributes ()->getAttributeValue (kNameAttribute);
+		if (nameAttributeValue && *nameAttributeValue == name)
+			return node;
+	}
+	return nullptr;
+}
+
 //-----------------------------------------------------------------------------
 void UIDescList::sort ()
 {
@@ -409,7 +999,8 @@ protected:
 
 	bool writeNode (UINode* node, OutputStream& stream);
 	bool writeComment (UICommentNode* node, OutputStream& stream);
-	bool writeNodeData (UINode::DataStorage& str, OutputStream& stream);
+	bool writeNodeData (const UINode* node, OutputStream& stream);
+	bool writeNodeData (const UINode::DataStorage& str, OutputStream& stream);
 	bool writeAttributes (UIAttributes* attr, OutputStream& stream);
 	int32_t intendLevel;
 };
@@ -463,7 +1054,18 @@ bool UIDescWriter::writeAttributes (UIAttributes* attr, OutputStream& stream)
 }
 
 //-----------------------------------------------------------------------------
-bool UIDescWriter::writeNodeData (UINode::DataStorage& str, OutputStream& stream)
+bool UIDescWriter::writeNodeData (const UINode* node, OutputStream& stream)
+{
+	if (!node->binaryData ())
+		return writeNodeData (node->getData (), stream);
+	auto encoded = Base64Codec::encode (node->getData ().data (), node->getData ().size ());
+	return writeNodeData (
+	    UINode::DataStorage (reinterpret_cast<const char*> (encoded.data.get ()), encoded.dataSize),
+	    stream);
+}
+
+//-----------------------------------------------------------------------------
+bool UIDescWriter::writeNodeData (const UINode::DataStorage& str, OutputStream& stream)
 {
 	for (int32_t i = 0; i < intendLevel; i++) stream << "\t";
 	uint32_t i = 0;
@@ -497,7 +1099,7 @@ bool UIDescWriter::writeNode (UINode* node, OutputStream& stream)
 	if (node->noExport ())
 		return result;
 	for (int32_t i = 0; i < intendLevel; i++) stream << "\t";
-	if (UICommentNode* commentNode = dynamic_cast<UICommentNode*> (node))
+	if (UICommentNode* commentNode = nodeCast<UICommentNode> (node))
 	{
 		return writeComment (commentNode, stream);
 	}
@@ -512,7 +1114,7 @@ bool UIDescWriter::writeNode (UINode* node, OutputStream& stream)
 			stream << ">\n";
 			intendLevel++;
 			if (!node->getData ().empty ())
-				result = writeNodeData (node->getData (), stream);
+				result = writeNodeData (node, stream);
 			for (auto& childNode : children)
 			{
 				if (!writeNode (childNode, stream))
@@ -528,7 +1130,7 @@ bool UIDescWriter::writeNode (UINode* node, OutputStream& stream)
 		{
 			stream << ">\n";
 			intendLevel++;
-			result = writeNodeData (node->getData (), stream);
+			result = writeNodeData (node, stream);
 			intendLevel--;
 			for (int32_t i = 0; i < intendLevel; i++) stream << "\t";
 			stream << "</";
@@ -588,6 +1190,28 @@ static UIViewFactory* getGenericViewFactory ()
 
 namespace UIDescriptionPrivate {
 
+//-----------------------------------------------------------------------------
+/** appends everything written to it to the data of a node */
+class NodeDataOutputStream : public OutputStream
+{
+public:
+	explicit NodeDataOutputStream (UINode::DataStorage& data) : data (data) {}
+
+	bool operator<< (const std::string& str) override
+	{
+		data.append (str);
+		return true;
+	}
+	uint32_t writeRaw (const void* buffer, uint32_t size) override
+	{
+		data.append (reinterpret_cast<const char*> (buffer), size);
+		return size;
+	}
+
+private:
+	UINode::DataStorage& data;
+};
+
 //-----------------------------------------------------------------------------
 template <bool nameHasExtension, size_t numIndicators>
 std::pair<size_t, size_t> rangeOfScaleFactor (const std::string& name,
@@ -681,21 +1305,253 @@ struct UIDescription::Impl
 	
 	bool restoreViewsMode {false};
 
-	Optional<UINode*> variableBaseNode;
+	/** the unique main nodes of the root node they were looked up in, including the ones which
+	 *	don't exist. Holding the root prevents that a new root node at the same address uses the
+	 *	cached nodes.
+	 */
+	struct UniqueNodeCache
+	{
+		SharedPointer<UINode> root;
+		std::array<Optional<UINode*>, MainNodeNames::kNumUniqueNodes> nodes;
+	};
+	UniqueNodeCache uniqueNodeCache;
+
+	/** runs bitmap decode jobs on up to kMaxThreads background threads, the threads exit when
+	 *	there are no more jobs
+	 */
+	struct BitmapPrefetcher
+	{
+		static constexpr uint32_t kMaxThreads = 4;
+
+		std::mutex mutex;
+		std::deque<std::shared_ptr<UIBitmapDecodeJob>> jobs;
+		std::vector<std::thread> threads;
+		uint32_t numRunningThreads {0};
+
+		~BitmapPrefetcher () noexcept
+		{
+			{
+				std::lock_guard<std::mutex> guard (mutex);
+				jobs.clear ();
+			}
+			for (auto& thread : threads)
+				thread.join ();
+		}
+
+		void add (std::vector<std::shared_ptr<UIBitmapDecodeJob>>&& newJobs)
+		{
+			if (newJobs.empty ())
+				return;
+			std::lock_guard<std::mutex> guard (mutex);
+			if (numRunningThreads == 0)
+			{
+				for (auto& thread : threads)
+					thread.join ();
+				threads.clear ();
+			}
+			for (auto& job : newJobs)
+				jobs.emplace_back (std::move (job));
+			auto maxThreads = std::max<uint32_t> (1, std::min<uint32_t> (std::thread::hardware_concurrency (), kMaxThreads));
+			while (numRunningThreads < maxThreads && numRunningThreads < jobs.size ())
+			{
+				threads.emplace_back ([this] () { work (); });
+				++numRunningThreads;
+			}
+		}
 
-	UINode* getVariableBaseNode ()
+		void work ()
+		{
+			while (true)
+			{
+				std::shared_ptr<UIBitmapDecodeJob> job;
+				{
+					std::lock_guard<std::mutex> guard (mutex);
+					if (jobs.empty ())
+					{
+						--numRunningThreads;
+						return;
+					}
+					job = std::move (jobs.front ());
+					jobs.pop_front ();
+				}
+				job->run ();
+			}
+		}
+	};
+	BitmapPrefetcher bitmapPrefetcher;
+
+	void resetUniqueNodeCache ()
 	{
-		if (!variableBaseNode)
+		uniqueNodeCache.root = nullptr;
+		for (auto& node : uniqueNodeCache.nodes)
+			node.reset ();
+	}
+
+	UINode* findUniqueNode (size_t index, bool create)
+	{
+		if (!nodes)
+			return nullptr;
+		if (uniqueNodeCache.root != nodes)
+		{
+			resetUniqueNodeCache ();
+			uniqueNodeCache.root = nodes;
+		}
+		auto& cachedNode = uniqueNodeCache.nodes[index];
+		if (!cachedNode)
 		{
-			if (nodes)
-				variableBaseNode = nodes->getChildren ().findChildNode (MainNodeNames::kVariable);
+			cachedNode = Optional<UINode*> (
+			    nodes->getChildren ().findChildNode (MainNodeNames::kUniqueNodes[index]));
+		}
+		if (*cachedNode == nullptr && create)
+		{
+			*cachedNode = new UINode (MainNodeNames::kUniqueNodes[index], {}, true);
+			nodes->getChildren ().add (*cachedNode);
+		}
+		return *cachedNode;
+	}
+
+	UINode* getVariablesNode ()
+	{
+		return findUniqueNode (MainNodeNames::indexOfUniqueNode (MainNodeNames::kVariable), false);
+	}
+
+	UINode* getControlTagsNode ()
+	{
+		return findUniqueNode (MainNodeNames::indexOfUniqueNode (MainNodeNames::kControlTag), false);
+	}
+
+	/** evaluates a compiled expression, the control tags it uses are added to dependencies */
+	bool evaluate (const UIDescription* desc, const UIDescriptionPrivate::Expression& expression,
+	               double& value, UIDescriptionPrivate::ExpressionCache* dependencies)
+	{
+		auto resolveVariable = [&] (const std::string& name, double& result) {
+			auto node = nodeCast<UIVariableNode> (
+			    desc->findChildNodeByNameAttribute (getVariablesNode (), name.data ()));
+			if (node && node->getType () == UIVariableNode::kNumber)
+			{
+				result = node->getNumber ();
+				return true;
+			}
+			if (node && node->getType () == UIVariableNode::kString &&
+			    evaluate (desc, node->getString (), node->getExpressionCache (), result, dependencies))
+				return true;
+		#if DEBUG
+			DebugPrint ("Variable not found :var.%s\n", name.data ());
+		#endif
+			return false;
+		};
+		auto resolveTag = [&] (const std::string& name, double& result) {
+			if (dependencies)
+				dependencies->addTagDependency (name);
+			auto tag = desc->getTagForName (name.data ());
+			if (tag == -1)
+			{
+			#if DEBUG
+				DebugPrint ("Tag not found :tag.%s\n", name.data ());
+			#endif
+				return false;
+			}
+			result = tag;
+			return true;
+		};
+		return expression.evaluate (value, resolveVariable, resolveTag);
+	}
+
+	/** evaluates the expression of a variable or control tag node, compiles it on first use and
+	 *	returns the cached value until a control tag it depends on changes
+	 */
+	bool evaluate (const UIDescription* desc, const std::string& str,
+	               UIDescriptionPrivate::ExpressionCache& cache, double& value,
+	               UIDescriptionPrivate::ExpressionCache* dependencies = nullptr)
+	{
+		if (!cache.valid)
+		{
+			if (cache.evaluating)
+			{
+			#if DEBUG
+				DebugPrint ("Cyclic Expression :%s\n", str.data ());
+			#endif
+				return false;
+			}
+			auto expression = cache.getExpression (str);
+			if (!expression)
+				return false;
+			cache.tagDependencies.clear ();
+			cache.evaluating = true;
+			cache.valid = evaluate (desc, *expression, cache.value, &cache);
+			cache.evaluating = false;
+			if (!cache.valid)
+			{
+				cache.invalidate ();
+				return false;
+			}
+		}
+		value = cache.value;
+		if (dependencies)
+		{
+			for (const auto& name : cache.tagDependencies)
+				dependencies->addTagDependency (name);
+		}
+		return true;
+	}
+
+	/** invalidates the cached values of the expressions which depend on the control tag, or on any
+	 *	control tag if tagName is nullptr
+	 */
+	void invalidateExpressions (UTF8StringPtr tagName)
+	{
+		std::vector<std::string> changedTags;
+		if (tagName)
+			changedTags.emplace_back (tagName);
+		auto isAffected = [&] (const UIDescriptionPrivate::ExpressionCache& cache) {
+			if (!cache.valid || cache.tagDependencies.empty ())
+				return false;
+			if (tagName == nullptr)
+				return true;
+			for (const auto& name : changedTags)
+			{
+				if (cache.dependsOnTag (name))
+					return true;
+			}
+			return false;
+		};
+		if (auto tagsNode = getControlTagsNode ())
+		{
+			// a control tag computed from the changed tag changes, too
+			bool changed = true;
+			while (changed)
+			{
+				changed = false;
+				for (auto node : tagsNode->getChildren ())
+				{
+					auto tagNode = nodeCast<UIControlTagNode> (node);
+					if (!tagNode || !isAffected (tagNode->getExpressionCache ()))
+						continue;
+					tagNode->getExpressionCache ().invalidate ();
+					tagNode->setTag (-1);
+					if (auto name = tagNode->getAttributes ()->getAttributeValue (kNameAttribute))
+						changedTags.emplace_back (*name);
+					changed = true;
+				}
+			}
+		}
+		if (auto variablesNode = getVariablesNode ())
+		{
+			for (auto node : variablesNode->getChildren ())
+			{
+				auto variableNode = nodeCast<UIVariableNode> (node);
+				if (variableNode && isAffected (variableNode->getExpressionCache ()))
+					variableNode->getExpressionCache ().invalidate ();
+			}
 		}
-		return *variableBaseNode;
 	}
 
 	DispatchList<UIDescriptionListener*> listeners;
 };
 
+//-----------------------------------------------------------------------------
+constexpr uint32_t UIDescription::Impl::BitmapPrefetcher::kMaxThreads;
+
 //-----------------------------------------------------------------------------
 UIDescription::UIDescription (const CResourceDescription& xmlFile, IViewFactory* _viewFactory)
 {
@@ -844,11 +1700,32 @@ bool UIDescription::parse ()
 	}
 	else
 	{
+		auto parseResourceStream = [&] (CResourceInputStream& stream) {
+			// parse memory mapped files in place
+			size_t size;
+			auto data = stream.getMappedData (size);
+			if (data && size <= std::numeric_limits<uint32_t>::max ())
+			{
+				Xml::MemoryContentProvider contentProvider (data, static_cast<uint32_t> (size));
+				return parser.parse (&contentProvider, this);
+			}
+			Xml::InputStreamContentProvider contentProvider (stream);
+			return parser.parse (&contentProvider, this);
+		};
 		CResourceInputStream resInputStream;
+		CMappedFileInputStream mappedFileStream;
 		if (resInputStream.open (impl->xmlFile))
 		{
-			Xml::InputStreamContentProvider contentProvider (resInputStream);
-			if (parser.parse (&contentProvider, this))
+			if (parseResourceStream (resInputStream))
+			{
+				addDefaultNodes ();
+				return true;
+			}
+		}
+		else if (impl->xmlFile.type == CResourceDescription::kStringType &&
+		         mappedFileStream.open (impl->xmlFile.u.name))
+		{
+			if (parseResourceStream (mappedFileStream))
 			{
 				addDefaultNodes ();
 				return true;
@@ -870,7 +1747,7 @@ bool UIDescription::parse ()
 	}
 	if (!impl->nodes)
 	{
-		impl->nodes = makeOwned<UINode> ("vstgui-ui-description");
+		impl->nodes = makeOwned<UINode> ("vstgui-ui-description", nullptr, true);
 		addDefaultNodes ();
 	}
 	return false;
@@ -879,6 +1756,8 @@ bool UIDescription::parse ()
 //-----------------------------------------------------------------------------
 void UIDescription::setController (IController* inController) const
 {
+	if (impl->controller != inController)
+		impl->invalidateExpressions (nullptr);
 	impl->controller = inController;
 }
 
@@ -922,6 +1801,50 @@ static void FreeNodePlatformResources (UINode* node)
 	}
 }
 
+//-----------------------------------------------------------------------------
+void UIDescription::prefetchBitmaps (const std::vector<std::string>& names)
+{
+	UINode* bitmapNodes = getBaseNode (MainNodeNames::kBitmap);
+	if (bitmapNodes == nullptr)
+		return;
+	std::vector<std::shared_ptr<UIBitmapDecodeJob>> jobs;
+	auto addJob = [&] (UINode* node) {
+		if (auto bitmapNode = nodeCast<UIBitmapNode> (node))
+		{
+			if (auto job = bitmapNode->prefetch (impl->filePath))
+				jobs.emplace_back (std::move (job));
+		}
+	};
+	if (names.empty ())
+	{
+		for (auto& childNode : bitmapNodes->getChildren ())
+			addJob (childNode);
+	}
+	else
+	{
+		for (auto& name : names)
+			addJob (findResourceNode<UIBitmapNode> (MainNodeNames::kBitmap, name.data ()));
+	}
+	impl->bitmapPrefetcher.add (std::move (jobs));
+}
+
+//-----------------------------------------------------------------------------
+auto UIDescription::getBitmapDecodeInfos () const -> std::vector<BitmapDecodeInfo>
+{
+	std::vector<BitmapDecodeInfo> result;
+	if (UINode* bitmapNodes = getBaseNode (MainNodeNames::kBitmap))
+	{
+		for (auto& childNode : bitmapNodes->getChildren ())
+		{
+			BitmapDecodeInfo info;
+			auto bitmapNode = nodeCast<UIBitmapNode> (childNode);
+			if (bitmapNode && bitmapNode->getDecodeInfo (info))
+				result.emplace_back (std::move (info));
+		}
+	}
+	return result;
+}
+
 //-----------------------------------------------------------------------------
 void UIDescription::freePlatformResources ()
 {
@@ -1017,7 +1940,7 @@ bool UIDescription::saveToStream (OutputStream& stream, int32_t flags)
 		{
 			for (auto& childNode : bitmapNodes->getChildren ())
 			{
-				UIBitmapNode* bitmapNode = dynamic_cast<UIBitmapNode*> (childNode);
+				UIBitmapNode* bitmapNode = nodeCast<UIBitmapNode> (childNode);
 				if (bitmapNode)
 				{
 					if (flags & kWriteImagesIntoXMLFile)
@@ -1311,22 +2234,12 @@ CViewAttributeID UIDescription::kTemplateNameAttributeID = 'uitl';
 CView* UIDescription::createView (UTF8StringPtr name, IController* _controller) const
 {
 	ScopePointer<IController> sp (&impl->controller, _controller);
-	if (impl->nodes)
+	if (UINode* templateNode = findTemplateNode (name))
 	{
-		for (const auto& itNode : impl->nodes->getChildren ())
-		{
-			if (itNode->getName () == MainNodeNames::kTemplate)
-			{
-				const std::string* nodeName = itNode->getAttributes ()->getAttributeValue ("name");
-				if (nodeName && *nodeName == name)
-				{
-					CView* view = createViewFromNode (itNode);
-					if (view)
-						view->setAttribute (kTemplateNameAttributeID, static_cast<uint32_t> (strlen (name) + 1), name);
-					return view;
-				}
-			}
-		}
+		CView* view = createViewFromNode (templateNode);
+		if (view)
+			view->setAttribute (kTemplateNameAttributeID, static_cast<uint32_t> (strlen (name) + 1), name);
+		return view;
 	}
 	return nullptr;
 }
@@ -1352,36 +2265,22 @@ bool UIDescription::getTemplateNameFromView (CView* view, std::string& templateN
 //-----------------------------------------------------------------------------
 const UIAttributes* UIDescription::getViewAttributes (UTF8StringPtr name) const
 {
-	if (impl->nodes)
-	{
-		for (const auto& itNode : impl->nodes->getChildren ())
-		{
-			if (itNode->getName () == MainNodeNames::kTemplate)
-			{
-				const std::string* nodeName = itNode->getAttributes ()->getAttributeValue ("name");
-				if (nodeName && *nodeName == name)
-					return itNode->getAttributes ();
-			}
-		}
-	}
+	if (UINode* templateNode = findTemplateNode (name))
+		return templateNode->getAttributes ();
 	return nullptr;
 }
 
 //-----------------------------------------------------------------------------
 UINode* UIDescription::getBaseNode (UTF8StringPtr name) const
 {
-	UTF8StringView nameView (name);
-	nameView.calculateByteCount ();
-	if (impl->sharedResources)
-	{
-		if (nameView == MainNodeNames::kBitmap || nameView == MainNodeNames::kFont || nameView == MainNodeNames::kColor || nameView == MainNodeNames::kGradient)
-		{
-			return impl->sharedResources->getBaseNode (name);
-		}
-	}
+	auto uniqueNodeIndex = MainNodeNames::indexOfUniqueNode (name);
+	if (impl->sharedResources && MainNodeNames::isSharedResource (uniqueNodeIndex))
+		return impl->sharedResources->getBaseNode (name);
+	if (uniqueNodeIndex < MainNodeNames::kNumUniqueNodes)
+		return impl->findUniqueNode (uniqueNodeIndex, true);
 	if (impl->nodes)
 	{
-		UINode* node = impl->nodes->getChildren ().findChildNode (nameView);
+		UINode* node = impl->nodes->getChildren ().findChildNode (name);
 		if (node)
 			return node;
 
@@ -1396,7 +2295,34 @@ UINode* UIDescription::getBaseNode (UTF8StringPtr name) const
 UINode* UIDescription::findChildNodeByNameAttribute (UINode* node, UTF8StringPtr nameAttribute) const
 {
 	if (node)
-		return node->getChildren ().findChildNodeWithAttributeValue ("name", nameAttribute);
+		return node->getChildren ().findChildNodeByNameAttribute (nameAttribute);
+	return nullptr;
+}
+
+//-----------------------------------------------------------------------------
+template<typename NodeType>
+NodeType* UIDescription::findResourceNode (IdStringPtr mainNodeName, UTF8StringPtr name) const
+{
+	return nodeCast<NodeType> (findChildNodeByNameAttribute (getBaseNode (mainNodeName), name));
+}
+
+//-----------------------------------------------------------------------------
+UINode* UIDescription::findTemplateNode (UTF8StringPtr name) const
+{
+	auto node = findChildNodeByNameAttribute (impl->nodes, name);
+	if (node == nullptr)
+		return nullptr;
+	if (node->getName () == MainNodeNames::kTemplate)
+		return node;
+	// the name index only knows the first top level node with the name, which is no template here
+	for (const auto& child : impl->nodes->getChildren ())
+	{
+		if (child->getName () != MainNodeNames::kTemplate)
+			continue;
+		auto nameAttribute = child->getAttributes ()->getAttributeValue (kNameAttribute);
+		if (nameAttribute && *nameAttribute == name)
+			return child;
+	}
 	return nullptr;
 }
 
@@ -1404,7 +2330,7 @@ UINode* UIDescription::findChildNodeByNameAttribute (UINode* node, UTF8StringPtr
 int32_t UIDescription::getTagForName (UTF8StringPtr name) const
 {
 	int32_t tag = -1;
-	UIControlTagNode* controlTagNode = dynamic_cast<UIControlTagNode*> (findChildNodeByNameAttribute (getBaseNode (MainNodeNames::kControlTag), name));
+	UIControlTagNode* controlTagNode = findResourceNode<UIControlTagNode> (MainNodeNames::kControlTag, name);
 	if (controlTagNode)
 	{
 		tag = controlTagNode->getTag ();
@@ -1414,7 +2340,7 @@ int32_t UIDescription::getTagForName (UTF8StringPtr name) const
 			if (tagStr)
 			{
 				double value;
-				if (calculateStringValue (tagStr->c_str (), value))
+				if (impl->evaluate (this, *tagStr, controlTagNode->getExpressionCache (), value))
 				{
 					tag = (int32_t)value;
 					controlTagNode->setTag (tag);
@@ -1430,35 +2356,35 @@ int32_t UIDescription::getTagForName (UTF8StringPtr name) const
 //-----------------------------------------------------------------------------
 bool UIDescription::hasColorName (UTF8StringPtr name) const
 {
-	UIColorNode* node = dynamic_cast<UIColorNode*> (findChildNodeByNameAttribute (getBaseNode (MainNodeNames::kColor), name));
+	UIColorNode* node = findResourceNode<UIColorNode> (MainNodeNames::kColor, name);
 	return node ? true : false;
 }
 
 //-----------------------------------------------------------------------------
 bool UIDescription::hasTagName (UTF8StringPtr name) const
 {
-	UIControlTagNode* node = dynamic_cast<UIControlTagNode*> (findChildNodeByNameAttribute (getBaseNode (MainNodeNames::kControlTag), name));
+	UIControlTagNode* node = findResourceNode<UIControlTagNode> (MainNodeNames::kControlTag, name);
 	return node ? true : false;
 }
 
 //-----------------------------------------------------------------------------
 bool UIDescription::hasFontName (UTF8StringPtr name) const
 {
-	UIFontNode* node = dynamic_cast<UIFontNode*> (findChildNodeByNameAttribute (getBaseNode (MainNodeNames::kFont), name));
+	UIFontNode* node = findResourceNode<UIFontNode> (MainNodeNames::kFont, name);
 	return node ? true : false;
 }
 
 //-----------------------------------------------------------------------------
 bool UIDescription::hasBitmapName (UTF8StringPtr name) const
 {
-	UIBitmapNode* node = dynamic_cast<UIBitmapNode*> (findChildNodeByNameAttribute (getBaseNode (MainNodeNames::kBitmap), name));
+	UIBitmapNode* node = findResourceNode<UIBitmapNode> (MainNodeNames::kBitmap, name);
 	return node ? true : false;
 }
 
 //-----------------------------------------------------------------------------
 bool UIDescription::hasGradientName (UTF8StringPtr name) const
 {
-	UIGradientNode* node = dynamic_cast<UIGradientNode*> (findChildNodeByNameAttribute (getBaseNode (MainNodeNames::kGradient), name));
+	UIGradientNode* node = findResourceNode<UIGradientNode> (MainNodeNames::kGradient, name);
 	return node ? true : false;
 }
 
@@ -1473,7 +2399,7 @@ IControlListener* UIDescription::getControlListener (UTF8StringPtr name) const
 //-----------------------------------------------------------------------------
 CBitmap* UIDescription::getBitmap (UTF8StringPtr name) const
 {
-	UIBitmapNode* bitmapNode = dynamic_cast<UIBitmapNode*> (findChildNodeByNameAttribute (getBaseNode (MainNodeNames::kBitmap), name));
+	UIBitmapNode* bitmapNode = findResourceNode<UIBitmapNode> (MainNodeNames::kBitmap, name);
 	if (bitmapNode)
 	{
 		CBitmap* bitmap = bitmapNode->getBitmap (impl->filePath);
@@ -1584,7 +2510,7 @@ CBitmap* UIDescription::getBitmap (UTF8StringPtr name) const
 				UINode* bitmapsNode = getBaseNode (MainNodeNames::kBitmap);
 				for (auto& it : bitmapsNode->getChildren ())
 				{
-					UIBitmapNode* childNode = dynamic_cast<UIBitmapNode*>(it);
+					UIBitmapNode* childNode = nodeCast<UIBitmapNode> (it);
 					if (childNode == nullptr || childNode == bitmapNode)
 						continue;
 					const std::string* childNodeBitmapName = childNode->getAttributes()->getAttributeValue ("name");
@@ -1610,7 +2536,7 @@ CBitmap* UIDescription::getBitmap (UTF8StringPtr name) const
 //-----------------------------------------------------------------------------
 CFontRef UIDescription::getFont (UTF8StringPtr name) const
 {
-	UIFontNode* fontNode = dynamic_cast<UIFontNode*> (findChildNodeByNameAttribute (getBaseNode (MainNodeNames::kFont), name));
+	UIFontNode* fontNode = findResourceNode<UIFontNode> (MainNodeNames::kFont, name);
 	if (fontNode)
 		return fontNode->getFont ();
 	return nullptr;
@@ -1619,7 +2545,7 @@ CFontRef UIDescription::getFont (UTF8StringPtr name) const
 //-----------------------------------------------------------------------------
 bool UIDescription::getColor (UTF8StringPtr name, CColor& color) const
 {
-	UIColorNode* colorNode = dynamic_cast<UIColorNode*> (findChildNodeByNameAttribute (getBaseNode (MainNodeNames::kColor), name));
+	UIColorNode* colorNode = findResourceNode<UIColorNode> (MainNodeNames::kColor, name);
 	if (colorNode)
 	{
 		color = colorNode->getColor ();
@@ -1633,7 +2559,7 @@ bool UIDescription::getColor (UTF8StringPtr name, CColor& color) const
 //-----------------------------------------------------------------------------
 CGradient* UIDescription::getGradient (UTF8StringPtr name) const
 {
-	UIGradientNode* gradientNode = dynamic_cast<UIGradientNode*> (findChildNodeByNameAttribute (getBaseNode(MainNodeNames::kGradient), name));
+	UIGradientNode* gradientNode = findResourceNode<UIGradientNode> (MainNodeNames::kGradient, name);
 	if (gradientNode)
 		return gradientNode->getGradient ();
 	return nullptr;
@@ -1648,7 +2574,7 @@ template<typename NodeType, typename ObjType, typename CompareFunction> UTF8Stri
 		UIDescList& children = baseNode->getChildren ();
 		for (const auto& itNode : children)
 		{
-			NodeType* node = dynamic_cast<NodeType*>(itNode);
+			NodeType* node = nodeCast<NodeType> (itNode);
 			if (node && compare (this, node, obj))
 			{
 				const std::string* name = node->getAttributes ()->getAttributeValue ("name");
@@ -1699,7 +2625,7 @@ UTF8StringPtr UIDescription::lookupControlTagName (const int32_t tag) const
 		if (nodeTag == -1 && node->getTagString ())
 		{
 			double v;
-			if (desc->calculateStringValue (node->getTagString ()->c_str (), v))
+			if (desc->impl->evaluate (desc, *node->getTagString (), node->getExpressionCache (), v))
 				nodeTag = (int32_t)v;
 		}
 		return nodeTag == tag;
@@ -1711,11 +2637,12 @@ template<typename NodeType>
 void UIDescription::changeNodeName (UTF8StringPtr oldName, UTF8StringPtr newName, IdStringPtr mainNodeName)
 {
 	UINode* mainNode = getBaseNode (mainNodeName);
-	NodeType* node = dynamic_cast<NodeType*> (findChildNodeByNameAttribute(mainNode, oldName));
+	NodeType* node = nodeCast<NodeType> (findChildNodeByNameAttribute(mainNode, oldName));
 	if (node)
 	{
+		std::string oldNameCopy (oldName);
 		node->getAttributes ()->setAttribute ("name", newName);
-		mainNode->childAttributeChanged (node, "name", oldName);
+		mainNode->childAttributeChanged (node, "name", oldNameCopy.data ());
 		mainNode->sortChildren ();
 	}
 }
@@ -1733,6 +2660,8 @@ void UIDescription::changeColorName (UTF8StringPtr oldName, UTF8StringPtr newNam
 void UIDescription::changeTagName (UTF8StringPtr oldName, UTF8StringPtr newName)
 {
 	changeNodeName<UIControlTagNode> (oldName, newName, MainNodeNames::kControlTag);
+	impl->invalidateExpressions (oldName);
+	impl->invalidateExpressions (newName);
 	impl->listeners.forEach ([this] (UIDescriptionListener* l) {
 		l->onUIDescTagChanged (this);
 	});
@@ -1769,7 +2698,7 @@ void UIDescription::changeGradientName (UTF8StringPtr oldName, UTF8StringPtr new
 void UIDescription::changeColor (UTF8StringPtr name, const CColor& newColor)
 {
 	UINode* colorsNode = getBaseNode (MainNodeNames::kColor);
-	UIColorNode* node = dynamic_cast<UIColorNode*> (findChildNodeByNameAttribute (colorsNode, name));
+	UIColorNode* node = nodeCast<UIColorNode> (findChildNodeByNameAttribute (colorsNode, name));
 	if (node)
 	{
 		if (!node->noExport ())
@@ -1803,7 +2732,7 @@ void UIDescription::changeColor (UTF8StringPtr name, const CColor& newColor)
 void UIDescription::changeFont (UTF8StringPtr name, CFontRef newFont)
 {
 	UINode* fontsNode = getBaseNode (MainNodeNames::kFont);
-	UIFontNode* node = dynamic_cast<UIFontNode*> (findChildNodeByNameAttribute (fontsNode, name));
+	UIFontNode* node = nodeCast<UIFontNode> (findChildNodeByNameAttribute (fontsNode, name));
 	if (node)
 	{
 		if (!node->noExport ())
@@ -1835,7 +2764,7 @@ void UIDescription::changeFont (UTF8StringPtr name, CFontRef newFont)
 void UIDescription::changeGradient (UTF8StringPtr name, CGradient* newGradient)
 {
 	UINode* gradientsNode = getBaseNode (MainNodeNames::kGradient);
-	UIGradientNode* node = dynamic_cast<UIGradientNode*> (findChildNodeByNameAttribute (gradientsNode, name));
+	UIGradientNode* node = nodeCast<UIGradientNode> (findChildNodeByNameAttribute (gradientsNode, name));
 	if (node)
 	{
 		if (!node->noExport ())
@@ -1867,7 +2796,7 @@ void UIDescription::changeGradient (UTF8StringPtr name, CGradient* newGradient)
 void UIDescription::changeBitmap (UTF8StringPtr name, UTF8StringPtr newName, const CRect* nineparttiledOffset)
 {
 	UINode* bitmapsNode = getBaseNode (MainNodeNames::kBitmap);
-	UIBitmapNode* node = dynamic_cast<UIBitmapNode*> (findChildNodeByNameAttribute (bitmapsNode, name));
+	UIBitmapNode* node = nodeCast<UIBitmapNode> (findChildNodeByNameAttribute (bitmapsNode, name));
 	if (node)
 	{
 		if (!node->noExport ())
@@ -1901,7 +2830,7 @@ void UIDescription::changeBitmap (UTF8StringPtr name, UTF8StringPtr newName, con
 //-----------------------------------------------------------------------------
 void UIDescription::changeBitmapFilters (UTF8StringPtr bitmapName, const std::list<SharedPointer<UIAttributes> >& filters)
 {
-	UIBitmapNode* bitmapNode = dynamic_cast<UIBitmapNode*> (findChildNodeByNameAttribute (getBaseNode (MainNodeNames::kBitmap), bitmapName));
+	UIBitmapNode* bitmapNode = findResourceNode<UIBitmapNode> (MainNodeNames::kBitmap, bitmapName);
 	if (bitmapNode)
 	{
 		bitmapNode->getChildren().removeAll ();
@@ -1933,7 +2862,7 @@ void UIDescription::changeBitmapFilters (UTF8StringPtr bitmapName, const std::li
 //-----------------------------------------------------------------------------
 void UIDescription::collectBitmapFilters (UTF8StringPtr bitmapName, std::list<SharedPointer<UIAttributes> >& filters) const
 {
-	UIBitmapNode* bitmapNode = dynamic_cast<UIBitmapNode*> (findChildNodeByNameAttribute (getBaseNode (MainNodeNames::kBitmap), bitmapName));
+	UIBitmapNode* bitmapNode = findResourceNode<UIBitmapNode> (MainNodeNames::kBitmap, bitmapName);
 	if (bitmapNode)
 	{
 		for (auto& childNode : bitmapNode->getChildren ())
@@ -2002,6 +2931,7 @@ void UIDescription::removeColor (UTF8StringPtr name)
 void UIDescription::removeTag (UTF8StringPtr name)
 {
 	removeNode (name, MainNodeNames::kControlTag);
+	impl->invalidateExpressions (name);
 	impl->listeners.forEach ([this] (UIDescriptionListener* l) {
 		l->onUIDescTagChanged (this);
 	});
@@ -2037,7 +2967,7 @@ void UIDescription::removeGradient (UTF8StringPtr name)
 //-----------------------------------------------------------------------------
 void UIDescription::changeAlternativeFontNames (UTF8StringPtr name, UTF8StringPtr alternativeFonts)
 {
-	UIFontNode* node = dynamic_cast<UIFontNode*> (findChildNodeByNameAttribute (getBaseNode (MainNodeNames::kFont), name));
+	UIFontNode* node = findResourceNode<UIFontNode> (MainNodeNames::kFont, name);
 	if (node)
 	{
 		node->setAlternativeFontNames (alternativeFonts);
@@ -2050,7 +2980,7 @@ void UIDescription::changeAlternativeFontNames (UTF8StringPtr name, UTF8StringPt
 //-----------------------------------------------------------------------------
 bool UIDescription::getAlternativeFontNames (UTF8StringPtr name, std::string& alternativeFonts) const
 {
-	UIFontNode* node = dynamic_cast<UIFontNode*> (findChildNodeByNameAttribute (getBaseNode (MainNodeNames::kFont), name));
+	UIFontNode* node = findResourceNode<UIFontNode> (MainNodeNames::kFont, name);
 	if (node)
 	{
 		if (node->getAlternativeFontNames (alternativeFonts))
@@ -2084,7 +3014,7 @@ template<typename NodeType> void UIDescription::collectNamesFromNode (IdStringPt
 		UIDescList& children = node->getChildren ();
 		for (const auto& itNode : children)
 		{
-			NodeType* node = dynamic_cast<NodeType*>(itNode);
+			NodeType* node = nodeCast<NodeType> (itNode);
 			if (node)
 			{
 				const std::string* name = node->getAttributes ()->getAttributeValue ("name");
@@ -2240,7 +3170,7 @@ bool UIDescription::addNewTemplate (UTF8StringPtr name, const SharedPointer<UIAt
 {
 #if VSTGUI_LIVE_EDITING
 	vstgui_assert (impl->nodes);
-	UINode* templateNode = findChildNodeByNameAttribute (impl->nodes, name);
+	UINode* templateNode = findTemplateNode (name);
 	if (templateNode == nullptr)
 	{
 		UINode* newNode = new UINode (MainNodeNames::kTemplate, attr);
@@ -2259,7 +3189,7 @@ bool UIDescription::addNewTemplate (UTF8StringPtr name, const SharedPointer<UIAt
 bool UIDescription::removeTemplate (UTF8StringPtr name)
 {
 #if VSTGUI_LIVE_EDITING
-	UINode* templateNode = findChildNodeByNameAttribute (impl->nodes, name);
+	UINode* templateNode = findTemplateNode (name);
 	if (templateNode)
 	{
 		impl->nodes->getChildren ().remove (templateNode);
@@ -2276,10 +3206,12 @@ bool UIDescription::removeTemplate (UTF8StringPtr name)
 bool UIDescription::changeTemplateName (UTF8StringPtr name, UTF8StringPtr newName)
 {
 #if VSTGUI_LIVE_EDITING
-	UINode* templateNode = findChildNodeByNameAttribute (impl->nodes, name);
+	UINode* templateNode = findTemplateNode (name);
 	if (templateNode)
 	{
+		std::string oldName (name);
 		templateNode->getAttributes()->setAttribute ("name", newName);
+		impl->nodes->childAttributeChanged (templateNode, "name", oldName.data ());
 		impl->listeners.forEach ([this] (UIDescriptionListener* l) {
 			l->onUIDescTemplateChanged (this);
 		});
@@ -2293,7 +3225,7 @@ bool UIDescription::changeTemplateName (UTF8StringPtr name, UTF8StringPtr newNam
 bool UIDescription::duplicateTemplate (UTF8StringPtr name, UTF8StringPtr duplicateName)
 {
 #if VSTGUI_LIVE_EDITING
-	UINode* templateNode = findChildNodeByNameAttribute (impl->nodes, name);
+	UINode* templateNode = findTemplateNode (name);
 	if (templateNode)
 	{
 		UINode* duplicate = new UINode (*templateNode);
@@ -2377,7 +3309,7 @@ void UIDescription::setFocusDrawingSettings (const FocusDrawing& fd)
 //-----------------------------------------------------------------------------
 bool UIDescription::getControlTagString (UTF8StringPtr tagName, std::string& tagString) const
 {
-	UIControlTagNode* controlTagNode = dynamic_cast<UIControlTagNode*> (findChildNodeByNameAttribute (getBaseNode (MainNodeNames::kControlTag), tagName));
+	UIControlTagNode* controlTagNode = findResourceNode<UIControlTagNode> (MainNodeNames::kControlTag, tagName);
 	if (controlTagNode)
 	{
 		const std::string* tagStr = controlTagNode->getTagString ();
@@ -2394,12 +3326,13 @@ bool UIDescription::getControlTagString (UTF8StringPtr tagName, std::string& tag
 bool UIDescription::changeControlTagString  (UTF8StringPtr tagName, const std::string& newTagString, bool create)
 {
 	UINode* tagsNode = getBaseNode (MainNodeNames::kControlTag);
-	UIControlTagNode* controlTagNode = dynamic_cast<UIControlTagNode*> (findChildNodeByNameAttribute (tagsNode, tagName));
+	UIControlTagNode* controlTagNode = nodeCast<UIControlTagNode> (findChildNodeByNameAttribute (tagsNode, tagName));
 	if (controlTagNode)
 	{
 		if (create)
 			return false;
 		controlTagNode->setTagString (newTagString);
+		impl->invalidateExpressions (tagName);
 		impl->listeners.forEach ([this] (UIDescriptionListener* l) {
 			l->onUIDescTagChanged (this);
 		});
@@ -2415,6 +3348,7 @@ bool UIDescription::changeControlTagString  (UTF8StringPtr tagName, const std::s
 			node->setTagString (newTagString);
 			tagsNode->getChildren ().add (node);
 			tagsNode->sortChildren ();
+			impl->invalidateExpressions (tagName);
 			impl->listeners.forEach ([this] (UIDescriptionListener* l) {
 				l->onUIDescTagChanged (this);
 			});
@@ -2427,7 +3361,7 @@ bool UIDescription::changeControlTagString  (UTF8StringPtr tagName, const std::s
 //-----------------------------------------------------------------------------
 bool UIDescription::getVariable (UTF8StringPtr name, double& value) const
 {
-	UIVariableNode* node = dynamic_cast<UIVariableNode*> (findChildNodeByNameAttribute (impl->getVariableBaseNode (), name));
+	UIVariableNode* node = nodeCast<UIVariableNode> (findChildNodeByNameAttribute (impl->getVariablesNode (), name));
 	if (node)
 	{
 		if (node->getType () == UIVariableNode::kNumber)
@@ -2436,14 +3370,7 @@ bool UIDescription::getVariable (UTF8StringPtr name, double& value) const
 			return true;
 		}
 		if (node->getType () == UIVariableNode::kString)
-		{
-			double v;
-			if (calculateStringValue (node->getString ().c_str (), v))
-			{
-				value = v;
-				return true;
-			}
-		}
+			return impl->evaluate (this, node->getString (), node->getExpressionCache (), value);
 	}
 	return false;
 }
@@ -2451,7 +3378,7 @@ bool UIDescription::getVariable (UTF8StringPtr name, double& value) const
 //-----------------------------------------------------------------------------
 bool UIDescription::getVariable (UTF8StringPtr name, std::string& value) const
 {
-	UIVariableNode* node = dynamic_cast<UIVariableNode*> (findChildNodeByNameAttribute (impl->getVariableBaseNode (), name));
+	UIVariableNode* node = nodeCast<UIVariableNode> (findChildNodeByNameAttribute (impl->getVariablesNode (), name));
 	if (node)
 	{
 		value = node->getString ();
@@ -2460,335 +3387,13 @@ bool UIDescription::getVariable (UTF8StringPtr name, std::string& value) const
 	return false;
 }
 
-namespace UIDescriptionPrivate {
-
-//-----------------------------------------------------------------------------
-struct Locale
-{
-	Locale ()
-	{
-		origLocal = std::locale ();
-		std::locale::global (std::locale::classic ());
-	}
-
-	~Locale () noexcept
-	{
-		std::locale::global (origLocal);
-	}
-
-	std::locale origLocal;
-};
-
-//-----------------------------------------------------------------------------
-class StringToken : public std::string
-{
-public:
-	enum Type {
-		kString,
-		kAdd,
-		kSubtract,
-		kMulitply,
-		kDivide,
-		kOpenParenthesis,
-		kCloseParenthesis,
-		kResult
-	};
-	
-	explicit StringToken (const std::string& str) : std::string (str), type (kString), result (0) {}
-	StringToken (const StringToken& token) = default;
-	StringToken (Type type, double value = 0) : type (type), result (value) {}
-	
-	Type type;
-	double result;
-};
-
-using StringTokenList = std::list<StringToken>;
-	
-//-----------------------------------------------------------------------------
-static bool tokenizeString (std::string& str, StringTokenList& tokens)
-{
-	UTF8CodePointIterator<std::string::const_iterator> start (str.begin ());
-	UTF8CodePointIterator<std::string::const_iterator> end (str.end ());
-	auto iterator = start;
-	while (iterator != end)
-	{
-		auto codePoint = *iterator;
-		if (isspace (codePoint))
-		{
-			if (start != iterator)
-				tokens.emplace_back (std::string {start.base (), iterator.base ()});
-			start = iterator;
-			++start;
-		}
-		else
-		{
-			switch (codePoint)
-			{
-				case '+':
-				{
-					if (start != iterator)
-						tokens.emplace_back (std::string {start.base (), iterator.base ()});
-					tokens.emplace_back (StringToken::kAdd);
-					start = iterator;
-					++start;
-					break;
-				}
-				case '-':
-				{
-					if (start != iterator)
-						tokens.emplace_back (std::string {start.base (), iterator.base ()});
-					tokens.emplace_back (StringToken::kSubtract);
-					start = iterator;
-					++start;
-					break;
-				}
-				case '*':
-				{
-					if (start != iterator)
-						tokens.emplace_back (std::string {start.base (), iterator.base ()});
-					tokens.emplace_back (StringToken::kMulitply);
-					start = iterator;
-					++start;
-					break;
-				}
-				case '/':
-				{
-					if (start != iterator)
-						tokens.emplace_back (std::string {start.base (), iterator.base ()});
-					tokens.emplace_back (StringToken::kDivide);
-					start = iterator;
-					++start;
-					break;
-				}
-				case '(':
-				{
-					if (start != iterator)
-						tokens.emplace_back (std::string {start.base (), iterator.base ()});
-					tokens.emplace_back (StringToken::kOpenParenthesis);
-					start = iterator;
-					++start;
-					break;
-				}
-				case ')':
-				{
-					if (start != iterator)
-						tokens.emplace_back (std::string {start.base (), iterator.base ()});
-					tokens.emplace_back (StringToken::kCloseParenthesis);
-					start = iterator;
-					++start;
-					break;
-				}
-			}
-		}
-		++iterator;
-	}
-	if (start != iterator)
-		tokens.emplace_back (std::string {start.base (), iterator.base ()});
-	return true;
-}
-
-//-----------------------------------------------------------------------------
-static bool computeTokens (StringTokenList& tokens, double& result)
-{
-	int32_t openCount = 0;
-	StringTokenList::iterator openPosition = tokens.end ();
-	// first check parentheses
-	for (StringTokenList::iterator it = tokens.begin (); it != tokens.end (); ++it)
-	{
-		if ((*it).type == StringToken::kOpenParenthesis)
-		{
-			openCount++;
-			if (openCount == 1)
-				openPosition = it;
-		}
-		else if ((*it).type == StringToken::kCloseParenthesis)
-		{
-			openCount--;
-			if (openCount == 0)
-			{
-				StringTokenList tmp (++openPosition, it);
-				double value = 0;
-				if (computeTokens (tmp, value))
-				{
-					--openPosition;
-					++it;
-					tokens.erase (openPosition, it);
-					tokens.insert (it, StringToken (StringToken::kResult, value));
-					if (it == tokens.end ())
-					{
-						break;
-					}
-
-				}
-				else
-					return false;
-			}
-		}
-	}
-	// now multiply and divide
-	StringTokenList::iterator prevToken = tokens.begin ();
-	for (StringTokenList::iterator it = tokens.begin (); it != tokens.end (); ++it)
-	{
-		if (prevToken != it)
-		{
-			if ((*it).type == StringToken::kMulitply)
-			{
-				if ((*prevToken).type == StringToken::kResult)
-				{
-					++it;
-					if ((*it).type == StringToken::kResult)
-					{
-						double value = (*prevToken).result * (*it).result;
-						++it;
-						tokens.erase (prevToken, it);
-						tokens.insert (it, StringToken (StringToken::kResult, value));
-						--it;
-						prevToken = it;
-					}
-					else
-					{
-						return false;
-					}
-				}
-				else
-				{
-					return false;
-				}
-			}
-			else if ((*it).type == StringToken::kDivide)
-			{
-				if ((*prevToken).type == StringToken::kResult)
-				{
-					++it;
-					if ((*it).type == StringToken::kResult)
-					{
-						double value = (*prevToken).result / (*it).result;
-						++it;
-						tokens.erase (prevToken, it);
-						tokens.insert (it, StringToken (StringToken::kResult, value));
-						--it;
-						prevToken = it;
-					}
-					else
-					{
-						return false;
-					}
-				}
-				else
-				{
-					return false;
-				}
-			}
-			else
-			{
-				prevToken = it;
-			}
-		}
-	}
-	// now add and subtract
-	int32_t lastType = -1;
-	for (StringTokenList::const_iterator it = tokens.begin (); it != tokens.end (); ++it)
-	{
-		if ((*it).type == UIDescriptionPrivate::StringToken::kResult)
-		{
-			double value = (*it).result;
-			if (lastType == -1)
-				result = value;
-			else if (lastType == StringToken::kAdd)
-				result += value;
-			else if (lastType == StringToken::kSubtract)
-				result -= value;
-			else
-			{
-			#if DEBUG
-				DebugPrint ("Wrong Expression: %d\n", (*it).type);
-			#endif
-				return false;
-			}
-		}
-		else if (!(lastType == -1 || lastType == UIDescriptionPrivate::StringToken::kResult))
-		{
-		#if DEBUG
-			DebugPrint ("Wrong Expression: %d\n", (*it).type);
-		#endif
-			return false;
-		}
-		lastType = (*it).type;
-		
-	}
-	return true;
-}
-
-} // namespace UIDescriptionPrivate
-
 //-----------------------------------------------------------------------------
-bool UIDescription::calculateStringValue (UTF8StringPtr _str, double& result) const
+bool UIDescription::calculateStringValue (UTF8StringPtr str, double& result) const
 {
-	UIDescriptionPrivate::Locale localeResetter;
-
-	char* endPtr = nullptr;
-	result = strtod (_str, &endPtr);
-	if (endPtr == _str + strlen (_str))
-		return true;
-	std::string str (_str);
-	UIDescriptionPrivate::StringTokenList tokens;
-	if (!UIDescriptionPrivate::tokenizeString (str, tokens))
-	{
-	#if DEBUG
-		DebugPrint("TokenizeString failed :%s\n", _str);
-	#endif
+	auto expression = UIDescriptionPrivate::Expression::compile (str);
+	if (!expression)
 		return false;
-	}
-	// first make substituation
-	for (auto& token : tokens)
-	{
-		if (token.type == UIDescriptionPrivate::StringToken::kString)
-		{
-			const char* tokenStr = token.c_str ();
-			double value = strtod (tokenStr, &endPtr);
-			if (endPtr != tokenStr + token.length ())
-			{
-				// if it is not pure numeric try to substitute the string with a control tag or variable
-				if (token.find ("tag.") == 0)
-				{
-					value = getTagForName (token.c_str () + 4);
-					if (value == -1)
-					{
-					#if DEBUG
-						DebugPrint("Tag not found :%s\n", tokenStr);
-					#endif
-						return false;
-					}
-				}
-				else if (token.find ("var.") == 0)
-				{
-					double v;
-					if (getVariable (token.c_str () + 4, v))
-					{
-						value = v;
-					}
-					else
-					{
-					#if DEBUG
-						DebugPrint("Variable not found :%s\n", tokenStr);
-					#endif
-						return false;
-					}
-				}
-				else
-				{
-				#if DEBUG
-					DebugPrint("Substitution failed :%s\n", tokenStr);
-				#endif
-					return false;
-				}
-			}
-			token.result = value;
-			token.type = UIDescriptionPrivate::StringToken::kResult;
-		}
-	}
-	result = 0;
-	return UIDescriptionPrivate::computeTokens (tokens, result);
+	return impl->evaluate (this, *expression, result, nullptr);
 }
 
 //-----------------------------------------------------------------------------
@@ -2812,11 +3417,12 @@ void UIDescription::startXmlElement (Xml::Parser* parser, IdStringPtr elementNam
 			if (parent == impl->nodes)
 			{
 				// only allowed second level elements
-				if (name == MainNodeNames::kControlTag || name == MainNodeNames::kColor || name == MainNodeNames::kBitmap)
+				if (MainNodeNames::indexOfUniqueNode (name.data ()) < MainNodeNames::kNumUniqueNodes)
+				{
 					newNode = new UINode (name, makeOwned<UIAttributes> (elementAttributes), true);
-				else if (name == MainNodeNames::kFont || name == MainNodeNames::kTemplate
-					  || name == MainNodeNames::kControlTag || name == MainNodeNames::kCustom
-					  || name == MainNodeNames::kVariable || name == MainNodeNames::kGradient)
+					impl->resetUniqueNodeCache ();
+				}
+				else if (name == MainNodeNames::kTemplate)
 					newNode = new UINode (name, makeOwned<UIAttributes> (elementAttributes));
 				else
 					parser->stop ();
@@ -2874,7 +3480,7 @@ void UIDescription::startXmlElement (Xml::Parser* parser, IdStringPtr elementNam
 	}
 	else if (name == "vstgui-ui-description")
 	{
-		impl->nodes = makeOwned<UINode> (name, makeOwned<UIAttributes> (elementAttributes));
+		impl->nodes = makeOwned<UINode> (name, makeOwned<UIAttributes> (elementAttributes), true);
 		impl->nodeStack.emplace_back (impl->nodes);
 	}
 	else if (name == "vstgui-ui-description-view-list")
@@ -2894,6 +3500,16 @@ void UIDescription::endXmlElement (Xml::Parser* parser, IdStringPtr name)
 	impl->nodeStack.pop_back ();
 }
 
+//-----------------------------------------------------------------------------
+void UIDescription::setBinaryNodeData (const void* data, size_t size)
+{
+	if (impl->nodeStack.size () == 0)
+		return;
+	auto node = impl->nodeStack.back ();
+	node->getData ().assign (reinterpret_cast<const char*> (data), size);
+	node->binaryData (true);
+}
+
 //-----------------------------------------------------------------------------
 void UIDescription::xmlCharData (Xml::Parser* parser, const int8_t* data, int32_t length)
 {
@@ -2974,6 +3590,13 @@ UINode::UINode (const std::string& _name, const SharedPointer<UIDescList>& _chil
 		attributes = makeOwned<UIAttributes> ();
 }
 
+//-----------------------------------------------------------------------------
+UINode::UINode (const std::string& _name, const SharedPointer<UIAttributes>& _attributes, Kind _kind)
+: UINode (_name, _attributes)
+{
+	kind = _kind;
+}
+
 //-----------------------------------------------------------------------------
 UINode::UINode (const UINode& n)
 : name (n.name)
@@ -3011,7 +3634,7 @@ void UINode::sortChildren ()
 //-----------------------------------------------------------------------------
 //-----------------------------------------------------------------------------
 UICommentNode::UICommentNode (const std::string& comment)
-: UINode ("comment")
+: UINode ("comment", {}, kKind)
 {
 	data = comment;
 }
@@ -3020,7 +3643,7 @@ UICommentNode::UICommentNode (const std::string& comment)
 //-----------------------------------------------------------------------------
 //-----------------------------------------------------------------------------
 UIVariableNode::UIVariableNode (const std::string& name, const SharedPointer<UIAttributes>& attributes)
-: UINode (name, attributes)
+: UINode (name, attributes, kKind)
 , type (kUnknown)
 , number (0)
 {
@@ -3035,25 +3658,10 @@ UIVariableNode::UIVariableNode (const std::string& name, const SharedPointer<UIA
 	}
 	if (valueStr)
 	{
-		UIDescriptionPrivate::Locale localeResetter;
-
-		const char* strPtr = valueStr->c_str ();
 		if (type == kUnknown)
-		{
-			char* endPtr = nullptr;
-			double numberCheck = strtod (strPtr, &endPtr);
-			if (endPtr == strPtr + strlen (strPtr))
-			{
-				number = numberCheck;
-				type = kNumber;
-			}
-			else
-				type = kString;
-		}
+			type = UIDescriptionPrivate::parseNumber (*valueStr, number) ? kNumber : kString;
 		else if (type == kNumber)
-		{
-			number = strtod (strPtr, nullptr);
-		}
+			number = UTF8StringView (valueStr->data ()).toDouble ();
 	}
 }
 
@@ -3083,7 +3691,7 @@ const std::string& UIVariableNode::getString () const
 //-----------------------------------------------------------------------------
 //-----------------------------------------------------------------------------
 UIControlTagNode::UIControlTagNode (const std::string& name, const SharedPointer<UIAttributes>& attributes)
-: UINode (name, attributes)
+: UINode (name, attributes, kKind)
 , tag (-1)
 {
 }
@@ -3133,13 +3741,77 @@ void UIControlTagNode::setTagString (const std::string& str)
 {
 	attributes->setAttribute ("tag", str);
 	tag = -1;
+	expressionCache.reset ();
+}
+
+//-----------------------------------------------------------------------------
+//-----------------------------------------------------------------------------
+//-----------------------------------------------------------------------------
+bool UIBitmapDecodeJob::run ()
+{
+	auto expected = kPending;
+	if (!state.compare_exchange_strong (expected, kRunning))
+		return false;
+	auto start = std::chrono::steady_clock::now ();
+	auto result = decode ();
+	std::lock_guard<std::mutex> guard (mutex);
+	platformBitmap = std::move (result);
+	decodeTime = std::chrono::duration<double, std::milli> (std::chrono::steady_clock::now () - start).count ();
+	state = kDone;
+	condition.notify_all ();
+	return true;
+}
+
+//-----------------------------------------------------------------------------
+const SharedPointer<IPlatformBitmap>& UIBitmapDecodeJob::wait (double& waitTime, bool& decodedOnOtherThread)
+{
+	auto start = std::chrono::steady_clock::now ();
+	decodedOnOtherThread = !run ();
+	std::unique_lock<std::mutex> lock (mutex);
+	condition.wait (lock, [this] () { return state == kDone; });
+	if (decodedOnOtherThread)
+		waitTime = std::chrono::duration<double, std::milli> (std::chrono::steady_clock::now () - start).count ();
+	return platformBitmap;
 }
 
 //-----------------------------------------------------------------------------
+static SharedPointer<IPlatformBitmap> createPlatformBitmapFromImageData (const std::string& data,
+                                                                         bool base64)
+{
+	if (!base64)
+		return IPlatformBitmap::createFromMemory (data.data (), static_cast<uint32_t> (data.size ()));
+	auto result = Base64Codec::decode (data);
+	return IPlatformBitmap::createFromMemory (result.data.get (), result.dataSize);
+}
+
 //-----------------------------------------------------------------------------
+SharedPointer<IPlatformBitmap> UIBitmapDecodeJob::decode () const
+{
+	if (auto bitmap = IPlatformBitmap::create ())
+	{
+		if (bitmap->load (CResourceDescription (path.data ())))
+			return bitmap;
+	}
+	if (!absolutePath.empty ())
+	{
+		if (auto bitmap = IPlatformBitmap::createFromPath (absolutePath.data ()))
+			return bitmap;
+	}
+	if (!imageData.empty ())
+	{
+		if (auto bitmap = createPlatformBitmapFromImageData (imageData, imageDataIsBase64))
+		{
+			if (scaleFactor != 0.)
+				bitmap->setScaleFactor (scaleFactor);
+			return bitmap;
+		}
+	}
+	return nullptr;
+}
+
 //-----------------------------------------------------------------------------
 UIBitmapNode::UIBitmapNode (const std::string& name, const SharedPointer<UIAttributes>& attributes)
-: UINode (name, attributes)
+: UINode (name, attributes, kKind)
 , bitmap (nullptr)
 , filterProcessed (false)
 , scaledBitmapsAdded (false)
@@ -3159,6 +3831,7 @@ void UIBitmapNode::freePlatformResources ()
 	if (bitmap)
 		bitmap->forget ();
 	bitmap = nullptr;
+	decodeJob = nullptr;
 }
 
 //-----------------------------------------------------------------------------
@@ -3229,10 +3902,14 @@ void UIBitmapNode::createXMLData (const std::string& pathHint)
 				auto buffer = IPlatformBitmap::createMemoryPNGRepresentation (platformBitmap);
 				if (!buffer.empty ())
 				{
-					auto result = Base64Codec::encode (buffer.data(), static_cast<uint32_t> (buffer.size ()));
 					UINode* dataNode = new UINode ("data");
 					dataNode->getAttributes ()->setAttribute ("encoding", "base64");
-					dataNode->getData ().append (reinterpret_cast<const char*> (result.data.get ()), static_cast<std::streamsize> (result.dataSize));
+					auto& data = dataNode->getData ();
+					data.reserve (Base64Codec::getEncodedSize (buffer.size ()));
+					UIDescriptionPrivate::NodeDataOutputStream dataStream (data);
+					Base64EncodingOutputStream encoder (dataStream);
+					encoder.writeRaw (buffer.data (), static_cast<uint32_t> (buffer.size ()));
+					encoder.finish ();
 					getChildren ().add (dataNode);
 				}
 			}
@@ -3249,11 +3926,12 @@ void UIBitmapNode::removeXMLData ()
 }
 
 //-----------------------------------------------------------------------------
-CBitmap* UIBitmapNode::createBitmap (const std::string& str, CNinePartTiledDescription* partDesc) const
+CBitmap* UIBitmapNode::createBitmap (const std::string& str, CNinePartTiledDescription* partDesc,
+                                     const SharedPointer<IPlatformBitmap>& platformBitmap) const
 {
 	if (partDesc)
-		return new CNinePartTiledBitmap (CResourceDescription (str.c_str()), *partDesc);
-	return new CBitmap (CResourceDescription (str.c_str()));
+		return new CNinePartTiledBitmap (CResourceDescription (str.c_str()), platformBitmap, *partDesc);
+	return new CBitmap (CResourceDescription (str.c_str()), platformBitmap);
 }
 
 //------------------------------------------------------------------------
@@ -3264,33 +3942,85 @@ UINode* UIBitmapNode::dataNode () const
 }
 
 //------------------------------------------------------------------------
-SharedPointer<IPlatformBitmap> UIBitmapNode::createBitmapFromDataNode () const
+const std::string* UIBitmapNode::dataNodeImage (bool& base64) const
 {
 	if (auto node = dataNode ())
 	{
+		base64 = !node->binaryData ();
+		if (!base64)
+			return &node->getData ();
 		auto codecStr = node->getAttributes ()->getAttributeValue ("encoding");
 		if (codecStr && *codecStr == "base64")
+			return &node->getData ();
+	}
+	return nullptr;
+}
+
+//------------------------------------------------------------------------
+SharedPointer<IPlatformBitmap> UIBitmapNode::createBitmapFromDataNode () const
+{
+	bool base64;
+	if (auto data = dataNodeImage (base64))
+	{
+		if (auto platformBitmap = createPlatformBitmapFromImageData (*data, base64))
 		{
-			auto result = Base64Codec::decode (node->getData ());
-			if (auto platformBitmap = IPlatformBitmap::createFromMemory (result.data.get (), result.dataSize))
-			{
-				double scaleFactor = 1.;
-				if (attributes->getDoubleAttribute ("scale-factor", scaleFactor))
-					platformBitmap->setScaleFactor (scaleFactor);
-				return platformBitmap;
-			}
+			double scaleFactor = 1.;
+			if (attributes->getDoubleAttribute ("scale-factor", scaleFactor))
+				platformBitmap->setScaleFactor (scaleFactor);
+			return platformBitmap;
 		}
 	}
 	return nullptr;
 }
 
+//------------------------------------------------------------------------
+std::shared_ptr<UIBitmapDecodeJob> UIBitmapNode::createDecodeJob (const std::string& pathHint) const
+{
+	const std::string* path = attributes->getAttributeValue ("path");
+	if (path == nullptr)
+		return nullptr;
+	auto job = std::make_shared<UIBitmapDecodeJob> ();
+	job->path = *path;
+	if (pathIsAbsolute (pathHint))
+	{
+		std::string absPath = pathHint;
+		if (removeLastPathComponent (absPath))
+			job->absolutePath = absPath + "/" + *path;
+	}
+	if (auto data = dataNodeImage (job->imageDataIsBase64))
+		job->imageData = *data;
+	attributes->getDoubleAttribute ("scale-factor", job->scaleFactor);
+	return job;
+}
+
+//------------------------------------------------------------------------
+std::shared_ptr<UIBitmapDecodeJob> UIBitmapNode::prefetch (const std::string& pathHint)
+{
+	if (bitmap || decodeJob)
+		return nullptr;
+	decodeJob = createDecodeJob (pathHint);
+	return decodeJob;
+}
+
+//------------------------------------------------------------------------
+bool UIBitmapNode::getDecodeInfo (UIDescription::BitmapDecodeInfo& info) const
+{
+	if (!decoded)
+		return false;
+	info = decodeInfo;
+	if (auto name = attributes->getAttributeValue (kNameAttribute))
+		info.name = *name;
+	return true;
+}
+
 //-----------------------------------------------------------------------------
 CBitmap* UIBitmapNode::getBitmap (const std::string& pathHint)
 {
 	if (bitmap == nullptr)
 	{
 		const std::string* path = attributes->getAttributeValue ("path");
-		if (path)
+		auto job = std::move (decodeJob);
+		if (path && (job || (job = createDecodeJob (pathHint))))
 		{
 			CNinePartTiledDescription partDesc;
 			CNinePartTiledDescription* partDescPtr = nullptr;
@@ -3300,22 +4030,10 @@ CBitmap* UIBitmapNode::getBitmap (const std::string& pathHint)
 				partDesc = CNinePartTiledDescription (offsets.left, offsets.top, offsets.right, offsets.bottom);
 				partDescPtr = &partDesc;
 			}
-			bitmap = createBitmap (*path, partDescPtr);
-			if (bitmap->getPlatformBitmap () == nullptr && pathIsAbsolute (pathHint))
-			{
-				std::string absPath = pathHint;
-				if (removeLastPathComponent (absPath))
-				{
-					absPath += "/" + *path;
-					if (auto platformBitmap = IPlatformBitmap::createFromPath (absPath.c_str ()))
-						bitmap->setPlatformBitmap (platformBitmap);
-				}
-			}
-		}
-		if (bitmap && bitmap->getPlatformBitmap () == nullptr)
-		{
-			if (auto platformBitmap = createBitmapFromDataNode ())
-				bitmap->setPlatformBitmap (platformBitmap);
+			decodeInfo = {};
+			bitmap = createBitmap (*path, partDescPtr, job->wait (decodeInfo.waitTime, decodeInfo.prefetched));
+			decodeInfo.decodeTime = job->getDecodeTime ();
+			decoded = true;
 		}
 		if (bitmap && path && bitmap->getPlatformBitmap () && bitmap->getPlatformBitmap ()->getScaleFactor () == 1.)
 		{
@@ -3337,6 +4055,7 @@ void UIBitmapNode::setBitmap (UTF8StringPtr bitmapName)
 	if (bitmap)
 		bitmap->forget ();
 	bitmap = nullptr;
+	decodeJob = nullptr;
 	double scaleFactor = 1.;
 	if (UIDescriptionPrivate::decodeScaleFactorFromName (bitmapName, scaleFactor))
 		attributes->setDoubleAttribute ("scale-factor", scaleFactor);
@@ -3371,6 +4090,7 @@ void UIBitmapNode::invalidBitmap ()
 	if (bitmap)
 		bitmap->forget ();
 	bitmap = nullptr;
+	decodeJob = nullptr;
 	filterProcessed = false;
 }
 
@@ -3378,7 +4098,7 @@ void UIBitmapNode::invalidBitmap ()
 //-----------------------------------------------------------------------------
 //-----------------------------------------------------------------------------
 UIFontNode::UIFontNode (const std::string& name, const SharedPointer<UIAttributes>& attributes)
-: UINode (name, attributes)
+: UINode (name, attributes, kKind)
 , font (nullptr)
 {
 }
@@ -3508,7 +4228,7 @@ bool UIFontNode::getAlternativeFontNames (std::string& fontNames)
 
 //-----------------------------------------------------------------------------
 UIColorNode::UIColorNode (const std::string& name, const SharedPointer<UIAttributes>& attributes)
-: UINode (name, attributes)
+: UINode (name, attributes, kKind)
 {
 	color.alpha = 255;
 	const std::string* red = attributes->getAttributeValue ("red");
@@ -3546,7 +4266,7 @@ void UIColorNode::setColor (const CColor& newColor)
 
 //-----------------------------------------------------------------------------
 UIGradientNode::UIGradientNode (const std::string& name, const SharedPointer<UIAttributes>& attributes)
-: UINode (name, attributes)
+: UINode (name, attributes, kKind)
 {
 }
 
@@ -12,6 +12,7 @@
 #include <list>
 #include <string>
 #include <memory>
+#include <vector>
 
 namespace VSTGUI {
 
@@ -127,6 +128,23 @@ public:
 
 	void setBitmapCreator (IBitmapCreator* bitmapCreator);
 
+	/** decode the named bitmaps (all bitmaps if names is empty) on background threads.
+	 *	getBitmap only blocks on bitmaps which are not yet decoded.
+	 */
+	void prefetchBitmaps (const std::vector<std::string>& names = {});
+
+	struct BitmapDecodeInfo
+	{
+		std::string name;
+		/** decode time in milliseconds */
+		double decodeTime {0.};
+		/** time getBitmap was blocked waiting for a prefetched bitmap in milliseconds */
+		double waitTime {0.};
+		bool prefetched {false};
+	};
+	/** decode timings of all bitmaps loaded so far */
+	std::vector<BitmapDecodeInfo> getBitmapDecodeInfos () const;
+
 	using FocusDrawing = FocusDrawingSettings;
 	FocusDrawing getFocusDrawingSettings () const;
 	void setFocusDrawingSettings (const FocusDrawing& fd);
@@ -145,6 +163,8 @@ protected:
 	void setXmlContentProvider (Xml::IContentProvider* provider);
 
 	const CResourceDescription& getXmlFile () const;
+	/** set raw binary data of the current node while parsing, it is base64 encoded when saved */
+	void setBinaryNodeData (const void* data, size_t size);
 private:
 	// Xml::IHandler
 	void startXmlElement (Xml::Parser* parser, IdStringPtr elementName, UTF8StringPtr* elementAttributes) override;
@@ -155,6 +175,8 @@ private:
 	CView* createViewFromNode (UINode* node) const;
 	UINode* getBaseNode (UTF8StringPtr name) const;
 	UINode* findChildNodeByNameAttribute (UINode* node, UTF8StringPtr nameAttribute) const;
+	template<typename NodeType> NodeType* findResourceNode (IdStringPtr mainNodeName, UTF8StringPtr name) const;
+	UINode* findTemplateNode (UTF8StringPtr name) const;
 	UINode* findNodeForView (CView* view) const;
 	bool updateAttributesForView (UINode* node, CView* view, bool deep = true);
 	void removeNode (UTF8StringPtr name, IdStringPtr mainNodeName);
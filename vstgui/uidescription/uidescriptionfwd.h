@@ -15,6 +15,7 @@ class UIDescriptionListener;
 class UIDescriptionListenerAdapter;
 class IViewFactory;
 class InputStream;
+class CResourceInputStream;
 class OutputStream;
 class IBitmapCreator;
 
@@ -362,6 +362,7 @@ static constexpr auto strVertical = "vertical";
 static constexpr auto strNone = "none";
 static constexpr auto strHead = "head";
 static constexpr auto strTail = "tail";
+static constexpr auto strMiddle = "middle";
 
 static constexpr auto strLeft = "left";
 static constexpr auto strRight = "right";
@@ -1893,6 +1894,8 @@ public:
 				label->setTextTruncateMode (CTextLabel::kTruncateHead);
 			else if (*attr == strTail)
 				label->setTextTruncateMode (CTextLabel::kTruncateTail);
+			else if (*attr == strMiddle)
+				label->setTextTruncateMode (CTextLabel::kTruncateMiddle);
 			else
 				label->setTextTruncateMode (CTextLabel::kTruncateNone);
 		}
@@ -1933,6 +1936,7 @@ public:
 			{
 				case CTextLabel::kTruncateHead: stringValue = strHead; break;
 				case CTextLabel::kTruncateTail: stringValue = strTail; break;
+				case CTextLabel::kTruncateMiddle: stringValue = strMiddle; break;
 				case CTextLabel::kTruncateNone: stringValue = ""; break;
 			}
 			return true;
@@ -1958,6 +1962,7 @@ public:
 	std::string kClip = "clip";
 	std::string kTruncate = "truncate";
 	std::string kWrap = "wrap";
+	std::string kBalancedWrap = "balanced-wrap";
 
 	CMultiLineTextLabelCreator () { UIViewFactory::registerViewCreator (*this); }
 	IdStringPtr getViewName () const override { return kCMultiLineTextLabel; }
@@ -1977,6 +1982,8 @@ public:
 				label->setLineLayout (CMultiLineTextLabel::LineLayout::truncate);
 			else if (*attr == kWrap)
 				label->setLineLayout (CMultiLineTextLabel::LineLayout::wrap);
+			else if (*attr == kBalancedWrap)
+				label->setLineLayout (CMultiLineTextLabel::LineLayout::balancedWrap);
 			else
 				label->setLineLayout (CMultiLineTextLabel::LineLayout::clip);
 		}
@@ -2009,6 +2016,7 @@ public:
 			{
 				case CMultiLineTextLabel::LineLayout::truncate: stringValue = kTruncate; break;
 				case CMultiLineTextLabel::LineLayout::wrap: stringValue = kWrap; break;
+				case CMultiLineTextLabel::LineLayout::balancedWrap: stringValue = kBalancedWrap; break;
 				case CMultiLineTextLabel::LineLayout::clip: stringValue = kClip; break;
 			}
 			return true;
@@ -2028,6 +2036,7 @@ public:
 			values.emplace_back (&kClip);
 			values.emplace_back (&kTruncate);
 			values.emplace_back (&kWrap);
+			values.emplace_back (&kBalancedWrap);
 			return true;
 		}
 		return false;
@@ -2555,6 +2564,8 @@ public:
 				button->setTextTruncateMode (CDrawMethods::kTextTruncateHead);
 			else if (*attr == strTail)
 				button->setTextTruncateMode (CDrawMethods::kTextTruncateTail);
+			else if (*attr == strMiddle)
+				button->setTextTruncateMode (CDrawMethods::kTextTruncateMiddle);
 			else
 				button->setTextTruncateMode (CDrawMethods::kTextTruncateNone);
 		}
@@ -2719,6 +2730,7 @@ public:
 			{
 				case CDrawMethods::kTextTruncateHead: stringValue = strHead; break;
 				case CDrawMethods::kTextTruncateTail: stringValue = strTail; break;
+				case CDrawMethods::kTextTruncateMiddle: stringValue = strMiddle; break;
 				case CDrawMethods::kTextTruncateNone: stringValue = ""; break;
 			}
 			return true;
@@ -4367,10 +4379,12 @@ static bool getStandardAttributeListValues (const std::string& attributeName, st
 		static std::string kNone = strNone;
 		static std::string kHead = strHead;
 		static std::string kTail = strTail;
+		static std::string kMiddle = strMiddle;
 		
 		values.emplace_back (&kNone);
 		values.emplace_back (&kHead);
 		values.emplace_back (&kTail);
+		values.emplace_back (&kMiddle);
 		return true;
 	}
 	return false;
@@ -154,8 +154,8 @@ CView* UIViewFactory::createViewByName (const std::string* className, const UIAt
 			IdStringPtr viewName = (*iter).second->getViewName ();
 			view->setAttribute (kViewNameAttribute, viewName);
 			UIAttributes evaluatedAttributes;
-			evaluateAttributesAndRemember (view, attributes, evaluatedAttributes, description);
-			while (iter != registry.end () && (*iter).second->apply (view, evaluatedAttributes, description))
+			const auto& viewAttributes = evaluateAttributesAndRemember (view, attributes, evaluatedAttributes, description);
+			while (iter != registry.end () && (*iter).second->apply (view, viewAttributes, description))
 			{
 				if ((*iter).second->getBaseViewName () == nullptr)
 					break;
@@ -191,9 +191,9 @@ bool UIViewFactory::applyAttributeValues (CView* view, const UIAttributes& attri
 	auto iter = registry.find (getViewName (view));
 
 	UIAttributes evaluatedAttributes;
-	evaluateAttributesAndRemember (view, attributes, evaluatedAttributes, desc);
+	const auto& viewAttributes = evaluateAttributesAndRemember (view, attributes, evaluatedAttributes, desc);
 	
-	while (iter != registry.end () && (result = (*iter).second->apply (view, evaluatedAttributes, desc)) && (*iter).second->getBaseViewName ())
+	while (iter != registry.end () && (result = (*iter).second->apply (view, viewAttributes, desc)) && (*iter).second->getBaseViewName ())
 	{
 		iter = registry.find ((*iter).second->getBaseViewName ());
 	}
@@ -212,8 +212,8 @@ bool UIViewFactory::applyCustomViewAttributeValues (CView* customView, IdStringP
 		customView->setAttribute (kViewNameAttribute, viewName);
 	}
 	UIAttributes evaluatedAttributes;
-	evaluateAttributesAndRemember (customView, attributes, evaluatedAttributes, desc);
-	while (iter != registry.end () && (result = (*iter).second->apply (customView, evaluatedAttributes, desc)) && (*iter).second->getBaseViewName ())
+	const auto& viewAttributes = evaluateAttributesAndRemember (customView, attributes, evaluatedAttributes, desc);
+	while (iter != registry.end () && (result = (*iter).second->apply (customView, viewAttributes, desc)) && (*iter).second->getBaseViewName ())
 	{
 		iter = registry.find ((*iter).second->getBaseViewName ());
 	}
@@ -230,17 +230,28 @@ IdStringPtr UIViewFactory::getViewName (CView* view) const
 }
 
 //-----------------------------------------------------------------------------
-void UIViewFactory::evaluateAttributesAndRemember (CView* view, const UIAttributes& attributes, UIAttributes& evaluatedAttributes, const IUIDescription* description) const
+const UIAttributes& UIViewFactory::evaluateAttributesAndRemember (CView* view, const UIAttributes& attributes, UIAttributes& evaluatedAttributes, const IUIDescription* description) const
 {
+	// evaluatedAttributes is only filled once a variable is substituted. Otherwise the creators read
+	// the attributes of the node directly and reuse their cached typed values the next time the
+	// node creates a view.
+	bool substituted = false;
 	std::string evaluatedValue;
-	for (const auto& attr : attributes)
+	for (auto it = attributes.begin (); it != attributes.end (); ++it)
 	{
+		const auto& attr = *it;
 		const std::string& value = attr.second;
 		if (description && description->getVariable (value.c_str (), evaluatedValue))
 		{
 		#if VSTGUI_LIVE_EDITING
 			rememberAttribute (view, attr.first.c_str (), value.c_str ());
 		#endif
+			if (!substituted)
+			{
+				for (auto prev = attributes.begin (); prev != it; ++prev)
+					evaluatedAttributes.setAttribute (prev->first, prev->second);
+				substituted = true;
+			}
 			evaluatedAttributes.setAttribute (attr.first, evaluatedValue);
 		}
 		else
@@ -259,9 +270,11 @@ void UIViewFactory::evaluateAttributesAndRemember (CView* view, const UIAttribut
 					break;
 			}
 		#endif
-			evaluatedAttributes.setAttribute (attr.first, value);
+			if (substituted)
+				evaluatedAttributes.setAttribute (attr.first, value);
 		}
 	}
+	return substituted ? evaluatedAttributes : attributes;
 }
 
 #if VSTGUI_LIVE_EDITING
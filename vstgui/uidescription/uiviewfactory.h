@@ -55,7 +55,8 @@ public:
 #endif
 
 protected:
-	void evaluateAttributesAndRemember (CView* view, const UIAttributes& attributes, UIAttributes& evaluatedAttributes, const IUIDescription* description) const;
+	/** returns attributes if no variable was substituted, otherwise evaluatedAttributes */
+	const UIAttributes& evaluateAttributesAndRemember (CView* view, const UIAttributes& attributes, UIAttributes& evaluatedAttributes, const IUIDescription* description) const;
 	CView* createViewByName (const std::string* className, const UIAttributes& attributes, const IUIDescription* description) const;
 
 #if VSTGUI_LIVE_EDITING
@@ -11,7 +11,7 @@
 #define XML_STATIC 1
 #define XML_NS 0
 #define XML_DTD 0
-#define XML_CONTEXT_BYTES 1024
+// XML_CONTEXT_BYTES is not defined, so that XML_Parse parses a complete buffer in place
 #define XML_LARGE_SIZE 1
 
 #ifdef BYTEORDER
@@ -34,6 +34,7 @@ namespace Xml {
 
 #include "xmlparser.h"
 #include <algorithm>
+#include <limits>
 
 namespace VSTGUI {
 namespace Xml {
@@ -43,6 +44,15 @@ struct Parser::Impl
 {
 	XML_ParserStruct* parser {nullptr};
 	IHandler* handler {nullptr};
+	bool stopped {false};
+
+	enum class Result
+	{
+		Continue,
+		Finished,
+		Failed
+	};
+	Result handleStatus (XML_Status status, const int8_t* data, uint32_t dataSize);
 };
 
 //------------------------------------------------------------------------
@@ -101,6 +111,69 @@ IHandler* Parser::getHandler () const
 	return pImpl->handler;
 }
 
+//-----------------------------------------------------------------------------
+auto Parser::Impl::handleStatus (XML_Status status, const int8_t* data, uint32_t dataSize) -> Result
+{
+	switch (status)
+	{
+		case XML_STATUS_ERROR:
+		{
+			XML_Error error = XML_GetErrorCode (parser);
+			if (error == XML_ERROR_JUNK_AFTER_DOC_ELEMENT) // that's ok
+				return Result::Finished;
+			#if DEBUG
+			XML_Size currentLineNumber = XML_GetCurrentLineNumber (parser);
+			DebugPrint ("XML Parser Error on line: %d\n", currentLineNumber);
+			DebugPrint ("%s\n", XML_ErrorString (XML_GetErrorCode (parser)));
+			int offset, size;
+			const char* inputContext;
+			if (data)
+			{
+				inputContext = reinterpret_cast<const char*> (data);
+				offset = static_cast<int> (XML_GetCurrentByteIndex (parser));
+				size = static_cast<int> (dataSize);
+			}
+			else
+				inputContext = XML_GetInputContext (parser, &offset, &size);
+			if (inputContext && offset >= 0 && offset < size)
+			{
+				int pos = offset;
+				while (offset > 0 && pos - offset < 20)
+				{
+					if (inputContext[offset] == '\n')
+					{
+						offset++;
+						break;
+					}
+					offset--;
+				}
+				for (int i = offset; i < size && i - offset < 40; i++)
+				{
+					if (inputContext[i] == '\n')
+						break;
+					if (inputContext[i] == '\t')
+						DebugPrint (" ");
+					else
+						DebugPrint ("%c", inputContext[i]);
+				}
+				DebugPrint ("\n");
+				for (int i = offset; i < pos; i++)
+				{
+					DebugPrint (" ");
+				}
+				DebugPrint ("^\n");
+			}
+			#endif
+			return Result::Failed;
+		}
+		case XML_STATUS_SUSPENDED:
+			return Result::Finished;
+		default:
+			break;
+	}
+	return Result::Continue;
+}
+
 //-----------------------------------------------------------------------------
 bool Parser::parse (IContentProvider* provider, IHandler* handler)
 {
@@ -108,6 +181,7 @@ bool Parser::parse (IContentProvider* provider, IHandler* handler)
 		return false;
 
 	pImpl->handler = handler;
+	pImpl->stopped = false;
 	XML_SetUserData (pImpl->parser, this);
 	XML_SetStartElementHandler (pImpl->parser, gStartElementHandler);
 	XML_SetEndElementHandler (pImpl->parser, gEndElementHandler);
@@ -118,90 +192,54 @@ bool Parser::parse (IContentProvider* provider, IHandler* handler)
 
 	provider->rewind ();
 
-	while (true) 
+	auto result = Impl::Result::Continue;
+	uint32_t dataSize = 0;
+	auto data = provider->getRawXmlData (dataSize);
+	if (data && dataSize <= static_cast<uint32_t> (std::numeric_limits<int>::max ()))
 	{
-		void* buffer = XML_GetBuffer (pImpl->parser, kBufferSize);
-		if (buffer == nullptr)
-		{
-			pImpl->handler = nullptr;
-			return false;
-		}
-
-		uint32_t bytesRead = provider->readRawXmlData ((int8_t*)buffer, kBufferSize);
-		if (bytesRead == kStreamIOError)
-			bytesRead = 0;
-		XML_Status status = XML_ParseBuffer (pImpl->parser, static_cast<int> (bytesRead), bytesRead == 0);
-		switch (status) 
+		// the whole content is in memory, let expat parse it directly without copying
+		auto status = XML_Parse (pImpl->parser, reinterpret_cast<const char*> (data),
+		                         static_cast<int> (dataSize), true);
+		result = pImpl->handleStatus (status, data, dataSize);
+	}
+	else
+	{
+		while (result == Impl::Result::Continue)
 		{
-			case XML_STATUS_ERROR:
-			{
-				XML_Error error = XML_GetErrorCode (pImpl->parser);
-				if (error == XML_ERROR_JUNK_AFTER_DOC_ELEMENT) // that's ok
-				{
-					pImpl->handler = nullptr;
-					return true;
-				}
-				#if DEBUG
-				XML_Size currentLineNumber = XML_GetCurrentLineNumber (pImpl->parser);
-				DebugPrint ("XML Parser Error on line: %d\n", currentLineNumber);
-				DebugPrint ("%s\n", XML_ErrorString (XML_GetErrorCode (pImpl->parser)));
-				int offset, size;
-				const char* inputContext = XML_GetInputContext (pImpl->parser, &offset, &size);
-				if (inputContext)
-				{
-					int pos = offset;
-					while (offset > 0 && pos - offset < 20)
-					{
-						if (inputContext[offset] == '\n')
-						{
-							offset++;
-							break;
-						}
-						offset--;
-					}
-					for (int i = offset; i < size && i - offset < 40; i++)
-					{
-						if (inputContext[i] == '\n')
-							break;
-						if (inputContext[i] == '\t')
-							DebugPrint (" ");
-						else
-							DebugPrint ("%c", inputContext[i]);
-					}
-					DebugPrint ("\n");
-					for (int i = offset; i < pos; i++)
-					{
-						DebugPrint (" ");
-					}
-					DebugPrint ("^\n");
-				}
-				#endif
-				pImpl->handler = nullptr;
-				return false;
-			}
-			case XML_STATUS_SUSPENDED:
+			void* buffer = XML_GetBuffer (pImpl->parser, kBufferSize);
+			if (buffer == nullptr)
 			{
-				pImpl->handler = nullptr;
-				return true;
+				result = Impl::Result::Failed;
+				break;
 			}
-			default:
+
+			uint32_t bytesRead = provider->readRawXmlData ((int8_t*)buffer, kBufferSize);
+			if (bytesRead == kStreamIOError)
+				bytesRead = 0;
+			XML_Status status = XML_ParseBuffer (pImpl->parser, static_cast<int> (bytesRead), bytesRead == 0);
+			result = pImpl->handleStatus (status, nullptr, 0);
+			if (bytesRead == 0)
 				break;
 		}
-
-		if (bytesRead == 0)
-			break;
 	}
 	pImpl->handler = nullptr;
-	return true;
+	return result != Impl::Result::Failed;
 }
 
 //-----------------------------------------------------------------------------
 bool Parser::stop ()
 {
+	pImpl->stopped = true;
 	XML_StopParser (pImpl->parser, false);
 	return true;
 }
 
+//-----------------------------------------------------------------------------
+bool Parser::isStopped () const
+{
+	return pImpl->stopped;
+}
+
 //------------------------------------------------------------------------
 //------------------------------------------------------------------------
 //------------------------------------------------------------------------
@@ -222,6 +260,13 @@ void MemoryContentProvider::rewind ()
 	CMemoryStream::rewind ();
 }
 
+//------------------------------------------------------------------------
+const int8_t* MemoryContentProvider::getRawXmlData (uint32_t& dataSize)
+{
+	dataSize = size;
+	return buffer;
+}
+
 //------------------------------------------------------------------------
 //------------------------------------------------------------------------
 //------------------------------------------------------------------------
@@ -20,6 +20,11 @@ class IContentProvider
 public:
 	virtual uint32_t readRawXmlData (int8_t* buffer, uint32_t size) = 0;
 	virtual void rewind () = 0;
+
+	/** if the whole content is available in memory, return it here. The parser then parses it in
+	 *	one go instead of copying it chunk by chunk via readRawXmlData.
+	 */
+	virtual const int8_t* getRawXmlData (uint32_t& size) { return nullptr; }
 };
 
 //-----------------------------------------------------------------------------
@@ -42,6 +47,8 @@ public:
 	bool parse (IContentProvider* provider, IHandler* handler);
 
 	bool stop ();
+	/** true if a handler called stop () */
+	bool isStopped () const;
 
 	IHandler* getHandler () const;
 protected:
@@ -56,6 +63,7 @@ public:
 	MemoryContentProvider (const void* data, uint32_t dataSize);		// data must be valid the whole lifetime of this object
 	uint32_t readRawXmlData (int8_t* buffer, uint32_t size) override;
 	void rewind () override;
+	const int8_t* getRawXmlData (uint32_t& size) override;
 };
 
 //-----------------------------------------------------------------------------
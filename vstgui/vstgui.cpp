@@ -12,8 +12,12 @@
 #include "lib/cfileselector.cpp"
 #include "lib/cfont.cpp"
 #include "lib/cframe.cpp"
+#include "lib/cframeclock.cpp"
+#include "lib/cframeprofiler.cpp"
+#include "lib/cframeprofilerview.cpp"
 #include "lib/cgradientview.cpp"
 #include "lib/cgraphicspath.cpp"
+#include "lib/cinvalidrectlist.cpp"
 #include "lib/clayeredviewcontainer.cpp"
 #include "lib/clinestyle.cpp"
 #include "lib/coffscreencontext.cpp"
@@ -26,9 +30,11 @@
 #include "lib/csplitview.cpp"
 #include "lib/cstring.cpp"
 #include "lib/ctabview.cpp"
+#include "lib/ctextlayout.cpp"
 #include "lib/ctooltipsupport.cpp"
 #include "lib/cview.cpp"
 #include "lib/cviewcontainer.cpp"
+#include "lib/cviewlayercache.cpp"
 #include "lib/cvstguitimer.cpp"
 #include "lib/genericstringlistdatabrowsersource.cpp"
 #include "lib/vstguidebug.cpp"
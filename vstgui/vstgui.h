@@ -17,9 +17,13 @@
 #include "lib/cfileselector.h"
 #include "lib/cfont.h"
 #include "lib/cframe.h"
+#include "lib/cframeclock.h"
+#include "lib/cframeprofiler.h"
+#include "lib/cframeprofilerview.h"
 #include "lib/cgradient.h"
 #include "lib/cgradientview.h"
 #include "lib/cgraphicspath.h"
+#include "lib/cinvalidrectlist.h"
 #include "lib/clayeredviewcontainer.h"
 #include "lib/clinestyle.h"
 #include "lib/coffscreencontext.h"
@@ -32,9 +36,11 @@
 #include "lib/csplitview.h"
 #include "lib/cstring.h"
 #include "lib/ctabview.h"
+#include "lib/ctextlayout.h"
 #include "lib/ctooltipsupport.h"
 #include "lib/cview.h"
 #include "lib/cviewcontainer.h"
+#include "lib/cviewlayercache.h"
 #include "lib/cvstguitimer.h"
 #include "lib/iviewlistener.h"
 #include "lib/vstguidebug.h"
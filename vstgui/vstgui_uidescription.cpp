@@ -4,6 +4,8 @@
 
 #include "vstgui_uidescription.h"
 
+#include "uidescription/binaryuidescription.cpp"
+#include "uidescription/compresseduidescription.cpp"
 #include "uidescription/cstream.cpp"
 #include "uidescription/uiattributes.cpp"
 #include "uidescription/uidescription.cpp"